@@ -1,3913 +1,6880 @@
-#include "pic24duino.h"						//pic24duino
-
-//mcus supported
-//PIC24GA00x: PIC24FJxx002, PIC24FJxx004
-//PIC24GA10x: PIC24FJxx102, PIC24FJxx104
-//PIC24GB00x: PIC24FJxx002, PIC24FJxx004
-
-
-
-//config words settings
-#if defined(__XC__)					//for XC16
-//PIC24FJxxGA104 family
-#if defined(__PIC24GA10x__)
-/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | */
-/*		defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) */
-
-//config fues settings for 24fj64ga102
-///config fues settings
-//CONFIG1
-#pragma config JTAGEN = OFF
-#pragma config GCP = OFF
-#pragma config GWRP = OFF
-#pragma config ICS = PGx2
-#pragma config FWDTEN = OFF
-#pragma config WINDIS = OFF
-#pragma config FWPSA = PR128
-#pragma config WDTPS = PS32768
-
-//CONFIG2
-#pragma config IESO = OFF
-#pragma config FNOSC = FRC		//FRC, FRCPLL, PRI, PRIPLL, SOSC, LPRC, FRCDIV
-#pragma config FCKSM = CSDCMD
-#pragma config OSCIOFNC = OFF
-#pragma config IOL1WAY = OFF
-#pragma config POSCMOD = HS		//EC, XT, HS, NONE
-#pragma config I2C1SEL = PRI
-
-//CONFIG3
-#pragma config WPFP = WPFP0
-#pragma config SOSCSEL = IO
-#pragma config WUTSEL = LEG
-#pragma config WPDIS = WPDIS
-#pragma config WPCFG = WPCFGDIS
-#pragma config WPEND = WPENDMEM
-
-//CONFIG4
-#pragma config DSWDTPS = DSWDTPSF
-#pragma config DSWDTOSC = LPRC
-#pragma config RTCOSC = LPRC
-#pragma config DSBOREN = OFF
-#pragma config DSWDTEN = OFF
-
-
-/*
- DSWDT Postscale Select
-DSWDTPS = DSWDTPS0	 1 : 2 (2.1 ms)
-DSWDTPS = DSWDTPS1	 1 : 8 (8.3 ms)
-DSWDTPS = DSWDTPS2	 1 : 32 (33 ms)
-DSWDTPS = DSWDTPS3	 1 : 128 (132 ms)
-DSWDTPS = DSWDTPS4	 1 : 512 (528 ms)
-DSWDTPS = DSWDTPS5	 1 : 2,048 (2.1 seconds)
-DSWDTPS = DSWDTPS6	 1 : 8,192 (8.5 seconds)
-DSWDTPS = DSWDTPS7	 1 : 32,768 (34 seconds)
-DSWDTPS = DSWDTPS8	 1 : 131,072 (135 seconds)
-DSWDTPS = DSWDTPS9	 1 : 524,288 (9 minutes)
-DSWDTPS = DSWDTPSA	 1 : 2,097,152 (36 minutes)
-DSWDTPS = DSWDTPSB	 1 : 8,388,608 (2.4 hours)
-DSWDTPS = DSWDTPSC	 1 : 33,554,432 (9.6 hours)
-DSWDTPS = DSWDTPSD	 1 : 134,217,728 (38.5 hours)
-DSWDTPS = DSWDTPSE	 1 : 536,870,912 (6.4 days)
-DSWDTPS = DSWDTPSF	 1 : 2,147,483,648 (25.7 days)
-
-Deep Sleep Watchdog Timer Oscillator Select
-DSWDTOSC = SOSC	 DSWDT uses Secondary Oscillator (SOSC)
-DSWDTOSC = LPRC	 DSWDT uses Low Power RC Oscillator (LPRC)
-
-RTCC Reference Oscillator Select
-RTCOSC = LPRC	 RTCC uses Low Power RC Oscillator (LPRC)
-RTCOSC = SOSC	 RTCC uses Secondary Oscillator (SOSC)
-
-Deep Sleep BOR Enable bit
-DSBOREN = OFF	 BOR disabled in Deep Sleep
-DSBOREN = ON	 BOR enabled in Deep Sleep
-
-Deep Sleep Watchdog Timer
-DSWDTEN = OFF	 DSWDT disabled
-DSWDTEN = ON	 DSWDT enabled
-
-Write Protection Flash Page Segment Boundary
-WPFP = WPFP0	 Page 0 (0x0)
-WPFP = WPFP1	 Page 1 (0x400)
-WPFP = WPFP2	 Page 2 (0x800)
-WPFP = WPFP3	 Page 3 (0xC00)
-WPFP = WPFP4	 Page 4 (0x1000)
-WPFP = WPFP5	 Page 5 (0x1400)
-WPFP = WPFP6	 Page 6 (0x1800)
-WPFP = WPFP7	 Page 7 (0x1C00)
-WPFP = WPFP8	 Page 8 (0x2000)
-WPFP = WPFP9	 Page 9 (0x2400)
-WPFP = WPFP10	 Page 10 (0x2800)
-WPFP = WPFP11	 Page 11 (0x2C00)
-WPFP = WPFP12	 Page 12 (0x3000)
-WPFP = WPFP13	 Page 13 (0x3400)
-WPFP = WPFP14	 Page 14 (0x3800)
-WPFP = WPFP15	 Page 15 (0x3C00)
-WPFP = WPFP16	 Page 16 (0x4000)
-WPFP = WPFP17	 Page 17 (0x4400)
-WPFP = WPFP18	 Page 18 (0x4800)
-WPFP = WPFP19	 Page 19 (0x4C00)
-WPFP = WPFP20	 Page 20 (0x5000)
-WPFP = WPFP21	 Page 21 (0x5400)
-WPFP = WPFP22	 Page 22 (0x5800)
-WPFP = WPFP23	 Page 23 (0x5C00)
-WPFP = WPFP24	 Page 24 (0x6000)
-WPFP = WPFP25	 Page 25 (0x6400)
-WPFP = WPFP26	 Page 26 (0x6800)
-WPFP = WPFP27	 Page 27 (0x6C00)
-WPFP = WPFP28	 Page 28 (0x7000)
-WPFP = WPFP29	 Page 29 (0x7400)
-WPFP = WPFP30	 Page 30 (0x7800)
-WPFP = WPFP31	 Page 31 (0x7C00)
-WPFP = WPFP32	 Page 32 (0x8000)
-WPFP = WPFP33	 Page 33 (0x8400)
-WPFP = WPFP34	 Page 34 (0x8800)
-WPFP = WPFP35	 Page 35 (0x8C00)
-WPFP = WPFP36	 Page 36 (0x9000)
-WPFP = WPFP37	 Page 37 (0x9400)
-WPFP = WPFP38	 Page 38 (0x9800)
-WPFP = WPFP39	 Page 39 (0x9C00)
-WPFP = WPFP40	 Page 40 (0xA000)
-WPFP = WPFP41	 Page 41 (0xA400)
-WPFP = WPFP42	 Page 42 (0xA800)
-WPFP = WPFP63	 Highest Page (same as page 42)
-
- * Secondary Oscillator Pin Mode Select
-SOSCSEL = IO	 SOSC pins have digital I/O functions (RA4, RB4)
-SOSCSEL = LPSOSC	 SOSC pins in Low-Power (low drive-strength) Oscillator Mode
-SOSCSEL = SOSC	 SOSC pins in Default (high drive-strength) Oscillator Mode
-
-Voltage Regulator Wake-up Time Select
-WUTSEL = FST	 Fast regulator start-up time used
-WUTSEL = LEG	 Default regulator start-up time used
-
-Segment Write Protection Disable
-WPDIS = WPEN	 Segmented code protection enabled
-WPDIS = WPDIS	 Segmented code protection disabled
-
-Write Protect Configuration Page Select
-WPCFG = WPCFGEN	 Last page and Flash Configuration words are code-protected
-WPCFG = WPCFGDIS	 Last page and Flash Configuration words are unprotected
-
-Segment Write Protection End Page Select
-WPEND = WPSTARTMEM	 Write Protect from page 0 to WPFP
-WPEND = WPENDMEM	 Write Protect from WPFP to the last page of memory
-
-Primary Oscillator Select
-POSCMOD = EC	 EC Oscillator mode selected
-POSCMOD = XT	 XT Oscillator mode selected
-POSCMOD = HS	 HS Oscillator mode selected
-POSCMOD = NONE	 Primary Oscillator disabled
-
-I2C1 Pin Select bit
-I2C1SEL = SEC	 Use alternate SCL1/SDA1 pins for I2C1
-I2C1SEL = PRI	 Use default SCL1/SDA1 pins for I2C1
-
-IOLOCK One-Way Set Enable
-IOL1WAY = OFF	 The IOLOCK bit can be set and cleared using the unlock sequence
-IOL1WAY = ON	 Once set, the IOLOCK bit cannot be cleared
-
- * OSCO Pin Configuration
-OSCIOFNC = ON	 OSCO pin functions as port I/O (RA3)
-OSCIOFNC = OFF	 OSCO pin functions as clock output (CLKO)
-
-Clock Switching and Fail-Safe Clock Monitor
-FCKSM = CSECME	 Sw Enabled, Mon Enabled
-FCKSM = CSECMD	 Sw Enabled, Mon Disabled
-FCKSM = CSDCMD	 Sw Disabled, Mon Disabled
-
-Initial Oscillator Select
-FNOSC = FRC	 Fast RC Oscillator (FRC)
-FNOSC = FRCPLL	 Fast RC Oscillator with Postscaler and PLL module (FRCPLL)
-FNOSC = PRI	 Primary Oscillator (XT, HS, EC)
-FNOSC = PRIPLL	 Primary Oscillator with PLL module (XTPLL, HSPLL, ECPLL)
-FNOSC = SOSC	 Secondary Oscillator (SOSC)
-FNOSC = LPRC	 Low-Power RC Oscillator (LPRC)
-FNOSC = FRCDIV	 Fast RC Oscillator with Postscaler (FRCDIV)
-
-Internal External Switchover
-IESO = OFF	 IESO mode (Two-Speed Start-up) disabled
-IESO = ON	 IESO mode (Two-Speed Start-up) enabled
-
-Watchdog Timer Postscaler
-WDTPS = PS1	 1 : 1
-WDTPS = PS2	 1 : 2
-WDTPS = PS4	 1 : 4
-WDTPS = PS8	 1 : 8
-WDTPS = PS16	 1 : 16
-WDTPS = PS32	 1 : 32
-WDTPS = PS64	 1 : 64
-WDTPS = PS128	 1 : 128
-WDTPS = PS256	 1 : 256
-WDTPS = PS512	 1 : 512
-WDTPS = PS1024	 1 : 1,024
-WDTPS = PS2048	 1 : 2,048
-WDTPS = PS4096	 1 : 4,096
-WDTPS = PS8192	 1 : 8,192
-WDTPS = PS16384	 1 : 16,384
-WDTPS = PS32768	 1 : 32,768
-
-WDT Prescaler
-FWPSA = PR32	 Prescaler ratio of 1 : 32
-FWPSA = PR128	 Prescaler ratio of 1 : 128
-
-Windowed WDT
-WINDIS = ON	 Windowed Watchdog Timer enabled; FWDTEN must be 1
-WINDIS = OFF	 Standard Watchdog Timer enabled,(Windowed-mode is disabled)
-
-Watchdog Timer
-FWDTEN = OFF	 Watchdog Timer is disabled
-FWDTEN = ON	 Watchdog Timer is enabled
-
-Emulator Pin Placement Select bits
-ICS = PGx3	 Emulator functions are shared with PGEC3/PGED3
-ICS = PGx2	 Emulator functions are shared with PGEC2/PGED2
-ICS = PGx1	 Emulator functions are shared with PGEC1/PGED1
-
-General Segment Write Protect
-GWRP = ON	 Writes to program memory are disabled
-GWRP = OFF	 Writes to program memory are allowed
-
-General Segment Code Protect
-GCP = ON	 Code protection is enabled for the entire program memory space
-GCP = OFF	 Code protection is disabled
-
-JTAG Port Enable
-JTAGEN = OFF	 JTAG port is disabled
-JTAGEN = ON	 JTAG port is enabled
- */
-
-//pic24fj64ga004 family
-#elif defined(__PIC24GA00x__)
-/*#elif 	defined(__PIC24FJ64GA002__) | defined (__PIC24FJ64GA004__) | \*/
-/*		defined(__PIC24FJ48GA002__) | defined (__PIC24FJ48GA004__) | \*/
-/*		defined(__PIC24FJ32GA002__) | defined (__PIC24FJ32GA004__) | \*/
-/*		defined(__PIC24FJ16GA002__) | defined (__PIC24FJ16GA004__)*/
-
-/*config fues settings for everything else - need customization*/
-//CONFIG1
-#pragma config JTAGEN = OFF
-#pragma config GCP = OFF
-#pragma config GWRP = OFF
-#pragma config BKBUG = OFF
-#pragma config COE = OFF
-#pragma config ICS = PGx2
-#pragma config FWDTEN = OFF
-#pragma config WINDIS = OFF
-#pragma config FWPSA = PR128
-#pragma config WDTPS = PS32768
-
-//CONFIG2
-#pragma config IESO = OFF
-#pragma config SOSCSEL = SOSC
-#pragma config WUTSEL = LEG
-#pragma config FCKSM = CSDCMD
-#pragma config OSCIOFNC = OFF
-#pragma config IOL1WAY = OFF
-#pragma config I2C1SEL = PRI
-#pragma config POSCMOD = NONE				//EC/XT/HS/NONE
-#pragma config FNOSC = FRC				//FRC/FRCPLL/FRCDIV/PRI/PRIPLL/SOSC/LPRC
-
-/*
- Primary Oscillator Select
-POSCMOD = EC	 EC Oscillator mode selected
-POSCMOD = XT	 XT Oscillator mode selected
-POSCMOD = HS	 HS Oscillator mode selected
-POSCMOD = NONE	 Primary oscillator disabled
-
-I2C1 Pin Location Select
-I2C1SEL = SEC	 Use alternate SCL1/SDA1 pins
-I2C1SEL = PRI	 Use default SCL1/SDA1 pins
-
-IOLOCK Protection
-IOL1WAY = OFF	 IOLOCK may be changed via unlocking seq
-IOL1WAY = ON	 Once IOLOCK is set, cannot be changed
-
-Primary Oscillator Output Function
-OSCIOFNC = ON	 OSC2/CLKO/RC15 functions as port I/O (RC15)
-OSCIOFNC = OFF	 OSC2/CLKO/RC15 functions as CLKO (FOSC/2)
-
-Clock Switching and Monitor
-FCKSM = CSECME	 Clock switching is enabled, Fail-Safe Clock Monitor is enabled
-FCKSM = CSECMD	 Clock switching is enabled, Fail-Safe Clock Monitor is disabled
-FCKSM = CSDCMD	 Clock switching and Fail-Safe Clock Monitor are disabled
-
-Oscillator Select
-FNOSC = FRC	 Fast RC Oscillator (FRC)
-FNOSC = FRCPLL	 Fast RC Oscillator with PLL module (FRCPLL)
-FNOSC = PRI	 Primary Oscillator (XT, HS, EC)
-FNOSC = PRIPLL	 Primary Oscillator with PLL module (HSPLL, ECPLL)
-FNOSC = SOSC	 Secondary Oscillator (SOSC)
-FNOSC = LPRC	 Low-Power RC Oscillator (LPRC)
-FNOSC = FRCDIV	 Fast RC Oscillator with Postscaler (FRCDIV)
-
-Sec Oscillator Select
-SOSCSEL = LPSOSC	 Low Power Secondary Oscillator (LPSOSC)
-SOSCSEL = SOSC	 Default Secondary Oscillator (SOSC)
-
-Wake-up timer Select
-WUTSEL = FST	 Fast Wake-up Timer
-WUTSEL = LEG	 Legacy Wake-up Timer
-
-Internal External Switch Over Mode
-IESO = OFF	 IESO mode (Two-Speed Start-up) disabled
-IESO = ON	 IESO mode (Two-Speed Start-up) enabled
-
-Watchdog Timer Postscaler
-WDTPS = PS1	 1 : 1
-WDTPS = PS2	 1 : 2
-WDTPS = PS4	 1 : 4
-WDTPS = PS8	 1 : 8
-WDTPS = PS16	 1 : 16
-WDTPS = PS32	 1 : 32
-WDTPS = PS64	 1 : 64
-WDTPS = PS128	 1 : 128
-WDTPS = PS256	 1 : 256
-WDTPS = PS512	 1 : 512
-WDTPS = PS1024	 1 : 1,024
-WDTPS = PS2048	 1 : 2,048
-WDTPS = PS4096	 1 : 4,096
-WDTPS = PS8192	 1 : 8,192
-WDTPS = PS16384	 1 : 16,384
-WDTPS = PS32768	 1 : 32,768
-
-WDT Prescaler
-FWPSA = PR32	 Prescaler ratio of 1 : 32
-FWPSA = PR128	 Prescaler ratio of 1 : 128
-
-Watchdog Timer Window
-WINDIS = OFF	 Windowed Watchdog Timer enabled; FWDTEN must be 1
-WINDIS = ON	 Standard Watchdog Timer enabled,(Windowed-mode is disabled)
-
-Watchdog Timer Enable
-FWDTEN = OFF	 Watchdog Timer is disabled
-FWDTEN = ON	 Watchdog Timer is enabled
-
-Comm Channel Select
-ICS = PGx3	 Emulator EMUC3/EMUD3 pins are shared with PGC3/PGD3
-ICS = PGx2	 Emulator EMUC2/EMUD2 pins are shared with PGC2/PGD2
-ICS = PGx1	 Emulator EMUC1/EMUD1 pins are shared with PGC1/PGD1
-
-Set Clip On Emulation Mode
-COE = ON	 Reset Into Clip On Emulation Mode
-COE = OFF	 Reset Into Operational Mode
-
-Background Debug
-BKBUG = ON	 Device resets into Debug mode
-BKBUG = OFF	 Device resets into Operational mode
-
-General Code Segment Write Protect
-GWRP = ON	 Writes to program memory are disabled
-GWRP = OFF	 Writes to program memory are allowed
-
-General Code Segment Code Protect
-GCP = ON	 Code protection is enabled for the entire program memory space
-GCP = OFF	 Code protection is disabled
-
-JTAG Port Enable
-JTAGEN = OFF	 JTAG port is disabled
-JTAGEN = ON	 JTAG port is enabled
- */
-
-//pic24fjgb004 family
-#elif defined(__PIC24GB00x__)
-/*#elif 	defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \*/
-/*		defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \*/
-/*		defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-
-//CONFIG1
-#pragma config JTAGEN = OFF
-#pragma config GCP = OFF
-#pragma config GWRP = OFF
-#pragma config ICS = PGx2
-#pragma config FWDTEN = OFF
-#pragma config WINDIS = OFF
-#pragma config FWPSA = PR128
-#pragma config WDTPS = PS32768
-
-//CONFIG2
-#pragma config IESO = OFF
-#pragma config PLLDIV = DIV12
-#pragma config PLL96MHZ = ON
-#pragma config FNOSC = PRI					//FRC, FRCPLL, PRI, PRIPLL, SOSC, LSOC
-#pragma config FCKSM = CSDCMD
-#pragma config OSCIOFNC = OFF
-#pragma config IOL1WAY = OFF
-#pragma config POSCMOD = HS					//EC, HS, XT, NONE
-#pragma config I2C1SEL = PRI
-
-//CONFIG3
-#pragma config WPFP = WPFP0
-#pragma config SOSCSEL = IO
-#pragma config WUTSEL = LEG
-#pragma config WPDIS = WPDIS
-#pragma config WPCFG = WPCFGDIS
-#pragma config WPEND = WPENDMEM
-
-//CONFIG4
-#pragma config DSWDTPS = DSWDTPSF
-#pragma config DSWDTOSC = LPRC
-#pragma config RTCOSC = LPRC
-#pragma config DSBOREN = OFF
-#pragma config DSWDTEN = OFF
-
-
-
-
-/*DSWDT Postscale Select
-DSWDTPS = DSWDTPS0	 1 : 2 (2.1 ms)
-DSWDTPS = DSWDTPS1	 1 : 8 (8.3 ms)
-DSWDTPS = DSWDTPS2	 1 : 32 (33 ms)
-DSWDTPS = DSWDTPS3	 1 : 128 (132 ms)
-DSWDTPS = DSWDTPS4	 1 : 512 (528 ms)
-DSWDTPS = DSWDTPS5	 1 : 2,048 (2.1 seconds)
-DSWDTPS = DSWDTPS6	 1 : 8,192 (8.5 seconds)
-DSWDTPS = DSWDTPS7	 1 : 32,768 (34 seconds)
-DSWDTPS = DSWDTPS8	 1 : 131,072 (135 seconds)
-DSWDTPS = DSWDTPS9	 1 : 524,288 (9 minutes)
-DSWDTPS = DSWDTPSA	 1 : 2,097,152 (36 minutes)
-DSWDTPS = DSWDTPSB	 1 : 8,388,608 (2.4 hours)
-DSWDTPS = DSWDTPSC	 1 : 33,554,432 (9.6 hours)
-DSWDTPS = DSWDTPSD	 1 : 134,217,728 (38.5 hours)
-DSWDTPS = DSWDTPSE	 1 : 536,870,912 (6.4 days)
-DSWDTPS = DSWDTPSF	 1 : 2,147,483,648 (25.7 days)
-
-Deep Sleep Watchdog Timer Oscillator Select
-DSWDTOSC = SOSC	 DSWDT uses Secondary Oscillator (SOSC)
-DSWDTOSC = LPRC	 DSWDT uses Low Power RC Oscillator (LPRC)
-
-RTCC Reference Oscillator Select
-RTCOSC = LPRC	 RTCC uses Low Power RC Oscillator (LPRC)
-RTCOSC = SOSC	 RTCC uses Secondary Oscillator (SOSC)
-
-Deep Sleep BOR Enable bit
-DSBOREN = OFF	 BOR disabled in Deep Sleep
-DSBOREN = ON	 BOR enabled in Deep Sleep
-
-Deep Sleep Watchdog Timer
-DSWDTEN = OFF	 DSWDT disabled
-DSWDTEN = ON	 DSWDT enabled
-
-Write Protection Flash Page Segment Boundary
-WPFP = WPFP0	 Page 0 (0x0)
-WPFP = WPFP1	 Page 1 (0x400)
-WPFP = WPFP2	 Page 2 (0x800)
-WPFP = WPFP3	 Page 3 (0xC00)
-WPFP = WPFP4	 Page 4 (0x1000)
-WPFP = WPFP5	 Page 5 (0x1400)
-WPFP = WPFP6	 Page 6 (0x1800)
-WPFP = WPFP7	 Page 7 (0x1C00)
-WPFP = WPFP8	 Page 8 (0x2000)
-WPFP = WPFP9	 Page 9 (0x2400)
-WPFP = WPFP10	 Page 10 (0x2800)
-WPFP = WPFP11	 Page 11 (0x2C00)
-WPFP = WPFP12	 Page 12 (0x3000)
-WPFP = WPFP13	 Page 13 (0x3400)
-WPFP = WPFP14	 Page 14 (0x3800)
-WPFP = WPFP15	 Page 15 (0x3C00)
-WPFP = WPFP16	 Page 16 (0x4000)
-WPFP = WPFP17	 Page 17 (0x4400)
-WPFP = WPFP18	 Page 18 (0x4800)
-WPFP = WPFP19	 Page 19 (0x4C00)
-WPFP = WPFP20	 Page 20 (0x5000)
-WPFP = WPFP21	 Page 21 (0x5400)
-WPFP = WPFP22	 Page 22 (0x5800)
-WPFP = WPFP23	 Page 23 (0x5C00)
-WPFP = WPFP24	 Page 24 (0x6000)
-WPFP = WPFP25	 Page 25 (0x6400)
-WPFP = WPFP26	 Page 26 (0x6800)
-WPFP = WPFP27	 Page 27 (0x6C00)
-WPFP = WPFP28	 Page 28 (0x7000)
-WPFP = WPFP29	 Page 29 (0x7400)
-WPFP = WPFP30	 Page 30 (0x7800)
-WPFP = WPFP31	 Page 31 (0x7C00)
-WPFP = WPFP32	 Page 32 (0x8000)
-WPFP = WPFP33	 Page 33 (0x8400)
-WPFP = WPFP34	 Page 34 (0x8800)
-WPFP = WPFP35	 Page 35 (0x8C00)
-WPFP = WPFP36	 Page 36 (0x9000)
-WPFP = WPFP37	 Page 37 (0x9400)
-WPFP = WPFP38	 Page 38 (0x9800)
-WPFP = WPFP39	 Page 39 (0x9C00)
-WPFP = WPFP40	 Page 40 (0xA000)
-WPFP = WPFP41	 Page 41 (0xA400)
-WPFP = WPFP42	 Page 42 (0xA800)
-WPFP = WPFP63	 Highest Page (same as page 42)
-
-Secondary Oscillator Pin Mode Select
-SOSCSEL = IO	 SOSC pins have digital I/O functions (RA4, RB4)
-SOSCSEL = LPSOSC	 SOSC pins in Low-Power (low drive-strength) Oscillator Mode
-SOSCSEL = SOSC	 SOSC pins in Default (high drive-strength) Oscillator Mode
-
-Voltage Regulator Wake-up Time Select
-WUTSEL = FST	 Fast regulator start-up time used
-WUTSEL = LEG	 Default regulator start-up time used
-
-Segment Write Protection Disable
-WPDIS = WPEN	 Segmented code protection enabled
-WPDIS = WPDIS	 Segmented code protection disabled
-
-Write Protect Configuration Page Select
-WPCFG = WPCFGEN	 Last page and Flash Configuration words are code-protected
-WPCFG = WPCFGDIS	 Last page and Flash Configuration words are unprotected
-
-Segment Write Protection End Page Select
-WPEND = WPSTARTMEM	 Write Protect from page 0 to WPFP
-WPEND = WPENDMEM	 Write Protect from WPFP to the last page of memory
-
-Primary Oscillator Select
-POSCMOD = EC	 EC Oscillator mode selected
-POSCMOD = XT	 XT Oscillator mode selected
-POSCMOD = HS	 HS Oscillator mode selected
-POSCMOD = NONE	 Primary Oscillator disabled
-
-I2C1 Pin Select bit
-I2C1SEL = SEC	 Use alternate SCL1/SDA1 pins for I2C1
-I2C1SEL = PRI	 Use default SCL1/SDA1 pins for I2C1
-
-IOLOCK One-Way Set Enable
-IOL1WAY = OFF	 The IOLOCK bit can be set and cleared using the unlock sequence
-IOL1WAY = ON	 Once set, the IOLOCK bit cannot be cleared
-
-OSCO Pin Configuration
-OSCIOFNC = ON	 OSCO pin functions as port I/O (RA3)
-OSCIOFNC = OFF	 OSCO pin functions as clock output (CLKO)
-
-Clock Switching and Fail-Safe Clock Monitor
-FCKSM = CSECME	 Sw Enabled, Mon Enabled
-FCKSM = CSECMD	 Sw Enabled, Mon Disabled
-FCKSM = CSDCMD	 Sw Disabled, Mon Disabled
-
-Initial Oscillator Select
-FNOSC = FRC	 Fast RC Oscillator (FRC)
-FNOSC = FRCPLL	 Fast RC Oscillator with Postscaler and PLL module (FRCPLL)
-FNOSC = PRI	 Primary Oscillator (XT, HS, EC)
-FNOSC = PRIPLL	 Primary Oscillator with PLL module (XTPLL, HSPLL, ECPLL)
-FNOSC = SOSC	 Secondary Oscillator (SOSC)
-FNOSC = LPRC	 Low-Power RC Oscillator (LPRC)
-FNOSC = FRCDIV	 Fast RC Oscillator with Postscaler (FRCDIV)
-
-96MHz PLL Startup Select
-PLL96MHZ = OFF	 96 MHz PLL Startup is enabled by user in software( controlled with the PLLEN bit)
-PLL96MHZ = ON	 96 MHz PLL Startup is enabled automatically on start-up
-
-USB 96 MHz PLL Prescaler Select
-PLLDIV = NODIV	 Oscillator input used directly (4 MHz input)
-PLLDIV = DIV2	 Oscillator input divided by 2 (8 MHz input)
-PLLDIV = DIV3	 Oscillator input divided by 3 (12 MHz input)
-PLLDIV = DIV4	 Oscillator input divided by 4 (16 MHz input)
-PLLDIV = DIV5	 Oscillator input divided by 5 (20 MHz input)
-PLLDIV = DIV6	 Oscillator input divided by 6 (24 MHz input)
-PLLDIV = DIV8	 Oscillator input divided by 8 (32 MHz input)
-PLLDIV = DIV12	 Oscillator input divided by 12 (48 MHz input)
-
-Internal External Switchover
-IESO = OFF	 IESO mode (Two-Speed Start-up) disabled
-IESO = ON	 IESO mode (Two-Speed Start-up) enabled
-
-Watchdog Timer Postscaler
-WDTPS = PS1	 1 : 1
-WDTPS = PS2	 1 : 2
-WDTPS = PS4	 1 : 4
-WDTPS = PS8	 1 : 8
-WDTPS = PS16	 1 : 16
-WDTPS = PS32	 1 : 32
-WDTPS = PS64	 1 : 64
-WDTPS = PS128	 1 : 128
-WDTPS = PS256	 1 : 256
-WDTPS = PS512	 1 : 512
-WDTPS = PS1024	 1 : 1,024
-WDTPS = PS2048	 1 : 2,048
-WDTPS = PS4096	 1 : 4,096
-WDTPS = PS8192	 1 : 8,192
-WDTPS = PS16384	 1 : 16,384
-WDTPS = PS32768	 1 : 32,768
-
-WDT Prescaler
-FWPSA = PR32	 Prescaler ratio of 1 : 32
-FWPSA = PR128	 Prescaler ratio of 1 : 128
-
-Windowed WDT
-WINDIS = ON	 Windowed Watchdog Timer enabled; FWDTEN must be 1
-WINDIS = OFF	 Standard Watchdog Timer enabled,(Windowed-mode is disabled)
-
-Watchdog Timer
-FWDTEN = OFF	 Watchdog Timer is disabled
-FWDTEN = ON	 Watchdog Timer is enabled
-
-Emulator Pin Placement Select bits
-ICS = PGx3	 Emulator functions are shared with PGEC3/PGED3
-ICS = PGx2	 Emulator functions are shared with PGEC2/PGED2
-ICS = PGx1	 Emulator functions are shared with PGEC1/PGED1
-
-General Segment Write Protect
-GWRP = ON	 Writes to program memory are disabled
-GWRP = OFF	 Writes to program memory are allowed
-
-General Segment Code Protect
-GCP = ON	 Code protection is enabled for the entire program memory space
-GCP = OFF	 Code protection is disabled
-
-JTAG Port Enable
-JTAGEN = OFF	 JTAG port is disabled
-JTAGEN = ON	 JTAG port is enabled
- */
-#endif			//pic24gb00x
-#endif 					//xc16
-
-//config for C30
-#if defined(__C30__)				//for C30 compiler
-
-#if defined(__PIC24GA10x__)		//for pic24ga10x
-
-
-//config fues settings for 24fj64ga102
-///config fues settings
-_CONFIG1(
-	JTAGEN_OFF &					//Disable JTAG port
-	GCP_OFF &						//Disable code protect
-	GWRP_OFF &						//Disable write protect
-	ICS_PGx2 &						//EMUC/EMUD share PGC2/PGD2
-	FWDTEN_OFF &					//Disable watchdog timer (WDT)
-	WINDIS_OFF &					//Use standard WDT (if it is enabled)
-	FWPSA_PR128 &					//Use WDT prescaler ratio of 1:128
-	WDTPS_PS32768					//Use WDT postscaler ratio of 1:32,768
-)
-
-_CONFIG2(
-	FNOSC_FRC &						//Primary oscillator: FRC, FRCPLL, PRI, PRIPLL, SOSC, LPRC, FRCDIV
-	POSCMOD_HS &					//External oscillator: HS, XT, EC, NONE
-	IESO_OFF &						//Disabled
-	FCKSM_CSDCMD &					//Clock switching and clock monitor disabled
-	OSCIOFNC_OFF &					//OSCO or Fosc/2
-	IOL1WAY_OFF &					//Unlimited Writes To RP Registers
-	I2C1SEL_PRI						//Use Primary I2C1 pins
-	//SOSCSEL_SOSC &					//Default Secondary Oscillator
-	//WUTSEL_LEG &					//Legacy Wake-up timer selected
-)
-
-_CONFIG3(
-	WPFP_WPFP63 &					//Highest Page (same as page 42)
-	SOSCSEL_IO &					//SOSC pins have digital I/O functions (RA4, RB4)
-	WUTSEL_LEG &					//Default regulator start-up time used
-	WPDIS_WPDIS &					//Segmented code protection disabled
-	WPCFG_WPCFGDIS &				//Last page and Flash Configuration words are unprotected
-	WPEND_WPENDMEM					//Write Protect from WPFP to the last page of memory
-)
-
-_CONFIG4(
-	DSWDTPS_DSWDTPSF &				//1:2,147,483,648 (25.7 days)
-	DSWDTOSC_LPRC &					//DSWDT uses Low Power RC Oscillator (LPRC)
-	RTCOSC_LPRC &					//RTCC uses Low Power RC Oscillator (LPRC)
-	DSBOREN_OFF &					//BOR disabled in Deep Sleep
-	DSWDTEN_OFF 					//DSWDT disabled
-)
-
-/* -------------------------------------------------------- */
-/* Macros for setting device configuration registers        */
-/* -------------------------------------------------------- */
-
-/* Register CONFIG4 (0xabf8)                               */
-
-/*
-** Only one invocation of CONFIG4 should appear in a project,
-** at the top of a C source file (outside of any function).
-**
-** The following constants can be used to set CONFIG4.
-** Multiple options may be combined, as shown:
-**
-** _CONFIG4( OPT1_ON & OPT2_OFF & OPT3_PLL )
-**
-**   DSWDT Postscale Select:
-**     DSWDTPS_DSWDTPS0     1:2 (2.1 ms)
-**     DSWDTPS_DSWDTPS1     1:8 (8.3 ms)
-**     DSWDTPS_DSWDTPS2     1:32 (33 ms)
-**     DSWDTPS_DSWDTPS3     1:128 (132 ms)
-**     DSWDTPS_DSWDTPS4     1:512 (528 ms)
-**     DSWDTPS_DSWDTPS5     1:2,048 (2.1 seconds)
-**     DSWDTPS_DSWDTPS6     1:8,192 (8.5 seconds)
-**     DSWDTPS_DSWDTPS7     1:32,768 (34 seconds)
-**     DSWDTPS_DSWDTPS8     1:131,072 (135 seconds)
-**     DSWDTPS_DSWDTPS9     1:524,288 (9 minutes)
-**     DSWDTPS_DSWDTPSA     1:2,097,152 (36 minutes)
-**     DSWDTPS_DSWDTPSB     1:8,388,608 (2.4 hours)
-**     DSWDTPS_DSWDTPSC     1:33,554,432 (9.6 hours)
-**     DSWDTPS_DSWDTPSD     1:134,217,728 (38.5 hours)
-**     DSWDTPS_DSWDTPSE     1:536,870,912 (6.4 days)
-**     DSWDTPS_DSWDTPSF     1:2,147,483,648 (25.7 days)
-**
-**   Deep Sleep Watchdog Timer Oscillator Select:
-**     DSWDTOSC_SOSC        DSWDT uses Secondary Oscillator (SOSC)
-**     DSWDTOSC_LPRC        DSWDT uses Low Power RC Oscillator (LPRC)
-**
-**   RTCC Reference Oscillator  Select:
-**     RTCOSC_LPRC          RTCC uses Low Power RC Oscillator (LPRC)
-**     RTCOSC_SOSC          RTCC uses Secondary Oscillator (SOSC)
-**
-**   Deep Sleep BOR Enable bit:
-**     DSBOREN_OFF          BOR disabled in Deep Sleep
-**     DSBOREN_ON           BOR enabled in Deep Sleep
-**
-**   Deep Sleep Watchdog Timer:
-**     DSWDTEN_OFF          DSWDT disabled
-**     DSWDTEN_ON           DSWDT enabled
-**
-*/
-
-/* Register CONFIG3 (0xabfa)                               */
-
-/*
-** Only one invocation of CONFIG3 should appear in a project,
-** at the top of a C source file (outside of any function).
-**
-** The following constants can be used to set CONFIG3.
-** Multiple options may be combined, as shown:
-**
-** _CONFIG3( OPT1_ON & OPT2_OFF & OPT3_PLL )
-**
-**   Write Protection Flash Page Segment Boundary:
-**     WPFP_WPFP0           Page 0 (0x0)
-**     WPFP_WPFP1           Page 1 (0x400)
-**     WPFP_WPFP2           Page 2 (0x800)
-**     WPFP_WPFP3           Page 3 (0xC00)
-**     WPFP_WPFP4           Page 4 (0x1000)
-**     WPFP_WPFP5           Page 5 (0x1400)
-**     WPFP_WPFP6           Page 6 (0x1800)
-**     WPFP_WPFP7           Page 7 (0x1C00)
-**     WPFP_WPFP8           Page 8 (0x2000)
-**     WPFP_WPFP9           Page 9 (0x2400)
-**     WPFP_WPFP10          Page 10 (0x2800)
-**     WPFP_WPFP11          Page 11 (0x2C00)
-**     WPFP_WPFP12          Page 12 (0x3000)
-**     WPFP_WPFP13          Page 13 (0x3400)
-**     WPFP_WPFP14          Page 14 (0x3800)
-**     WPFP_WPFP15          Page 15 (0x3C00)
-**     WPFP_WPFP16          Page 16 (0x4000)
-**     WPFP_WPFP17          Page 17 (0x4400)
-**     WPFP_WPFP18          Page 18 (0x4800)
-**     WPFP_WPFP19          Page 19 (0x4C00)
-**     WPFP_WPFP20          Page 20 (0x5000)
-**     WPFP_WPFP21          Page 21 (0x5400)
-**     WPFP_WPFP22          Page 22 (0x5800)
-**     WPFP_WPFP23          Page 23 (0x5C00)
-**     WPFP_WPFP24          Page 24 (0x6000)
-**     WPFP_WPFP25          Page 25 (0x6400)
-**     WPFP_WPFP26          Page 26 (0x6800)
-**     WPFP_WPFP27          Page 27 (0x6C00)
-**     WPFP_WPFP28          Page 28 (0x7000)
-**     WPFP_WPFP29          Page 29 (0x7400)
-**     WPFP_WPFP30          Page 30 (0x7800)
-**     WPFP_WPFP31          Page 31 (0x7C00)
-**     WPFP_WPFP32          Page 32 (0x8000)
-**     WPFP_WPFP33          Page 33 (0x8400)
-**     WPFP_WPFP34          Page 34 (0x8800)
-**     WPFP_WPFP35          Page 35 (0x8C00)
-**     WPFP_WPFP36          Page 36 (0x9000)
-**     WPFP_WPFP37          Page 37 (0x9400)
-**     WPFP_WPFP38          Page 38 (0x9800)
-**     WPFP_WPFP39          Page 39 (0x9C00)
-**     WPFP_WPFP40          Page 40 (0xA000)
-**     WPFP_WPFP41          Page 41 (0xA400)
-**     WPFP_WPFP42          Page 42 (0xA800)
-**     WPFP_WPFP63          Highest Page (same as page 42)
-**
-**   Secondary Oscillator Pin Mode Select:
-**     SOSCSEL_IO           SOSC pins have digital I/O functions (RA4, RB4)
-**     SOSCSEL_LPSOSC       SOSC pins in Low-Power (low drive-strength) Oscillator Mode
-**     SOSCSEL_SOSC         SOSC pins in Default (high drive-strength) Oscillator Mode
-**
-**   Voltage Regulator Wake-up Time Select:
-**     WUTSEL_FST           Fast regulator start-up time used
-**     WUTSEL_LEG           Default regulator start-up time used
-**
-**   Segment Write Protection Disable:
-**     WPDIS_WPEN           Segmented code protection enabled
-**     WPDIS_WPDIS          Segmented code protection disabled
-**
-**   Write Protect Configuration Page Select:
-**     WPCFG_WPCFGEN        Last page and Flash Configuration words are code-protected
-**     WPCFG_WPCFGDIS       Last page and Flash Configuration words are unprotected
-**
-**   Segment Write Protection End Page Select:
-**     WPEND_WPSTARTMEM     Write Protect from page 0 to WPFP
-**     WPEND_WPENDMEM       Write Protect from WPFP to the last page of memory
-**
-*/
-
-/* Register CONFIG2 (0xabfc)                               */
-
-/*
-** Only one invocation of CONFIG2 should appear in a project,
-** at the top of a C source file (outside of any function).
-**
-** The following constants can be used to set CONFIG2.
-** Multiple options may be combined, as shown:
-**
-** _CONFIG2( OPT1_ON & OPT2_OFF & OPT3_PLL )
-**
-**   Primary Oscillator Select:
-**     POSCMOD_EC           EC Oscillator mode selected
-**     POSCMOD_XT           XT Oscillator mode selected
-**     POSCMOD_HS           HS Oscillator mode selected
-**     POSCMOD_NONE         Primary Oscillator disabled
-**
-**   I2C1 Pin Select bit:
-**     I2C1SEL_SEC          Use alternate SCL1/SDA1 pins for I2C1
-**     I2C1SEL_PRI          Use default SCL1/SDA1 pins for I2C1
-**
-**   IOLOCK One-Way Set Enable:
-**     IOL1WAY_OFF          The IOLOCK bit can be set and cleared using the unlock sequence
-**     IOL1WAY_ON           Once set, the IOLOCK bit cannot be cleared
-**
-**   OSCO Pin Configuration:
-**     OSCIOFNC_ON          OSCO pin functions as port I/O (RA3)
-**     OSCIOFNC_OFF         OSCO pin functions as clock output (CLKO)
-**
-**   Clock Switching and Fail-Safe Clock Monitor:
-**     FCKSM_CSECME         Sw Enabled, Mon Enabled
-**     FCKSM_CSECMD         Sw Enabled, Mon Disabled
-**     FCKSM_CSDCMD         Sw Disabled, Mon Disabled
-**
-**   Initial Oscillator Select:
-**     FNOSC_FRC            Fast RC Oscillator (FRC)
-**     FNOSC_FRCPLL         Fast RC Oscillator with Postscaler and PLL module (FRCPLL)
-**     FNOSC_PRI            Primary Oscillator (XT, HS, EC)
-**     FNOSC_PRIPLL         Primary Oscillator with PLL module (XTPLL, HSPLL, ECPLL)
-**     FNOSC_SOSC           Secondary Oscillator (SOSC)
-**     FNOSC_LPRC           Low-Power RC Oscillator (LPRC)
-**     FNOSC_FRCDIV         Fast RC Oscillator with Postscaler (FRCDIV)
-**
-**   Internal External Switchover:
-**     IESO_OFF             IESO mode (Two-Speed Start-up) disabled
-**     IESO_ON              IESO mode (Two-Speed Start-up) enabled
-**
-*/
-
-/* Register CONFIG1 (0xabfe)                               */
-
-/*
-** Only one invocation of CONFIG1 should appear in a project,
-** at the top of a C source file (outside of any function).
-**
-** The following constants can be used to set CONFIG1.
-** Multiple options may be combined, as shown:
-**
-** _CONFIG1( OPT1_ON & OPT2_OFF & OPT3_PLL )
-**
-**   Watchdog Timer Postscaler:
-**     WDTPS_PS1            1:1
-**     WDTPS_PS2            1:2
-**     WDTPS_PS4            1:4
-**     WDTPS_PS8            1:8
-**     WDTPS_PS16           1:16
-**     WDTPS_PS32           1:32
-**     WDTPS_PS64           1:64
-**     WDTPS_PS128          1:128
-**     WDTPS_PS256          1:256
-**     WDTPS_PS512          1:512
-**     WDTPS_PS1024         1:1,024
-**     WDTPS_PS2048         1:2,048
-**     WDTPS_PS4096         1:4,096
-**     WDTPS_PS8192         1:8,192
-**     WDTPS_PS16384        1:16,384
-**     WDTPS_PS32768        1:32,768
-**
-**   WDT Prescaler:
-**     FWPSA_PR32           1:32
-**     FWPSA_PR128          1:128
-**
-**   Windowed WDT:
-**     WINDIS_ON            Windowed Watchdof timer enabled
-**     WINDIS_OFF           Standard Watchdog Timer is enabled
-**
-**   Watchdog Timer:
-**     FWDTEN_OFF           Watchdog Timer is disabled
-**     FWDTEN_ON            Watchdog Timer is enabled
-**
-**   Emulator Pin Placement Select bits:
-**     ICS_PGx3             Emulator functions are shared with PGEC3/PGED3
-**     ICS_PGx2             Emulator functions are shared with PGEC2/PGED2
-**     ICS_PGx1             Emulator functions are shared with PGEC1/PGED1
-**
-**   General Segment Write Protect:
-**     GWRP_ON              Writes to program memory are allowed
-**     GWRP_OFF             Writes to program memory are disabled
-**
-**   General Segment Code Protect:
-**     GCP_ON               Code protection is enabled
-**     GCP_OFF              Code protection is disabled
-**
-**   JTAG Port Enable:
-**     JTAGEN_OFF           JTAG port is Disabled
-**     JTAGEN_ON            JTAG port is Enabled
-**
-*/
-
-#elif defined(__PIC24GA00x__)			//fro pic24ga00x
-//config fues settings for everything else - need customization
-_CONFIG1(
-	JTAGEN_OFF &					//Disable JTAG port
-	GCP_OFF &						//Disable code protect
-	GWRP_OFF &						//Disable write protect
-	BKBUG_OFF &						//Enable background debugger
-	COE_OFF &						//Device resets into operational mode
-	ICS_PGx2 &						//EMUC/EMUD share PGC2/PGD2
-	FWDTEN_OFF &					//Disable watchdog timer (WDT)
-	WINDIS_OFF &					//Use standard WDT (if it is enabled)
-	FWPSA_PR128 &					//Use WDT prescaler ratio of 1:128
-	WDTPS_PS32768					//Use WDT postscaler ratio of 1:32,768
-)
-
-_CONFIG2(
-	FNOSC_FRC &						//Primary oscillator: FRC, FRCPLL, PRI, PRIPLL, SOSC, LPRC, FRCDIV
-	POSCMOD_HS &					//High speed seeting for external oscillator: HS, XT, EC and NONE
-	IESO_OFF &						//Disabled
-	SOSCSEL_SOSC &					//Default Secondary Oscillator
-	WUTSEL_LEG &					//Legacy Wake-up timer selected
-	FCKSM_CSDCMD &					//Clock switching and clock monitor disabled
-	OSCIOFNC_OFF &					//OSCO or Fosc/2
-	IOL1WAY_OFF &					//Unlimited Writes To RP Registers
-	I2C1SEL_PRI 					//Use Primary I2C1 pins
-)
-/* Register CONFIG2 (0xabfc)                               */
-
-/*
-** Only one invocation of CONFIG2 should appear in a project,
-** at the top of a C source file (outside of any function).
-**
-** The following constants can be used to set CONFIG2.
-** Multiple options may be combined, as shown:
-**
-** _CONFIG2( OPT1_ON & OPT2_OFF & OPT3_PLL )
-**
-**   Two Speed Start-up:
-**     IESO_OFF             Disabled
-**     IESO_ON              Enabled
-**
-**   Secondary Oscillator:
-**     SOSCSEL_LPSOSC       Low Power Secondary Oscillator
-**     SOSCSEL_SOSC         Default Secondary Oscillator
-**
-**   Voltage Regulator Standby-mode Wake-up Timer:
-**     WUTSEL_FST           Fast Wake-up timer selected
-**     WUTSEL_LEG           Legacy Wake-up timer selected
-**
-**   Oscillator Selection:
-**     FNOSC_FRC            Fast RC oscillator
-**     FNOSC_FRCPLL         Fast RC oscillator w/ divide and PLL
-**     FNOSC_PRI            Primary oscillator (XT, HS, EC)
-**     FNOSC_PRIPLL         Primary oscillator (XT, HS, EC) w/ PLL
-**     FNOSC_SOSC           Secondary oscillator
-**     FNOSC_LPRC           Low power RC oscillator
-**     FNOSC_FRCDIV         Fast RC oscillator with divide
-**
-**   Clock switching and clock monitor:
-**     FCKSM_CSECME         Both enabled
-**     FCKSM_CSECMD         Only clock switching enabled
-**     FCKSM_CSDCMD         Both disabled
-**
-**   OSCO/RC15 function:
-**     OSCIOFNC_ON          RC15
-**     OSCIOFNC_OFF         OSCO or Fosc/2
-**
-**   RP Register Protection:
-**     IOL1WAY_OFF          Unlimited Writes To RP Registers
-**     IOL1WAY_ON           Write RP Registers Once
-**
-**   I2C1 pins Select:
-**     I2C1SEL_SEC          Use Secondary I2C1 pins
-**     I2C1SEL_PRI          Use Primary I2C1 pins
-**
-**   Oscillator Selection:
-**     POSCMOD_EC           External clock
-**     POSCMOD_XT           XT oscillator
-**     POSCMOD__S           HS oscillator
-**     POSCMOD_NONE         Primary disabled
-**
-*/
-
-/* Register CONFIG1 (0xabfe)                               */
-
-
-/*
-** Only one invocation of CONFIG1 should appear in a project,
-** at the top of a C source file (outside of any function).
-**
-** The following constants can be used to set CONFIG1.
-** Multiple options may be combined, as shown:
-**
-** _CONFIG1( OPT1_ON & OPT2_OFF & OPT3_PLL )
-**
-**   JTAG:
-**     JTAGEN_OFF           Disabled
-**     JTAGEN_ON            Enabled
-**
-**   Code Protect:
-**     GCP_ON               Enabled
-**     GCP_OFF              Disabled
-**
-**   Write Protect:
-**     GWRP_ON              Enabled
-**     GWRP_OFF             Disabled
-**
-**   Background Debugger:
-**     BKBUG_ON             Enabled
-**     BKBUG_OFF            Disabled
-**
-**   Clip-on Emulation mode:
-**     COE_ON               Enabled
-**     COE_OFF              Disabled
-**
-**   ICD pins select:
-**     ICS_PGx3             EMUC/EMUD share PGC3/PGD3
-**     ICS_PGx2             EMUC/EMUD share PGC2/PGD2
-**     ICS_PGx1             EMUC/EMUD share PGC1/PGD1
-**
-**   Watchdog Timer:
-**     FWDTEN_OFF           Disabled
-**     FWDTEN_ON            Enabled
-**
-**   Windowed WDT:
-**     WINDIS_ON            Enabled
-**     WINDIS_OFF           Disabled
-**
-**   Watchdog prescaler:
-**     FWPSA_PR32           1:32
-**     FWPSA_PR128          1:128
-**
-**   Watchdog postscale:
-**     WDTPS_PS1            1:1
-**     WDTPS_PS2            1:2
-**     WDTPS_PS4            1:4
-**     WDTPS_PS8            1:8
-**     WDTPS_PS16           1:16
-**     WDTPS_PS32           1:32
-**     WDTPS_PS64           1:64
-**     WDTPS_PS128          1:128
-**     WDTPS_PS256          1:256
-**     WDTPS_PS512          1:512
-**     WDTPS_PS1024         1:1,024
-**     WDTPS_PS2048         1:2,048
-**     WDTPS_PS4096         1:4,096
-**     WDTPS_PS8192         1:8,192
-**     WDTPS_PS16384        1:16,384
-**     WDTPS_PS32768        1:32,768
-**
-*/
-
-#elif defined(__PIC24GB00x__)		//for pic24gb00x
-
-
-
-_CONFIG1(
-	WDTPS_PS32768 &			//1:32,768
-	FWPSA_PR128 &			//1:128
-	WINDIS_OFF &			//Standard Watchdog Timer is enabled
-	FWDTEN_OFF &			//Watchdog Timer is disabled
-	ICS_PGx1 &				//Emulator functions are shared with PGEC1/PGED1
-	GWRP_OFF &				//Writes to program memory are disabled
-	GCP_OFF	&				//Code protection is disabled
-	JTAGEN_OFF				//JTAG port is Disabled
-)
-
-_CONFIG2(
-	FNOSC_FRC &				//Primary Oscillator: FRC, FRCPLL, PRI, PRIPLL, SOSC, LPRC, FRCDIV
-	POSCMOD_HS &			//HS Oscillator mode selected: HS, XT, EC and NONE
-	I2C1SEL_PRI &			//Use default SCL1/SDA1 pins for I2C1
-	IOL1WAY_OFF &			//The IOLOCK bit can be set and cleared using the unlock sequence
-	OSCIOFNC_OFF &			//OSCO pin functions as clock output (CLKO)
-	FCKSM_CSDCMD &			//Sw Disabled, Mon Disabled
-	PLL96MHZ_ON &			//96 MHz PLL Startup is enabled automatically on start-up
-	PLLDIV_DIV12 &			//Oscillator input divided by 12 (48 MHz input)
-	IESO_OFF			//IESO mode (Two-Speed Start-up) disabled
-)
-
-_CONFIG3(
-	WPFP_WPFP63 &			//Highest Page (same as page 42)
-	SOSCSEL_IO &			//SOSC pins have digital I/O functions (RA4, RB4)
-	WUTSEL_LEG &			//Default regulator start-up time used
-	WPDIS_WPDIS &			//Segmented code protection disabled
-	WPCFG_WPCFGDIS &		//Last page and Flash Configuration words are unprotected
-	WPEND_WPSTARTMEM		//Write Protect from page 0 to WPFP
-)
-
-_CONFIG4(
-	DSWDTPS_DSWDTPSF &		//1:2,147,483,648 (25.7 days)
-	DSWDTOSC_SOSC &			//DSWDT uses Secondary Oscillator (SOSC)
-	RTCOSC_LPRC &			//RTCC uses Low Power RC Oscillator (LPRC)
-	DSBOREN_OFF &			//BOR disabled in Deep Sleep
-	DSWDTEN_OFF			//DSWDT disabled
-)
-/* -------------------------------------------------------- */
-/* Macros for setting device configuration registers        */
-/* -------------------------------------------------------- */
-
-/* Register CONFIG4 (0xabf8)                               */
-
-/*
-** Only one invocation of CONFIG4 should appear in a project,
-** at the top of a C source file (outside of any function).
-**
-** The following constants can be used to set CONFIG4.
-** Multiple options may be combined, as shown:
-**
-** _CONFIG4( OPT1_ON & OPT2_OFF & OPT3_PLL )
-**
-**   DSWDT Postscale Select:
-**     DSWDTPS_DSWDTPS0     1:2 (2.1 ms)
-**     DSWDTPS_DSWDTPS1     1:8 (8.3 ms)
-**     DSWDTPS_DSWDTPS2     1:32 (33 ms)
-**     DSWDTPS_DSWDTPS3     1:128 (132 ms)
-**     DSWDTPS_DSWDTPS4     1:512 (528 ms)
-**     DSWDTPS_DSWDTPS5     1:2,048 (2.1 seconds)
-**     DSWDTPS_DSWDTPS6     1:8,192 (8.5 seconds)
-**     DSWDTPS_DSWDTPS7     1:32,768 (34 seconds)
-**     DSWDTPS_DSWDTPS8     1:131,072 (135 seconds)
-**     DSWDTPS_DSWDTPS9     1:524,288 (9 minutes)
-**     DSWDTPS_DSWDTPSA     1:2,097,152 (36 minutes)
-**     DSWDTPS_DSWDTPSB     1:8,388,608 (2.4 hours)
-**     DSWDTPS_DSWDTPSC     1:33,554,432 (9.6 hours)
-**     DSWDTPS_DSWDTPSD     1:134,217,728 (38.5 hours)
-**     DSWDTPS_DSWDTPSE     1:536,870,912 (6.4 days)
-**     DSWDTPS_DSWDTPSF     1:2,147,483,648 (25.7 days)
-**
-**   Deep Sleep Watchdog Timer Oscillator Select:
-**     DSWDTOSC_SOSC        DSWDT uses Secondary Oscillator (SOSC)
-**     DSWDTOSC_LPRC        DSWDT uses Low Power RC Oscillator (LPRC)
-**
-**   RTCC Reference Oscillator  Select:
-**     RTCOSC_LPRC          RTCC uses Low Power RC Oscillator (LPRC)
-**     RTCOSC_SOSC          RTCC uses Secondary Oscillator (SOSC)
-**
-**   Deep Sleep BOR Enable bit:
-**     DSBOREN_OFF          BOR disabled in Deep Sleep
-**     DSBOREN_ON           BOR enabled in Deep Sleep
-**
-**   Deep Sleep Watchdog Timer:
-**     DSWDTEN_OFF          DSWDT disabled
-**     DSWDTEN_ON           DSWDT enabled
-**
-*/
-
-/* Register CONFIG3 (0xabfa)                               */
-
-/*
-** Only one invocation of CONFIG3 should appear in a project,
-** at the top of a C source file (outside of any function).
-**
-** The following constants can be used to set CONFIG3.
-** Multiple options may be combined, as shown:
-**
-** _CONFIG3( OPT1_ON & OPT2_OFF & OPT3_PLL )
-**
-**   Write Protection Flash Page Segment Boundary:
-**     WPFP_WPFP0           Page 0 (0x0)
-**     WPFP_WPFP1           Page 1 (0x400)
-**     WPFP_WPFP2           Page 2 (0x800)
-**     WPFP_WPFP3           Page 3 (0xC00)
-**     WPFP_WPFP4           Page 4 (0x1000)
-**     WPFP_WPFP5           Page 5 (0x1400)
-**     WPFP_WPFP6           Page 6 (0x1800)
-**     WPFP_WPFP7           Page 7 (0x1C00)
-**     WPFP_WPFP8           Page 8 (0x2000)
-**     WPFP_WPFP9           Page 9 (0x2400)
-**     WPFP_WPFP10          Page 10 (0x2800)
-**     WPFP_WPFP11          Page 11 (0x2C00)
-**     WPFP_WPFP12          Page 12 (0x3000)
-**     WPFP_WPFP13          Page 13 (0x3400)
-**     WPFP_WPFP14          Page 14 (0x3800)
-**     WPFP_WPFP15          Page 15 (0x3C00)
-**     WPFP_WPFP16          Page 16 (0x4000)
-**     WPFP_WPFP17          Page 17 (0x4400)
-**     WPFP_WPFP18          Page 18 (0x4800)
-**     WPFP_WPFP19          Page 19 (0x4C00)
-**     WPFP_WPFP20          Page 20 (0x5000)
-**     WPFP_WPFP21          Page 21 (0x5400)
-**     WPFP_WPFP22          Page 22 (0x5800)
-**     WPFP_WPFP23          Page 23 (0x5C00)
-**     WPFP_WPFP24          Page 24 (0x6000)
-**     WPFP_WPFP25          Page 25 (0x6400)
-**     WPFP_WPFP26          Page 26 (0x6800)
-**     WPFP_WPFP27          Page 27 (0x6C00)
-**     WPFP_WPFP28          Page 28 (0x7000)
-**     WPFP_WPFP29          Page 29 (0x7400)
-**     WPFP_WPFP30          Page 30 (0x7800)
-**     WPFP_WPFP31          Page 31 (0x7C00)
-**     WPFP_WPFP32          Page 32 (0x8000)
-**     WPFP_WPFP33          Page 33 (0x8400)
-**     WPFP_WPFP34          Page 34 (0x8800)
-**     WPFP_WPFP35          Page 35 (0x8C00)
-**     WPFP_WPFP36          Page 36 (0x9000)
-**     WPFP_WPFP37          Page 37 (0x9400)
-**     WPFP_WPFP38          Page 38 (0x9800)
-**     WPFP_WPFP39          Page 39 (0x9C00)
-**     WPFP_WPFP40          Page 40 (0xA000)
-**     WPFP_WPFP41          Page 41 (0xA400)
-**     WPFP_WPFP42          Page 42 (0xA800)
-**     WPFP_WPFP63          Highest Page (same as page 42)
-**
-**   Secondary Oscillator Pin Mode Select:
-**     SOSCSEL_IO           SOSC pins have digital I/O functions (RA4, RB4)
-**     SOSCSEL_LPSOSC       SOSC pins in Low-Power (low drive-strength) Oscillator Mode
-**     SOSCSEL_SOSC         SOSC pins in Default (high drive-strength) Oscillator Mode
-**
-**   Voltage Regulator Wake-up Time Select:
-**     WUTSEL_FST           Fast regulator start-up time used
-**     WUTSEL_LEG           Default regulator start-up time used
-**
-**   Segment Write Protection Disable:
-**     WPDIS_WPEN           Segmented code protection enabled
-**     WPDIS_WPDIS          Segmented code protection disabled
-**
-**   Write Protect Configuration Page Select:
-**     WPCFG_WPCFGEN        Last page and Flash Configuration words are code-protected
-**     WPCFG_WPCFGDIS       Last page and Flash Configuration words are unprotected
-**
-**   Segment Write Protection End Page Select:
-**     WPEND_WPSTARTMEM     Write Protect from page 0 to WPFP
-**     WPEND_WPENDMEM       Write Protect from WPFP to the last page of memory
-**
-*/
-
-/* Register CONFIG2 (0xabfc)                               */
-/*
-** Only one invocation of CONFIG2 should appear in a project,
-** at the top of a C source file (outside of any function).
-**
-** The following constants can be used to set CONFIG2.
-** Multiple options may be combined, as shown:
-**
-** _CONFIG2( OPT1_ON & OPT2_OFF & OPT3_PLL )
-**
-**   Primary Oscillator Select:
-**     POSCMOD_EC           EC Oscillator mode selected
-**     POSCMOD_XT           XT Oscillator mode selected
-**     POSCMOD_HS           HS Oscillator mode selected
-**     POSCMOD_NONE         Primary Oscillator disabled
-**
-**   I2C1 Pin Select bit:
-**     I2C1SEL_SEC          Use alternate SCL1/SDA1 pins for I2C1
-**     I2C1SEL_PRI          Use default SCL1/SDA1 pins for I2C1
-**
-**   IOLOCK One-Way Set Enable:
-**     IOL1WAY_OFF          The IOLOCK bit can be set and cleared using the unlock sequence
-**     IOL1WAY_ON           Once set, the IOLOCK bit cannot be cleared
-**
-**   OSCO Pin Configuration:
-**     OSCIOFNC_ON          OSCO pin functions as port I/O (RA3)
-**     OSCIOFNC_OFF         OSCO pin functions as clock output (CLKO)
-**
-**   Clock Switching and Fail-Safe Clock Monitor:
-**     FCKSM_CSECME         Sw Enabled, Mon Enabled
-**     FCKSM_CSECMD         Sw Enabled, Mon Disabled
-**     FCKSM_CSDCMD         Sw Disabled, Mon Disabled
-**
-**   Initial Oscillator Select:
-**     FNOSC_FRC            Fast RC Oscillator (FRC)
-**     FNOSC_FRCPLL         Fast RC Oscillator with Postscaler and PLL module (FRCPLL)
-**     FNOSC_PRI            Primary Oscillator (XT, HS, EC)
-**     FNOSC_PRIPLL         Primary Oscillator with PLL module (XTPLL, HSPLL, ECPLL)
-**     FNOSC_SOSC           Secondary Oscillator (SOSC)
-**     FNOSC_LPRC           Low-Power RC Oscillator (LPRC)
-**     FNOSC_FRCDIV         Fast RC Oscillator with Postscaler (FRCDIV)
-**
-**   96MHz PLL Startup Select:
-**     PLL96MHZ_OFF         96 MHz PLL Startup is enabled by user in software( controlled with the PLLEN bit)
-**     PLL96MHZ_ON          96 MHz PLL Startup is enabled automatically on start-up
-**
-**   USB 96 MHz PLL Prescaler Select:
-**     PLLDIV_NODIV         Oscillator input used directly (4 MHz input)
-**     PLLDIV_DIV2          Oscillator input divided by 2 (8 MHz input)
-**     PLLDIV_DIV3          Oscillator input divided by 3 (12 MHz input)
-**     PLLDIV_DIV4          Oscillator input divided by 4 (16 MHz input)
-**     PLLDIV_DIV5          Oscillator input divided by 5 (20 MHz input)
-**     PLLDIV_DIV6          Oscillator input divided by 6 (24 MHz input)
-**     PLLDIV_DIV8          Oscillator input divided by 8 (32 MHz input)
-**     PLLDIV_DIV12         Oscillator input divided by 12 (48 MHz input)
-**
-**   Internal External Switchover:
-**     IESO_OFF             IESO mode (Two-Speed Start-up) disabled
-**     IESO_ON              IESO mode (Two-Speed Start-up) enabled
-**
-*/
-
-/* Register CONFIG1 (0xabfe)                               */
-/*
-** Only one invocation of CONFIG1 should appear in a project,
-** at the top of a C source file (outside of any function).
-**
-** The following constants can be used to set CONFIG1.
-** Multiple options may be combined, as shown:
-**
-** _CONFIG1( OPT1_ON & OPT2_OFF & OPT3_PLL )
-**
-**   Watchdog Timer Postscaler:
-**     WDTPS_PS1            1:1
-**     WDTPS_PS2            1:2
-**     WDTPS_PS4            1:4
-**     WDTPS_PS8            1:8
-**     WDTPS_PS16           1:16
-**     WDTPS_PS32           1:32
-**     WDTPS_PS64           1:64
-**     WDTPS_PS128          1:128
-**     WDTPS_PS256          1:256
-**     WDTPS_PS512          1:512
-**     WDTPS_PS1024         1:1,024
-**     WDTPS_PS2048         1:2,048
-**     WDTPS_PS4096         1:4,096
-**     WDTPS_PS8192         1:8,192
-**     WDTPS_PS16384        1:16,384
-**     WDTPS_PS32768        1:32,768
-**
-**   WDT Prescaler:
-**     FWPSA_PR32           1:32
-**     FWPSA_PR128          1:128
-**
-**   Windowed WDT:
-**     WINDIS_ON            Windowed Watchdof timer enabled
-**     WINDIS_OFF           Standard Watchdog Timer is enabled
-**
-**   Watchdog Timer:
-**     FWDTEN_OFF           Watchdog Timer is disabled
-**     FWDTEN_ON            Watchdog Timer is enabled
-**
-**   Emulator Pin Placement Select bits:
-**     ICS_PGx3             Emulator functions are shared with PGEC3/PGED3
-**     ICS_PGx2             Emulator functions are shared with PGEC2/PGED2
-**     ICS_PGx1             Emulator functions are shared with PGEC1/PGED1
-**
-**   General Segment Write Protect:
-**     GWRP_ON              Writes to program memory are allowed
-**     GWRP_OFF             Writes to program memory are disabled
-**
-**   General Segment Code Protect:
-**     GCP_ON               Code protection is enabled
-**     GCP_OFF              Code protection is disabled
-**
-**   JTAG Port Enable:
-**     JTAGEN_OFF           JTAG port is Disabled
-**     JTAGEN_ON            JTAG port is Enabled
-**
-*/
-
-#endif		//pic24gb00x
-#endif		//C30
-
-//global defines
-
-//global variables
-//declare pins
-//ALL PINS ARE MAPPED, WHETHER THEY EXIST OR NOT
-//SO MAKE SURE THAT THE PINS YOU PICKED ACTUALLY EXIST FOR YOUR PACKAGE
-//Pin  0.. 7 -> GPIOA
-//Pin  8..15 -> GPIOB
-const PIN2GPIO GPIO_PinDef[]= {
-	{GPIOA, 1<<0},						//PICduino Pin  0 = RP0/PB0/CHIP PIN4
-	{GPIOA, 1<<1},						//PICduino Pin  1 = RP1/PB1/CHIP PIN5
-	{GPIOA, 1<<2},						//PICduino Pin  2 = RP2/PB2/CHIP PIN6
-	{GPIOA, 1<<3},						//PICduino Pin  3 = RP3/PB3/CHIP PIN7
-	{GPIOA, 1<<4},						//PICduino Pin  4 = RP4/PB4/CHIP PIN11
-	{GPIOA, 1<<5},						//PICduino Pin  5 = RP5/PB5/CHIP PIN14
-	{GPIOA, 1<<6},						//PICduino Pin  6 = RP6/PB6/CHIP PIN15
-	{GPIOA, 1<<7},						//PICduino Pin  7 = RP7/PB7/CHIP PIN16
-	{GPIOA, 1<<8},						//PICduino Pin  8 = RP8/PB8/CHIP PIN17
-	{GPIOA, 1<<9},						//PICduino Pin  9 = RP9/PB9/CHIP PIN18
-	{GPIOA, 1<<10},						//PICduino Pin 10 = RP10/PB10/CHIP PIN21
-	{GPIOA, 1<<11},						//PICduino Pin 11 = RP11/PB11/CHIP PIN22
-	{GPIOA, 1<<12},						//PICduino Pin 12 = RP12/PB12/CHIP PIN23
-	{GPIOA, 1<<13},						//PICduino Pin 13 = RP13/PB13/CHIP PIN24
-	{GPIOA, 1<<14},						//PICduino Pin 14 = RP14/PB14/CHIP PIN25
-	{GPIOA, 1<<15},						//PICduino Pin 15 = RP15/PB15/CHIP PIN26
-
-	{GPIOB, 1<<0},						//PICduino Pin 16 = RP0/PB0/CHIP PIN4
-	{GPIOB, 1<<1},						//PICduino Pin 17 = RP1/PB1/CHIP PIN5
-	{GPIOB, 1<<2},						//PICduino Pin 18 = RP2/PB2/CHIP PIN6
-	{GPIOB, 1<<3},						//PICduino Pin 19 = RP3/PB3/CHIP PIN7
-	{GPIOB, 1<<4},						//PICduino Pin 20 = RP4/PB4/CHIP PIN11
-	{GPIOB, 1<<5},						//PICduino Pin 21 = RP5/PB5/CHIP PIN14
-	{GPIOB, 1<<6},						//PICduino Pin 22 = RP6/PB6/CHIP PIN15
-	{GPIOB, 1<<7},						//PICduino Pin 23 = RP7/PB7/CHIP PIN16
-	{GPIOB, 1<<8},						//PICduino Pin 24 = RP8/PB8/CHIP PIN17
-	{GPIOB, 1<<9},						//PICduino Pin 25 = RP9/PB9/CHIP PIN18
-	{GPIOB, 1<<10},						//PICduino Pin 26 = RP10/PB10/CHIP PIN21
-	{GPIOB, 1<<11},						//PICduino Pin 27 = RP11/PB11/CHIP PIN22
-	{GPIOB, 1<<12},						//PICduino Pin 28 = RP12/PB12/CHIP PIN23
-	{GPIOB, 1<<13},						//PICduino Pin 29 = RP13/PB13/CHIP PIN24
-	{GPIOB, 1<<14},						//PICduino Pin 30 = RP14/PB14/CHIP PIN25
-	{GPIOB, 1<<15},						//PICduino Pin 31 = RP15/PB15/CHIP PIN26
-
-#if defined(GPIOC)
-	{GPIOC, 1<<0},						//PICduino Pin 32 = RP0/PB0/CHIP PIN4
-	{GPIOC, 1<<1},						//PICduino Pin 33 = RP1/PB1/CHIP PIN5
-	{GPIOC, 1<<2},						//PICduino Pin 34 = RP2/PB2/CHIP PIN6
-	{GPIOC, 1<<3},						//PICduino Pin 35 = RP3/PB3/CHIP PIN7
-	{GPIOC, 1<<4},						//PICduino Pin 36 = RP4/PB4/CHIP PIN11
-	{GPIOC, 1<<5},						//PICduino Pin 37 = RP5/PB5/CHIP PIN14
-	{GPIOC, 1<<6},						//PICduino Pin 38 = RP6/PB6/CHIP PIN15
-	{GPIOC, 1<<7},						//PICduino Pin 39 = RP7/PB7/CHIP PIN16
-	{GPIOC, 1<<8},						//PICduino Pin 40 = RP8/PB8/CHIP PIN17
-	{GPIOC, 1<<9},						//PICduino Pin 41 = RP9/PB9/CHIP PIN18
-	{GPIOC, 1<<10},						//PICduino Pin 42 = RP10/PB10/CHIP PIN21
-	{GPIOC, 1<<11},						//PICduino Pin 43 = RP11/PB11/CHIP PIN22
-	{GPIOC, 1<<12},						//PICduino Pin 44 = RP12/PB12/CHIP PIN23
-	{GPIOC, 1<<13},						//PICduino Pin 45 = RP13/PB13/CHIP PIN24
-	{GPIOC, 1<<14},						//PICduino Pin 46 = RP14/PB14/CHIP PIN25
-	{GPIOC, 1<<15},						//PICduino Pin 47 = RP15/PB15/CHIP PIN26
-#endif	//GPIOC
-
-#if defined(GPIOD)
-	{GPIOD, 1<<0},						//PICduino Pin 32 = RP0/PB0/CHIP PIN4
-	{GPIOD, 1<<1},						//PICduino Pin 33 = RP1/PB1/CHIP PIN5
-	{GPIOD, 1<<2},						//PICduino Pin 34 = RP2/PB2/CHIP PIN6
-	{GPIOD, 1<<3},						//PICduino Pin 35 = RP3/PB3/CHIP PIN7
-	{GPIOD, 1<<4},						//PICduino Pin 36 = RP4/PB4/CHIP PIN11
-	{GPIOD, 1<<5},						//PICduino Pin 37 = RP5/PB5/CHIP PIN14
-	{GPIOD, 1<<6},						//PICduino Pin 38 = RP6/PB6/CHIP PIN15
-	{GPIOD, 1<<7},						//PICduino Pin 39 = RP7/PB7/CHIP PIN16
-	{GPIOD, 1<<8},						//PICduino Pin 40 = RP8/PB8/CHIP PIN17
-	{GPIOD, 1<<9},						//PICduino Pin 41 = RP9/PB9/CHIP PIN18
-	{GPIOD, 1<<10},						//PICduino Pin 42 = RP10/PB10/CHIP PIN21
-	{GPIOD, 1<<11},						//PICduino Pin 43 = RP11/PB11/CHIP PIN22
-	{GPIOD, 1<<12},						//PICduino Pin 44 = RP12/PB12/CHIP PIN23
-	{GPIOD, 1<<13},						//PICduino Pin 45 = RP13/PB13/CHIP PIN24
-	{GPIOD, 1<<14},						//PICduino Pin 46 = RP14/PB14/CHIP PIN25
-	{GPIOD, 1<<15},						//PICduino Pin 47 = RP15/PB15/CHIP PIN26
-#endif	//GPIOD
-
-#if defined(GPIOE)
-	{GPIOE, 1<<0},						//PICduino Pin 32 = RP0/PB0/CHIP PIN4
-	{GPIOE, 1<<1},						//PICduino Pin 33 = RP1/PB1/CHIP PIN5
-	{GPIOE, 1<<2},						//PICduino Pin 34 = RP2/PB2/CHIP PIN6
-	{GPIOE, 1<<3},						//PICduino Pin 35 = RP3/PB3/CHIP PIN7
-	{GPIOE, 1<<4},						//PICduino Pin 36 = RP4/PB4/CHIP PIN11
-	{GPIOE, 1<<5},						//PICduino Pin 37 = RP5/PB5/CHIP PIN14
-	{GPIOE, 1<<6},						//PICduino Pin 38 = RP6/PB6/CHIP PIN15
-	{GPIOE, 1<<7},						//PICduino Pin 39 = RP7/PB7/CHIP PIN16
-	{GPIOE, 1<<8},						//PICduino Pin 40 = RP8/PB8/CHIP PIN17
-	{GPIOE, 1<<9},						//PICduino Pin 41 = RP9/PB9/CHIP PIN18
-	{GPIOE, 1<<10},						//PICduino Pin 42 = RP10/PB10/CHIP PIN21
-	{GPIOE, 1<<11},						//PICduino Pin 43 = RP11/PB11/CHIP PIN22
-	{GPIOE, 1<<12},						//PICduino Pin 44 = RP12/PB12/CHIP PIN23
-	{GPIOE, 1<<13},						//PICduino Pin 45 = RP13/PB13/CHIP PIN24
-	{GPIOE, 1<<14},						//PICduino Pin 46 = RP14/PB14/CHIP PIN25
-	{GPIOE, 1<<15},						//PICduino Pin 47 = RP15/PB15/CHIP PIN26
-#endif	//GPIOE
-
-#if defined(GPIOF)
-	{GPIOF, 1<<0},						//PICduino Pin 32 = RP0/PB0/CHIP PIN4
-	{GPIOF, 1<<1},						//PICduino Pin 33 = RP1/PB1/CHIP PIN5
-	{GPIOF, 1<<2},						//PICduino Pin 34 = RP2/PB2/CHIP PIN6
-	{GPIOF, 1<<3},						//PICduino Pin 35 = RP3/PB3/CHIP PIN7
-	{GPIOF, 1<<4},						//PICduino Pin 36 = RP4/PB4/CHIP PIN11
-	{GPIOF, 1<<5},						//PICduino Pin 37 = RP5/PB5/CHIP PIN14
-	{GPIOF, 1<<6},						//PICduino Pin 38 = RP6/PB6/CHIP PIN15
-	{GPIOF, 1<<7},						//PICduino Pin 39 = RP7/PB7/CHIP PIN16
-	{GPIOF, 1<<8},						//PICduino Pin 40 = RP8/PB8/CHIP PIN17
-	{GPIOF, 1<<9},						//PICduino Pin 41 = RP9/PB9/CHIP PIN18
-	{GPIOF, 1<<10},						//PICduino Pin 42 = RP10/PB10/CHIP PIN21
-	{GPIOF, 1<<11},						//PICduino Pin 43 = RP11/PB11/CHIP PIN22
-	{GPIOF, 1<<12},						//PICduino Pin 44 = RP12/PB12/CHIP PIN23
-	{GPIOF, 1<<13},						//PICduino Pin 45 = RP13/PB13/CHIP PIN24
-	{GPIOF, 1<<14},						//PICduino Pin 46 = RP14/PB14/CHIP PIN25
-	{GPIOF, 1<<15},						//PICduino Pin 47 = RP15/PB15/CHIP PIN26
-#endif	//GPIOF
-
-#if defined(GPIOG)
-	{GPIOG, 1<<0},						//PICduino Pin 32 = RP0/PB0/CHIP PIN4
-	{GPIOG, 1<<1},						//PICduino Pin 33 = RP1/PB1/CHIP PIN5
-	{GPIOG, 1<<2},						//PICduino Pin 34 = RP2/PB2/CHIP PIN6
-	{GPIOG, 1<<3},						//PICduino Pin 35 = RP3/PB3/CHIP PIN7
-	{GPIOG, 1<<4},						//PICduino Pin 36 = RP4/PB4/CHIP PIN11
-	{GPIOG, 1<<5},						//PICduino Pin 37 = RP5/PB5/CHIP PIN14
-	{GPIOG, 1<<6},						//PICduino Pin 38 = RP6/PB6/CHIP PIN15
-	{GPIOG, 1<<7},						//PICduino Pin 39 = RP7/PB7/CHIP PIN16
-	{GPIOG, 1<<8},						//PICduino Pin 40 = RP8/PB8/CHIP PIN17
-	{GPIOG, 1<<9},						//PICduino Pin 41 = RP9/PB9/CHIP PIN18
-	{GPIOG, 1<<10},						//PICduino Pin 42 = RP10/PB10/CHIP PIN21
-	{GPIOG, 1<<11},						//PICduino Pin 43 = RP11/PB11/CHIP PIN22
-	{GPIOG, 1<<12},						//PICduino Pin 44 = RP12/PB12/CHIP PIN23
-	{GPIOG, 1<<13},						//PICduino Pin 45 = RP13/PB13/CHIP PIN24
-	{GPIOG, 1<<14},						//PICduino Pin 46 = RP14/PB14/CHIP PIN25
-	{GPIOG, 1<<15},						//PICduino Pin 47 = RP15/PB15/CHIP PIN26
-#endif	//GPIOG
-
-};
-
-//set up core timer
-//global variables
-uint32_t SystemCoreClock=F_FRC;			//system core clock, before devided by 2. Updated by SystemCoreClockUpdate()
-
-//for time base off TIMER1 @ 1:1 prescaler
-//volatile uint32_t timer1_millis = 0;
-volatile uint32_t SysTick = 0;
-//static uint16_t timer1_fract = 0;
-//111 = Fast RC Oscillator with Postscaler (FRCDIV)
-//110 = Reserved
-//101 = Low-Power RC Oscillator (LPRC)
-//100 = Secondary Oscillator (SOSC)
-//011 = Primary Oscillator with PLL module (XTPLL, HSPLL, ECPLL)
-//010 = Primary Oscillator (XT, HS, EC)
-//001 = Fast RC Oscillator with Postscaler and PLL module (FRCPLL)
-//000 = Fast RC Oscillator (FRC)
-//Needs to be executed during mcu initialization or after oscillator reconfiguration
-//updates SystemCoreClock.
-uint32_t SystemCoreClockUpdate(void) {
-	uint32_t tmp=F_FRC;
-
-	//test for current oscillator configuration
-	switch (OSCCONbits.COSC) {
-	case 0b111:
-		tmp = (F_FRC >> CLKDIVbits.RCDIV);
-		break;
-	case 0b110:
-		break;
-	case 0b101:
-		tmp = F_LPRC;
-		break;
-	case 0b100:
-		tmp = F_SOSC;
-		break;
-	case 0b011:
-		tmp = F_XTAL * 4;
-		break;
-	case 0b010:
-		tmp = F_XTAL;
-		break;
-	case 0b001:
-		tmp = (F_FRC >> CLKDIVbits.RCDIV) * 4;
-		break;
-	case 0b000:
-		tmp = F_FRC;
-		break;
-	}
-	return SystemCoreClock=tmp;
-}
-
-//switch oscillator
-//return SystemCoreClock in frequency
-//111 = Fast RC Oscillator with Postscaler (FRCDIV)
-//110 = Reserved
-//101 = Low-Power RC Oscillator (LPRC)
-//100 = Secondary Oscillator (SOSC)
-//011 = Primary Oscillator with PLL module (XTPLL, HSPLL, ECPLL)
-//010 = Primary Oscillator (XT, HS, EC)
-//001 = Fast RC Oscillator with Postscaler and PLL module (FRCPLL)
-//000 = Fast RC Oscillator (FRC)
-//Needs to be executed during mcu initialization or after oscillator reconfiguration
-//updates SystemCoreClock.
-uint32_t SystemCoreClockSwitch(uint8_t nosc) {
-	//uint32_t tmp=F_FRC;
-
-	//switch oscillator - not yet implemented
-	di();										//disable the interrupt
-	__builtin_write_OSCCONH(nosc);
-	__builtin_write_OSCCONL(0x01);				//set oswen bit -> start the switch
-	while (OSCCONbits.OSWEN != 0) continue;	//0->clock switch complete
-	//while (OSCCONbits.COSC != nosc) continue;
-	ei();										//enable the interrupt
-	return SystemCoreClockUpdate();			//update the core clock
-}
-
-//timer1 overflow isr
-//void _ISR_PSV _T2Interrupt(void) {
-//	IFS0bits.T2IF=0;							//clear tmr1 interrupt flag
-//	SysTick+=0x10000ul;							//increment overflow count: 16-bit timer
-//}
-
-//reset the mcu
-void mcuInit(void) {
-	//set poster scaler for FRC (default 2:1), for FRCDIV
-	CLKDIVbits.RCDIV=1;							//rc divider (0..7->1:1..128:1): 0->1:1, 1->2:1 (default), 2->4:1, 3=8:1, ...
-
-	//turn off all peripherals
-	PMD1=0xffff;
-	PMD2=0xffff;
-	PMD3=0xffff;
-//#if defined(PMD4)		- only on GA102/GB002
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined(__PIC24FJ32GA102__) | \
-			defined(__PIC24FJ64GA104__) | defined(__PIC24FJ32GA104__) | \
-			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-	PMD4=0xffff;
-#endif
-
-	//all pins digital
-	AD1PCFG = 0xffff;							//1->all pins digital
-
-#if defined(SYSTICK_TMR1)						//Systick running on tmr1
-	//initialize tmr1 for tick/pwm generation - do not stop this
-	PMD1bits.T1MD = 0;							//0->enable the peripheral, 1->disable the peripheral
-	T1CON = 0x0000;                 			//stop timer
-	T1CONbits.TCKPS = 0;						//set the prescaler: 0->1:1, 1->8:1, 2->64:1, 3->256:1
-	T1CONbits.TCS = 0;             				//use internal instruction clock from F_PHB
-	T1CONbits.TGATE = 0;            			//no gating
-	//T1CONbits.T32 = 0;							//0->16 bit mode, 1->32 bit mode
-	TMR1 = 0;									//initialize the timer2 counter
-	PR1 = PWM_PR;								//set pwm period
-	IFS0bits.T1IF = 0;							//reset the flag
-	IPC0bits.T1IP = TxIP_DEFAULT;
-	//IPC0bits.T2IS = TxIS_DEFAULT;
-	IEC0bits.T1IE = 1;							//0->disable tmr2 isr, 1->enable tmr2 isr
-	T1CONbits.TON = 1;             				//turn on the timer
-#else											//systick running on tmr2
-	//initialize tmr2 for tick/pwm generation - do not stop this
-	PMD1bits.T2MD = 0;							//0->enable the peripheral, 1->disable the peripheral
-	T2CON = 0x0000;                 			//stop timer
-	T2CONbits.TCKPS = 0;						//set the prescaler: 0->1:1, 1->8:1, 2->64:1, 3->256:1
-	T2CONbits.TCS = 0;             				//use internal instruction clock from F_PHB
-	T2CONbits.TGATE = 0;            			//no gating
-	T2CONbits.T32 = 0;							//0->16 bit mode, 1->32 bit mode
-	TMR2 = 0;									//initialize the timer2 counter
-	PR2 = PWM_PR;								//set pwm period
-	IFS0bits.T2IF = 0;							//reset the flag
-	IPC1bits.T2IP = TxIP_DEFAULT;
-	//IPC1bits.T2IS = TxIS_DEFAULT;
-	IEC0bits.T2IE = 1;							//0->disable tmr2 isr, 1->enable tmr2 isr
-	T2CONbits.TON = 1;             				//turn on the timer
-#endif		//systick on tmr1 or tmr2
-
-	//update SystemCoreClock
-	SystemCoreClockUpdate();					//update system core clock
-
-	//enable global interrupts
-	ei();										//testing
-
-}
-
-//empty interrupt handler
-void empty_handler(void) {
-	//do nothing here
-}
-
-//C main loop
-#ifndef USE_MAIN
-int main(void) {
-
-	mcuInit();						//reset the mcu
-	setup();						//run the setup code
-	while (1) {
-		loop();						//run the default loop
-	}
-}
-#endif	//use_main
-
-//Arduino Functions: GPIO
-//set a pin mode to INPUT or OUTPUT
-//no error checking on PIN
-inline void pinMode(PIN_TypeDef pin, uint8_t mode) {
-	if (mode==INPUT) GIO_IN(GPIO_PinDef[pin].gpio, GPIO_PinDef[pin].mask);
-	else GIO_OUT(GPIO_PinDef[pin].gpio, GPIO_PinDef[pin].mask);
-}
-
-//set / clear a pin
-inline void digitalWrite(PIN_TypeDef pin, uint8_t val) {
-	if (val==LOW) GIO_CLR(GPIO_PinDef[pin].gpio, GPIO_PinDef[pin].mask);
-	else GIO_SET(GPIO_PinDef[pin].gpio, GPIO_PinDef[pin].mask);
-}
-
-//read a pin
-inline int digitalRead(PIN_TypeDef pin) {
-	return (GIO_GET(GPIO_PinDef[pin].gpio, GPIO_PinDef[pin].mask))?HIGH:LOW;
-}
-//end GPIO
-
-//ticks()
-//Arduino Functions: Time
-//return timer ticks
-uint32_t ticks(void) {
-	uint32_t m;					//stores overflow count
-	uint16_t f;					//return the fractions / TMR1 value
-
-	//use double reads
-	do {
-		m = SysTick;
-		f = TMR2;
-	} while (m != SysTick);
-	//now m and f are consistent
-	return (m | f);
-}
-
-//delay millisseconds
-void delay(uint32_t ms) {
-	uint32_t start_time = ticks();
-	ms *= cyclesPerMillisecond();
-	while (ticks() - start_time < ms) continue;
-}
-
-//delay micros seconds
-void delayMicroseconds(uint32_t us) {
-	uint32_t start_time = ticks();
-	us *= cyclesPerMicrosecond();
-	while (ticks() - start_time < us) continue;
-}
-//end Time
-
-//uart1
-//initialize usart: high baudrate (brgh=1), 16-bit baudrate (brg16=1)
-//baudrate=Fxtal/(4*(spbrg+1))
-//spbrg=(Fxtal/4/baudrate)-1
-//tx/rx pins to be assumed in gpio mode
-//data bits: 	8
-//parity: 		none
-//stop bits: 	1
-//Xon/Xoff:		none
-void uart1Init(unsigned long baud_rate) {
-	//enable the pins
-#if defined(U1RX2RP)
-	U1RX2RP();					//PPS_U1RX_TO_RP(U1RX_RP);
-#endif
-
-#if defined(U1TX2RP)
-	U1TX2RP();					//PPS_U1TX_TO_RP();
-#endif
-
-
-	//disable md bits
-	PMD1bits.U1MD = 0;				//power up the module
-
-	//U2MODEbits register
-	//bit 15 UARTEN: UARTx Enable bit(1)
-	//1 = UARTx is enabled; all UARTx pins are controlled by UARTx as defined by UEN<1:0>
-	//0 = UARTx is disabled; all UARTx pins are controlled by PORT latches; UARTx power consumption is	minimal
-	U1MODEbits.UARTEN=1;	//enable the uart module
-	//bit 14 Unimplemented: Read as `0'
-	//bit 13 USIDL: Stop in Idle Mode bit
-	//1 = Discontinue module operation when device enters Idle mode
-	//0 = Continue module operation in Idle mode
-	//bit 12 IREN: IrDAr Encoder and Decoder Enable bit(2)
-	//1 = IrDA encoder and decoder enabled
-	//0 = IrDA encoder and decoder disabled
-	U1MODEbits.IREN = 0;		//disable irda
-	U1MODEbits.RTSMD = 0;		//1=in simplex mode. 0 = no flow control
-	//bit 11 RTSMD: Mode Selection for UxRTS Pin bit
-	//1 = UxRTS pin in Simplex mode
-	//0 = UxRTS pin in Flow Control mode
-	//bit 10 Unimplemented: Read as `0'
-	//bit 9-8 UEN1:UEN0: UARTx Enable bits(3)
-	//11 = UxTX, UxRX and BCLKx pins are enabled and used; UxCTS pin controlled by PORT latches
-	//10 = UxTX, UxRX, UxCTS and UxRTS pins are enabled and used
-	//01 = UxTX, UxRX and UxRTS pins are enabled and used; UxCTS pin controlled by PORT latches
-	//00 = UxTX and UxRX pins are enabled and used; UxCTS and UxRTS/BCLKx pins controlled by PORT latches
-	U1MODEbits.UEN1=0, U2MODEbits.UEN0=0;
-	//bit 7 WAKE: Wake-up on Start Bit Detect During Sleep Mode Enable bit
-	//1 = UARTx will continue to sample the UxRX pin; interrupt generated on falling edge, bit cleared in hardware on following rising edge
-	//0 = No wake-up enabled
-	U1MODEbits.WAKE = 0;
-	//bit 6 LPBACK: UARTx Loopback Mode Select bit
-	//1 = Enable Loopback mode
-	//0 = Loopback mode is disabled
-	U1MODEbits.LPBACK = 0;
-	//bit 5 ABAUD: Auto-Baud Enable bit
-	//1 = Enable baud rate measurement on the next character - requires reception of a Sync field (55h); cleared in hardware upon completion
-	//0 = Baud rate measurement disabled or completed
-	U1MODEbits.ABAUD = 0;
-	//bit 4 RXINV: Receive Polarity Inversion bit
-	//1 = UxRX Idle state is `0'
-	//0 = UxRX Idle state is `1'
-	U1MODEbits.RXINV = 0;
-	//bit 3 BRGH: High Baud Rate Enable bit
-	//1 = BRG generates 4 clocks per bit period (4x baud clock, High-Speed mode)
-	//0 = BRG generates 16 clocks per bit period (16x baud clock, Standard mode)
-	U1MODEbits.BRGH = 1;
-	//bit 2-1 PDSEL1:PDSEL0: Parity and Data Selection bits
-	//11 = 9-bit data, no parity
-	//10 = 8-bit data, odd parity
-	//01 = 8-bit data, even parity
-	//00 = 8-bit data, no parity
-	U1MODEbits.PDSEL1=0, U1MODEbits.PDSEL0=0;
-	//bit 0 STSEL: Stop Bit Selection bit
-	//1 = Two Stop bits
-	//0 = One Stop bit
-	U1MODEbits.STSEL=0;
-	//Note 1: If UARTEN = 1, the peripheral inputs and outputs must be configured to an available RPn pin. See
-	//Section 10.4 "Peripheral Pin Select" for more information.
-	//2: This feature is only available for the 16x BRG mode (BRGH = 0).
-	//3: Bit availability depends on pin availability.
-
-
-	//BAUDCON
-	U1BRG = F_UART / 4 / baud_rate - 1;				//set lower byte of brg.
-
-	//disable interrupts
-
-	//set up status register
-//#if defined(UxTX2RP)				//tx is used
-	IFS0bits.U1TXIF = 0;						//clera the flag
-	IEC0bits.U1TXIE = 0;						//disable the interrupt
-
-	//bit 15,13 UTXISEL1:UTXISEL0: Transmission Interrupt Mode Selection bits
-	//11 = Reserved; do not use
-	//10 = Interrupt when a character is transferred to the Transmit Shift Register (TSR) and as a result, the transmit buffer becomes empty
-	//01 = Interrupt when the last character is shifted out of the Transmit Shift Register; all transmit operations are completed
-	//00 = Interrupt when a character is transferred to the Transmit Shift Register (this implies there is at least one character open in the transmit buffer)
-	U1STAbits.UTXISEL1=0, U1STAbits.UTXISEL0=0;
-//#endif
-	//bit 14 UTXINV: IrDAr Encoder Transmit Polarity Inversion bit
-	//If IREN = 0:
-	//1 = UxTX Idle `0'
-	//0 = UxTX Idle `1'
-	//If IREN = 1:
-	//1 = UxTX Idle `1'
-	//0 = UxTX Idle `0'
-	U1STAbits.UTXINV=0;
-	//bit 12 Unimplemented: Read as `0'
-	//bit 11 UTXBRK: Transmit Break bit
-	//1 = Send Sync Break on next transmission - Start bit, followed by twelve `0' bits, followed by Stop bit;	cleared by hardware upon completion
-	//0 = Sync Break transmission disabled or completed
-	U1STAbits.UTXBRK=0;
-	//bit 10 UTXEN: Transmit Enable bit(1)
-	//1 = Transmit enabled, UxTX pin controlled by UARTx
-	//0 = Transmit disabled, any pending transmission is aborted and buffer is reset. UxTX pin controlled by the PORT register.
-#if defined(U1TX2RP)
-	U1STAbits.UTXEN=1;
-#else
-	U1STAbits.UTXEN=0;
-#endif
-#if defined(U1RX2RP)
-	//U1STAbits.URXEN=1;
-#else
-	//U1STAbits.URXEN=0;
-#endif
-	//bit 9 UTXBF: Transmit Buffer Full Status bit (read-only)
-	//1 = Transmit buffer is full
-	//0 = Transmit buffer is not full, at least one more character can be written
-	//bit 8 TRMT: Transmit Shift Register Empty bit (read-only)
-	//1 = Transmit Shift Register is empty and transmit buffer is empty (the last transmission has completed)
-	//0 = Transmit Shift Register is not empty, a transmission is in progress or queued
-//#if defined(UxRX2RP)
-	IFS0bits.U1RXIF = 0;						//clear the flag
-	IEC0bits.U1RXIE = 0;						//disable the interrupt
-
-	//bit 7-6 URXISEL1:URXISEL0: Receive Interrupt Mode Selection bits
-	//11 = Interrupt is set on RSR transfer, making the receive buffer full (i.e., has 4 data characters)
-	//10 = Interrupt is set on RSR transfer, making the receive buffer 3/4 full (i.e., has 3 data characters)
-	//0x = Interrupt is set when any character is received and transferred from the RSR to the receive buffer. Receive buffer has one or more characters.
-	U1STAbits.URXISEL1 = 0, U1STAbits.URXISEL0 = 0;
-//#endif
-	//bit 5 ADDEN: Address Character Detect bit (bit 8 of received data = 1)
-	//1 = Address Detect mode enabled. If 9-bit mode is not selected, this does not take effect.
-	//0 = Address Detect mode disabled
-	//bit 4 RIDLE: Receiver Idle bit (read-only)
-	//1 = Receiver is Idle
-	//0 = Receiver is active
-	//bit 3 PERR: Parity Error Status bit (read-only)
-	//1 = Parity error has been detected for the current character (character at the top of the receive FIFO)
-	//0 = Parity error has not been detected
-	//bit 2 FERR: Framing Error Status bit (read-only)
-	//1 = Framing error has been detected for the current character (character at the top of the receive FIFO)
-	//0 = Framing error has not been detected
-	//bit 1 OERR: Receive Buffer Overrun Error Status bit (clear/read-only)
-	//1 = Receive buffer has overflowed
-	//0 = Receive buffer has not overflowed (clearing a previously set OERR bit (1 ? 0 transition) will reset the receiver buffer and the RSR to the empty state)
-	//bit 0 URXDA: Receive Buffer Data Available bit (read-only)
-	//1 = Receive buffer has data; at least one more character can be read
-	//0 = Receive buffer is empty
-	//REGISTER 17-2: U1STAbits: UARTx STATUS AND CONTROL REGISTER (CONTINUED)
-	//Note 1: If UARTEN = 1, the peripheral inputs and outputs must be configured to an available RPn pin. See
-	//Section 10.4 "Peripheral Pin Select" for more information.
-
-}
-
-void uart1Putch(char ch) {
-	//Wait for TXREG Buffer to become available
-	//while(!TXIF);			//wait for prior transmission to finish
-	//USART_WAIT(U1STAbits.TRMT);		//wait for TRMT to be 0 = transmission done
-	while (U1STAbits.UTXBF) continue;	//wait if the tx buffer is full
-
-	//Write data
-	U1TXREG=ch;				//load up the tx register
-
-	//USART_WAIT(!U1STAbits.TRMT);
-	//while(!TRMT);			//wait for the transmission to finish
-	//don't use txif as this is not back-to-back transmission
-	//USART_WAIT(!IFS1bits.U1TXIF);		//wait for the falg
-	//IFS1bits.U1TXIF = 0;				//reset the flag
-}
-
-//put a string
-void uart1Puts(char *str) {
-	while(*str) {
-		uart1Putch(*str++);	//send the ch and advance the pointer
-	}
-}
-
-/*
-
-Writes a line of text to USART and goes to new line
-The new line is Windows style CR/LF pair.
-
-This will work on Hyper Terminal Only NOT on Linux
-
-*/
-
-//put a line termined with ln
-void uart1Putline(char *ln) {
-	//USARTWriteString(ln);
-	uart1Puts(ln);
-	//USARTWriteString("\r\n");
-	uart1Puts((char *)"\r\n");
-}
-
-//get the received char
-//uint8_t uart1Getch(void) {
-//    return U1RXREG;		//return it
-//}
-
-//test if data rx is available
-//uint16_t uart1Available(void) {
-//    return U1STAbits.URXDA;
-//}
-
-//test if uart tx is busy
-//uint16_t uart1Busy(void) {
-//    return U1STAbits.UTXBF;
-//}
-
-//print to uart1
-void u1Print(char *str, int32_t dat) {
-	char uRAM[40];						//transmission buffer, 40-1 char max
-
-	strcpy(uRAM, str);					//copy to uarm
-	if (dat < 0) {
-		uRAM[6]='-';
-		dat = -dat;
-	}
-	uRAM[19]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[18]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[17]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[16]=',';	//'0'+(dat % 10); dat /= 10;
-	uRAM[15]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[14]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[13]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[12]=',';	//'0'+(dat % 10); dat /= 10;
-	uRAM[11]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[10]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[ 9]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[ 8]=',';	//'0'+(dat % 10); dat /= 10;
-	uRAM[ 7]='0'+(dat % 10);
-	dat /= 10;
-	uart1Puts(uRAM);	//send a message on uart1
-}
-
-//uart2
-//initialize usart: high baudrate (brgh=1), 16-bit baudrate (brg16=1)
-//baudrate=Fxtal/(4*(spbrg+1))
-//spbrg=(Fxtal/4/baudrate)-1
-//tx/rx pins to be assumed in gpio mode
-//data bits: 	8
-//parity: 		none
-//stop bits: 	1
-//Xon/Xoff:		none
-void uart2Init(unsigned long baud_rate) {
-	//enable the pins
-#if defined(U2RX2RP)
-	U2RX2RP();					//PPS_U1RX_TO_RP(U1RX_RP);
-#endif
-
-#if defined(U2TX2RP)
-	U2TX2RP();					//PPS_U1TX_TO_RP();
-#endif
-
-
-	//disable md bits
-	PMD1bits.U2MD = 0;				//power up the module
-
-	//U2MODEbits register
-	//bit 15 UARTEN: UARTx Enable bit(1)
-	//1 = UARTx is enabled; all UARTx pins are controlled by UARTx as defined by UEN<1:0>
-	//0 = UARTx is disabled; all UARTx pins are controlled by PORT latches; UARTx power consumption is	minimal
-	U2MODEbits.UARTEN=1;	//enable the uart module
-	//bit 14 Unimplemented: Read as `0'
-	//bit 13 USIDL: Stop in Idle Mode bit
-	//1 = Discontinue module operation when device enters Idle mode
-	//0 = Continue module operation in Idle mode
-	//bit 12 IREN: IrDAr Encoder and Decoder Enable bit(2)
-	//1 = IrDA encoder and decoder enabled
-	//0 = IrDA encoder and decoder disabled
-	U2MODEbits.IREN = 0;		//disable irda
-	U2MODEbits.RTSMD = 0;		//1=in simplex mode. 0 = no flow control
-	//bit 11 RTSMD: Mode Selection for UxRTS Pin bit
-	//1 = UxRTS pin in Simplex mode
-	//0 = UxRTS pin in Flow Control mode
-	//bit 10 Unimplemented: Read as `0'
-	//bit 9-8 UEN1:UEN0: UARTx Enable bits(3)
-	//11 = UxTX, UxRX and BCLKx pins are enabled and used; UxCTS pin controlled by PORT latches
-	//10 = UxTX, UxRX, UxCTS and UxRTS pins are enabled and used
-	//01 = UxTX, UxRX and UxRTS pins are enabled and used; UxCTS pin controlled by PORT latches
-	//00 = UxTX and UxRX pins are enabled and used; UxCTS and UxRTS/BCLKx pins controlled by PORT latches
-	U2MODEbits.UEN1=0, U2MODEbits.UEN0=0;
-	//bit 7 WAKE: Wake-up on Start Bit Detect During Sleep Mode Enable bit
-	//1 = UARTx will continue to sample the UxRX pin; interrupt generated on falling edge, bit cleared in hardware on following rising edge
-	//0 = No wake-up enabled
-	U2MODEbits.WAKE = 0;
-	//bit 6 LPBACK: UARTx Loopback Mode Select bit
-	//1 = Enable Loopback mode
-	//0 = Loopback mode is disabled
-	U2MODEbits.LPBACK = 0;
-	//bit 5 ABAUD: Auto-Baud Enable bit
-	//1 = Enable baud rate measurement on the next character - requires reception of a Sync field (55h); cleared in hardware upon completion
-	//0 = Baud rate measurement disabled or completed
-	U2MODEbits.ABAUD = 0;
-	//bit 4 RXINV: Receive Polarity Inversion bit
-	//1 = UxRX Idle state is `0'
-	//0 = UxRX Idle state is `1'
-	U2MODEbits.RXINV = 0;
-	//bit 3 BRGH: High Baud Rate Enable bit
-	//1 = BRG generates 4 clocks per bit period (4x baud clock, High-Speed mode)
-	//0 = BRG generates 16 clocks per bit period (16x baud clock, Standard mode)
-	U2MODEbits.BRGH = 1;
-	//bit 2-1 PDSEL1:PDSEL0: Parity and Data Selection bits
-	//11 = 9-bit data, no parity
-	//10 = 8-bit data, odd parity
-	//01 = 8-bit data, even parity
-	//00 = 8-bit data, no parity
-	U2MODEbits.PDSEL1=0, U2MODEbits.PDSEL0=0;
-	//bit 0 STSEL: Stop Bit Selection bit
-	//1 = Two Stop bits
-	//0 = One Stop bit
-	U2MODEbits.STSEL=0;
-	//Note 1: If UARTEN = 1, the peripheral inputs and outputs must be configured to an available RPn pin. See
-	//Section 10.4 "Peripheral Pin Select" for more information.
-	//2: This feature is only available for the 16x BRG mode (BRGH = 0).
-	//3: Bit availability depends on pin availability.
-
-
-	//BAUDCON
-	U2BRG = F_UART / 4 / baud_rate - 1;				//set lower byte of brg
-
-	//disable interrupts
-//#if defined(UxTX2RP)
-	IFS1bits.U2TXIF = 0;						//clera the flag
-	IEC1bits.U2TXIE = 0;						//disable the interrupt
-
-	//set up status register
-	//bit 15,13 UTXISEL1:UTXISEL0: Transmission Interrupt Mode Selection bits
-	//11 = Reserved; do not use
-	//10 = Interrupt when a character is transferred to the Transmit Shift Register (TSR) and as a result, the transmit buffer becomes empty
-	//01 = Interrupt when the last character is shifted out of the Transmit Shift Register; all transmit operations are completed
-	//00 = Interrupt when a character is transferred to the Transmit Shift Register (this implies there is at least one character open in the transmit buffer)
-	U2STAbits.UTXISEL1=0, U2STAbits.UTXISEL0=0;
-//#endif
-	//bit 14 UTXINV: IrDAr Encoder Transmit Polarity Inversion bit
-	//If IREN = 0:
-	//1 = UxTX Idle `0'
-	//0 = UxTX Idle `1'
-	//If IREN = 1:
-	//1 = UxTX Idle `1'
-	//0 = UxTX Idle `0'
-	U2STAbits.UTXINV=0;
-	//bit 12 Unimplemented: Read as `0'
-	//bit 11 UTXBRK: Transmit Break bit
-	//1 = Send Sync Break on next transmission - Start bit, followed by twelve `0' bits, followed by Stop bit;	cleared by hardware upon completion
-	//0 = Sync Break transmission disabled or completed
-	U2STAbits.UTXBRK=0;
-	//bit 10 UTXEN: Transmit Enable bit(1)
-	//1 = Transmit enabled, UxTX pin controlled by UARTx
-	//0 = Transmit disabled, any pending transmission is aborted and buffer is reset. UxTX pin controlled by the PORT register.
-#if defined(U2TX2RP)
-	U2STAbits.UTXEN=1;
-#else
-	U2STAbits.UTXEN=0;
-#endif
-#if defined(U2RX2RP)
-	//U2STAbits.URXEN=1;
-#else
-	//U2STAbits.URXEN=0;
-#endif
-	//bit 9 UTXBF: Transmit Buffer Full Status bit (read-only)
-	//1 = Transmit buffer is full
-	//0 = Transmit buffer is not full, at least one more character can be written
-	//bit 8 TRMT: Transmit Shift Register Empty bit (read-only)
-	//1 = Transmit Shift Register is empty and transmit buffer is empty (the last transmission has completed)
-	//0 = Transmit Shift Register is not empty, a transmission is in progress or queued
-//#if defined(UxRX2RP)
-	IFS1bits.U2RXIF = 0;						//clear the flag
-	IEC1bits.U2RXIE = 0;						//disable the interrupt
-
-	//bit 7-6 URXISEL1:URXISEL0: Receive Interrupt Mode Selection bits
-	//11 = Interrupt is set on RSR transfer, making the receive buffer full (i.e., has 4 data characters)
-	//10 = Interrupt is set on RSR transfer, making the receive buffer 3/4 full (i.e., has 3 data characters)
-	//0x = Interrupt is set when any character is received and transferred from the RSR to the receive buffer. Receive buffer has one or more characters.
-	U2STAbits.URXISEL1 = 0, U2STAbits.URXISEL0 = 0;
-//#endif
-	//bit 5 ADDEN: Address Character Detect bit (bit 8 of received data = 1)
-	//1 = Address Detect mode enabled. If 9-bit mode is not selected, this does not take effect.
-	//0 = Address Detect mode disabled
-	//bit 4 RIDLE: Receiver Idle bit (read-only)
-	//1 = Receiver is Idle
-	//0 = Receiver is active
-	//bit 3 PERR: Parity Error Status bit (read-only)
-	//1 = Parity error has been detected for the current character (character at the top of the receive FIFO)
-	//0 = Parity error has not been detected
-	//bit 2 FERR: Framing Error Status bit (read-only)
-	//1 = Framing error has been detected for the current character (character at the top of the receive FIFO)
-	//0 = Framing error has not been detected
-	//bit 1 OERR: Receive Buffer Overrun Error Status bit (clear/read-only)
-	//1 = Receive buffer has overflowed
-	//0 = Receive buffer has not overflowed (clearing a previously set OERR bit (1 ? 0 transition) will reset the receiver buffer and the RSR to the empty state)
-	//bit 0 URXDA: Receive Buffer Data Available bit (read-only)
-	//1 = Receive buffer has data; at least one more character can be read
-	//0 = Receive buffer is empty
-	//REGISTER 17-2: U1STAbits: UARTx STATUS AND CONTROL REGISTER (CONTINUED)
-	//Note 1: If UARTEN = 1, the peripheral inputs and outputs must be configured to an available RPn pin. See
-	//Section 10.4 "Peripheral Pin Select" for more information.
-
-}
-
-void uart2Putch(char ch) {
-	while (U2STAbits.UTXBF) continue;	//wait if the tx buffer is full
-
-	//Write data
-	U2TXREG=ch;				//load up the tx register
-
-	//while(!TRMT);			//wait for the transmission to finish
-	//don't use txif as this is not back-to-back transmission
-	//USART_WAIT(U1STAbits.TRMT);
-}
-
-void uart2Puts(char *str) {
-	while(*str) {
-		uart2Putch(*str++);	//send the ch and advance the pointer
-	}
-}
-
-/*
-
-Writes a line of text to USART and goes to new line
-The new line is Windows style CR/LF pair.
-
-This will work on Hyper Terminal Only NOT on Linux
-
-*/
-
-void uart2Putline(char *ln) {
-	//USARTWriteString(ln);
-	uart2Puts(ln);
-	//USARTWriteString("\r\n");
-	uart2Puts((char *)"\r\n");
-}
-
-//uint8_t uart2Getch(void) {
-//    //while(!RCIF); RCIF=0;		//Wait for a byte
-//   //USART_WAIT(U1STAbits.TRMT);		//wait for the prior transmission to end
-//
-//    return U2RXREG;		//return it
-//}
-
-//test if data rx is available
-//uint16_t uart2Available(void) {
-//    return U2STAbits.URXDA;
-//}
-
-//test if uart tx is busy
-//uint16_t uart2Busy(void) {
-//    return U2STAbits.UTXBF;
-//}
-
-//print to uart2
-void u2Print(char *str, int32_t dat) {
-	char uRAM[40];						//transmission buffer, 40-1 char max
-
-	strcpy(uRAM, str);					//copy to uarm
-	if (dat < 0) {
-		uRAM[6]='-';
-		dat = -dat;
-	}
-	uRAM[19]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[18]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[17]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[16]=',';	//'0'+(dat % 10); dat /= 10;
-	uRAM[15]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[14]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[13]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[12]=',';	//'0'+(dat % 10); dat /= 10;
-	uRAM[11]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[10]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[ 9]='0'+(dat % 10);
-	dat /= 10;
-	uRAM[ 8]=',';	//'0'+(dat % 10); dat /= 10;
-	uRAM[ 7]='0'+(dat % 10);
-	dat /= 10;
-	uart2Puts(uRAM);	//send a message on uart1
-}
-
-//end Serial
-
-//tmr1
-//global variables
-static void (* _tmr1_isrptr)(void)=empty_handler;				//tmr1_ptr pointing to empty_handler by default
-
-//interrupt service routine
-void _ISR_PSV _T1Interrupt(void) {
-	IFS0bits.T1IF=0;							//clear tmr1 interrupt flag
-#if defined(SYSTICK_TMR1)
-	SysTick+=0x10000ul;							//increment overflow count: 16-bit timer
-#else	//systick on tmr2
-	//do nothing
-#endif
-	_tmr1_isrptr();								//execute user tmr1 isr
-}
-
-//initialize the timer1 (16bit)
-void tmr1Init(uint8_t ps, uint16_t period) {
-	_tmr1_isrptr=empty_handler;					//point to default handler
-
-	PMD1bits.T1MD = 0;							//enable power to tmr
-	T1CONbits.TON = 0;							//turn off rtc1
-	T1CONbits.TCS = 0;							//use internal clock = Fosc
-	//T1CONbits.T32 = 0;						//0->16 bit timer, 1->32bit timer
-	T1CONbits.TCKPS=ps & TMR_PSMASK;			//set prescaler to 1:1
-	T1CONbits.TGATE = 0;						//rtc1 gate disabled
-	TMR1 = 0;									//reset the timer/counter
-	PR1=period-0;								//minimum rtc resolution is 1ms
-	IFS0bits.T1IF = 0;							//reset the flag
-	IEC0bits.T1IE = 0;							//rtc1 interrupt off
-	T1CONbits.TON = 1;							//turn on rtc1
-}
-
-//activate the isr handler
-void tmr1AttachISR(void (*isrptr)(void)) {
-	_tmr1_isrptr=isrptr;						//activate the isr handler
-	IPC0bits.T1IP = TxIP_DEFAULT;
-	//IPC0bits.T1IS = TxIS_DEFAULT;
-	IFS0bits.T1IF = 0;							//reset the flag
-	IEC0bits.T1IE = 1;							//rtc1 interrupt on
-}
-
-//tmr2
-//global variables
-static void (* _tmr2_isrptr)(void)=empty_handler;				//tmr1_ptr pointing to empty_handler by default
-
-//interrupt service routine
-void _ISR_PSV _T2Interrupt(void) {
-	IFS0bits.T2IF=0;							//clear tmr1 interrupt flag
-#if defined(SYSTICK_TMR1)
-	//do nothing
-#else	//systick on tmr2
-	SysTick+=0x10000ul;							//increment overflow count: 16-bit timer
-#endif
-	_tmr2_isrptr();								//execute user tmr2 isr
-}
-
-//initialize the timer2 (16bit)
-void tmr2Init(uint8_t ps, uint16_t period) {
-	_tmr2_isrptr=empty_handler;					//point to default handler
-
-	PMD1bits.T2MD = 0;							//enable power to tmr
-	T2CONbits.TON = 0;							//turn off rtc1
-	T2CONbits.TCS = 0;							//use internal clock = Fosc
-	T2CONbits.T32 = 0;							//0->16 bit timer, 1->32bit timer
-	T2CONbits.TCKPS=ps & TMR_PSMASK;			//set prescaler to 1:1
-	T2CONbits.TGATE = 0;						//rtc1 gate disabled
-	TMR2 = 0;									//reset the timer/counter
-	PR2=period-0;								//minimum rtc resolution is 1ms
-	IFS0bits.T2IF = 0;							//reset the flag
-	IEC0bits.T2IE = 0;							//rtc1 interrupt off
-	T2CONbits.TON = 1;							//turn on rtc1
-}
-
-//activate the isr handler
-void tmr2AttachISR(void (*isrptr)(void)) {
-	_tmr2_isrptr=isrptr;						//activate the isr handler
-	IPC1bits.T2IP = TxIP_DEFAULT;
-	//IPC2bits.T2IS = TxIS_DEFAULT;
-	IFS0bits.T2IF = 0;							//reset the flag
-	IEC0bits.T2IE = 1;							//rtc1 interrupt on
-}
-
-//tmr3
-//global variables
-static void (* _tmr3_isrptr)(void)=empty_handler;				//tmr1_ptr pointing to empty_handler by default
-
-//interrupt service routine
-void _ISR_PSV _T3Interrupt(void) {
-	IFS0bits.T3IF=0;							//clear tmr1 interrupt flag
-	_tmr3_isrptr();								//execute user tmr1 isr
-}
-
-//initialize the timer3 (16bit)
-void tmr3Init(uint8_t ps, uint16_t period) {
-	_tmr3_isrptr=empty_handler;					//point to default handler
-
-	PMD1bits.T3MD = 0;							//enable power to tmr
-	T3CONbits.TON = 0;							//turn off rtc1
-	T3CONbits.TCS = 0;							//use internal clock = Fosc
-	//T3CONbits.T32 = 0;						//0->16 bit timer, 1->32bit timer
-	T3CONbits.TCKPS=ps & TMR_PSMASK;			//set prescaler to 1:1
-	T3CONbits.TGATE = 0;						//rtc1 gate disabled
-	TMR3 = 0;									//reset the timer/counter
-	PR3=period-0;								//minimum rtc resolution is 1ms
-	IFS0bits.T3IF = 0;							//reset the flag
-	IEC0bits.T3IE = 0;							//rtc1 interrupt off
-	T3CONbits.TON = 1;							//turn on rtc1
-}
-
-//activate the isr handler
-void tmr3AttachISR(void (*isrptr)(void)) {
-	_tmr3_isrptr=isrptr;						//activate the isr handler
-	IPC2bits.T3IP = TxIP_DEFAULT;
-	//IPC2bits.T3IS = TxIS_DEFAULT;
-	IFS0bits.T3IF = 0;							//reset the flag
-	IEC0bits.T3IE = 1;							//rtc1 interrupt on
-}
-
-//tmr4
-//global variables
-static void (* _tmr4_isrptr)(void)=empty_handler;				//tmr1_ptr pointing to empty_handler by default
-
-//interrupt service routine
-void _ISR_PSV _T4Interrupt(void) {
-	IFS1bits.T4IF=0;							//clear tmr1 interrupt flag
-	_tmr4_isrptr();								//execute user tmr1 isr
-}
-
-//initialize the timer4 (16bit)
-void tmr4Init(uint8_t ps, uint16_t period) {
-	_tmr4_isrptr=empty_handler;					//point to default handler
-
-	PMD1bits.T4MD = 0;							//enable power to tmr
-	T4CONbits.TON = 0;							//turn off rtc1
-	T4CONbits.TCS = 0;							//use internal clock = Fosc
-	T4CONbits.T32 = 0;							//0->16 bit timer, 1->32bit timer
-	T4CONbits.TCKPS=ps & TMR_PSMASK;			//set prescaler to 1:1
-	T4CONbits.TGATE = 0;						//rtc1 gate disabled
-	TMR4 = 0;									//reset the timer/counter
-	PR4=period-0;								//minimum rtc resolution is 1ms
-	IFS1bits.T4IF = 0;							//reset the flag
-	IEC1bits.T4IE = 0;							//rtc1 interrupt off
-	T4CONbits.TON = 1;							//turn on rtc1
-}
-
-//activate the isr handler
-void tmr4AttachISR(void (*isrptr)(void)) {
-	_tmr4_isrptr=isrptr;						//activate the isr handler
-	IPC6bits.T4IP = TxIP_DEFAULT;
-	//IPC6bits.T4IS = TxIS_DEFAULT;
-	IFS1bits.T4IF = 0;							//reset the flag
-	IEC1bits.T4IE = 1;							//rtc1 interrupt on
-}
-
-//tmr5
-//global variables
-static void (* _tmr5_isrptr)(void)=empty_handler;				//tmr1_ptr pointing to empty_handler by default
-
-//interrupt service routine
-void _ISR_PSV _T5Interrupt(void) {
-	IFS1bits.T5IF=0;							//clear tmr1 interrupt flag
-	_tmr5_isrptr();								//execute user tmr1 isr
-}
-
-//initialize the timer5 (16bit)
-void tmr5Init(uint8_t ps, uint16_t period) {
-	_tmr5_isrptr=empty_handler;					//point to default handler
-
-	PMD1bits.T5MD = 0;							//enable power to tmr
-	T5CONbits.TON = 0;							//turn off rtc1
-	T5CONbits.TCS = 0;							//use internal clock = Fosc
-	//T5CONbits.T32 = 0;						//0->16 bit timer, 1->32bit timer
-	T5CONbits.TCKPS=ps & TMR_PSMASK;			//set prescaler to 1:1
-	T5CONbits.TGATE = 0;						//rtc1 gate disabled
-	TMR5 = 0;									//reset the timer/counter
-	PR5=period-0;								//minimum rtc resolution is 1ms
-	IFS1bits.T5IF = 0;							//reset the flag
-	IEC1bits.T5IE = 0;							//rtc1 interrupt off
-	T5CONbits.TON = 1;							//turn on rtc1
-}
-
-//activate the isr handler
-void tmr5AttachISR(void (*isrptr)(void)) {
-	_tmr5_isrptr=isrptr;						//activate the isr handler
-	IPC7bits.T5IP = TxIP_DEFAULT;
-	//IPC7bits.T5IS = TxIS_DEFAULT;
-	IFS1bits.T5IF = 0;							//reset the flag
-	IEC1bits.T5IE = 1;							//rtc1 interrupt on
-}
-
-//set up 32-bit timer
-//using tmr2 (lsw) and tmr3 (msw)
-void tmr23Init(uint8_t ps, uint32_t period) {
-	tmr2Init(ps, period);
-	tmr3Init(ps, period >>16);
-	T2CONbits.T32=1;					//1->as 32-bit timer
-
-	TMR2 = TMR3 = 0;					//reset the timer
-}
-
-//read 32-bit timer2 and 3
-uint32_t tmr23Get(void) {
-	uint16_t tmp2, tmp3;
-
-	do {
-		tmp3 = TMR3;					//read the mws
-		tmp2 = TMR2;					//read the lsw
-	} while (tmp3 ^ TMR2);
-
-	return ((uint32_t) tmp3 << 16) | tmp2;
-}
-
-//#define tmr23AttachISR(isr)				tmr3AttachISR(isr)
-
-//using tmr4 (lsw) and tmr5 (msw)
-void tmr45Init(uint8_t ps, uint32_t period) {
-	tmr4Init(ps, period);
-	tmr5Init(ps, period>>16);
-	T4CONbits.T32=1;					//1->as 32-bit timer
-
-	TMR4 = TMR5 = 0;					//reset the timer
-}
-
-//read 32-bit timer4 and 5
-uint32_t tmr45Get(void) {
-	uint16_t tmp4, tmp5;
-
-	do {
-		tmp5 = TMR5;					//read the mws
-		tmp4 = TMR4;					//read the lsw
-	} while (tmp5 ^ TMR5);
-
-	return ((uint32_t) tmp5 << 16) | tmp5;
-}
-
-//#define tmr45AttachISR(isr)				tmr5AttachISR(isr)
-//end Timer
-
-//define pwm functions
-//time base is Timer2, defined in mcu_init()
-
-//pwm1/oc1
-//reset pwm
-void pwm1Init(void) {
-	//power up the pwm module
-	PMD2bits.OC1MD = 0;							//0->turn on the peripheral, 1->turn off the peripheral
-
-#if defined(PWM12RP)
-	//assign the output pins
-	PWM12RP();
-#endif
-
-	//tris pin presumed to have been set to output
-
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
-			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-	//OCxCON1 register settings
-	//reset the registers
-	OC1CON1 = 0x0000;
-	OC1CON2 = 0x0000;
-	OC1CON1bits.OCM = 7;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm
-	OC1CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	OC1R = OC1RS = 0;						//reset the duty cycle registers
-	//OC1CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
-#else
-	//for GA002 chips
-	//OCxCON1 register settings
-	//reset the registers
-	OC1CON = 0x0000;
-	//OC1CON2 = 0x0000;
-	OC1CONbits.OCM = 0x06;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled
-	OC1CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	OC1R = OC1RS = 0;						//reset the duty cycle registers
-	//OC1CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
-#endif
-}
-
-//pwm2/oc2
-//reset pwm
-void pwm2Init(void) {
-	//power up the pwm module
-	PMD2bits.OC2MD = 0;						//0->turn on the peripheral, 1->turn off the peripheral
-
-#if defined(PWM22RP)
-	//assign the output pins
-	PWM22RP();
-#endif
-
-	//tris pin presumed to have been set to output
-
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
-			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-
-	//OCxCON1 register settings
-	//reset the registers
-	OC2CON1 = 0x0000;
-	OC2CON2 = 0x0000;
-	OC2CON1bits.OCM = 7;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm
-	OC2CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	OC2R = OC2RS = 0;						//reset the duty cycle registers
-	//OC2CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
-#else
-	//for ga002 devices
-	//OCxCON1 register settings
-	//reset the registers
-	OC2CON = 0x0000;
-	//OC2CON2 = 0x0000;
-	OC2CONbits.OCM = 0x06;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled
-	OC2CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	OC2R = OC2RS = 0;						//reset the duty cycle registers
-	//OC2CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
-#endif
-}
-
-
-//pwm3/oc3
-//reset pwm
-void pwm3Init(void) {
-	//power up the pwm module
-	PMD2bits.OC3MD = 0;						//0->turn on the peripheral, 1->turn off the peripheral
-
-#if defined(PWM32RP)
-	//assign the output pins
-	PWM32RP();
-#endif
-
-	//tris pin presumed to have been set to output
-
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
-			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-	//OCxCON1 register settings
-	//reset the registers
-	OC3CON1 = 0x0000;
-	OC3CON2 = 0x0000;
-	OC3CON1bits.OCM = 7;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm
-	OC3CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	OC3R = OC3RS = 0;						//reset the duty cycle registers
-	//OC2CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
-#else
-	//for ga002 devices
-	//OCxCON1 register settings
-	//reset the registers
-	OC3CON = 0x0000;
-	//OC3CON2 = 0x0000;
-	OC3CONbits.OCM = 0x06;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled
-	OC3CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	OC3R = OC3RS = 0;						//reset the duty cycle registers
-	//OC3CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
-#endif
-}
-
-
-//pwm4/oc4
-//reset pwm
-void pwm4Init(void) {
-	//power up the pwm module
-	PMD2bits.OC4MD = 0;						//0->turn on the peripheral, 1->turn off the peripheral
-
-#if defined(PWM42RP)
-	//assign the output pins
-	PWM42RP();
-#endif
-
-	//tris pin presumed to have been set to output
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
-			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-
-	//OCxCON1 register settings
-	//reset the registers
-	OC4CON1 = 0x0000;
-	OC4CON2 = 0x0000;
-	OC4CON1bits.OCM = 7;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm
-	OC4CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	OC4R = OC4RS = 0;						//reset the duty cycle registers
-	//OC2CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
-#else
-	//for ga002 devices
-	//OCxCON1 register settings
-	//reset the registers
-	OC4CON = 0x0000;
-	//OC4CON2 = 0x0000;
-	OC4CONbits.OCM = 0x06;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled
-	OC4CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	OC4R = OC4RS = 0;						//reset the duty cycle registers
-	//OC4CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
-#endif
-}
-
-
-//pwm5/oc5
-//reset pwm
-void pwm5Init(void) {
-	//power up the pwm module
-	PMD2bits.OC5MD = 0;						//0->turn on the peripheral, 1->turn off the peripheral
-
-#if defined(PWM52RP)
-	//assign the output pins
-	PWM52RP();
-#endif
-
-	//tris pin presumed to have been set to output
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
-			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-	//OCxCON1 register settings
-	//reset the registers
-	OC5CON1 = 0x0000;
-	OC5CON2 = 0x0000;
-	OC5CON1bits.OCM = 7;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm
-	OC5CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	OC5R = OC5RS = 0;						//reset the duty cycle registers
-	//OC5CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
-#else
-	//for ga002 devices
-	//OCxCON1 register settings
-	//reset the registers
-	OC5CON = 0x0000;
-	//OC5CON2 = 0x0000;
-	OC5CONbits.OCM = 0x06;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled
-	OC5CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	OC5R = OC5RS = 0;						//reset the duty cycle registers
-	//OC5CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
-#endif
-}
-//end pwm/oc
-
-//adc module
-//rest the adc
-//automatic sampling (ASAM=1), manual conversion
-void adcInit(void) {
-	PMD1bits.ADC1MD = 0;					//enable power to adc
-
-	//reset the adc control registers
-	AD1CON1 = 0;
-	AD1CON2 = 0;
-	AD1CON3 = 0;
-
-	AD1CON1bits.SSRC = 7;					//0->samp ends sampling and starts conversion. 7=auto mode
-	AD1CON2bits.VCFG = 0;					//0..7. adc reference: 0->AVdd-AVss,1=Vref+-AVss, 2=AVdd-Vref-, 3=Vref+ - Vref-
-	AD1CON2bits.ALTS = 0;					//0->always use mux A inputs. 1->alternate between mux a and mux b inputs
-	AD1CON3bits.SAMC = 31;					//0..31. 0->0 Tad (not recommended), 1->1 Tad, ... 31->32 Tad
-	AD1CON3bits.ADCS = 2;					//0..63. 0->Tcy, 1-> 1Tcy, 63->64 Tcy
-	AD1CSSL = 0;							//scanning disabled
-	AD1PCFGbits.PCFG15=1;					//1->band gap enabled, 0->band gap disabled
-	AD1CON1bits.ADON = 1;					//1->enable adc
-}
-
-//read the adc
-//single ended only.
-uint16_t analogRead(uint16_t adc_ch) {
-	uint16_t tmp;
-
-	tmp=AD1PCFG;							//save current port configuration setting
-	//set up adc port configuration bits
-	//for the positive channel (mux a only)
-	AD1CON1bits.DONE=0;
-	adc_ch = adc_ch & 0x0f;					//adc_ch limited to 16 channels
-#if 1
-	AD1PCFG &=~(1<<adc_ch);					//configure the port to be analog
-	AD1CHS = adc_ch;						//select the channel
-#else
-	switch (adc_ch) {
-	case ADC_AN0:
-		AD1PCFG &=~(1<< 0);
-		AD1CHS =0x0000;
-		break;		//AD1PCFG: 1->digital GPIO, 0->analog input
-	case ADC_AN1:
-		AD1PCFG &=~(1<< 1);
-		AD1CHS =0x0001;
-		break;
-	case ADC_AN2:
-		AD1PCFG &=~(1<< 2);
-		AD1CHS =0x0002;
-		break;
-	case ADC_AN3:
-		AD1PCFG &=~(1<< 3);
-		AD1CHS =0x0003;
-		break;
-	case ADC_AN4:
-		AD1PCFG &=~(1<< 4);
-		AD1CHS =0x0004;
-		break;
-	case ADC_AN5:
-		AD1PCFG &=~(1<< 5);
-		AD1CHS =0x0005;
-		break;
-	case ADC_AN6:
-		AD1PCFG &=~(1<< 6);
-		AD1CHS =0x0006;
-		break;					//not implemented on 28pin devices. do not use
-	case ADC_AN7:
-		AD1PCFG &=~(1<< 7);
-		AD1CHS =0x0007;
-		break;					//not implemented on 28pin devices. do not use
-	case ADC_AN8:
-		AD1PCFG &=~(1<< 8);
-		AD1CHS =0x0008;
-		break;					//not implemented on 28pin devices. do not use
-	case ADC_AN9:
-		AD1PCFG &=~(1<< 9);
-		AD1CHS =0x0008;
-		break;
-	case ADC_AN10:
-		AD1PCFG &=~(1<<10);
-		AD1CHS =0x000a;
-		break;
-	case ADC_AN11:
-		AD1PCFG &=~(1<<11);
-		AD1CHS =0x000b;
-		break;
-	case ADC_AN12:
-		AD1PCFG &=~(1<<12);
-		AD1CHS =0x000c;
-		break;						//not impelemned on 28pin devices. do not use
-	case ADC_VCORE:
-		AD1PCFG &=~(1<<13);
-		AD1CHS =0x000d;
-		break;
-	case ADC_VBG_2:
-		AD1PCFG &=~(1<<14);
-		AD1CHS =0x000e;
-		break;
-	case ADC_VBG:
-		AD1PCFG &=~(1<<15);
-		AD1CHS =0x000f;
-		break;						//AD1PCFG = ~adc_ch;					//mux b: not used; mux a: negative is Vref-,
-		//case ADC_CTMU:		AD1PCFG &=~(0<<0); AD1CHS = 0x001f; break;						//reserved for ctmu
-	default:
-		break;				//do nothing
-	}
-#endif
-	AD1CON1bits.SAMP = 1;						//start the adc
-	while (!AD1CON1bits.DONE) continue;			//wait for adc to finish
-	AD1PCFG = tmp;								//restore ad1pcfg setting
-	return ADC1BUF0;							//return the adc results
-}
-//end ADC
-
-//output compare
-//oc1
-uint16_t _oc1pr=0xffff;							//oc isr period
-void (*_oc1_isrptr)(void)=empty_handler;		//tmr1_ptr pointing to empty_handler by default
-//OC ISR
-void _ISR_PSV _OC1Interrupt(void) {				//for PIC24
-	//clear the flag
-	IFS0bits.OC1IF = 0;							//clear the flag
-	OC1R += _oc1pr;								//update to the next match point
-	_oc1_isrptr();								//run user handler
-}
-
-void oc1Init(uint16_t pr) {
-	_oc1_isrptr=empty_handler;
-	_oc1pr = pr;								//reset the pr
-
-	//power up the pwm module
-	PMD2bits.OC1MD = 0;							//0->turn on the peripheral, 1->turn off the peripheral
-
-	//assign the output pins
-#if defined(PWM12RP)
-	PWM12RP();
-#endif
-
-	//tris pin presumed to have been set to output
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
-			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-	//OCxCON1 register settings
-	//reset the registers
-	OC1CON1 = 0x0000;
-	OC1CON2 = 0x0000;
-	OC1CON1bits.OCM = 0x03;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm, 0b011->continous pulse
-	OC1CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	//OC1R = OC1RS = TMR2 + _oc1pr;			//reset the duty cycle registers
-
-	IFS0bits.OC1IF = 0;						//0->clear the flag;
-	IEC0bits.OC1IE = 0;						//0->disable the interrupt, 1->enable the interrupt
-	IPC0bits.OC1IP = OCxIP_DEFAULT;			//clear the interrupt priority
-
-	//OC1CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
-#else
-	//for ga002 devices
-	//OCxCON1 register settings
-	//reset the registers
-	OC1CON = 0x0000;
-	//OC5CON2 = 0x0000;
-	OC1CONbits.OCM = 0x03;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled, 0b011->compare toggles ocx
-	OC1CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	//OC1R = OC1RS = TMR2 + _oc1pr;			//reset the duty cycle registers
-
-	IFS0bits.OC1IF = 0;						//0->clear the flag;
-	IEC0bits.OC1IE = 0;						//0->disable the interrupt, 1->enable the interrupt
-	IPC0bits.OC1IP = OCxIP_DEFAULT;			//clear the interrupt priority
-
-	//OC1CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
-#endif
-}
-
-//activate user isr
-void oc1AttachISR(void (*isrptr)(void)) {
-	_oc1_isrptr=isrptr;						//activate the isr handler
-	OC1R = TMR2 + _oc1pr;					//update to the next match point
-	IFS0bits.OC1IF = 0;						//0->clear the flag;
-	IEC0bits.OC1IE = 1;						//0->disable the interrupt, 1->enable the interrupt
-}
-
-//oc2
-uint16_t _oc2pr=0xffff;							//oc isr period
-void (*_oc2_isrptr)(void)=empty_handler;		//tmr1_ptr pointing to empty_handler by default
-//OC ISR
-void _ISR_PSV _OC2Interrupt(void) {				//for PIC24
-	//clear the flag
-	IFS0bits.OC2IF = 0;							//clear the flag
-	OC2R += _oc2pr;								//update to the next match point
-	_oc2_isrptr();								//run user handler
-}
-
-void oc2Init(uint16_t pr) {
-	_oc2_isrptr=empty_handler;
-	_oc2pr = pr;								//reset the pr
-
-	//power up the pwm module
-	PMD2bits.OC2MD = 0;							//0->turn on the peripheral, 1->turn off the peripheral
-
-	//assign the output pins
-#if defined(PWM22RP)
-	PWM22RP();
-#endif
-
-	//tris pin presumed to have been set to output
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
-			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-	//OCxCON1 register settings
-	//reset the registers
-	OC2CON1 = 0x0000;
-	OC2CON2 = 0x0000;
-	OC2CON1bits.OCM = 0x03;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm, 0b011->continous pulse
-	OC2CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	//OC2R = OC2RS = TMR2 + _oc2pr;			//reset the duty cycle registers
-
-	IFS0bits.OC2IF = 0;						//0->clear the flag;
-	IEC0bits.OC2IE = 0;						//0->disable the interrupt, 1->enable the interrupt
-	IPC1bits.OC2IP = OCxIP_DEFAULT;			//clear the interrupt priority
-
-	//OC2CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
-#else
-	//for ga002 devices
-	//OCxCON1 register settings
-	//reset the registers
-	OC2CON = 0x0000;
-	//OC5CON2 = 0x0000;
-	OC2CONbits.OCM = 0x03;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled, 0b011->compare toggles ocx
-	OC2CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	//OC2R = OC2RS = TMR2 + _oc2pr;			//reset the duty cycle registers
-
-	IFS0bits.OC2IF = 0;						//0->clear the flag;
-	IEC0bits.OC2IE = 0;						//0->disable the interrupt, 1->enable the interrupt
-	IPC1bits.OC2IP = OCxIP_DEFAULT;			//clear the interrupt priority
-
-	//OC2CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
-#endif
-}
-
-//activate user isr
-void oc2AttachISR(void (*isrptr)(void)) {
-	_oc2_isrptr=isrptr;						//activate the isr handler
-	OC2R = TMR2 + _oc2pr;					//update to the next match point
-	IFS0bits.OC2IF = 0;						//0->clear the flag;
-	IEC0bits.OC2IE = 1;						//0->disable the interrupt, 1->enable the interrupt
-}
-
-//oc3
-uint16_t _oc3pr=0xffff;							//oc isr period
-void (*_oc3_isrptr)(void)=empty_handler;		//tmr1_ptr pointing to empty_handler by default
-//OC ISR
-void _ISR_PSV _OC3Interrupt(void) {				//for PIC24
-	//clear the flag
-	IFS1bits.OC3IF = 0;							//clear the flag
-	OC3R += _oc3pr;								//update to the next match point
-	_oc3_isrptr();								//run user handler
-}
-
-void oc3Init(uint16_t pr) {
-	_oc3_isrptr=empty_handler;
-	_oc3pr = pr;								//reset the pr
-
-	//power up the pwm module
-	PMD2bits.OC3MD = 0;							//0->turn on the peripheral, 1->turn off the peripheral
-
-	//assign the output pins
-#if defined(PWM32RP)
-	PWM32RP();
-#endif
-
-	//tris pin presumed to have been set to output
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
-			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-	//OCxCON1 register settings
-	//reset the registers
-	OC3CON1 = 0x0000;
-	OC3CON2 = 0x0000;
-	OC3CON1bits.OCM = 0x03;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm, 0b011->continous pulse
-	OC3CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	//OC3R = OC3RS = TMR2 + _oc3pr;			//reset the duty cycle registers
-
-	IFS1bits.OC3IF = 0;						//0->clear the flag;
-	IEC1bits.OC3IE = 0;						//0->disable the interrupt, 1->enable the interrupt
-	IPC6bits.OC3IP = OCxIP_DEFAULT;			//clear the interrupt priority
-
-	//OC3CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
-#else
-	//for ga002 devices
-	//OCxCON1 register settings
-	//reset the registers
-	OC3CON = 0x0000;
-	//OC3CON2 = 0x0000;
-	OC3CONbits.OCM = 0x03;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled, 0b011->compare toggles ocx
-	OC3CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	//OC3R = OC3RS = TMR2 + _oc3pr;			//reset the duty cycle registers
-
-	IFS1bits.OC3IF = 0;						//0->clear the flag;
-	IEC1bits.OC3IE = 0;						//0->disable the interrupt, 1->enable the interrupt
-	IPC6bits.OC3IP = OCxIP_DEFAULT;			//clear the interrupt priority
-
-	//OC3CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
-#endif
-}
-
-//activate user isr
-void oc3AttachISR(void (*isrptr)(void)) {
-	_oc3_isrptr=isrptr;						//activate the isr handler
-	OC3R = TMR2 + _oc3pr;					//update to the next match point
-	IFS1bits.OC3IF = 0;						//0->clear the flag;
-	IEC1bits.OC3IE = 1;						//0->disable the interrupt, 1->enable the interrupt
-}
-
-//oc4
-uint16_t _oc4pr=0xffff;							//oc isr period
-void (*_oc4_isrptr)(void)=empty_handler;		//tmr1_ptr pointing to empty_handler by default
-//OC ISR
-void _ISR_PSV _OC4Interrupt(void) {				//for PIC24
-	//clear the flag
-	IFS1bits.OC4IF = 0;							//clear the flag
-	OC4R += _oc4pr;								//update to the next match point
-	_oc4_isrptr();								//run user handler
-}
-
-void oc4Init(uint16_t pr) {
-	_oc4_isrptr=empty_handler;
-	_oc4pr = pr;								//reset the pr
-
-	//power up the pwm module
-	PMD2bits.OC4MD = 0;							//0->turn on the peripheral, 1->turn off the peripheral
-
-	//assign the output pins
-#if defined(PWM42RP)
-	PWM42RP();
-#endif
-
-	//tris pin presumed to have been set to output
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
-			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-	//OCxCON1 register settings
-	//reset the registers
-	OC4CON1 = 0x0000;
-	OC4CON2 = 0x0000;
-	OC4CON1bits.OCM = 0x03;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm, 0b011->continous pulse
-	OC4CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	//OC4R = OC4RS = TMR2 + _oc4pr;			//reset the duty cycle registers
-
-	IFS1bits.OC4IF = 0;						//0->clear the flag;
-	IEC1bits.OC4IE = 0;						//0->disable the interrupt, 1->enable the interrupt
-	IPC6bits.OC4IP = OCxIP_DEFAULT;			//clear the interrupt priority
-
-	//OC4CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
-#else
-	//for ga002 devices
-	//OCxCON1 register settings
-	//reset the registers
-	OC4CON = 0x0000;
-	//OC4CON2 = 0x0000;
-	OC4CONbits.OCM = 0x03;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled, 0b011->compare toggles ocx
-	OC4CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	//OC4R = OC4RS = TMR2 + _oc4pr;			//reset the duty cycle registers
-
-	IFS1bits.OC4IF = 0;						//0->clear the flag;
-	IEC1bits.OC4IE = 0;						//0->disable the interrupt, 1->enable the interrupt
-	IPC6bits.OC4IP = OCxIP_DEFAULT;			//clear the interrupt priority
-
-	//OC1CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
-#endif
-}
-
-//activate user isr
-void oc4AttachISR(void (*isrptr)(void)) {
-	_oc4_isrptr=isrptr;						//activate the isr handler
-	OC4R = TMR2 + _oc4pr;					//update to the next match point
-	IFS1bits.OC4IF = 0;						//0->clear the flag;
-	IEC1bits.OC4IE = 1;						//0->disable the interrupt, 1->enable the interrupt
-}
-
-//oc5
-uint16_t _oc5pr=0xffff;							//oc isr period
-void (*_oc5_isrptr)(void)=empty_handler;		//tmr1_ptr pointing to empty_handler by default
-//OC ISR
-void _ISR_PSV _OC5Interrupt(void) {				//for PIC24
-	//clear the flag
-	IFS2bits.OC5IF = 0;							//clear the flag
-	OC5R += _oc5pr;								//update to the next match point
-	_oc5_isrptr();								//run user handler
-}
-
-void oc5Init(uint16_t pr) {
-	_oc5_isrptr=empty_handler;
-	_oc5pr = pr;								//reset the pr
-
-	//power up the pwm module
-	PMD2bits.OC5MD = 0;							//0->turn on the peripheral, 1->turn off the peripheral
-
-	//assign the output pins
-#if defined(PWM52RP)
-	PWM52RP();
-#endif
-
-	//tris pin presumed to have been set to output
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
-			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-	//OCxCON1 register settings
-	//reset the registers
-	OC5CON1 = 0x0000;
-	OC5CON2 = 0x0000;
-	OC5CON1bits.OCM = 0x03;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm, 0b011->continous pulse
-	OC5CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	//OC5R = OC5RS = TMR2 + _oc5pr;			//reset the duty cycle registers
-
-	IFS2bits.OC5IF = 0;						//0->clear the flag;
-	IEC2bits.OC5IE = 0;						//0->disable the interrupt, 1->enable the interrupt
-	IPC10bits.OC5IP = OCxIP_DEFAULT;			//clear the interrupt priority
-
-	//OC5CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
-#else
-	//for ga002 devices
-	//OCxCON1 register settings
-	//reset the registers
-	OC5CON = 0x0000;
-	//OC5CON2 = 0x0000;
-	OC5CONbits.OCM = 0x03;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled, 0b011->compare toggles ocx
-	OC5CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
-	//OC5R = OC5RS = TMR2 + _oc5pr;			//reset the duty cycle registers
-
-	IFS2bits.OC5IF = 0;						//0->clear the flag;
-	IEC2bits.OC5IE = 0;						//0->disable the interrupt, 1->enable the interrupt
-	IPC10bits.OC5IP = OCxIP_DEFAULT;			//clear the interrupt priority
-
-	//OC1CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
-#endif
-}
-
-//activate user isr
-void oc5AttachISR(void (*isrptr)(void)) {
-	_oc5_isrptr=isrptr;						//activate the isr handler
-	OC5R = TMR2 + _oc5pr;					//update to the next match point
-	IFS2bits.OC5IF = 0;						//0->clear the flag;
-	IEC2bits.OC5IE = 1;						//0->disable the interrupt, 1->enable the interrupt
-}
-//end output compare
-
-//input capture
-static void (*_ic1_isrptr)(void)=empty_handler;	//function pointer pointing to empty_handler by default
-//volatile uint16_t IC1DAT=0;						//buffer
-
-//input capture ISR
-void _ISR_PSV _IC1Interrupt(void) {				//for PIC24
-	//clear the flag
-	//IC1DAT = IC1BUF;							//read the captured value
-	IFS0bits.IC1IF = 0;							//clear the flag after the buffer has been read (the interrupt flag is persistent)
-	_ic1_isrptr();								//run user handler
-}
-
-//reset input capture 1
-//16-bit mode, rising edge, single capture, Timer2 as timebase
-//interrupt disabled
-void ic1Init(void) {
-	_ic1_isrptr = empty_handler;				//reset user handler
-
-	IC12RP();									//assign pin to IC
-	PMD2bits.IC1MD = 0;							//0->enable power to input capture
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
-			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-	IC1CON1 = 0;						//reset to default value
-	IC1CON2 = 0;						//reset to default value
-	IC1CON1  = 	(0<<15) |				//1->enable the module, 0->disable the module
-				(0<<13) |				//0->operates in idle, 1->don't operate in idle
-				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
-				(0<<8) |				//1->32-bit mode, 0->16-bit mode
-				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
-				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
-				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
-				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
-				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
-				0x00;
-
-	while (IC1CON1bits.ICBNE) IC1BUF;	//read the buffer to clear the flag
-	IFS0bits.IC1IF   = 0;				//0->clear the flag
-	IEC0bits.IC1IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
-	//ICxIP   = 1;						//optional
-	//enable the input capture
-	//IC1CON1bits.ON = 1;				//1->enable the module, 0->disable the module
-#else
-	//for ga002 devices
-	IC1CON = 0;							//reset to default value
-	//IC1CON2 = 0;						//reset to default value
-	IC1CON  = 	(0<<15) |				//1->enable the module, 0->disable the module
-				(0<<13) |				//0->operates in idle, 1->don't operate in idle
-				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
-				(0<<8) |				//1->32-bit mode, 0->16-bit mode
-				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
-				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
-				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
-				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
-				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
-				0x00;
-
-	while (IC1CONbits.ICBNE) IC1BUF;	//read the buffer to clear the flag
-	IFS0bits.IC1IF   = 0;				//0->clear the flag
-	IEC0bits.IC1IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
-	//ICxIP   = 1;						//optional
-	//enable the input capture
-	//IC1CONbits.ON = 1;				//1->enable the module, 0->disable the module
-#endif
-	//input capture running now
-}
-
-//activate user ptr
-void ic1AttachISR(void (*isrptr)(void)) {
-	_ic1_isrptr = isrptr;				//install user ptr
-	//IC1BUF;								//read the buffer to clear the flag
-	IFS0bits.IC1IF   = 0;				//0->clear the flag
-	IEC0bits.IC1IE   = 1;				//1->enable the interrupt, 0->disable the interrupt
-}
-
-static void (*_ic2_isrptr)(void)=empty_handler;				//function pointer pointing to empty_handler by default
-//volatile uint16_t IC2DAT=0;				//buffer
-
-//input capture ISR
-void _ISR_PSV _IC2Interrupt(void) {		//for PIC24
-	//clear the flag
-	//IC2DAT = IC2BUF;					//read the captured value
-	IFS0bits.IC2IF = 0;					//clear the flag after the buffer has been read (the interrupt flag is persistent)
-	_ic2_isrptr();						//run user handler
-}
-
-//reset input capture 1
-//16-bit mode, rising edge, single capture, Timer2 as timebase
-//interrupt disabled
-void ic2Init(void) {
-	_ic2_isrptr = empty_handler;		//reset user handler
-
-	IC22RP();							//assign pin to IC
-	PMD2bits.IC2MD = 0;					//0->enable power to input capture
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
-			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-	IC2CON1 = 0;						//reset to default value
-	IC2CON2 = 0;						//reset to default value
-	IC2CON1  = 	(0<<15) |				//1->enable the module, 0->disable the module
-				(0<<13) |				//0->operates in idle, 1->don't operate in idle
-				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
-				(0<<8) |				//1->32-bit mode, 0->16-bit mode
-				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
-				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
-				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
-				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
-				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
-				0x00;
-
-	while (IC2CON1bits.ICBNE) IC2BUF;	//read the buffer to clear the flag
-	IFS0bits.IC2IF   = 0;				//0->clear the flag
-	IEC0bits.IC2IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
-	//ICxIP   = 1;						//optional
-	//enable the input capture
-	//IC2CON1bits.ON = 1;				//1->enable the module, 0->disable the module
-#else
-	//for ga002 devices
-	IC2CON = 0;							//reset to default value
-	//IC2CON2 = 0;						//reset to default value
-	IC2CON  = 	(0<<15) |				//1->enable the module, 0->disable the module
-				(0<<13) |				//0->operates in idle, 1->don't operate in idle
-				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
-				(0<<8) |				//1->32-bit mode, 0->16-bit mode
-				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
-				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
-				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
-				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
-				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
-				0x00;
-
-	while (IC2CONbits.ICBNE) IC2BUF;	//read the buffer to clear the flag
-	IFS0bits.IC2IF   = 0;				//0->clear the flag
-	IEC0bits.IC2IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
-	//ICxIP   = 1;						//optional
-	//enable the input capture
-	//IC2CONbits.ON = 1;				//1->enable the module, 0->disable the module
-#endif
-}
-
-//activate user ptr
-void ic2AttachISR(void (*isrptr)(void)) {
-	_ic2_isrptr = isrptr;				//install user ptr
-	//IC2BUF;								//read the buffer to clear the flag
-	IFS0bits.IC2IF   = 0;				//0->clear the flag
-	IEC0bits.IC2IE   = 1;				//1->enable the interrupt, 0->disable the interrupt
-}
-
-static void (*_ic3_isrptr)(void)=empty_handler;				//function pointer pointing to empty_handler by default
-//volatile uint16_t IC3DAT=0;				//buffer
-
-//input capture ISR
-void _ISR_PSV _IC3Interrupt(void) {		//for PIC24
-	//clear the flag
-	//IC3DAT = IC3BUF;					//read the captured value
-	IFS2bits.IC3IF = 0;					//clear the flag after the buffer has been read (the interrupt flag is persistent)
-	_ic3_isrptr();						//run user handler
-}
-
-//reset input capture 1
-//16-bit mode, rising edge, single capture, Timer2 as timebase
-//interrupt disabled
-void ic3Init(void) {
-	_ic3_isrptr = empty_handler;		//reset user handler
-
-	IC32RP();							//assign pin to IC
-	PMD2bits.IC3MD = 0;					//0->enable power to input capture
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
-			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-	IC3CON1 = 0;						//reset to default value
-	IC3CON2 = 0;						//reset to default value
-	IC3CON1  = 	(0<<15) |				//1->enable the module, 0->disable the module
-				(0<<13) |				//0->operates in idle, 1->don't operate in idle
-				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
-				(0<<8) |				//1->32-bit mode, 0->16-bit mode
-				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
-				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
-				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
-				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
-				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
-				0x00;
-
-	while (IC3CON1bits.ICBNE) IC3BUF;	//read the buffer to clear the flag
-	IFS2bits.IC3IF   = 0;				//0->clear the flag
-	IEC2bits.IC3IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
-	//ICxIP   = 1;						//optional
-	//enable the input capture
-	//IC3CON1bits.ON = 1;				//1->enable the module, 0->disable the module
-	//input capture running now
-#else
-	//for ga002 devices
-	IC3CON = 0;							//reset to default value
-	//IC3CON2 = 0;						//reset to default value
-	IC3CON  = 	(0<<15) |				//1->enable the module, 0->disable the module
-				(0<<13) |				//0->operates in idle, 1->don't operate in idle
-				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
-				(0<<8) |				//1->32-bit mode, 0->16-bit mode
-				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
-				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
-				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
-				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
-				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
-				0x00;
-
-	while (IC3CONbits.ICBNE) IC3BUF;	//read the buffer to clear the flag
-	IFS2bits.IC3IF   = 0;				//0->clear the flag
-	IEC2bits.IC3IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
-	//ICxIP   = 1;						//optional
-	//enable the input capture
-	//IC3CONbits.ON = 1;				//1->enable the module, 0->disable the module
-#endif
-}
-
-//activate user ptr
-void ic3AttachISR(void (*isrptr)(void)) {
-	_ic3_isrptr = isrptr;				//install user ptr
-	//IC3BUF;								//read the buffer to clear the flag
-	IFS2bits.IC3IF   = 0;				//0->clear the flag
-	IEC2bits.IC3IE   = 1;				//1->enable the interrupt, 0->disable the interrupt
-}
-
-static void (*_ic4_isrptr)(void)=empty_handler;				//function pointer pointing to empty_handler by default
-//volatile uint16_t IC4DAT=0;				//buffer
-
-//input capture ISR
-void _ISR_PSV _IC4Interrupt(void) {		//for PIC24
-	//clear the flag
-	//IC4DAT = IC4BUF;					//read the captured value
-	IFS2bits.IC4IF = 0;					//clear the flag after the buffer has been read (the interrupt flag is persistent)
-	_ic4_isrptr();						//run user handler
-}
-
-//reset input capture 1
-//16-bit mode, rising edge, single capture, Timer2 as timebase
-//interrupt disabled
-void ic4Init(void) {
-	_ic4_isrptr = empty_handler;		//reset user handler
-
-	IC42RP();							//assign pin to IC
-	PMD2bits.IC4MD = 0;					//0->enable power to input capture
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
-			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-	IC4CON1 = 0;						//reset to default value
-	IC4CON2 = 0;						//reset to default value
-	IC4CON1  = 	(0<<15) |				//1->enable the module, 0->disable the module
-				(0<<13) |				//0->operates in idle, 1->don't operate in idle
-				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
-				(0<<8) |				//1->32-bit mode, 0->16-bit mode
-				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
-				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
-				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
-				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
-				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
-				0x00;
-
-	while (IC4CON1bits.ICBNE) IC4BUF;	//read the buffer to clear the flag
-	IFS2bits.IC4IF   = 0;				//0->clear the flag
-	IEC2bits.IC4IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
-	//ICxIP   = 1;						//optional
-	//enable the input capture
-	//IC4CON1bits.ON = 1;				//1->enable the module, 0->disable the module
-	//input capture running now
-#else
-	//for ga002 devices
-	IC4CON = 0;							//reset to default value
-	//IC4CON2 = 0;						//reset to default value
-	IC4CON  = 	(0<<15) |				//1->enable the module, 0->disable the module
-				(0<<13) |				//0->operates in idle, 1->don't operate in idle
-				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
-				(0<<8) |				//1->32-bit mode, 0->16-bit mode
-				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
-				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
-				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
-				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
-				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
-				0x00;
-
-	while (IC4CONbits.ICBNE) IC4BUF;	//read the buffer to clear the flag
-	IFS2bits.IC4IF   = 0;				//0->clear the flag
-	IEC2bits.IC4IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
-	//ICxIP   = 1;						//optional
-	//enable the input capture
-	//IC4CONbits.ON = 1;				//1->enable the module, 0->disable the module
-#endif
-}
-
-//activate user ptr
-void ic4AttachISR(void (*isrptr)(void)) {
-	_ic4_isrptr = isrptr;				//install user ptr
-	//IC4BUF;								//read the buffer to clear the flag
-	IFS2bits.IC4IF   = 0;				//0->clear the flag
-	IEC2bits.IC4IE   = 1;				//1->enable the interrupt, 0->disable the interrupt
-}
-
-static void (*_ic5_isrptr)(void)=empty_handler;				//function pointer pointing to empty_handler by default
-//volatile uint16_t IC5DAT=0;				//buffer
-
-//input capture ISR
-void _ISR_PSV _IC5Interrupt(void) {		//for PIC24
-	//clear the flag
-	//IC5DAT = IC5BUF;					//read the captured value
-	IFS2bits.IC5IF = 0;					//clear the flag after the buffer has been read (the interrupt flag is persistent)
-	_ic5_isrptr();						//run user handler
-}
-
-//reset input capture 1
-//16-bit mode, rising edge, single capture, Timer2 as timebase
-//interrupt disabled
-void ic5Init(void) {
-	_ic5_isrptr = empty_handler;		//reset user handler
-
-	IC52RP();							//assign pin to IC
-	PMD2bits.IC5MD = 0;					//0->enable power to input capture
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
-			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-	IC5CON1 = 0;						//reset to default value
-	IC5CON2 = 0;						//reset to default value
-	IC5CON1  = 	(0<<15) |				//1->enable the module, 0->disable the module
-				(0<<13) |				//0->operates in idle, 1->don't operate in idle
-				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
-				(0<<8) |				//1->32-bit mode, 0->16-bit mode
-				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
-				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
-				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
-				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
-				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
-				0x00;
-
-	while (IC5CON1bits.ICBNE) IC5BUF;	//read the buffer to clear the flag
-	IFS2bits.IC5IF   = 0;				//0->clear the flag
-	IEC2bits.IC5IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
-	//ICxIP   = 1;						//optional
-	//enable the input capture
-	//IC5CON1bits.ON = 1;				//1->enable the module, 0->disable the module
-	//input capture running now
-#else
-	//for ga002 devices
-	IC5CON = 0;							//reset to default value
-	//IC5CON2 = 0;						//reset to default value
-	IC5CON  = 	(0<<15) |				//1->enable the module, 0->disable the module
-				(0<<13) |				//0->operates in idle, 1->don't operate in idle
-				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
-				(0<<8) |				//1->32-bit mode, 0->16-bit mode
-				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
-				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
-				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
-				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
-				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
-				0x00;
-
-	while (IC5CONbits.ICBNE) IC5BUF;	//read the buffer to clear the flag
-	IFS2bits.IC5IF   = 0;				//0->clear the flag
-	IEC2bits.IC5IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
-	//ICxIP   = 1;						//optional
-	//enable the input capture
-	//IC5CONbits.ON = 1;				//1->enable the module, 0->disable the module
-#endif
-}
-
-//activate user ptr
-void ic5AttachISR(void (*isrptr)(void)) {
-	_ic5_isrptr = isrptr;				//install user ptr
-	//IC5BUF;								//read the buffer to clear the flag
-	IFS2bits.IC5IF   = 0;				//0->clear the flag
-	IEC2bits.IC5IE   = 1;				//1->enable the interrupt, 0->disable the interrupt
-}
-
-//end input capture
-
-//extint
-//extint0
-void (* _int0_isrptr) (void)=empty_handler;
-
-void _ISR_PSV _INT0Interrupt(void) {
-	IFS0bits.INT0IF = 0;				//clera the flag
-	_int0_isrptr();						//run the isr
-}
-
-void int0Init(void) {
-	//INT02RP();						//map int0_pin - int0 cannot be remapped
-	_int0_isrptr = empty_handler;		//initialize int isr ptr
-	IFS0bits.INT0IF = 0;				//clear int0 flag
-	IEC0bits.INT0IE = 0;				//1->enable int0 interrupt, 0->disable the interrupt
-	//INTCONbits.INT0EP = 1;			//1=triggered on the falling edge. 0 = rising edge
-}
-
-void int0AttachISR(void (*isrptr) (void)) {
-	_int0_isrptr = isrptr;
-	IFS0bits.INT0IF = 0;				//clear int0 flag
-	IEC0bits.INT0IE = 1;				//1->enable int0 interrupt, 0->disable the interrupt
-}
-
-//extint1
-void (* _int1_isrptr) (void)=empty_handler;
-
-void _ISR_PSV _INT1Interrupt(void) {
-	IFS1bits.INT1IF = 0;				//clera the flag
-	_int1_isrptr();						//run the isr
-}
-
-void int1Init(void) {
-	INT12RP();							//map int1_pin
-	_int1_isrptr = empty_handler;		//initialize int isr ptr
-	IFS1bits.INT1IF = 0;				//clear int0 flag
-	IEC1bits.INT1IE = 0;				//1->enable int0 interrupt, 0->disable the interrupt
-	//INTCONbits.INT1EP = 1;			//1=triggered on the falling edge. 0 = rising edge
-}
-
-void int1AttachISR(void (*isrptr) (void)) {
-	_int1_isrptr = isrptr;
-	IFS1bits.INT1IF = 0;				//clear int0 flag
-	IEC1bits.INT1IE = 1;				//1->enable int0 interrupt, 0->disable the interrupt
-}
-
-//extint2
-void (* _int2_isrptr) (void)=empty_handler;
-
-void _ISR_PSV _INT2Interrupt(void) {
-	IFS1bits.INT2IF = 0;				//clera the flag
-	_int2_isrptr();						//run the isr
-}
-
-void int2Init(void) {
-	INT22RP();							//map int2_pin
-	_int2_isrptr = empty_handler;		//initialize int isr ptr
-	IFS1bits.INT2IF = 0;				//clear int0 flag
-	IEC1bits.INT2IE = 0;				//1->enable int0 interrupt, 0->disable the interrupt
-	//INTCONbits.INT2EP = 1;			//1=triggered on the falling edge. 0 = rising edge
-}
-
-void int2AttachISR(void (*isrptr) (void)) {
-	_int2_isrptr = isrptr;
-	IFS1bits.INT2IF = 0;				//clear int0 flag
-	IEC1bits.INT2IE = 1;				//1->enable int0 interrupt, 0->disable the interrupt
-}
-
-
-//end extint
-
-//spi
-//rest spi1
-void spi1Init(uint16_t br) {
-	PMD1bits.SPI1MD = 0;				//0->enable the module
-
-	//map the pins
-#if defined(SCK1RP)
-	SCK1RP();
-#endif
-#if defined(SDO1RP)
-	SDO1RP();
-#endif
-#if defined(SDI1RP)
-	SDI1RP();
-#endif
-
-	//initialize the spi module
-	//master mode, PBCLK as clock, 8-bit data, enhanced buffer mode
-	SPI1CON1 = SPI1CON2 = 0; 			//reset the spi module
-	SPI1CON1bits.MSTEN = 1;				//1->master mode, 0->slave mode
-	SPI1CON1bits.PPRE = br;				//set the baudrate generator (primary prescaler)
-	SPI1CON1bits.SPRE = 0;				//set the secondary prescaler
-	SPI1STATbits.SPIROV=0;				//clear rov flag
-	//SPI1BUF;							//perform a read to clear the flag
-	SPI1CON2bits.SPIBEN= 1;				//1->enable enhanced buffer mode, 0->disable enhanced buffer mode
-	//need to deal with secondary as well
-	SPI1BUF;							//read the buffer to reset the flag
-	IFS0bits.SPI1IF = 0;				//0->reset the flag
-	IEC0bits.SPI1IE = 0;				//0->disable the interrupt, 1->enable the interrupt
-	IPC2bits.SPI1IP = SPIIP_DEFAULT;	//default interrupt priority
-
-	SPI1STATbits.SPIEN = 1;				//1->enable the module, 0->disable the module
-}
-
-//rest spi2
-void spi2Init(uint16_t br) {
-	PMD1bits.SPI2MD = 0;				//0->enable the module
-
-	//map the pins
-#if defined(SCK2RP)
-	SCK2RP();
-#endif
-#if defined(SDO2RP)
-	SDO2RP();
-#endif
-#if defined(SDI2RP)
-	SDI2RP();
-#endif
-
-
-	//initialize the spi module
-	//master mode, PBCLK as clock, 8-bit data, enhanced buffer mode
-	SPI2CON1 = SPI2CON2 = 0; 			//reset the spi module
-	SPI2CON1bits.MSTEN = 1;				//1->master mode, 0->slave mode
-	SPI2CON1bits.PPRE = br;				//set the baudrate generator
-	SPI2CON1bits.SPRE = 0;				//set the secondary prescaler
-	SPI1STATbits.SPIROV=0;				//clear rov flag
-	//SPI1BUF;							//perform a read to clear the flag
-	SPI1CON2bits.SPIBEN= 1;				//1->enable enhanced buffer mode, 0->disable enhanced buffer mode
-	//need to deal with 2nd ary as well
-	SPI2BUF;							//read the buffer to reset the flag
-	IFS2bits.SPI2IF = 0;				//0->reset the flag
-	IEC2bits.SPI2IE = 0;				//0->disable the interrupt, 1->enable the interrupt
-	IPC8bits.SPI2IP = SPIIP_DEFAULT;	//default interrupt priority
-
-	SPI2STATbits.SPIEN = 1;				//1->enable the module, 0->disable the module
-}
-
-//send data via spi
-//void spi2Write(uint8_t dat) {
-//	while (spi2Busy()) continue;		//tx buffer is full
-//	SPI2BUF = dat;						//load the data
-//}
-//end spi
-
-//i2c
-
-//end i2c
-
-//rtcc
-//initialize the rtcc
-//clock source choosen in config bits: RTCOSC (SOSC and LPRC)
-void RTCCInit(void) {
-	PMD3bits.RTCCMD = 0;						//0->enable power to rtcc
-	RTCC_WREN();								//allows write to rtc registers
-	RCFGCALbits.RTCEN=1;						//start the rtc
-	RTCC_WRDIS();
-}
-
-//read from rtcc
-//mask: 0b00->min.sec, 0b01->weekday.hour, 0b10->month.day, 0b11->..year
-uint16_t RTCCRead(uint16_t mask) {
-	uint16_t tmp;
-	//RTCC_WREN();								//allows write to rtc registers
-	//RCFGCAL &= RTCC_MASK;						//mask off all bits not related to pointers
-	//RCFGCAL |= mask;							//point to min/sec
-	RCFGCALbits.RTCPTR=mask;
-	tmp = RTCVAL;								//return the lower byte
-	//RTCC_WRDIS();
-	return tmp;
-}
-
-//write to rtcc
-void RTCCWrite(uint16_t mask, uint16_t byte_t) {
-	RTCC_WREN();								//allows write to rtc registers
-	//RCFGCAL &= RTCC_MASK;						//mask off all bits not related to pointers
-	//RCFGCAL |= mask;							//point to min/sec
-	RCFGCALbits.RTCPTR=mask;
-	RTCVAL = byte_t;							//return the lower byte
-	RTCC_WRDIS();
-}
-
-//write to rtcc calibration register
-void RTCCSetCal(uint8_t cal) {
-	RTCC_WREN();								//allows write to rtc registers
-	RCFGCALbits.CAL=cal;
-	RTCC_WRDIS();
-}
-
-//read from rtcc calibration register
-uint8_t RTCCGetCal(void) {
-	return RCFGCALbits.CAL;
-}
-
-//end rtcc
-
-//cnint
-void (* _cn_isrptr) (void)=empty_handler;
-
-void _ISR_PSV _CNInterrupt(void) {
-	IFS1bits.CNIF = 0; 							//clear the flag
-	_cn_isrptr();								//run the isr
-}
-
-//initialize change notification
-void cnInit(uint32_t pins) {
-	_cn_isrptr=empty_handler;					//reset the isr
-
-	//enable power - always enabled
-
-	IFS1bits.CNIF = 0;							//clear the flag
-	IEC1bits.CNIE = 1;							//1->enable the interrupt, 0->disable the interrupt
-
-	//set up cnie
-	CNEN1 = pins;
-	CNPU1 = pins;
-	pins = pins >> 16;
-	CNEN2 = pins;
-	CNPU1 = pins;
-
-	IEC1bits.CNIE = 1;							//1->enable the interrupt, 0->disable the interrupt
-}
-
-//attach user isr
-void cnAttachISR(void (*isrptr) (void)) {
-	_cn_isrptr = isrptr;						//point the isrptr
-	IFS1bits.CNIF= 0;							//0->clear the flag
-	IEC1bits.CNIE= 1;							//0->disable the interrupt
-}
-
-//end cnint
-
-//crc, 16-bit and 32-bit
-//initialize crc engine: little endian, no interrupt
-//weight in xor, and initial value in init
-void CRCInit(uint8_t len, uint32_t poly) {
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
-			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-	PMD3bits.CRCMD = 0;							//0->enable the model, 1->disable the model
-
-	//configure the crc engine
-	CRCCON1 = CRCCON2 = 0;						//reset the configuration word
-	CRCCON1bits.LENDIAN=0;						//0->data shifting LSB first (little endian), 1->data shifting MSB first (big endian)
-	CRCCON1bits.CRCISEL=0;						//0->CRCIF set on shift completion; 1->CRCIF set on buffer empty
-	//CRCCON1bits.CRCGO  =1;					//1->start crc shift, 0->crc shifter turned off
-
-	CRCCON2bits.PLEN = len-1;	//0..31: length of CRC. 0x07->8bit, 0x0f->16 bit, 0x1f->32 bit
-	CRCCON2bits.DWIDTH = CRCCON2bits.PLEN;		//set data width to plen
-
-	//CRCXORH = CRCXORL = 0;					//crc xor registers
-	//CRCXORH = xor >> 16; CRCXORL = xor;		//configure the xor words
-	CRCXOR = poly;
-
-	//CRCWDATH= init >> 16; CRCWDATL = init;
-	//CRCWDAT = init;
-
-	IFS4bits.CRCIF = 0;							//0->clear the flag, 1->set the flag
-	IPC16bits.CRCIP= CRCIP_DEFAULT;				//set the interrupt priority
-	//IPC16bits.CRCIS= CRCIS_DEFAULT;			//set the interrupt subpriority
-	IEC4bits.CRCIE = 0;							//0->disable the interrupt, 1->enable the interrupt
-
-	CRCCON1bits.CRCEN = 1;						//1->enable the model, 0->disable the model
-#else	//ga002 chips
-	PMD3bits.CRCPMD = 0;						//0->enable the model, 1->disable the model
-
-	//configure the crc engine
-	CRCCON = 0;									//reset the configuration word
-	//CRCCONbits.LENDIAN=0;						//0->data shifting LSB first (little endian), 1->data shifting MSB first (big endian)
-	//CRCCONbits.CRCISEL=0;						//0->CRCIF set on shift completion; 1->CRCIF set on buffer empty
-	//CRCCON1bits.CRCGO  =1;					//1->start crc shift, 0->crc shifter turned off
-
-	CRCCONbits.PLEN = len-1;	//0..31: length of CRC. 0x07->8bit, 0x0f->16 bit, 0x1f->32 bit
-	//CRCCONbits.DWIDTH = CRCCON2bits.PLEN;		//set data width to plen
-
-	//CRCXORH = CRCXORL = 0;					//crc xor registers
-	//CRCXORH = xor >> 16; CRCXORL = xor;		//configure the xor words
-	CRCXOR = poly;
-
-	//CRCWDATH= init >> 16; CRCWDATL = init;
-	//CRCWDAT = init;
-
-	IFS4bits.CRCIF = 0;							//0->clear the flag, 1->set the flag
-	IPC16bits.CRCIP= CRCIP_DEFAULT;				//set the interrupt priority
-	//IPC16bits.CRCIS= CRCIS_DEFAULT;			//set the interrupt subpriority
-	IEC4bits.CRCIE = 0;							//0->disable the interrupt, 1->enable the interrupt
-
-	//CRCCONbits.CRCEN = 1;						//1->enable the model, 0->disable the model
-#endif	//ga102
-}
-
-//calculate crc
-//length must be multiples of 2
-uint16_t CRC16(char *msg, uint16_t length, uint16_t init_val) {
-	uint16_t tmp;
-#if defined(__PIC24GA10x__)
-	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__)*/
-	CRCWDAT = init_val;							//load the initial word
-	CRCCON1bits.CRCGO = 1;						//CRCGo(); //while (CRCCON1bits.CRCMPT==0) continue;	//wait for crc to complete
-
-	while (length) {
-		//tmp = *(uint16_t *)msg++;				//load the data
-		//tmp = ((uint16_t) (*msg++) << 8) | (*msg++);
-		tmp = *msg++;
-		tmp = tmp << 8;			//form the data
-		tmp|= *msg++;
-		while (CRCCON1bits.CRCFUL==1) continue;	//wait for buffer to have at least 1 space
-		CRCDAT = tmp;
-		length-=2;
-	}
-
-	while (CRCCON1bits.CRCFUL==1) continue;		//wait until CRC is not full
-	CRCDAT = 0;									//shift out the last two bytes
-	while (CRCCON1bits.CRCMPT==0) continue;
-	NOP4();										//wait for the shift to complete. 1 NOP() is enough
-	//CRCCON1bits.CRCGO=0;						//why?
-	//while (CRCCON1bits.CRCGO == 1) continue;
-
-#else
-	CRCWDAT = init_val;							//load the initial word
-	CRCCONbits.CRCGO = 1;						//CRCGo(); //while (CRCCON1bits.CRCMPT==0) continue;	//wait for crc to complete
-
-	while (length) {
-		//tmp = *(uint16_t *)msg++;				//load the data
-		//tmp = ((uint16_t) (*msg++) << 8) | (*msg++);
-		tmp = *msg++;
-		tmp = tmp << 8;			//form the data
-		tmp|= *msg++;
-		while (CRCCONbits.CRCFUL==1) continue;	//wait for buffer to have at least 1 space
-		CRCDAT = tmp;
-		length-=2;
-	}
-
-	while (CRCCONbits.CRCFUL==1) continue;		//wait until CRC is not full
-	CRCDAT = 0;									//shift out the last two bytes
-	while (CRCCONbits.CRCMPT==0) continue;
-	NOP4();										//wait for the shift to complete. 1 NOP() is enough
-	//CRCCON1bits.CRCGO=0;						//why?
-	//while (CRCCON1bits.CRCGO == 1) continue;
-
-#endif
-
-	return CRCWDAT;
-}
-
-//comparator voltage reference
-void CVrefInit(void) {
-	//no PMD bits?
-
-	CVRCON = 0;									//reset value
-	CVRCONbits.CVRR = 1;						//1->0..0.625 in 24 steps. 0->0.25..0.719 in 32 steps
-	//output disabled
-	//
-	CVRCONbits.CVREN = 1;						//enable the module
-}
-//end comparator voltage reference
-
-//comparator
-#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
-/*#if 	defined(__PIC24FJ64GA102__) | defined(__PIC24FJ64GA104__) | \
-		defined(__PIC24FJ32GA102__) | defined(__PIC24FJ32GA104__) | \
-	 	defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-		defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-		defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
-//initialize comparator
-void CM1Init(void) {
-	PMD3bits.CMPMD = 0;							//1->disable the module, 0->enable the model
-
-	CM1CON = 0;									//reset value
-	CM1CONbits.CEN = 1;							//1->enable the module, 0->disable the module
-}
-
-void CM2Init(void) {
-	PMD3bits.CMPMD = 0;							//1->disable the module, 0->enable the model
-
-	CM2CON = 0;									//reset value
-	CM2CONbits.CEN = 1;							//1->enable the module, 0->disable the module
-}
-
-void CM3Init(void) {
-	PMD3bits.CMPMD = 0;							//1->disable the module, 0->enable the model
-
-	CM3CON = 0;									//reset value
-	CM3CONbits.CEN = 1;							//1->enable the module, 0->disable the module
-}
-#else		//ga002 devices
-//initialize comparator
-void CM1Init(void) {
-	PMD3bits.CMPMD = 0;							//1->disable the module, 0->enable the model
-
-	CMCON = CMCON & 0b0010101010101100;			//reset value
-	CMCONbits.C1EN = 1;							//1->enable the module, 0->disable the module
-}
-
-void CM2Init(void) {
-	PMD3bits.CMPMD = 0;							//1->disable the module, 0->enable the model
-
-	CMCON = CMCON &~0b0010101010101100;			//reset value
-	CMCONbits.C2EN = 1;							//1->enable the module, 0->disable the module
-}
-#endif
-
-//end comparator
-
+#include "pic24duino.h"						//pic24duino
+
+//mcus supported
+//PIC24GA00x: PIC24FJxx002, PIC24FJxx004
+//PIC24GA10x: PIC24FJxx102, PIC24FJxx104
+//PIC24GB00x: PIC24FJxx002, PIC24FJxx004
+
+
+
+//config words settings
+#if defined(__XC__)					//for XC16
+//PIC24FJxxGA104 family
+#if defined(__PIC24GA10x__)
+/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | */
+/*		defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) */
+
+//config fues settings for 24fj64ga102
+///config fues settings
+//CONFIG1
+#pragma config JTAGEN = OFF
+#pragma config GCP = OFF
+#pragma config GWRP = OFF
+#pragma config ICS = PGx2
+#pragma config FWDTEN = OFF
+#pragma config WINDIS = OFF
+#pragma config FWPSA = PR128
+#pragma config WDTPS = PS32768
+
+//CONFIG2
+#pragma config IESO = OFF
+#pragma config FNOSC = FRC		//FRC, FRCPLL, PRI, PRIPLL, SOSC, LPRC, FRCDIV
+#pragma config FCKSM = CSECMD				//clock switching on: SystemCoreClockSwitch()
+#pragma config OSCIOFNC = OFF
+#pragma config IOL1WAY = OFF
+#pragma config POSCMOD = HS		//EC, XT, HS, NONE
+#pragma config I2C1SEL = PRI
+
+//CONFIG3
+#pragma config WPFP = WPFP0
+#pragma config SOSCSEL = IO
+#pragma config WUTSEL = LEG
+#pragma config WPDIS = WPDIS
+#pragma config WPCFG = WPCFGDIS
+#pragma config WPEND = WPENDMEM
+
+//CONFIG4
+#pragma config DSWDTPS = DSWDTPSF
+#pragma config DSWDTOSC = LPRC
+#pragma config RTCOSC = LPRC
+#pragma config DSBOREN = OFF
+#pragma config DSWDTEN = OFF
+
+
+/*
+ DSWDT Postscale Select
+DSWDTPS = DSWDTPS0	 1 : 2 (2.1 ms)
+DSWDTPS = DSWDTPS1	 1 : 8 (8.3 ms)
+DSWDTPS = DSWDTPS2	 1 : 32 (33 ms)
+DSWDTPS = DSWDTPS3	 1 : 128 (132 ms)
+DSWDTPS = DSWDTPS4	 1 : 512 (528 ms)
+DSWDTPS = DSWDTPS5	 1 : 2,048 (2.1 seconds)
+DSWDTPS = DSWDTPS6	 1 : 8,192 (8.5 seconds)
+DSWDTPS = DSWDTPS7	 1 : 32,768 (34 seconds)
+DSWDTPS = DSWDTPS8	 1 : 131,072 (135 seconds)
+DSWDTPS = DSWDTPS9	 1 : 524,288 (9 minutes)
+DSWDTPS = DSWDTPSA	 1 : 2,097,152 (36 minutes)
+DSWDTPS = DSWDTPSB	 1 : 8,388,608 (2.4 hours)
+DSWDTPS = DSWDTPSC	 1 : 33,554,432 (9.6 hours)
+DSWDTPS = DSWDTPSD	 1 : 134,217,728 (38.5 hours)
+DSWDTPS = DSWDTPSE	 1 : 536,870,912 (6.4 days)
+DSWDTPS = DSWDTPSF	 1 : 2,147,483,648 (25.7 days)
+
+Deep Sleep Watchdog Timer Oscillator Select
+DSWDTOSC = SOSC	 DSWDT uses Secondary Oscillator (SOSC)
+DSWDTOSC = LPRC	 DSWDT uses Low Power RC Oscillator (LPRC)
+
+RTCC Reference Oscillator Select
+RTCOSC = LPRC	 RTCC uses Low Power RC Oscillator (LPRC)
+RTCOSC = SOSC	 RTCC uses Secondary Oscillator (SOSC)
+
+Deep Sleep BOR Enable bit
+DSBOREN = OFF	 BOR disabled in Deep Sleep
+DSBOREN = ON	 BOR enabled in Deep Sleep
+
+Deep Sleep Watchdog Timer
+DSWDTEN = OFF	 DSWDT disabled
+DSWDTEN = ON	 DSWDT enabled
+
+Write Protection Flash Page Segment Boundary
+WPFP = WPFP0	 Page 0 (0x0)
+WPFP = WPFP1	 Page 1 (0x400)
+WPFP = WPFP2	 Page 2 (0x800)
+WPFP = WPFP3	 Page 3 (0xC00)
+WPFP = WPFP4	 Page 4 (0x1000)
+WPFP = WPFP5	 Page 5 (0x1400)
+WPFP = WPFP6	 Page 6 (0x1800)
+WPFP = WPFP7	 Page 7 (0x1C00)
+WPFP = WPFP8	 Page 8 (0x2000)
+WPFP = WPFP9	 Page 9 (0x2400)
+WPFP = WPFP10	 Page 10 (0x2800)
+WPFP = WPFP11	 Page 11 (0x2C00)
+WPFP = WPFP12	 Page 12 (0x3000)
+WPFP = WPFP13	 Page 13 (0x3400)
+WPFP = WPFP14	 Page 14 (0x3800)
+WPFP = WPFP15	 Page 15 (0x3C00)
+WPFP = WPFP16	 Page 16 (0x4000)
+WPFP = WPFP17	 Page 17 (0x4400)
+WPFP = WPFP18	 Page 18 (0x4800)
+WPFP = WPFP19	 Page 19 (0x4C00)
+WPFP = WPFP20	 Page 20 (0x5000)
+WPFP = WPFP21	 Page 21 (0x5400)
+WPFP = WPFP22	 Page 22 (0x5800)
+WPFP = WPFP23	 Page 23 (0x5C00)
+WPFP = WPFP24	 Page 24 (0x6000)
+WPFP = WPFP25	 Page 25 (0x6400)
+WPFP = WPFP26	 Page 26 (0x6800)
+WPFP = WPFP27	 Page 27 (0x6C00)
+WPFP = WPFP28	 Page 28 (0x7000)
+WPFP = WPFP29	 Page 29 (0x7400)
+WPFP = WPFP30	 Page 30 (0x7800)
+WPFP = WPFP31	 Page 31 (0x7C00)
+WPFP = WPFP32	 Page 32 (0x8000)
+WPFP = WPFP33	 Page 33 (0x8400)
+WPFP = WPFP34	 Page 34 (0x8800)
+WPFP = WPFP35	 Page 35 (0x8C00)
+WPFP = WPFP36	 Page 36 (0x9000)
+WPFP = WPFP37	 Page 37 (0x9400)
+WPFP = WPFP38	 Page 38 (0x9800)
+WPFP = WPFP39	 Page 39 (0x9C00)
+WPFP = WPFP40	 Page 40 (0xA000)
+WPFP = WPFP41	 Page 41 (0xA400)
+WPFP = WPFP42	 Page 42 (0xA800)
+WPFP = WPFP63	 Highest Page (same as page 42)
+
+ * Secondary Oscillator Pin Mode Select
+SOSCSEL = IO	 SOSC pins have digital I/O functions (RA4, RB4)
+SOSCSEL = LPSOSC	 SOSC pins in Low-Power (low drive-strength) Oscillator Mode
+SOSCSEL = SOSC	 SOSC pins in Default (high drive-strength) Oscillator Mode
+
+Voltage Regulator Wake-up Time Select
+WUTSEL = FST	 Fast regulator start-up time used
+WUTSEL = LEG	 Default regulator start-up time used
+
+Segment Write Protection Disable
+WPDIS = WPEN	 Segmented code protection enabled
+WPDIS = WPDIS	 Segmented code protection disabled
+
+Write Protect Configuration Page Select
+WPCFG = WPCFGEN	 Last page and Flash Configuration words are code-protected
+WPCFG = WPCFGDIS	 Last page and Flash Configuration words are unprotected
+
+Segment Write Protection End Page Select
+WPEND = WPSTARTMEM	 Write Protect from page 0 to WPFP
+WPEND = WPENDMEM	 Write Protect from WPFP to the last page of memory
+
+Primary Oscillator Select
+POSCMOD = EC	 EC Oscillator mode selected
+POSCMOD = XT	 XT Oscillator mode selected
+POSCMOD = HS	 HS Oscillator mode selected
+POSCMOD = NONE	 Primary Oscillator disabled
+
+I2C1 Pin Select bit
+I2C1SEL = SEC	 Use alternate SCL1/SDA1 pins for I2C1
+I2C1SEL = PRI	 Use default SCL1/SDA1 pins for I2C1
+
+IOLOCK One-Way Set Enable
+IOL1WAY = OFF	 The IOLOCK bit can be set and cleared using the unlock sequence
+IOL1WAY = ON	 Once set, the IOLOCK bit cannot be cleared
+
+ * OSCO Pin Configuration
+OSCIOFNC = ON	 OSCO pin functions as port I/O (RA3)
+OSCIOFNC = OFF	 OSCO pin functions as clock output (CLKO)
+
+Clock Switching and Fail-Safe Clock Monitor
+FCKSM = CSECME	 Sw Enabled, Mon Enabled
+FCKSM = CSECMD	 Sw Enabled, Mon Disabled
+FCKSM = CSDCMD	 Sw Disabled, Mon Disabled
+
+Initial Oscillator Select
+FNOSC = FRC	 Fast RC Oscillator (FRC)
+FNOSC = FRCPLL	 Fast RC Oscillator with Postscaler and PLL module (FRCPLL)
+FNOSC = PRI	 Primary Oscillator (XT, HS, EC)
+FNOSC = PRIPLL	 Primary Oscillator with PLL module (XTPLL, HSPLL, ECPLL)
+FNOSC = SOSC	 Secondary Oscillator (SOSC)
+FNOSC = LPRC	 Low-Power RC Oscillator (LPRC)
+FNOSC = FRCDIV	 Fast RC Oscillator with Postscaler (FRCDIV)
+
+Internal External Switchover
+IESO = OFF	 IESO mode (Two-Speed Start-up) disabled
+IESO = ON	 IESO mode (Two-Speed Start-up) enabled
+
+Watchdog Timer Postscaler
+WDTPS = PS1	 1 : 1
+WDTPS = PS2	 1 : 2
+WDTPS = PS4	 1 : 4
+WDTPS = PS8	 1 : 8
+WDTPS = PS16	 1 : 16
+WDTPS = PS32	 1 : 32
+WDTPS = PS64	 1 : 64
+WDTPS = PS128	 1 : 128
+WDTPS = PS256	 1 : 256
+WDTPS = PS512	 1 : 512
+WDTPS = PS1024	 1 : 1,024
+WDTPS = PS2048	 1 : 2,048
+WDTPS = PS4096	 1 : 4,096
+WDTPS = PS8192	 1 : 8,192
+WDTPS = PS16384	 1 : 16,384
+WDTPS = PS32768	 1 : 32,768
+
+WDT Prescaler
+FWPSA = PR32	 Prescaler ratio of 1 : 32
+FWPSA = PR128	 Prescaler ratio of 1 : 128
+
+Windowed WDT
+WINDIS = ON	 Windowed Watchdog Timer enabled; FWDTEN must be 1
+WINDIS = OFF	 Standard Watchdog Timer enabled,(Windowed-mode is disabled)
+
+Watchdog Timer
+FWDTEN = OFF	 Watchdog Timer is disabled
+FWDTEN = ON	 Watchdog Timer is enabled
+
+Emulator Pin Placement Select bits
+ICS = PGx3	 Emulator functions are shared with PGEC3/PGED3
+ICS = PGx2	 Emulator functions are shared with PGEC2/PGED2
+ICS = PGx1	 Emulator functions are shared with PGEC1/PGED1
+
+General Segment Write Protect
+GWRP = ON	 Writes to program memory are disabled
+GWRP = OFF	 Writes to program memory are allowed
+
+General Segment Code Protect
+GCP = ON	 Code protection is enabled for the entire program memory space
+GCP = OFF	 Code protection is disabled
+
+JTAG Port Enable
+JTAGEN = OFF	 JTAG port is disabled
+JTAGEN = ON	 JTAG port is enabled
+ */
+
+//pic24fj64ga004 family
+#elif defined(__PIC24GA00x__)
+/*#elif 	defined(__PIC24FJ64GA002__) | defined (__PIC24FJ64GA004__) | \*/
+/*		defined(__PIC24FJ48GA002__) | defined (__PIC24FJ48GA004__) | \*/
+/*		defined(__PIC24FJ32GA002__) | defined (__PIC24FJ32GA004__) | \*/
+/*		defined(__PIC24FJ16GA002__) | defined (__PIC24FJ16GA004__)*/
+
+/*config fues settings for everything else - need customization*/
+//CONFIG1
+#pragma config JTAGEN = OFF
+#pragma config GCP = OFF
+#pragma config GWRP = OFF
+#pragma config BKBUG = OFF
+#pragma config COE = OFF
+#pragma config ICS = PGx2
+#pragma config FWDTEN = OFF
+#pragma config WINDIS = OFF
+#pragma config FWPSA = PR128
+#pragma config WDTPS = PS32768
+
+//CONFIG2
+#pragma config IESO = OFF
+#pragma config SOSCSEL = SOSC
+#pragma config WUTSEL = LEG
+#pragma config FCKSM = CSECMD				//clock switching on: SystemCoreClockSwitch()
+#pragma config OSCIOFNC = OFF
+#pragma config IOL1WAY = OFF
+#pragma config I2C1SEL = PRI
+#pragma config POSCMOD = NONE				//EC/XT/HS/NONE
+#pragma config FNOSC = FRC				//FRC/FRCPLL/FRCDIV/PRI/PRIPLL/SOSC/LPRC
+
+/*
+ Primary Oscillator Select
+POSCMOD = EC	 EC Oscillator mode selected
+POSCMOD = XT	 XT Oscillator mode selected
+POSCMOD = HS	 HS Oscillator mode selected
+POSCMOD = NONE	 Primary oscillator disabled
+
+I2C1 Pin Location Select
+I2C1SEL = SEC	 Use alternate SCL1/SDA1 pins
+I2C1SEL = PRI	 Use default SCL1/SDA1 pins
+
+IOLOCK Protection
+IOL1WAY = OFF	 IOLOCK may be changed via unlocking seq
+IOL1WAY = ON	 Once IOLOCK is set, cannot be changed
+
+Primary Oscillator Output Function
+OSCIOFNC = ON	 OSC2/CLKO/RC15 functions as port I/O (RC15)
+OSCIOFNC = OFF	 OSC2/CLKO/RC15 functions as CLKO (FOSC/2)
+
+Clock Switching and Monitor
+FCKSM = CSECME	 Clock switching is enabled, Fail-Safe Clock Monitor is enabled
+FCKSM = CSECMD	 Clock switching is enabled, Fail-Safe Clock Monitor is disabled
+FCKSM = CSDCMD	 Clock switching and Fail-Safe Clock Monitor are disabled
+
+Oscillator Select
+FNOSC = FRC	 Fast RC Oscillator (FRC)
+FNOSC = FRCPLL	 Fast RC Oscillator with PLL module (FRCPLL)
+FNOSC = PRI	 Primary Oscillator (XT, HS, EC)
+FNOSC = PRIPLL	 Primary Oscillator with PLL module (HSPLL, ECPLL)
+FNOSC = SOSC	 Secondary Oscillator (SOSC)
+FNOSC = LPRC	 Low-Power RC Oscillator (LPRC)
+FNOSC = FRCDIV	 Fast RC Oscillator with Postscaler (FRCDIV)
+
+Sec Oscillator Select
+SOSCSEL = LPSOSC	 Low Power Secondary Oscillator (LPSOSC)
+SOSCSEL = SOSC	 Default Secondary Oscillator (SOSC)
+
+Wake-up timer Select
+WUTSEL = FST	 Fast Wake-up Timer
+WUTSEL = LEG	 Legacy Wake-up Timer
+
+Internal External Switch Over Mode
+IESO = OFF	 IESO mode (Two-Speed Start-up) disabled
+IESO = ON	 IESO mode (Two-Speed Start-up) enabled
+
+Watchdog Timer Postscaler
+WDTPS = PS1	 1 : 1
+WDTPS = PS2	 1 : 2
+WDTPS = PS4	 1 : 4
+WDTPS = PS8	 1 : 8
+WDTPS = PS16	 1 : 16
+WDTPS = PS32	 1 : 32
+WDTPS = PS64	 1 : 64
+WDTPS = PS128	 1 : 128
+WDTPS = PS256	 1 : 256
+WDTPS = PS512	 1 : 512
+WDTPS = PS1024	 1 : 1,024
+WDTPS = PS2048	 1 : 2,048
+WDTPS = PS4096	 1 : 4,096
+WDTPS = PS8192	 1 : 8,192
+WDTPS = PS16384	 1 : 16,384
+WDTPS = PS32768	 1 : 32,768
+
+WDT Prescaler
+FWPSA = PR32	 Prescaler ratio of 1 : 32
+FWPSA = PR128	 Prescaler ratio of 1 : 128
+
+Watchdog Timer Window
+WINDIS = OFF	 Windowed Watchdog Timer enabled; FWDTEN must be 1
+WINDIS = ON	 Standard Watchdog Timer enabled,(Windowed-mode is disabled)
+
+Watchdog Timer Enable
+FWDTEN = OFF	 Watchdog Timer is disabled
+FWDTEN = ON	 Watchdog Timer is enabled
+
+Comm Channel Select
+ICS = PGx3	 Emulator EMUC3/EMUD3 pins are shared with PGC3/PGD3
+ICS = PGx2	 Emulator EMUC2/EMUD2 pins are shared with PGC2/PGD2
+ICS = PGx1	 Emulator EMUC1/EMUD1 pins are shared with PGC1/PGD1
+
+Set Clip On Emulation Mode
+COE = ON	 Reset Into Clip On Emulation Mode
+COE = OFF	 Reset Into Operational Mode
+
+Background Debug
+BKBUG = ON	 Device resets into Debug mode
+BKBUG = OFF	 Device resets into Operational mode
+
+General Code Segment Write Protect
+GWRP = ON	 Writes to program memory are disabled
+GWRP = OFF	 Writes to program memory are allowed
+
+General Code Segment Code Protect
+GCP = ON	 Code protection is enabled for the entire program memory space
+GCP = OFF	 Code protection is disabled
+
+JTAG Port Enable
+JTAGEN = OFF	 JTAG port is disabled
+JTAGEN = ON	 JTAG port is enabled
+ */
+
+//pic24fjgb004 family
+#elif defined(__PIC24GB00x__)
+/*#elif 	defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \*/
+/*		defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \*/
+/*		defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+
+//CONFIG1
+#pragma config JTAGEN = OFF
+#pragma config GCP = OFF
+#pragma config GWRP = OFF
+#pragma config ICS = PGx2
+#pragma config FWDTEN = OFF
+#pragma config WINDIS = OFF
+#pragma config FWPSA = PR128
+#pragma config WDTPS = PS32768
+
+//CONFIG2
+#pragma config IESO = OFF
+#pragma config PLLDIV = DIV12
+#pragma config PLL96MHZ = ON
+#pragma config FNOSC = PRI					//FRC, FRCPLL, PRI, PRIPLL, SOSC, LSOC
+#pragma config FCKSM = CSECMD				//clock switching on: SystemCoreClockSwitch()
+#pragma config OSCIOFNC = OFF
+#pragma config IOL1WAY = OFF
+#pragma config POSCMOD = HS					//EC, HS, XT, NONE
+#pragma config I2C1SEL = PRI
+
+//CONFIG3
+#pragma config WPFP = WPFP0
+#pragma config SOSCSEL = IO
+#pragma config WUTSEL = LEG
+#pragma config WPDIS = WPDIS
+#pragma config WPCFG = WPCFGDIS
+#pragma config WPEND = WPENDMEM
+
+//CONFIG4
+#pragma config DSWDTPS = DSWDTPSF
+#pragma config DSWDTOSC = LPRC
+#pragma config RTCOSC = LPRC
+#pragma config DSBOREN = OFF
+#pragma config DSWDTEN = OFF
+
+
+
+
+/*DSWDT Postscale Select
+DSWDTPS = DSWDTPS0	 1 : 2 (2.1 ms)
+DSWDTPS = DSWDTPS1	 1 : 8 (8.3 ms)
+DSWDTPS = DSWDTPS2	 1 : 32 (33 ms)
+DSWDTPS = DSWDTPS3	 1 : 128 (132 ms)
+DSWDTPS = DSWDTPS4	 1 : 512 (528 ms)
+DSWDTPS = DSWDTPS5	 1 : 2,048 (2.1 seconds)
+DSWDTPS = DSWDTPS6	 1 : 8,192 (8.5 seconds)
+DSWDTPS = DSWDTPS7	 1 : 32,768 (34 seconds)
+DSWDTPS = DSWDTPS8	 1 : 131,072 (135 seconds)
+DSWDTPS = DSWDTPS9	 1 : 524,288 (9 minutes)
+DSWDTPS = DSWDTPSA	 1 : 2,097,152 (36 minutes)
+DSWDTPS = DSWDTPSB	 1 : 8,388,608 (2.4 hours)
+DSWDTPS = DSWDTPSC	 1 : 33,554,432 (9.6 hours)
+DSWDTPS = DSWDTPSD	 1 : 134,217,728 (38.5 hours)
+DSWDTPS = DSWDTPSE	 1 : 536,870,912 (6.4 days)
+DSWDTPS = DSWDTPSF	 1 : 2,147,483,648 (25.7 days)
+
+Deep Sleep Watchdog Timer Oscillator Select
+DSWDTOSC = SOSC	 DSWDT uses Secondary Oscillator (SOSC)
+DSWDTOSC = LPRC	 DSWDT uses Low Power RC Oscillator (LPRC)
+
+RTCC Reference Oscillator Select
+RTCOSC = LPRC	 RTCC uses Low Power RC Oscillator (LPRC)
+RTCOSC = SOSC	 RTCC uses Secondary Oscillator (SOSC)
+
+Deep Sleep BOR Enable bit
+DSBOREN = OFF	 BOR disabled in Deep Sleep
+DSBOREN = ON	 BOR enabled in Deep Sleep
+
+Deep Sleep Watchdog Timer
+DSWDTEN = OFF	 DSWDT disabled
+DSWDTEN = ON	 DSWDT enabled
+
+Write Protection Flash Page Segment Boundary
+WPFP = WPFP0	 Page 0 (0x0)
+WPFP = WPFP1	 Page 1 (0x400)
+WPFP = WPFP2	 Page 2 (0x800)
+WPFP = WPFP3	 Page 3 (0xC00)
+WPFP = WPFP4	 Page 4 (0x1000)
+WPFP = WPFP5	 Page 5 (0x1400)
+WPFP = WPFP6	 Page 6 (0x1800)
+WPFP = WPFP7	 Page 7 (0x1C00)
+WPFP = WPFP8	 Page 8 (0x2000)
+WPFP = WPFP9	 Page 9 (0x2400)
+WPFP = WPFP10	 Page 10 (0x2800)
+WPFP = WPFP11	 Page 11 (0x2C00)
+WPFP = WPFP12	 Page 12 (0x3000)
+WPFP = WPFP13	 Page 13 (0x3400)
+WPFP = WPFP14	 Page 14 (0x3800)
+WPFP = WPFP15	 Page 15 (0x3C00)
+WPFP = WPFP16	 Page 16 (0x4000)
+WPFP = WPFP17	 Page 17 (0x4400)
+WPFP = WPFP18	 Page 18 (0x4800)
+WPFP = WPFP19	 Page 19 (0x4C00)
+WPFP = WPFP20	 Page 20 (0x5000)
+WPFP = WPFP21	 Page 21 (0x5400)
+WPFP = WPFP22	 Page 22 (0x5800)
+WPFP = WPFP23	 Page 23 (0x5C00)
+WPFP = WPFP24	 Page 24 (0x6000)
+WPFP = WPFP25	 Page 25 (0x6400)
+WPFP = WPFP26	 Page 26 (0x6800)
+WPFP = WPFP27	 Page 27 (0x6C00)
+WPFP = WPFP28	 Page 28 (0x7000)
+WPFP = WPFP29	 Page 29 (0x7400)
+WPFP = WPFP30	 Page 30 (0x7800)
+WPFP = WPFP31	 Page 31 (0x7C00)
+WPFP = WPFP32	 Page 32 (0x8000)
+WPFP = WPFP33	 Page 33 (0x8400)
+WPFP = WPFP34	 Page 34 (0x8800)
+WPFP = WPFP35	 Page 35 (0x8C00)
+WPFP = WPFP36	 Page 36 (0x9000)
+WPFP = WPFP37	 Page 37 (0x9400)
+WPFP = WPFP38	 Page 38 (0x9800)
+WPFP = WPFP39	 Page 39 (0x9C00)
+WPFP = WPFP40	 Page 40 (0xA000)
+WPFP = WPFP41	 Page 41 (0xA400)
+WPFP = WPFP42	 Page 42 (0xA800)
+WPFP = WPFP63	 Highest Page (same as page 42)
+
+Secondary Oscillator Pin Mode Select
+SOSCSEL = IO	 SOSC pins have digital I/O functions (RA4, RB4)
+SOSCSEL = LPSOSC	 SOSC pins in Low-Power (low drive-strength) Oscillator Mode
+SOSCSEL = SOSC	 SOSC pins in Default (high drive-strength) Oscillator Mode
+
+Voltage Regulator Wake-up Time Select
+WUTSEL = FST	 Fast regulator start-up time used
+WUTSEL = LEG	 Default regulator start-up time used
+
+Segment Write Protection Disable
+WPDIS = WPEN	 Segmented code protection enabled
+WPDIS = WPDIS	 Segmented code protection disabled
+
+Write Protect Configuration Page Select
+WPCFG = WPCFGEN	 Last page and Flash Configuration words are code-protected
+WPCFG = WPCFGDIS	 Last page and Flash Configuration words are unprotected
+
+Segment Write Protection End Page Select
+WPEND = WPSTARTMEM	 Write Protect from page 0 to WPFP
+WPEND = WPENDMEM	 Write Protect from WPFP to the last page of memory
+
+Primary Oscillator Select
+POSCMOD = EC	 EC Oscillator mode selected
+POSCMOD = XT	 XT Oscillator mode selected
+POSCMOD = HS	 HS Oscillator mode selected
+POSCMOD = NONE	 Primary Oscillator disabled
+
+I2C1 Pin Select bit
+I2C1SEL = SEC	 Use alternate SCL1/SDA1 pins for I2C1
+I2C1SEL = PRI	 Use default SCL1/SDA1 pins for I2C1
+
+IOLOCK One-Way Set Enable
+IOL1WAY = OFF	 The IOLOCK bit can be set and cleared using the unlock sequence
+IOL1WAY = ON	 Once set, the IOLOCK bit cannot be cleared
+
+OSCO Pin Configuration
+OSCIOFNC = ON	 OSCO pin functions as port I/O (RA3)
+OSCIOFNC = OFF	 OSCO pin functions as clock output (CLKO)
+
+Clock Switching and Fail-Safe Clock Monitor
+FCKSM = CSECME	 Sw Enabled, Mon Enabled
+FCKSM = CSECMD	 Sw Enabled, Mon Disabled
+FCKSM = CSDCMD	 Sw Disabled, Mon Disabled
+
+Initial Oscillator Select
+FNOSC = FRC	 Fast RC Oscillator (FRC)
+FNOSC = FRCPLL	 Fast RC Oscillator with Postscaler and PLL module (FRCPLL)
+FNOSC = PRI	 Primary Oscillator (XT, HS, EC)
+FNOSC = PRIPLL	 Primary Oscillator with PLL module (XTPLL, HSPLL, ECPLL)
+FNOSC = SOSC	 Secondary Oscillator (SOSC)
+FNOSC = LPRC	 Low-Power RC Oscillator (LPRC)
+FNOSC = FRCDIV	 Fast RC Oscillator with Postscaler (FRCDIV)
+
+96MHz PLL Startup Select
+PLL96MHZ = OFF	 96 MHz PLL Startup is enabled by user in software( controlled with the PLLEN bit)
+PLL96MHZ = ON	 96 MHz PLL Startup is enabled automatically on start-up
+
+USB 96 MHz PLL Prescaler Select
+PLLDIV = NODIV	 Oscillator input used directly (4 MHz input)
+PLLDIV = DIV2	 Oscillator input divided by 2 (8 MHz input)
+PLLDIV = DIV3	 Oscillator input divided by 3 (12 MHz input)
+PLLDIV = DIV4	 Oscillator input divided by 4 (16 MHz input)
+PLLDIV = DIV5	 Oscillator input divided by 5 (20 MHz input)
+PLLDIV = DIV6	 Oscillator input divided by 6 (24 MHz input)
+PLLDIV = DIV8	 Oscillator input divided by 8 (32 MHz input)
+PLLDIV = DIV12	 Oscillator input divided by 12 (48 MHz input)
+
+Internal External Switchover
+IESO = OFF	 IESO mode (Two-Speed Start-up) disabled
+IESO = ON	 IESO mode (Two-Speed Start-up) enabled
+
+Watchdog Timer Postscaler
+WDTPS = PS1	 1 : 1
+WDTPS = PS2	 1 : 2
+WDTPS = PS4	 1 : 4
+WDTPS = PS8	 1 : 8
+WDTPS = PS16	 1 : 16
+WDTPS = PS32	 1 : 32
+WDTPS = PS64	 1 : 64
+WDTPS = PS128	 1 : 128
+WDTPS = PS256	 1 : 256
+WDTPS = PS512	 1 : 512
+WDTPS = PS1024	 1 : 1,024
+WDTPS = PS2048	 1 : 2,048
+WDTPS = PS4096	 1 : 4,096
+WDTPS = PS8192	 1 : 8,192
+WDTPS = PS16384	 1 : 16,384
+WDTPS = PS32768	 1 : 32,768
+
+WDT Prescaler
+FWPSA = PR32	 Prescaler ratio of 1 : 32
+FWPSA = PR128	 Prescaler ratio of 1 : 128
+
+Windowed WDT
+WINDIS = ON	 Windowed Watchdog Timer enabled; FWDTEN must be 1
+WINDIS = OFF	 Standard Watchdog Timer enabled,(Windowed-mode is disabled)
+
+Watchdog Timer
+FWDTEN = OFF	 Watchdog Timer is disabled
+FWDTEN = ON	 Watchdog Timer is enabled
+
+Emulator Pin Placement Select bits
+ICS = PGx3	 Emulator functions are shared with PGEC3/PGED3
+ICS = PGx2	 Emulator functions are shared with PGEC2/PGED2
+ICS = PGx1	 Emulator functions are shared with PGEC1/PGED1
+
+General Segment Write Protect
+GWRP = ON	 Writes to program memory are disabled
+GWRP = OFF	 Writes to program memory are allowed
+
+General Segment Code Protect
+GCP = ON	 Code protection is enabled for the entire program memory space
+GCP = OFF	 Code protection is disabled
+
+JTAG Port Enable
+JTAGEN = OFF	 JTAG port is disabled
+JTAGEN = ON	 JTAG port is enabled
+ */
+#endif			//pic24gb00x
+#endif 					//xc16
+
+//config for C30
+#if defined(__C30__)				//for C30 compiler
+
+#if defined(__PIC24GA10x__)		//for pic24ga10x
+
+
+//config fues settings for 24fj64ga102
+///config fues settings
+_CONFIG1(
+	JTAGEN_OFF &					//Disable JTAG port
+	GCP_OFF &						//Disable code protect
+	GWRP_OFF &						//Disable write protect
+	ICS_PGx2 &						//EMUC/EMUD share PGC2/PGD2
+	FWDTEN_OFF &					//Disable watchdog timer (WDT)
+	WINDIS_OFF &					//Use standard WDT (if it is enabled)
+	FWPSA_PR128 &					//Use WDT prescaler ratio of 1:128
+	WDTPS_PS32768					//Use WDT postscaler ratio of 1:32,768
+)
+
+_CONFIG2(
+	FNOSC_FRC &						//Primary oscillator: FRC, FRCPLL, PRI, PRIPLL, SOSC, LPRC, FRCDIV
+	POSCMOD_HS &					//External oscillator: HS, XT, EC, NONE
+	IESO_OFF &						//Disabled
+	FCKSM_CSECMD &					//Clock switching enabled, clock monitor disabled: SystemCoreClockSwitch()
+	OSCIOFNC_OFF &					//OSCO or Fosc/2
+	IOL1WAY_OFF &					//Unlimited Writes To RP Registers
+	I2C1SEL_PRI						//Use Primary I2C1 pins
+	//SOSCSEL_SOSC &					//Default Secondary Oscillator
+	//WUTSEL_LEG &					//Legacy Wake-up timer selected
+)
+
+_CONFIG3(
+	WPFP_WPFP63 &					//Highest Page (same as page 42)
+	SOSCSEL_IO &					//SOSC pins have digital I/O functions (RA4, RB4)
+	WUTSEL_LEG &					//Default regulator start-up time used
+	WPDIS_WPDIS &					//Segmented code protection disabled
+	WPCFG_WPCFGDIS &				//Last page and Flash Configuration words are unprotected
+	WPEND_WPENDMEM					//Write Protect from WPFP to the last page of memory
+)
+
+_CONFIG4(
+	DSWDTPS_DSWDTPSF &				//1:2,147,483,648 (25.7 days)
+	DSWDTOSC_LPRC &					//DSWDT uses Low Power RC Oscillator (LPRC)
+	RTCOSC_LPRC &					//RTCC uses Low Power RC Oscillator (LPRC)
+	DSBOREN_OFF &					//BOR disabled in Deep Sleep
+	DSWDTEN_OFF 					//DSWDT disabled
+)
+
+/* -------------------------------------------------------- */
+/* Macros for setting device configuration registers        */
+/* -------------------------------------------------------- */
+
+/* Register CONFIG4 (0xabf8)                               */
+
+/*
+** Only one invocation of CONFIG4 should appear in a project,
+** at the top of a C source file (outside of any function).
+**
+** The following constants can be used to set CONFIG4.
+** Multiple options may be combined, as shown:
+**
+** _CONFIG4( OPT1_ON & OPT2_OFF & OPT3_PLL )
+**
+**   DSWDT Postscale Select:
+**     DSWDTPS_DSWDTPS0     1:2 (2.1 ms)
+**     DSWDTPS_DSWDTPS1     1:8 (8.3 ms)
+**     DSWDTPS_DSWDTPS2     1:32 (33 ms)
+**     DSWDTPS_DSWDTPS3     1:128 (132 ms)
+**     DSWDTPS_DSWDTPS4     1:512 (528 ms)
+**     DSWDTPS_DSWDTPS5     1:2,048 (2.1 seconds)
+**     DSWDTPS_DSWDTPS6     1:8,192 (8.5 seconds)
+**     DSWDTPS_DSWDTPS7     1:32,768 (34 seconds)
+**     DSWDTPS_DSWDTPS8     1:131,072 (135 seconds)
+**     DSWDTPS_DSWDTPS9     1:524,288 (9 minutes)
+**     DSWDTPS_DSWDTPSA     1:2,097,152 (36 minutes)
+**     DSWDTPS_DSWDTPSB     1:8,388,608 (2.4 hours)
+**     DSWDTPS_DSWDTPSC     1:33,554,432 (9.6 hours)
+**     DSWDTPS_DSWDTPSD     1:134,217,728 (38.5 hours)
+**     DSWDTPS_DSWDTPSE     1:536,870,912 (6.4 days)
+**     DSWDTPS_DSWDTPSF     1:2,147,483,648 (25.7 days)
+**
+**   Deep Sleep Watchdog Timer Oscillator Select:
+**     DSWDTOSC_SOSC        DSWDT uses Secondary Oscillator (SOSC)
+**     DSWDTOSC_LPRC        DSWDT uses Low Power RC Oscillator (LPRC)
+**
+**   RTCC Reference Oscillator  Select:
+**     RTCOSC_LPRC          RTCC uses Low Power RC Oscillator (LPRC)
+**     RTCOSC_SOSC          RTCC uses Secondary Oscillator (SOSC)
+**
+**   Deep Sleep BOR Enable bit:
+**     DSBOREN_OFF          BOR disabled in Deep Sleep
+**     DSBOREN_ON           BOR enabled in Deep Sleep
+**
+**   Deep Sleep Watchdog Timer:
+**     DSWDTEN_OFF          DSWDT disabled
+**     DSWDTEN_ON           DSWDT enabled
+**
+*/
+
+/* Register CONFIG3 (0xabfa)                               */
+
+/*
+** Only one invocation of CONFIG3 should appear in a project,
+** at the top of a C source file (outside of any function).
+**
+** The following constants can be used to set CONFIG3.
+** Multiple options may be combined, as shown:
+**
+** _CONFIG3( OPT1_ON & OPT2_OFF & OPT3_PLL )
+**
+**   Write Protection Flash Page Segment Boundary:
+**     WPFP_WPFP0           Page 0 (0x0)
+**     WPFP_WPFP1           Page 1 (0x400)
+**     WPFP_WPFP2           Page 2 (0x800)
+**     WPFP_WPFP3           Page 3 (0xC00)
+**     WPFP_WPFP4           Page 4 (0x1000)
+**     WPFP_WPFP5           Page 5 (0x1400)
+**     WPFP_WPFP6           Page 6 (0x1800)
+**     WPFP_WPFP7           Page 7 (0x1C00)
+**     WPFP_WPFP8           Page 8 (0x2000)
+**     WPFP_WPFP9           Page 9 (0x2400)
+**     WPFP_WPFP10          Page 10 (0x2800)
+**     WPFP_WPFP11          Page 11 (0x2C00)
+**     WPFP_WPFP12          Page 12 (0x3000)
+**     WPFP_WPFP13          Page 13 (0x3400)
+**     WPFP_WPFP14          Page 14 (0x3800)
+**     WPFP_WPFP15          Page 15 (0x3C00)
+**     WPFP_WPFP16          Page 16 (0x4000)
+**     WPFP_WPFP17          Page 17 (0x4400)
+**     WPFP_WPFP18          Page 18 (0x4800)
+**     WPFP_WPFP19          Page 19 (0x4C00)
+**     WPFP_WPFP20          Page 20 (0x5000)
+**     WPFP_WPFP21          Page 21 (0x5400)
+**     WPFP_WPFP22          Page 22 (0x5800)
+**     WPFP_WPFP23          Page 23 (0x5C00)
+**     WPFP_WPFP24          Page 24 (0x6000)
+**     WPFP_WPFP25          Page 25 (0x6400)
+**     WPFP_WPFP26          Page 26 (0x6800)
+**     WPFP_WPFP27          Page 27 (0x6C00)
+**     WPFP_WPFP28          Page 28 (0x7000)
+**     WPFP_WPFP29          Page 29 (0x7400)
+**     WPFP_WPFP30          Page 30 (0x7800)
+**     WPFP_WPFP31          Page 31 (0x7C00)
+**     WPFP_WPFP32          Page 32 (0x8000)
+**     WPFP_WPFP33          Page 33 (0x8400)
+**     WPFP_WPFP34          Page 34 (0x8800)
+**     WPFP_WPFP35          Page 35 (0x8C00)
+**     WPFP_WPFP36          Page 36 (0x9000)
+**     WPFP_WPFP37          Page 37 (0x9400)
+**     WPFP_WPFP38          Page 38 (0x9800)
+**     WPFP_WPFP39          Page 39 (0x9C00)
+**     WPFP_WPFP40          Page 40 (0xA000)
+**     WPFP_WPFP41          Page 41 (0xA400)
+**     WPFP_WPFP42          Page 42 (0xA800)
+**     WPFP_WPFP63          Highest Page (same as page 42)
+**
+**   Secondary Oscillator Pin Mode Select:
+**     SOSCSEL_IO           SOSC pins have digital I/O functions (RA4, RB4)
+**     SOSCSEL_LPSOSC       SOSC pins in Low-Power (low drive-strength) Oscillator Mode
+**     SOSCSEL_SOSC         SOSC pins in Default (high drive-strength) Oscillator Mode
+**
+**   Voltage Regulator Wake-up Time Select:
+**     WUTSEL_FST           Fast regulator start-up time used
+**     WUTSEL_LEG           Default regulator start-up time used
+**
+**   Segment Write Protection Disable:
+**     WPDIS_WPEN           Segmented code protection enabled
+**     WPDIS_WPDIS          Segmented code protection disabled
+**
+**   Write Protect Configuration Page Select:
+**     WPCFG_WPCFGEN        Last page and Flash Configuration words are code-protected
+**     WPCFG_WPCFGDIS       Last page and Flash Configuration words are unprotected
+**
+**   Segment Write Protection End Page Select:
+**     WPEND_WPSTARTMEM     Write Protect from page 0 to WPFP
+**     WPEND_WPENDMEM       Write Protect from WPFP to the last page of memory
+**
+*/
+
+/* Register CONFIG2 (0xabfc)                               */
+
+/*
+** Only one invocation of CONFIG2 should appear in a project,
+** at the top of a C source file (outside of any function).
+**
+** The following constants can be used to set CONFIG2.
+** Multiple options may be combined, as shown:
+**
+** _CONFIG2( OPT1_ON & OPT2_OFF & OPT3_PLL )
+**
+**   Primary Oscillator Select:
+**     POSCMOD_EC           EC Oscillator mode selected
+**     POSCMOD_XT           XT Oscillator mode selected
+**     POSCMOD_HS           HS Oscillator mode selected
+**     POSCMOD_NONE         Primary Oscillator disabled
+**
+**   I2C1 Pin Select bit:
+**     I2C1SEL_SEC          Use alternate SCL1/SDA1 pins for I2C1
+**     I2C1SEL_PRI          Use default SCL1/SDA1 pins for I2C1
+**
+**   IOLOCK One-Way Set Enable:
+**     IOL1WAY_OFF          The IOLOCK bit can be set and cleared using the unlock sequence
+**     IOL1WAY_ON           Once set, the IOLOCK bit cannot be cleared
+**
+**   OSCO Pin Configuration:
+**     OSCIOFNC_ON          OSCO pin functions as port I/O (RA3)
+**     OSCIOFNC_OFF         OSCO pin functions as clock output (CLKO)
+**
+**   Clock Switching and Fail-Safe Clock Monitor:
+**     FCKSM_CSECME         Sw Enabled, Mon Enabled
+**     FCKSM_CSECMD         Sw Enabled, Mon Disabled
+**     FCKSM_CSDCMD         Sw Disabled, Mon Disabled
+**
+**   Initial Oscillator Select:
+**     FNOSC_FRC            Fast RC Oscillator (FRC)
+**     FNOSC_FRCPLL         Fast RC Oscillator with Postscaler and PLL module (FRCPLL)
+**     FNOSC_PRI            Primary Oscillator (XT, HS, EC)
+**     FNOSC_PRIPLL         Primary Oscillator with PLL module (XTPLL, HSPLL, ECPLL)
+**     FNOSC_SOSC           Secondary Oscillator (SOSC)
+**     FNOSC_LPRC           Low-Power RC Oscillator (LPRC)
+**     FNOSC_FRCDIV         Fast RC Oscillator with Postscaler (FRCDIV)
+**
+**   Internal External Switchover:
+**     IESO_OFF             IESO mode (Two-Speed Start-up) disabled
+**     IESO_ON              IESO mode (Two-Speed Start-up) enabled
+**
+*/
+
+/* Register CONFIG1 (0xabfe)                               */
+
+/*
+** Only one invocation of CONFIG1 should appear in a project,
+** at the top of a C source file (outside of any function).
+**
+** The following constants can be used to set CONFIG1.
+** Multiple options may be combined, as shown:
+**
+** _CONFIG1( OPT1_ON & OPT2_OFF & OPT3_PLL )
+**
+**   Watchdog Timer Postscaler:
+**     WDTPS_PS1            1:1
+**     WDTPS_PS2            1:2
+**     WDTPS_PS4            1:4
+**     WDTPS_PS8            1:8
+**     WDTPS_PS16           1:16
+**     WDTPS_PS32           1:32
+**     WDTPS_PS64           1:64
+**     WDTPS_PS128          1:128
+**     WDTPS_PS256          1:256
+**     WDTPS_PS512          1:512
+**     WDTPS_PS1024         1:1,024
+**     WDTPS_PS2048         1:2,048
+**     WDTPS_PS4096         1:4,096
+**     WDTPS_PS8192         1:8,192
+**     WDTPS_PS16384        1:16,384
+**     WDTPS_PS32768        1:32,768
+**
+**   WDT Prescaler:
+**     FWPSA_PR32           1:32
+**     FWPSA_PR128          1:128
+**
+**   Windowed WDT:
+**     WINDIS_ON            Windowed Watchdof timer enabled
+**     WINDIS_OFF           Standard Watchdog Timer is enabled
+**
+**   Watchdog Timer:
+**     FWDTEN_OFF           Watchdog Timer is disabled
+**     FWDTEN_ON            Watchdog Timer is enabled
+**
+**   Emulator Pin Placement Select bits:
+**     ICS_PGx3             Emulator functions are shared with PGEC3/PGED3
+**     ICS_PGx2             Emulator functions are shared with PGEC2/PGED2
+**     ICS_PGx1             Emulator functions are shared with PGEC1/PGED1
+**
+**   General Segment Write Protect:
+**     GWRP_ON              Writes to program memory are allowed
+**     GWRP_OFF             Writes to program memory are disabled
+**
+**   General Segment Code Protect:
+**     GCP_ON               Code protection is enabled
+**     GCP_OFF              Code protection is disabled
+**
+**   JTAG Port Enable:
+**     JTAGEN_OFF           JTAG port is Disabled
+**     JTAGEN_ON            JTAG port is Enabled
+**
+*/
+
+#elif defined(__PIC24GA00x__)			//fro pic24ga00x
+//config fues settings for everything else - need customization
+_CONFIG1(
+	JTAGEN_OFF &					//Disable JTAG port
+	GCP_OFF &						//Disable code protect
+	GWRP_OFF &						//Disable write protect
+	BKBUG_OFF &						//Enable background debugger
+	COE_OFF &						//Device resets into operational mode
+	ICS_PGx2 &						//EMUC/EMUD share PGC2/PGD2
+	FWDTEN_OFF &					//Disable watchdog timer (WDT)
+	WINDIS_OFF &					//Use standard WDT (if it is enabled)
+	FWPSA_PR128 &					//Use WDT prescaler ratio of 1:128
+	WDTPS_PS32768					//Use WDT postscaler ratio of 1:32,768
+)
+
+_CONFIG2(
+	FNOSC_FRC &						//Primary oscillator: FRC, FRCPLL, PRI, PRIPLL, SOSC, LPRC, FRCDIV
+	POSCMOD_HS &					//High speed seeting for external oscillator: HS, XT, EC and NONE
+	IESO_OFF &						//Disabled
+	SOSCSEL_SOSC &					//Default Secondary Oscillator
+	WUTSEL_LEG &					//Legacy Wake-up timer selected
+	FCKSM_CSECMD &					//Clock switching enabled, clock monitor disabled: SystemCoreClockSwitch()
+	OSCIOFNC_OFF &					//OSCO or Fosc/2
+	IOL1WAY_OFF &					//Unlimited Writes To RP Registers
+	I2C1SEL_PRI 					//Use Primary I2C1 pins
+)
+/* Register CONFIG2 (0xabfc)                               */
+
+/*
+** Only one invocation of CONFIG2 should appear in a project,
+** at the top of a C source file (outside of any function).
+**
+** The following constants can be used to set CONFIG2.
+** Multiple options may be combined, as shown:
+**
+** _CONFIG2( OPT1_ON & OPT2_OFF & OPT3_PLL )
+**
+**   Two Speed Start-up:
+**     IESO_OFF             Disabled
+**     IESO_ON              Enabled
+**
+**   Secondary Oscillator:
+**     SOSCSEL_LPSOSC       Low Power Secondary Oscillator
+**     SOSCSEL_SOSC         Default Secondary Oscillator
+**
+**   Voltage Regulator Standby-mode Wake-up Timer:
+**     WUTSEL_FST           Fast Wake-up timer selected
+**     WUTSEL_LEG           Legacy Wake-up timer selected
+**
+**   Oscillator Selection:
+**     FNOSC_FRC            Fast RC oscillator
+**     FNOSC_FRCPLL         Fast RC oscillator w/ divide and PLL
+**     FNOSC_PRI            Primary oscillator (XT, HS, EC)
+**     FNOSC_PRIPLL         Primary oscillator (XT, HS, EC) w/ PLL
+**     FNOSC_SOSC           Secondary oscillator
+**     FNOSC_LPRC           Low power RC oscillator
+**     FNOSC_FRCDIV         Fast RC oscillator with divide
+**
+**   Clock switching and clock monitor:
+**     FCKSM_CSECME         Both enabled
+**     FCKSM_CSECMD         Only clock switching enabled
+**     FCKSM_CSDCMD         Both disabled
+**
+**   OSCO/RC15 function:
+**     OSCIOFNC_ON          RC15
+**     OSCIOFNC_OFF         OSCO or Fosc/2
+**
+**   RP Register Protection:
+**     IOL1WAY_OFF          Unlimited Writes To RP Registers
+**     IOL1WAY_ON           Write RP Registers Once
+**
+**   I2C1 pins Select:
+**     I2C1SEL_SEC          Use Secondary I2C1 pins
+**     I2C1SEL_PRI          Use Primary I2C1 pins
+**
+**   Oscillator Selection:
+**     POSCMOD_EC           External clock
+**     POSCMOD_XT           XT oscillator
+**     POSCMOD__S           HS oscillator
+**     POSCMOD_NONE         Primary disabled
+**
+*/
+
+/* Register CONFIG1 (0xabfe)                               */
+
+
+/*
+** Only one invocation of CONFIG1 should appear in a project,
+** at the top of a C source file (outside of any function).
+**
+** The following constants can be used to set CONFIG1.
+** Multiple options may be combined, as shown:
+**
+** _CONFIG1( OPT1_ON & OPT2_OFF & OPT3_PLL )
+**
+**   JTAG:
+**     JTAGEN_OFF           Disabled
+**     JTAGEN_ON            Enabled
+**
+**   Code Protect:
+**     GCP_ON               Enabled
+**     GCP_OFF              Disabled
+**
+**   Write Protect:
+**     GWRP_ON              Enabled
+**     GWRP_OFF             Disabled
+**
+**   Background Debugger:
+**     BKBUG_ON             Enabled
+**     BKBUG_OFF            Disabled
+**
+**   Clip-on Emulation mode:
+**     COE_ON               Enabled
+**     COE_OFF              Disabled
+**
+**   ICD pins select:
+**     ICS_PGx3             EMUC/EMUD share PGC3/PGD3
+**     ICS_PGx2             EMUC/EMUD share PGC2/PGD2
+**     ICS_PGx1             EMUC/EMUD share PGC1/PGD1
+**
+**   Watchdog Timer:
+**     FWDTEN_OFF           Disabled
+**     FWDTEN_ON            Enabled
+**
+**   Windowed WDT:
+**     WINDIS_ON            Enabled
+**     WINDIS_OFF           Disabled
+**
+**   Watchdog prescaler:
+**     FWPSA_PR32           1:32
+**     FWPSA_PR128          1:128
+**
+**   Watchdog postscale:
+**     WDTPS_PS1            1:1
+**     WDTPS_PS2            1:2
+**     WDTPS_PS4            1:4
+**     WDTPS_PS8            1:8
+**     WDTPS_PS16           1:16
+**     WDTPS_PS32           1:32
+**     WDTPS_PS64           1:64
+**     WDTPS_PS128          1:128
+**     WDTPS_PS256          1:256
+**     WDTPS_PS512          1:512
+**     WDTPS_PS1024         1:1,024
+**     WDTPS_PS2048         1:2,048
+**     WDTPS_PS4096         1:4,096
+**     WDTPS_PS8192         1:8,192
+**     WDTPS_PS16384        1:16,384
+**     WDTPS_PS32768        1:32,768
+**
+*/
+
+#elif defined(__PIC24GB00x__)		//for pic24gb00x
+
+
+
+_CONFIG1(
+	WDTPS_PS32768 &			//1:32,768
+	FWPSA_PR128 &			//1:128
+	WINDIS_OFF &			//Standard Watchdog Timer is enabled
+	FWDTEN_OFF &			//Watchdog Timer is disabled
+	ICS_PGx1 &				//Emulator functions are shared with PGEC1/PGED1
+	GWRP_OFF &				//Writes to program memory are disabled
+	GCP_OFF	&				//Code protection is disabled
+	JTAGEN_OFF				//JTAG port is Disabled
+)
+
+_CONFIG2(
+	FNOSC_FRC &				//Primary Oscillator: FRC, FRCPLL, PRI, PRIPLL, SOSC, LPRC, FRCDIV
+	POSCMOD_HS &			//HS Oscillator mode selected: HS, XT, EC and NONE
+	I2C1SEL_PRI &			//Use default SCL1/SDA1 pins for I2C1
+	IOL1WAY_OFF &			//The IOLOCK bit can be set and cleared using the unlock sequence
+	OSCIOFNC_OFF &			//OSCO pin functions as clock output (CLKO)
+	FCKSM_CSDCMD &			//Sw Disabled, Mon Disabled
+	PLL96MHZ_ON &			//96 MHz PLL Startup is enabled automatically on start-up
+	PLLDIV_DIV12 &			//Oscillator input divided by 12 (48 MHz input)
+	IESO_OFF			//IESO mode (Two-Speed Start-up) disabled
+)
+
+_CONFIG3(
+	WPFP_WPFP63 &			//Highest Page (same as page 42)
+	SOSCSEL_IO &			//SOSC pins have digital I/O functions (RA4, RB4)
+	WUTSEL_LEG &			//Default regulator start-up time used
+	WPDIS_WPDIS &			//Segmented code protection disabled
+	WPCFG_WPCFGDIS &		//Last page and Flash Configuration words are unprotected
+	WPEND_WPSTARTMEM		//Write Protect from page 0 to WPFP
+)
+
+_CONFIG4(
+	DSWDTPS_DSWDTPSF &		//1:2,147,483,648 (25.7 days)
+	DSWDTOSC_SOSC &			//DSWDT uses Secondary Oscillator (SOSC)
+	RTCOSC_LPRC &			//RTCC uses Low Power RC Oscillator (LPRC)
+	DSBOREN_OFF &			//BOR disabled in Deep Sleep
+	DSWDTEN_OFF			//DSWDT disabled
+)
+/* -------------------------------------------------------- */
+/* Macros for setting device configuration registers        */
+/* -------------------------------------------------------- */
+
+/* Register CONFIG4 (0xabf8)                               */
+
+/*
+** Only one invocation of CONFIG4 should appear in a project,
+** at the top of a C source file (outside of any function).
+**
+** The following constants can be used to set CONFIG4.
+** Multiple options may be combined, as shown:
+**
+** _CONFIG4( OPT1_ON & OPT2_OFF & OPT3_PLL )
+**
+**   DSWDT Postscale Select:
+**     DSWDTPS_DSWDTPS0     1:2 (2.1 ms)
+**     DSWDTPS_DSWDTPS1     1:8 (8.3 ms)
+**     DSWDTPS_DSWDTPS2     1:32 (33 ms)
+**     DSWDTPS_DSWDTPS3     1:128 (132 ms)
+**     DSWDTPS_DSWDTPS4     1:512 (528 ms)
+**     DSWDTPS_DSWDTPS5     1:2,048 (2.1 seconds)
+**     DSWDTPS_DSWDTPS6     1:8,192 (8.5 seconds)
+**     DSWDTPS_DSWDTPS7     1:32,768 (34 seconds)
+**     DSWDTPS_DSWDTPS8     1:131,072 (135 seconds)
+**     DSWDTPS_DSWDTPS9     1:524,288 (9 minutes)
+**     DSWDTPS_DSWDTPSA     1:2,097,152 (36 minutes)
+**     DSWDTPS_DSWDTPSB     1:8,388,608 (2.4 hours)
+**     DSWDTPS_DSWDTPSC     1:33,554,432 (9.6 hours)
+**     DSWDTPS_DSWDTPSD     1:134,217,728 (38.5 hours)
+**     DSWDTPS_DSWDTPSE     1:536,870,912 (6.4 days)
+**     DSWDTPS_DSWDTPSF     1:2,147,483,648 (25.7 days)
+**
+**   Deep Sleep Watchdog Timer Oscillator Select:
+**     DSWDTOSC_SOSC        DSWDT uses Secondary Oscillator (SOSC)
+**     DSWDTOSC_LPRC        DSWDT uses Low Power RC Oscillator (LPRC)
+**
+**   RTCC Reference Oscillator  Select:
+**     RTCOSC_LPRC          RTCC uses Low Power RC Oscillator (LPRC)
+**     RTCOSC_SOSC          RTCC uses Secondary Oscillator (SOSC)
+**
+**   Deep Sleep BOR Enable bit:
+**     DSBOREN_OFF          BOR disabled in Deep Sleep
+**     DSBOREN_ON           BOR enabled in Deep Sleep
+**
+**   Deep Sleep Watchdog Timer:
+**     DSWDTEN_OFF          DSWDT disabled
+**     DSWDTEN_ON           DSWDT enabled
+**
+*/
+
+/* Register CONFIG3 (0xabfa)                               */
+
+/*
+** Only one invocation of CONFIG3 should appear in a project,
+** at the top of a C source file (outside of any function).
+**
+** The following constants can be used to set CONFIG3.
+** Multiple options may be combined, as shown:
+**
+** _CONFIG3( OPT1_ON & OPT2_OFF & OPT3_PLL )
+**
+**   Write Protection Flash Page Segment Boundary:
+**     WPFP_WPFP0           Page 0 (0x0)
+**     WPFP_WPFP1           Page 1 (0x400)
+**     WPFP_WPFP2           Page 2 (0x800)
+**     WPFP_WPFP3           Page 3 (0xC00)
+**     WPFP_WPFP4           Page 4 (0x1000)
+**     WPFP_WPFP5           Page 5 (0x1400)
+**     WPFP_WPFP6           Page 6 (0x1800)
+**     WPFP_WPFP7           Page 7 (0x1C00)
+**     WPFP_WPFP8           Page 8 (0x2000)
+**     WPFP_WPFP9           Page 9 (0x2400)
+**     WPFP_WPFP10          Page 10 (0x2800)
+**     WPFP_WPFP11          Page 11 (0x2C00)
+**     WPFP_WPFP12          Page 12 (0x3000)
+**     WPFP_WPFP13          Page 13 (0x3400)
+**     WPFP_WPFP14          Page 14 (0x3800)
+**     WPFP_WPFP15          Page 15 (0x3C00)
+**     WPFP_WPFP16          Page 16 (0x4000)
+**     WPFP_WPFP17          Page 17 (0x4400)
+**     WPFP_WPFP18          Page 18 (0x4800)
+**     WPFP_WPFP19          Page 19 (0x4C00)
+**     WPFP_WPFP20          Page 20 (0x5000)
+**     WPFP_WPFP21          Page 21 (0x5400)
+**     WPFP_WPFP22          Page 22 (0x5800)
+**     WPFP_WPFP23          Page 23 (0x5C00)
+**     WPFP_WPFP24          Page 24 (0x6000)
+**     WPFP_WPFP25          Page 25 (0x6400)
+**     WPFP_WPFP26          Page 26 (0x6800)
+**     WPFP_WPFP27          Page 27 (0x6C00)
+**     WPFP_WPFP28          Page 28 (0x7000)
+**     WPFP_WPFP29          Page 29 (0x7400)
+**     WPFP_WPFP30          Page 30 (0x7800)
+**     WPFP_WPFP31          Page 31 (0x7C00)
+**     WPFP_WPFP32          Page 32 (0x8000)
+**     WPFP_WPFP33          Page 33 (0x8400)
+**     WPFP_WPFP34          Page 34 (0x8800)
+**     WPFP_WPFP35          Page 35 (0x8C00)
+**     WPFP_WPFP36          Page 36 (0x9000)
+**     WPFP_WPFP37          Page 37 (0x9400)
+**     WPFP_WPFP38          Page 38 (0x9800)
+**     WPFP_WPFP39          Page 39 (0x9C00)
+**     WPFP_WPFP40          Page 40 (0xA000)
+**     WPFP_WPFP41          Page 41 (0xA400)
+**     WPFP_WPFP42          Page 42 (0xA800)
+**     WPFP_WPFP63          Highest Page (same as page 42)
+**
+**   Secondary Oscillator Pin Mode Select:
+**     SOSCSEL_IO           SOSC pins have digital I/O functions (RA4, RB4)
+**     SOSCSEL_LPSOSC       SOSC pins in Low-Power (low drive-strength) Oscillator Mode
+**     SOSCSEL_SOSC         SOSC pins in Default (high drive-strength) Oscillator Mode
+**
+**   Voltage Regulator Wake-up Time Select:
+**     WUTSEL_FST           Fast regulator start-up time used
+**     WUTSEL_LEG           Default regulator start-up time used
+**
+**   Segment Write Protection Disable:
+**     WPDIS_WPEN           Segmented code protection enabled
+**     WPDIS_WPDIS          Segmented code protection disabled
+**
+**   Write Protect Configuration Page Select:
+**     WPCFG_WPCFGEN        Last page and Flash Configuration words are code-protected
+**     WPCFG_WPCFGDIS       Last page and Flash Configuration words are unprotected
+**
+**   Segment Write Protection End Page Select:
+**     WPEND_WPSTARTMEM     Write Protect from page 0 to WPFP
+**     WPEND_WPENDMEM       Write Protect from WPFP to the last page of memory
+**
+*/
+
+/* Register CONFIG2 (0xabfc)                               */
+/*
+** Only one invocation of CONFIG2 should appear in a project,
+** at the top of a C source file (outside of any function).
+**
+** The following constants can be used to set CONFIG2.
+** Multiple options may be combined, as shown:
+**
+** _CONFIG2( OPT1_ON & OPT2_OFF & OPT3_PLL )
+**
+**   Primary Oscillator Select:
+**     POSCMOD_EC           EC Oscillator mode selected
+**     POSCMOD_XT           XT Oscillator mode selected
+**     POSCMOD_HS           HS Oscillator mode selected
+**     POSCMOD_NONE         Primary Oscillator disabled
+**
+**   I2C1 Pin Select bit:
+**     I2C1SEL_SEC          Use alternate SCL1/SDA1 pins for I2C1
+**     I2C1SEL_PRI          Use default SCL1/SDA1 pins for I2C1
+**
+**   IOLOCK One-Way Set Enable:
+**     IOL1WAY_OFF          The IOLOCK bit can be set and cleared using the unlock sequence
+**     IOL1WAY_ON           Once set, the IOLOCK bit cannot be cleared
+**
+**   OSCO Pin Configuration:
+**     OSCIOFNC_ON          OSCO pin functions as port I/O (RA3)
+**     OSCIOFNC_OFF         OSCO pin functions as clock output (CLKO)
+**
+**   Clock Switching and Fail-Safe Clock Monitor:
+**     FCKSM_CSECME         Sw Enabled, Mon Enabled
+**     FCKSM_CSECMD         Sw Enabled, Mon Disabled
+**     FCKSM_CSDCMD         Sw Disabled, Mon Disabled
+**
+**   Initial Oscillator Select:
+**     FNOSC_FRC            Fast RC Oscillator (FRC)
+**     FNOSC_FRCPLL         Fast RC Oscillator with Postscaler and PLL module (FRCPLL)
+**     FNOSC_PRI            Primary Oscillator (XT, HS, EC)
+**     FNOSC_PRIPLL         Primary Oscillator with PLL module (XTPLL, HSPLL, ECPLL)
+**     FNOSC_SOSC           Secondary Oscillator (SOSC)
+**     FNOSC_LPRC           Low-Power RC Oscillator (LPRC)
+**     FNOSC_FRCDIV         Fast RC Oscillator with Postscaler (FRCDIV)
+**
+**   96MHz PLL Startup Select:
+**     PLL96MHZ_OFF         96 MHz PLL Startup is enabled by user in software( controlled with the PLLEN bit)
+**     PLL96MHZ_ON          96 MHz PLL Startup is enabled automatically on start-up
+**
+**   USB 96 MHz PLL Prescaler Select:
+**     PLLDIV_NODIV         Oscillator input used directly (4 MHz input)
+**     PLLDIV_DIV2          Oscillator input divided by 2 (8 MHz input)
+**     PLLDIV_DIV3          Oscillator input divided by 3 (12 MHz input)
+**     PLLDIV_DIV4          Oscillator input divided by 4 (16 MHz input)
+**     PLLDIV_DIV5          Oscillator input divided by 5 (20 MHz input)
+**     PLLDIV_DIV6          Oscillator input divided by 6 (24 MHz input)
+**     PLLDIV_DIV8          Oscillator input divided by 8 (32 MHz input)
+**     PLLDIV_DIV12         Oscillator input divided by 12 (48 MHz input)
+**
+**   Internal External Switchover:
+**     IESO_OFF             IESO mode (Two-Speed Start-up) disabled
+**     IESO_ON              IESO mode (Two-Speed Start-up) enabled
+**
+*/
+
+/* Register CONFIG1 (0xabfe)                               */
+/*
+** Only one invocation of CONFIG1 should appear in a project,
+** at the top of a C source file (outside of any function).
+**
+** The following constants can be used to set CONFIG1.
+** Multiple options may be combined, as shown:
+**
+** _CONFIG1( OPT1_ON & OPT2_OFF & OPT3_PLL )
+**
+**   Watchdog Timer Postscaler:
+**     WDTPS_PS1            1:1
+**     WDTPS_PS2            1:2
+**     WDTPS_PS4            1:4
+**     WDTPS_PS8            1:8
+**     WDTPS_PS16           1:16
+**     WDTPS_PS32           1:32
+**     WDTPS_PS64           1:64
+**     WDTPS_PS128          1:128
+**     WDTPS_PS256          1:256
+**     WDTPS_PS512          1:512
+**     WDTPS_PS1024         1:1,024
+**     WDTPS_PS2048         1:2,048
+**     WDTPS_PS4096         1:4,096
+**     WDTPS_PS8192         1:8,192
+**     WDTPS_PS16384        1:16,384
+**     WDTPS_PS32768        1:32,768
+**
+**   WDT Prescaler:
+**     FWPSA_PR32           1:32
+**     FWPSA_PR128          1:128
+**
+**   Windowed WDT:
+**     WINDIS_ON            Windowed Watchdof timer enabled
+**     WINDIS_OFF           Standard Watchdog Timer is enabled
+**
+**   Watchdog Timer:
+**     FWDTEN_OFF           Watchdog Timer is disabled
+**     FWDTEN_ON            Watchdog Timer is enabled
+**
+**   Emulator Pin Placement Select bits:
+**     ICS_PGx3             Emulator functions are shared with PGEC3/PGED3
+**     ICS_PGx2             Emulator functions are shared with PGEC2/PGED2
+**     ICS_PGx1             Emulator functions are shared with PGEC1/PGED1
+**
+**   General Segment Write Protect:
+**     GWRP_ON              Writes to program memory are allowed
+**     GWRP_OFF             Writes to program memory are disabled
+**
+**   General Segment Code Protect:
+**     GCP_ON               Code protection is enabled
+**     GCP_OFF              Code protection is disabled
+**
+**   JTAG Port Enable:
+**     JTAGEN_OFF           JTAG port is Disabled
+**     JTAGEN_ON            JTAG port is Enabled
+**
+*/
+
+#endif		//pic24gb00x
+#endif		//C30
+
+//global defines
+
+//global variables
+//declare pins
+//ALL PINS ARE MAPPED, WHETHER THEY EXIST OR NOT
+//SO MAKE SURE THAT THE PINS YOU PICKED ACTUALLY EXIST FOR YOUR PACKAGE
+//Pin  0.. 7 -> GPIOA
+//Pin  8..15 -> GPIOB
+const PIN2GPIO GPIO_PinDef[]= {
+	{GPIOA, 1<<0},						//PICduino Pin  0 = RP0/PB0/CHIP PIN4
+	{GPIOA, 1<<1},						//PICduino Pin  1 = RP1/PB1/CHIP PIN5
+	{GPIOA, 1<<2},						//PICduino Pin  2 = RP2/PB2/CHIP PIN6
+	{GPIOA, 1<<3},						//PICduino Pin  3 = RP3/PB3/CHIP PIN7
+	{GPIOA, 1<<4},						//PICduino Pin  4 = RP4/PB4/CHIP PIN11
+	{GPIOA, 1<<5},						//PICduino Pin  5 = RP5/PB5/CHIP PIN14
+	{GPIOA, 1<<6},						//PICduino Pin  6 = RP6/PB6/CHIP PIN15
+	{GPIOA, 1<<7},						//PICduino Pin  7 = RP7/PB7/CHIP PIN16
+	{GPIOA, 1<<8},						//PICduino Pin  8 = RP8/PB8/CHIP PIN17
+	{GPIOA, 1<<9},						//PICduino Pin  9 = RP9/PB9/CHIP PIN18
+	{GPIOA, 1<<10},						//PICduino Pin 10 = RP10/PB10/CHIP PIN21
+	{GPIOA, 1<<11},						//PICduino Pin 11 = RP11/PB11/CHIP PIN22
+	{GPIOA, 1<<12},						//PICduino Pin 12 = RP12/PB12/CHIP PIN23
+	{GPIOA, 1<<13},						//PICduino Pin 13 = RP13/PB13/CHIP PIN24
+	{GPIOA, 1<<14},						//PICduino Pin 14 = RP14/PB14/CHIP PIN25
+	{GPIOA, 1<<15},						//PICduino Pin 15 = RP15/PB15/CHIP PIN26
+
+	{GPIOB, 1<<0},						//PICduino Pin 16 = RP0/PB0/CHIP PIN4
+	{GPIOB, 1<<1},						//PICduino Pin 17 = RP1/PB1/CHIP PIN5
+	{GPIOB, 1<<2},						//PICduino Pin 18 = RP2/PB2/CHIP PIN6
+	{GPIOB, 1<<3},						//PICduino Pin 19 = RP3/PB3/CHIP PIN7
+	{GPIOB, 1<<4},						//PICduino Pin 20 = RP4/PB4/CHIP PIN11
+	{GPIOB, 1<<5},						//PICduino Pin 21 = RP5/PB5/CHIP PIN14
+	{GPIOB, 1<<6},						//PICduino Pin 22 = RP6/PB6/CHIP PIN15
+	{GPIOB, 1<<7},						//PICduino Pin 23 = RP7/PB7/CHIP PIN16
+	{GPIOB, 1<<8},						//PICduino Pin 24 = RP8/PB8/CHIP PIN17
+	{GPIOB, 1<<9},						//PICduino Pin 25 = RP9/PB9/CHIP PIN18
+	{GPIOB, 1<<10},						//PICduino Pin 26 = RP10/PB10/CHIP PIN21
+	{GPIOB, 1<<11},						//PICduino Pin 27 = RP11/PB11/CHIP PIN22
+	{GPIOB, 1<<12},						//PICduino Pin 28 = RP12/PB12/CHIP PIN23
+	{GPIOB, 1<<13},						//PICduino Pin 29 = RP13/PB13/CHIP PIN24
+	{GPIOB, 1<<14},						//PICduino Pin 30 = RP14/PB14/CHIP PIN25
+	{GPIOB, 1<<15},						//PICduino Pin 31 = RP15/PB15/CHIP PIN26
+
+#if defined(GPIOC)
+	{GPIOC, 1<<0},						//PICduino Pin 32 = RP0/PB0/CHIP PIN4
+	{GPIOC, 1<<1},						//PICduino Pin 33 = RP1/PB1/CHIP PIN5
+	{GPIOC, 1<<2},						//PICduino Pin 34 = RP2/PB2/CHIP PIN6
+	{GPIOC, 1<<3},						//PICduino Pin 35 = RP3/PB3/CHIP PIN7
+	{GPIOC, 1<<4},						//PICduino Pin 36 = RP4/PB4/CHIP PIN11
+	{GPIOC, 1<<5},						//PICduino Pin 37 = RP5/PB5/CHIP PIN14
+	{GPIOC, 1<<6},						//PICduino Pin 38 = RP6/PB6/CHIP PIN15
+	{GPIOC, 1<<7},						//PICduino Pin 39 = RP7/PB7/CHIP PIN16
+	{GPIOC, 1<<8},						//PICduino Pin 40 = RP8/PB8/CHIP PIN17
+	{GPIOC, 1<<9},						//PICduino Pin 41 = RP9/PB9/CHIP PIN18
+	{GPIOC, 1<<10},						//PICduino Pin 42 = RP10/PB10/CHIP PIN21
+	{GPIOC, 1<<11},						//PICduino Pin 43 = RP11/PB11/CHIP PIN22
+	{GPIOC, 1<<12},						//PICduino Pin 44 = RP12/PB12/CHIP PIN23
+	{GPIOC, 1<<13},						//PICduino Pin 45 = RP13/PB13/CHIP PIN24
+	{GPIOC, 1<<14},						//PICduino Pin 46 = RP14/PB14/CHIP PIN25
+	{GPIOC, 1<<15},						//PICduino Pin 47 = RP15/PB15/CHIP PIN26
+#endif	//GPIOC
+
+#if defined(GPIOD)
+	{GPIOD, 1<<0},						//PICduino Pin 32 = RP0/PB0/CHIP PIN4
+	{GPIOD, 1<<1},						//PICduino Pin 33 = RP1/PB1/CHIP PIN5
+	{GPIOD, 1<<2},						//PICduino Pin 34 = RP2/PB2/CHIP PIN6
+	{GPIOD, 1<<3},						//PICduino Pin 35 = RP3/PB3/CHIP PIN7
+	{GPIOD, 1<<4},						//PICduino Pin 36 = RP4/PB4/CHIP PIN11
+	{GPIOD, 1<<5},						//PICduino Pin 37 = RP5/PB5/CHIP PIN14
+	{GPIOD, 1<<6},						//PICduino Pin 38 = RP6/PB6/CHIP PIN15
+	{GPIOD, 1<<7},						//PICduino Pin 39 = RP7/PB7/CHIP PIN16
+	{GPIOD, 1<<8},						//PICduino Pin 40 = RP8/PB8/CHIP PIN17
+	{GPIOD, 1<<9},						//PICduino Pin 41 = RP9/PB9/CHIP PIN18
+	{GPIOD, 1<<10},						//PICduino Pin 42 = RP10/PB10/CHIP PIN21
+	{GPIOD, 1<<11},						//PICduino Pin 43 = RP11/PB11/CHIP PIN22
+	{GPIOD, 1<<12},						//PICduino Pin 44 = RP12/PB12/CHIP PIN23
+	{GPIOD, 1<<13},						//PICduino Pin 45 = RP13/PB13/CHIP PIN24
+	{GPIOD, 1<<14},						//PICduino Pin 46 = RP14/PB14/CHIP PIN25
+	{GPIOD, 1<<15},						//PICduino Pin 47 = RP15/PB15/CHIP PIN26
+#endif	//GPIOD
+
+#if defined(GPIOE)
+	{GPIOE, 1<<0},						//PICduino Pin 32 = RP0/PB0/CHIP PIN4
+	{GPIOE, 1<<1},						//PICduino Pin 33 = RP1/PB1/CHIP PIN5
+	{GPIOE, 1<<2},						//PICduino Pin 34 = RP2/PB2/CHIP PIN6
+	{GPIOE, 1<<3},						//PICduino Pin 35 = RP3/PB3/CHIP PIN7
+	{GPIOE, 1<<4},						//PICduino Pin 36 = RP4/PB4/CHIP PIN11
+	{GPIOE, 1<<5},						//PICduino Pin 37 = RP5/PB5/CHIP PIN14
+	{GPIOE, 1<<6},						//PICduino Pin 38 = RP6/PB6/CHIP PIN15
+	{GPIOE, 1<<7},						//PICduino Pin 39 = RP7/PB7/CHIP PIN16
+	{GPIOE, 1<<8},						//PICduino Pin 40 = RP8/PB8/CHIP PIN17
+	{GPIOE, 1<<9},						//PICduino Pin 41 = RP9/PB9/CHIP PIN18
+	{GPIOE, 1<<10},						//PICduino Pin 42 = RP10/PB10/CHIP PIN21
+	{GPIOE, 1<<11},						//PICduino Pin 43 = RP11/PB11/CHIP PIN22
+	{GPIOE, 1<<12},						//PICduino Pin 44 = RP12/PB12/CHIP PIN23
+	{GPIOE, 1<<13},						//PICduino Pin 45 = RP13/PB13/CHIP PIN24
+	{GPIOE, 1<<14},						//PICduino Pin 46 = RP14/PB14/CHIP PIN25
+	{GPIOE, 1<<15},						//PICduino Pin 47 = RP15/PB15/CHIP PIN26
+#endif	//GPIOE
+
+#if defined(GPIOF)
+	{GPIOF, 1<<0},						//PICduino Pin 32 = RP0/PB0/CHIP PIN4
+	{GPIOF, 1<<1},						//PICduino Pin 33 = RP1/PB1/CHIP PIN5
+	{GPIOF, 1<<2},						//PICduino Pin 34 = RP2/PB2/CHIP PIN6
+	{GPIOF, 1<<3},						//PICduino Pin 35 = RP3/PB3/CHIP PIN7
+	{GPIOF, 1<<4},						//PICduino Pin 36 = RP4/PB4/CHIP PIN11
+	{GPIOF, 1<<5},						//PICduino Pin 37 = RP5/PB5/CHIP PIN14
+	{GPIOF, 1<<6},						//PICduino Pin 38 = RP6/PB6/CHIP PIN15
+	{GPIOF, 1<<7},						//PICduino Pin 39 = RP7/PB7/CHIP PIN16
+	{GPIOF, 1<<8},						//PICduino Pin 40 = RP8/PB8/CHIP PIN17
+	{GPIOF, 1<<9},						//PICduino Pin 41 = RP9/PB9/CHIP PIN18
+	{GPIOF, 1<<10},						//PICduino Pin 42 = RP10/PB10/CHIP PIN21
+	{GPIOF, 1<<11},						//PICduino Pin 43 = RP11/PB11/CHIP PIN22
+	{GPIOF, 1<<12},						//PICduino Pin 44 = RP12/PB12/CHIP PIN23
+	{GPIOF, 1<<13},						//PICduino Pin 45 = RP13/PB13/CHIP PIN24
+	{GPIOF, 1<<14},						//PICduino Pin 46 = RP14/PB14/CHIP PIN25
+	{GPIOF, 1<<15},						//PICduino Pin 47 = RP15/PB15/CHIP PIN26
+#endif	//GPIOF
+
+#if defined(GPIOG)
+	{GPIOG, 1<<0},						//PICduino Pin 32 = RP0/PB0/CHIP PIN4
+	{GPIOG, 1<<1},						//PICduino Pin 33 = RP1/PB1/CHIP PIN5
+	{GPIOG, 1<<2},						//PICduino Pin 34 = RP2/PB2/CHIP PIN6
+	{GPIOG, 1<<3},						//PICduino Pin 35 = RP3/PB3/CHIP PIN7
+	{GPIOG, 1<<4},						//PICduino Pin 36 = RP4/PB4/CHIP PIN11
+	{GPIOG, 1<<5},						//PICduino Pin 37 = RP5/PB5/CHIP PIN14
+	{GPIOG, 1<<6},						//PICduino Pin 38 = RP6/PB6/CHIP PIN15
+	{GPIOG, 1<<7},						//PICduino Pin 39 = RP7/PB7/CHIP PIN16
+	{GPIOG, 1<<8},						//PICduino Pin 40 = RP8/PB8/CHIP PIN17
+	{GPIOG, 1<<9},						//PICduino Pin 41 = RP9/PB9/CHIP PIN18
+	{GPIOG, 1<<10},						//PICduino Pin 42 = RP10/PB10/CHIP PIN21
+	{GPIOG, 1<<11},						//PICduino Pin 43 = RP11/PB11/CHIP PIN22
+	{GPIOG, 1<<12},						//PICduino Pin 44 = RP12/PB12/CHIP PIN23
+	{GPIOG, 1<<13},						//PICduino Pin 45 = RP13/PB13/CHIP PIN24
+	{GPIOG, 1<<14},						//PICduino Pin 46 = RP14/PB14/CHIP PIN25
+	{GPIOG, 1<<15},						//PICduino Pin 47 = RP15/PB15/CHIP PIN26
+#endif	//GPIOG
+
+};
+
+//set up core timer
+//global variables
+uint32_t SystemCoreClock=F_FRC;			//system core clock, before devided by 2. Updated by SystemCoreClockUpdate()
+
+//for time base off TIMER1 @ 1:1 prescaler
+//volatile uint32_t timer1_millis = 0;
+volatile uint32_t SysTick = 0;
+static volatile uint16_t _tb_hi=0;				//SysTick wraps: bits 48..63 of ticks64()
+static uint64_t _tb_t0=0, _tb_us0=0;			//epoch: ticks64() and micros64() at its start. moved on by _tb_rebase()
+static uint32_t _tb_ms0=0, _tb_msr=0;			//millis() at the epoch, and the ticks into that ms already gone
+static uint32_t _tb_rate=1;						//F_PHB since the epoch
+static uint32_t _tb_usk=0, _tb_msk=0;			//ticks -> us / ms: (dt * k) >> sh, k in [2^31, 2^32)
+static uint8_t _tb_ussh=0, _tb_mssh=0;
+static uint32_t _tb_span=0x80000000ul;			//rebase the epoch once it is this many ticks old: keeps dt and the results in 32 bits
+#if defined(SYSTICK_TMR1)
+#error "the timebase (ticks64(), micros(), millis()) extends tmr2: run systick on tmr2"
+#endif
+static void _tb_epoch(uint64_t now);
+#if defined(ISR_PROFILE)
+//per-vector execution time, first to last statement, in TMR2 ticks
+static volatile uint16_t _isr_min[IRQ_CNT], _isr_max[IRQ_CNT];
+#define ISR_ENTER()				uint16_t _isr_t0 = TMR2
+#define ISR_EXIT(irq)			do {uint16_t _isr_dt = TMR2 - _isr_t0; \
+									if ((_isr_dt < _isr_min[irq]) || (_isr_max[irq] == 0)) _isr_min[irq] = _isr_dt; \
+									if (_isr_dt > _isr_max[irq]) _isr_max[irq] = _isr_dt;} while (0)
+#else
+#define ISR_ENTER()
+#define ISR_EXIT(irq)
+#endif
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+static uint16_t _ds_wake=0;						//DSWAKE at boot, 0->not a deep sleep wake
+static uint32_t _ds_state=0;					//DSGPR1:DSGPR0 at boot
+#endif
+//static uint16_t timer1_fract = 0;
+//111 = Fast RC Oscillator with Postscaler (FRCDIV)
+//110 = Reserved
+//101 = Low-Power RC Oscillator (LPRC)
+//100 = Secondary Oscillator (SOSC)
+//011 = Primary Oscillator with PLL module (XTPLL, HSPLL, ECPLL)
+//010 = Primary Oscillator (XT, HS, EC)
+//001 = Fast RC Oscillator with Postscaler and PLL module (FRCPLL)
+//000 = Fast RC Oscillator (FRC)
+//Needs to be executed during mcu initialization or after oscillator reconfiguration
+//updates SystemCoreClock.
+uint32_t SystemCoreClockUpdate(void) {
+	uint32_t tmp=F_FRC;
+
+	//test for current oscillator configuration
+	switch (OSCCONbits.COSC) {
+	case 0b111:
+		tmp = (F_FRC >> CLKDIVbits.RCDIV);
+		break;
+	case 0b110:
+		break;
+	case 0b101:
+		tmp = F_LPRC;
+		break;
+	case 0b100:
+		tmp = F_SOSC;
+		break;
+	case 0b011:
+		tmp = F_XTAL * 4;
+		break;
+	case 0b010:
+		tmp = F_XTAL;
+		break;
+	case 0b001:
+		tmp = (F_FRC >> CLKDIVbits.RCDIV) * 4;
+		break;
+	case 0b000:
+		tmp = F_FRC;
+		break;
+	}
+	return SystemCoreClock=tmp;
+}
+
+//timer1 overflow isr
+//void _ISR_PSV _T2Interrupt(void) {
+//	IFS0bits.T2IF=0;							//clear tmr1 interrupt flag
+//	SysTick+=0x10000ul;							//increment overflow count: 16-bit timer
+//}
+
+//reset the mcu
+void mcuInit(void) {
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	//deep sleep wake: pick up the reason and the state before anything else. the pins stay latched
+	if (RCONbits.DPSLP) {
+		_ds_wake = DSWAKE;						//wake-up reason
+		_ds_state = ((uint32_t) DSGPR1 << 16) | DSGPR0;
+		DSWAKE = 0;
+		RCONbits.DPSLP = 0;
+		if (_ds_wake == 0) _ds_wake = DS_MCLR;	//flags lost: count it as a plain wake
+	}
+#endif
+
+	//set poster scaler for FRC (default 2:1), for FRCDIV
+	CLKDIVbits.RCDIV=1;							//rc divider (0..7->1:1..128:1): 0->1:1, 1->2:1 (default), 2->4:1, 3=8:1, ...
+
+	//turn off all peripherals
+	PMD1=0xffff;
+	PMD2=0xffff;
+	PMD3=0xffff;
+//#if defined(PMD4)		- only on GA102/GB002
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined(__PIC24FJ32GA102__) | \
+			defined(__PIC24FJ64GA104__) | defined(__PIC24FJ32GA104__) | \
+			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+	PMD4=0xffff;
+#endif
+
+	//all pins digital
+	AD1PCFG = 0xffff;							//1->all pins digital
+
+#if defined(SYSTICK_TMR1)						//Systick running on tmr1
+	//initialize tmr1 for tick/pwm generation - do not stop this
+	PMD1bits.T1MD = 0;							//0->enable the peripheral, 1->disable the peripheral
+	T1CON = 0x0000;                 			//stop timer
+	T1CONbits.TCKPS = 0;						//set the prescaler: 0->1:1, 1->8:1, 2->64:1, 3->256:1
+	T1CONbits.TCS = 0;             				//use internal instruction clock from F_PHB
+	T1CONbits.TGATE = 0;            			//no gating
+	//T1CONbits.T32 = 0;							//0->16 bit mode, 1->32 bit mode
+	TMR1 = 0;									//initialize the timer2 counter
+	PR1 = PWM_PR;								//set pwm period
+	IFS0bits.T1IF = 0;							//reset the flag
+	irqApply(IRQ_T1);
+	//IPC0bits.T2IS = TxIS_DEFAULT;
+	IEC0bits.T1IE = 1;							//0->disable tmr2 isr, 1->enable tmr2 isr
+	T1CONbits.TON = 1;             				//turn on the timer
+#else											//systick running on tmr2
+	//initialize tmr2 for tick/pwm generation - do not stop this
+	PMD1bits.T2MD = 0;							//0->enable the peripheral, 1->disable the peripheral
+	T2CON = 0x0000;                 			//stop timer
+	T2CONbits.TCKPS = 0;						//set the prescaler: 0->1:1, 1->8:1, 2->64:1, 3->256:1
+	T2CONbits.TCS = 0;             				//use internal instruction clock from F_PHB
+	T2CONbits.TGATE = 0;            			//no gating
+	T2CONbits.T32 = 0;							//0->16 bit mode, 1->32 bit mode
+	TMR2 = 0;									//initialize the timer2 counter
+	PR2 = PWM_PR;								//set pwm period
+	IFS0bits.T2IF = 0;							//reset the flag
+	irqApply(IRQ_T2);
+	//IPC1bits.T2IS = TxIS_DEFAULT;
+	IEC0bits.T2IE = 1;							//0->disable tmr2 isr, 1->enable tmr2 isr
+	T2CONbits.TON = 1;             				//turn on the timer
+#endif		//systick on tmr1 or tmr2
+
+	//update SystemCoreClock
+	SystemCoreClockUpdate();					//update system core clock
+	_tb_epoch(0);								//timebase rate
+
+	//enable global interrupts
+	ei();										//testing
+
+}
+
+//empty interrupt handler
+void empty_handler(void) {
+	//do nothing here
+}
+
+//C main loop
+#ifndef USE_MAIN
+int main(void) {
+
+	mcuInit();						//reset the mcu
+#if defined(DS_RESUME) && (defined(__PIC24GA10x__) | defined(__PIC24GB00x__))
+	if (dsWake()) DS_RESUME();		//deep sleep wake: restore from dsState()
+	else
+#endif
+	setup();						//run the setup code
+	while (1) {
+		taskRun();					//run the tasks that are due
+		loop();						//run the default loop
+	}
+}
+#endif	//use_main
+
+//Arduino Functions: GPIO
+//set a pin mode to INPUT or OUTPUT
+//no error checking on PIN
+inline void pinMode(PIN_TypeDef pin, uint8_t mode) {
+	if (mode==INPUT) GIO_IN(GPIO_PinDef[pin].gpio, GPIO_PinDef[pin].mask);
+	else GIO_OUT(GPIO_PinDef[pin].gpio, GPIO_PinDef[pin].mask);
+}
+
+//set / clear a pin
+inline void digitalWrite(PIN_TypeDef pin, uint8_t val) {
+	if (val==LOW) GIO_CLR(GPIO_PinDef[pin].gpio, GPIO_PinDef[pin].mask);
+	else GIO_SET(GPIO_PinDef[pin].gpio, GPIO_PinDef[pin].mask);
+}
+
+//read a pin
+inline int digitalRead(PIN_TypeDef pin) {
+	return (GIO_GET(GPIO_PinDef[pin].gpio, GPIO_PinDef[pin].mask))?HIGH:LOW;
+}
+//end GPIO
+
+//ticks()
+//Arduino Functions: Time
+//return timer ticks
+uint32_t ticks(void) {
+	uint32_t m;					//stores overflow count
+	uint16_t f;					//return the fractions / TMR1 value
+
+	//use double reads
+	do {
+		m = SysTick;
+		f = TMR2;
+	} while (m != SysTick);
+	//now m and f are consistent
+	return (m | f);
+}
+
+//ticks() extended to 64 bits
+//read at ipl 7: a tmr2 overflow still pending is counted here, never half-counted by an isr running mid-read
+uint64_t ticks64(void) {
+	uint16_t h, f;
+	uint32_t m;
+	uint8_t ipl;
+
+	critEnter(ipl);
+	h = _tb_hi;
+	m = SysTick;
+	f = TMR2;
+	if (IFS0bits.T2IF && (f < 0x8000)) {		//overflow not yet counted
+		m += 0x10000ul;
+		if (m == 0) h++;
+	}
+	critExit(ipl);
+	return ((uint64_t) h << 32) | m | f;
+}
+
+//(dt * k) >> sh from four 16x16 hardware multiplies. the result fits 32 bits for dt < _tb_span
+static uint32_t _tb_conv(uint32_t dt, uint32_t k, uint8_t sh) {
+	uint64_t p;
+
+	p = ((uint64_t) __builtin_muluu((uint16_t) (dt >> 16), (uint16_t) (k >> 16)) << 32) +
+		((uint64_t) __builtin_muluu((uint16_t) (dt >> 16), (uint16_t) k) << 16) +
+		((uint64_t) __builtin_muluu((uint16_t) dt, (uint16_t) (k >> 16)) << 16) +
+		__builtin_muluu((uint16_t) dt, (uint16_t) k);
+	return (sh >= 32)?((uint32_t) (p >> 32) >> (sh - 32)):(uint32_t) (p >> sh);
+}
+
+//k and sh for ticks -> units at per_s units/s: k = (per_s << sh) / F_PHB, in [2^31, 2^32)
+static void _tb_q(uint32_t per_s, uint32_t *k, uint8_t *sh) {
+	uint8_t s=0;
+
+	while ((s < 42) && ((((uint64_t) per_s << (s + 1)) / F_PHB) <= 0xfffffffful)) s++;
+	*sh = s;
+	*k = ((uint64_t) per_s << s) / F_PHB;
+}
+
+//ticks() at ipl 7: count in a pending tmr2 overflow
+static uint32_t _tb_now(void) {
+	uint32_t m = SysTick;
+	uint16_t f = TMR2;
+
+	if (IFS0bits.T2IF && (f < 0x8000)) m += 0x10000ul;
+	return m | f;
+}
+
+//move the epoch to ticks64() t, micros64() us: the slow divisions happen here only
+//they run at the caller's ipl. only the swap is at ipl 7, so readers see the old epoch or the new one
+static void _tb_rebase(uint64_t t, uint64_t us) {
+	uint32_t ms0 = us / 1000, msr = ((us % 1000) * _tb_rate) / 1000000ul;
+	uint8_t ipl;
+
+	critEnter(ipl);
+	_tb_t0 = t;
+	_tb_us0 = us;
+	_tb_ms0 = ms0;
+	_tb_msr = msr;
+	critExit(ipl);
+}
+
+//microseconds since reset, continuous across F_PHB changes
+uint64_t micros64(void) {
+	uint64_t us0;
+	uint32_t dt;
+	uint8_t ipl;
+
+	critEnter(ipl);
+	dt = _tb_now() - (uint32_t) _tb_t0;
+	us0 = _tb_us0;
+	critExit(ipl);
+	return us0 + _tb_conv(dt, _tb_usk, _tb_ussh);
+}
+
+//microseconds since reset, modulo 2^32
+uint32_t micros(void) {
+	uint32_t dt, us0;
+	uint8_t ipl;
+
+	critEnter(ipl);
+	dt = _tb_now() - (uint32_t) _tb_t0;
+	us0 = _tb_us0;
+	critExit(ipl);
+	return us0 + _tb_conv(dt, _tb_usk, _tb_ussh);
+}
+
+//milliseconds since reset, modulo 2^32
+uint32_t millis(void) {
+	uint32_t dt, ms0;
+	uint8_t ipl;
+
+	critEnter(ipl);
+	dt = _tb_now() - (uint32_t) _tb_t0 + _tb_msr;
+	ms0 = _tb_ms0;
+	critExit(ipl);
+	return ms0 + _tb_conv(dt, _tb_msk, _tb_mssh);
+}
+
+//start a new epoch at the current F_PHB: call with interrupts held off, right after F_PHB changed
+//now: micros64() just before the change
+static void _tb_epoch(uint64_t now) {
+	uint64_t span;
+
+	_tb_rate = F_PHB;
+	_tb_q(1000000ul, &_tb_usk, &_tb_ussh);
+	_tb_q(1000, &_tb_msk, &_tb_mssh);
+	span = ((uint64_t) 1 << 31) * _tb_rate / 1000000ul;	//2^31 us, in ticks
+	_tb_span = (span < 0x80000000ul)?span:0x80000000ul;
+	_tb_rebase(ticks64(), now);
+}
+
+//background work
+static void (*_yield_hook[YIELD_CNT])(void);
+static uint8_t _yield_cnt=0;					//hooks attached
+static uint8_t _yield_busy=0;					//1->hooks running
+
+//add a hook
+//return 0 if full
+uint8_t yieldAttach(void (*func)(void)) {
+	if (_yield_cnt >= YIELD_CNT) return 0;
+	_yield_hook[_yield_cnt++] = func;
+	return 1;
+}
+
+//remove a hook
+void yieldDetach(void (*func)(void)) {
+	uint8_t i;
+
+	for (i = 0; i < _yield_cnt; i++)
+		if (_yield_hook[i] == func) {
+			_yield_hook[i] = _yield_hook[--_yield_cnt];	//move the last one in
+			break;
+		}
+}
+
+//run the hooks once
+//not from isrs or critical sections (ipl > 0), nor from a wait inside a hook
+void yield(void) {
+	uint8_t i;
+
+	if (_yield_busy || SRbits.IPL) return;
+	_yield_busy = 1;
+	for (i = 0; i < _yield_cnt; i++) _yield_hook[i]();
+	_yield_busy = 0;
+}
+
+//one pass of a wait until due: run the hooks, or idle with none attached
+//idle in steps of IDLE_MAX at most, spin through the last YIELD_IDLE_MIN ticks
+static void _yield_wait(uint32_t due) {
+#if defined(YIELD_IDLE) && !defined(USE_KERNEL) && !defined(SYSTICK_TMR1)
+	uint32_t now, left;
+
+	if ((_yield_cnt == 0) && !_yield_busy && !SRbits.IPL) {
+		now = ticks(); left = due - now;
+		if ((int32_t) left < (int32_t) YIELD_IDLE_MIN) return;	//short or already due: spin
+		idleUntil((left > IDLE_MAX)?(now + IDLE_MAX):due);
+		return;
+	}
+#endif
+	yield();
+}
+
+//delay millisseconds
+void delay(uint32_t ms) {
+	uint32_t start_time = ticks();
+	ms *= cyclesPerMillisecond();
+	while (ticks() - start_time < ms) _yield_wait(start_time + ms);
+}
+
+//delay micros seconds
+void delayMicroseconds(uint32_t us) {
+	uint32_t start_time = ticks();
+	us *= cyclesPerMicrosecond();
+	while (ticks() - start_time < us) _yield_wait(start_time + us);
+}
+//end Time
+
+//uart1
+static uint32_t _u1_baud=0, _u2_baud=0;			//baud rates, for uartRebaud()
+
+//initialize usart: high baudrate (brgh=1), 16-bit baudrate (brg16=1)
+//baudrate=Fxtal/(4*(spbrg+1))
+//spbrg=(Fxtal/4/baudrate)-1
+//tx/rx pins to be assumed in gpio mode
+//data bits: 	8
+//parity: 		none
+//stop bits: 	1
+//Xon/Xoff:		none
+void uart1Init(unsigned long baud_rate) {
+	//enable the pins
+#if defined(U1RX2RP)
+	U1RX2RP();					//PPS_U1RX_TO_RP(U1RX_RP);
+#endif
+
+#if defined(U1TX2RP)
+	U1TX2RP();					//PPS_U1TX_TO_RP();
+#endif
+
+
+	//disable md bits
+	PMD1bits.U1MD = 0;				//power up the module
+	irqApply(IRQ_U1RX); irqApply(IRQ_U1TX);	//set the interrupt priorities
+
+	//U2MODEbits register
+	//bit 15 UARTEN: UARTx Enable bit(1)
+	//1 = UARTx is enabled; all UARTx pins are controlled by UARTx as defined by UEN<1:0>
+	//0 = UARTx is disabled; all UARTx pins are controlled by PORT latches; UARTx power consumption is	minimal
+	U1MODEbits.UARTEN=1;	//enable the uart module
+	//bit 14 Unimplemented: Read as `0'
+	//bit 13 USIDL: Stop in Idle Mode bit
+	//1 = Discontinue module operation when device enters Idle mode
+	//0 = Continue module operation in Idle mode
+	//bit 12 IREN: IrDAr Encoder and Decoder Enable bit(2)
+	//1 = IrDA encoder and decoder enabled
+	//0 = IrDA encoder and decoder disabled
+	U1MODEbits.IREN = 0;		//disable irda
+	U1MODEbits.RTSMD = 0;		//1=in simplex mode. 0 = no flow control
+	//bit 11 RTSMD: Mode Selection for UxRTS Pin bit
+	//1 = UxRTS pin in Simplex mode
+	//0 = UxRTS pin in Flow Control mode
+	//bit 10 Unimplemented: Read as `0'
+	//bit 9-8 UEN1:UEN0: UARTx Enable bits(3)
+	//11 = UxTX, UxRX and BCLKx pins are enabled and used; UxCTS pin controlled by PORT latches
+	//10 = UxTX, UxRX, UxCTS and UxRTS pins are enabled and used
+	//01 = UxTX, UxRX and UxRTS pins are enabled and used; UxCTS pin controlled by PORT latches
+	//00 = UxTX and UxRX pins are enabled and used; UxCTS and UxRTS/BCLKx pins controlled by PORT latches
+	U1MODEbits.UEN1=0, U2MODEbits.UEN0=0;
+	//bit 7 WAKE: Wake-up on Start Bit Detect During Sleep Mode Enable bit
+	//1 = UARTx will continue to sample the UxRX pin; interrupt generated on falling edge, bit cleared in hardware on following rising edge
+	//0 = No wake-up enabled
+	U1MODEbits.WAKE = 0;
+	//bit 6 LPBACK: UARTx Loopback Mode Select bit
+	//1 = Enable Loopback mode
+	//0 = Loopback mode is disabled
+	U1MODEbits.LPBACK = 0;
+	//bit 5 ABAUD: Auto-Baud Enable bit
+	//1 = Enable baud rate measurement on the next character - requires reception of a Sync field (55h); cleared in hardware upon completion
+	//0 = Baud rate measurement disabled or completed
+	U1MODEbits.ABAUD = 0;
+	//bit 4 RXINV: Receive Polarity Inversion bit
+	//1 = UxRX Idle state is `0'
+	//0 = UxRX Idle state is `1'
+	U1MODEbits.RXINV = 0;
+	//bit 3 BRGH: High Baud Rate Enable bit
+	//1 = BRG generates 4 clocks per bit period (4x baud clock, High-Speed mode)
+	//0 = BRG generates 16 clocks per bit period (16x baud clock, Standard mode)
+	U1MODEbits.BRGH = 1;
+	//bit 2-1 PDSEL1:PDSEL0: Parity and Data Selection bits
+	//11 = 9-bit data, no parity
+	//10 = 8-bit data, odd parity
+	//01 = 8-bit data, even parity
+	//00 = 8-bit data, no parity
+	U1MODEbits.PDSEL1=0, U1MODEbits.PDSEL0=0;
+	//bit 0 STSEL: Stop Bit Selection bit
+	//1 = Two Stop bits
+	//0 = One Stop bit
+	U1MODEbits.STSEL=0;
+	//Note 1: If UARTEN = 1, the peripheral inputs and outputs must be configured to an available RPn pin. See
+	//Section 10.4 "Peripheral Pin Select" for more information.
+	//2: This feature is only available for the 16x BRG mode (BRGH = 0).
+	//3: Bit availability depends on pin availability.
+
+
+	//BAUDCON
+	U1BRG = F_UART / 4 / baud_rate - 1;				//set lower byte of brg.
+	_u1_baud = baud_rate;
+
+	//disable interrupts
+
+	//set up status register
+//#if defined(UxTX2RP)				//tx is used
+	IFS0bits.U1TXIF = 0;						//clera the flag
+	IEC0bits.U1TXIE = 0;						//disable the interrupt
+
+	//bit 15,13 UTXISEL1:UTXISEL0: Transmission Interrupt Mode Selection bits
+	//11 = Reserved; do not use
+	//10 = Interrupt when a character is transferred to the Transmit Shift Register (TSR) and as a result, the transmit buffer becomes empty
+	//01 = Interrupt when the last character is shifted out of the Transmit Shift Register; all transmit operations are completed
+	//00 = Interrupt when a character is transferred to the Transmit Shift Register (this implies there is at least one character open in the transmit buffer)
+	U1STAbits.UTXISEL1=0, U1STAbits.UTXISEL0=0;
+//#endif
+	//bit 14 UTXINV: IrDAr Encoder Transmit Polarity Inversion bit
+	//If IREN = 0:
+	//1 = UxTX Idle `0'
+	//0 = UxTX Idle `1'
+	//If IREN = 1:
+	//1 = UxTX Idle `1'
+	//0 = UxTX Idle `0'
+	U1STAbits.UTXINV=0;
+	//bit 12 Unimplemented: Read as `0'
+	//bit 11 UTXBRK: Transmit Break bit
+	//1 = Send Sync Break on next transmission - Start bit, followed by twelve `0' bits, followed by Stop bit;	cleared by hardware upon completion
+	//0 = Sync Break transmission disabled or completed
+	U1STAbits.UTXBRK=0;
+	//bit 10 UTXEN: Transmit Enable bit(1)
+	//1 = Transmit enabled, UxTX pin controlled by UARTx
+	//0 = Transmit disabled, any pending transmission is aborted and buffer is reset. UxTX pin controlled by the PORT register.
+#if defined(U1TX2RP)
+	U1STAbits.UTXEN=1;
+#else
+	U1STAbits.UTXEN=0;
+#endif
+#if defined(U1RX2RP)
+	//U1STAbits.URXEN=1;
+#else
+	//U1STAbits.URXEN=0;
+#endif
+	//bit 9 UTXBF: Transmit Buffer Full Status bit (read-only)
+	//1 = Transmit buffer is full
+	//0 = Transmit buffer is not full, at least one more character can be written
+	//bit 8 TRMT: Transmit Shift Register Empty bit (read-only)
+	//1 = Transmit Shift Register is empty and transmit buffer is empty (the last transmission has completed)
+	//0 = Transmit Shift Register is not empty, a transmission is in progress or queued
+//#if defined(UxRX2RP)
+	IFS0bits.U1RXIF = 0;						//clear the flag
+	IEC0bits.U1RXIE = 0;						//disable the interrupt
+
+	//bit 7-6 URXISEL1:URXISEL0: Receive Interrupt Mode Selection bits
+	//11 = Interrupt is set on RSR transfer, making the receive buffer full (i.e., has 4 data characters)
+	//10 = Interrupt is set on RSR transfer, making the receive buffer 3/4 full (i.e., has 3 data characters)
+	//0x = Interrupt is set when any character is received and transferred from the RSR to the receive buffer. Receive buffer has one or more characters.
+	U1STAbits.URXISEL1 = 0, U1STAbits.URXISEL0 = 0;
+//#endif
+	//bit 5 ADDEN: Address Character Detect bit (bit 8 of received data = 1)
+	//1 = Address Detect mode enabled. If 9-bit mode is not selected, this does not take effect.
+	//0 = Address Detect mode disabled
+	//bit 4 RIDLE: Receiver Idle bit (read-only)
+	//1 = Receiver is Idle
+	//0 = Receiver is active
+	//bit 3 PERR: Parity Error Status bit (read-only)
+	//1 = Parity error has been detected for the current character (character at the top of the receive FIFO)
+	//0 = Parity error has not been detected
+	//bit 2 FERR: Framing Error Status bit (read-only)
+	//1 = Framing error has been detected for the current character (character at the top of the receive FIFO)
+	//0 = Framing error has not been detected
+	//bit 1 OERR: Receive Buffer Overrun Error Status bit (clear/read-only)
+	//1 = Receive buffer has overflowed
+	//0 = Receive buffer has not overflowed (clearing a previously set OERR bit (1 ? 0 transition) will reset the receiver buffer and the RSR to the empty state)
+	//bit 0 URXDA: Receive Buffer Data Available bit (read-only)
+	//1 = Receive buffer has data; at least one more character can be read
+	//0 = Receive buffer is empty
+	//REGISTER 17-2: U1STAbits: UARTx STATUS AND CONTROL REGISTER (CONTINUED)
+	//Note 1: If UARTEN = 1, the peripheral inputs and outputs must be configured to an available RPn pin. See
+	//Section 10.4 "Peripheral Pin Select" for more information.
+
+}
+
+void uart1Putch(char ch) {
+	//Wait for TXREG Buffer to become available
+	//while(!TXIF);			//wait for prior transmission to finish
+	//USART_WAIT(U1STAbits.TRMT);		//wait for TRMT to be 0 = transmission done
+	while (U1STAbits.UTXBF) yield();	//wait if the tx buffer is full
+
+	//Write data
+	U1TXREG=ch;				//load up the tx register
+
+	//USART_WAIT(!U1STAbits.TRMT);
+	//while(!TRMT);			//wait for the transmission to finish
+	//don't use txif as this is not back-to-back transmission
+	//USART_WAIT(!IFS1bits.U1TXIF);		//wait for the falg
+	//IFS1bits.U1TXIF = 0;				//reset the flag
+}
+
+//put a string
+void uart1Puts(char *str) {
+	while(*str) {
+		uart1Putch(*str++);	//send the ch and advance the pointer
+	}
+}
+
+/*
+
+Writes a line of text to USART and goes to new line
+The new line is Windows style CR/LF pair.
+
+This will work on Hyper Terminal Only NOT on Linux
+
+*/
+
+//put a line termined with ln
+void uart1Putline(char *ln) {
+	//USARTWriteString(ln);
+	uart1Puts(ln);
+	//USARTWriteString("\r\n");
+	uart1Puts((char *)"\r\n");
+}
+
+//get the received char
+//uint8_t uart1Getch(void) {
+//    return U1RXREG;		//return it
+//}
+
+//test if data rx is available
+//uint16_t uart1Available(void) {
+//    return U1STAbits.URXDA;
+//}
+
+//test if uart tx is busy
+//uint16_t uart1Busy(void) {
+//    return U1STAbits.UTXBF;
+//}
+
+//print to uart1
+void u1Print(char *str, int32_t dat) {
+	char uRAM[40];						//transmission buffer, 40-1 char max
+
+	strcpy(uRAM, str);					//copy to uarm
+	if (dat < 0) {
+		uRAM[6]='-';
+		dat = -dat;
+	}
+	uRAM[19]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[18]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[17]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[16]=',';	//'0'+(dat % 10); dat /= 10;
+	uRAM[15]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[14]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[13]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[12]=',';	//'0'+(dat % 10); dat /= 10;
+	uRAM[11]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[10]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[ 9]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[ 8]=',';	//'0'+(dat % 10); dat /= 10;
+	uRAM[ 7]='0'+(dat % 10);
+	dat /= 10;
+	uart1Puts(uRAM);	//send a message on uart1
+}
+
+//uart2
+//initialize usart: high baudrate (brgh=1), 16-bit baudrate (brg16=1)
+//baudrate=Fxtal/(4*(spbrg+1))
+//spbrg=(Fxtal/4/baudrate)-1
+//tx/rx pins to be assumed in gpio mode
+//data bits: 	8
+//parity: 		none
+//stop bits: 	1
+//Xon/Xoff:		none
+void uart2Init(unsigned long baud_rate) {
+	//enable the pins
+#if defined(U2RX2RP)
+	U2RX2RP();					//PPS_U1RX_TO_RP(U1RX_RP);
+#endif
+
+#if defined(U2TX2RP)
+	U2TX2RP();					//PPS_U1TX_TO_RP();
+#endif
+
+
+	//disable md bits
+	PMD1bits.U2MD = 0;				//power up the module
+	irqApply(IRQ_U2RX); irqApply(IRQ_U2TX);	//set the interrupt priorities
+
+	//U2MODEbits register
+	//bit 15 UARTEN: UARTx Enable bit(1)
+	//1 = UARTx is enabled; all UARTx pins are controlled by UARTx as defined by UEN<1:0>
+	//0 = UARTx is disabled; all UARTx pins are controlled by PORT latches; UARTx power consumption is	minimal
+	U2MODEbits.UARTEN=1;	//enable the uart module
+	//bit 14 Unimplemented: Read as `0'
+	//bit 13 USIDL: Stop in Idle Mode bit
+	//1 = Discontinue module operation when device enters Idle mode
+	//0 = Continue module operation in Idle mode
+	//bit 12 IREN: IrDAr Encoder and Decoder Enable bit(2)
+	//1 = IrDA encoder and decoder enabled
+	//0 = IrDA encoder and decoder disabled
+	U2MODEbits.IREN = 0;		//disable irda
+	U2MODEbits.RTSMD = 0;		//1=in simplex mode. 0 = no flow control
+	//bit 11 RTSMD: Mode Selection for UxRTS Pin bit
+	//1 = UxRTS pin in Simplex mode
+	//0 = UxRTS pin in Flow Control mode
+	//bit 10 Unimplemented: Read as `0'
+	//bit 9-8 UEN1:UEN0: UARTx Enable bits(3)
+	//11 = UxTX, UxRX and BCLKx pins are enabled and used; UxCTS pin controlled by PORT latches
+	//10 = UxTX, UxRX, UxCTS and UxRTS pins are enabled and used
+	//01 = UxTX, UxRX and UxRTS pins are enabled and used; UxCTS pin controlled by PORT latches
+	//00 = UxTX and UxRX pins are enabled and used; UxCTS and UxRTS/BCLKx pins controlled by PORT latches
+	U2MODEbits.UEN1=0, U2MODEbits.UEN0=0;
+	//bit 7 WAKE: Wake-up on Start Bit Detect During Sleep Mode Enable bit
+	//1 = UARTx will continue to sample the UxRX pin; interrupt generated on falling edge, bit cleared in hardware on following rising edge
+	//0 = No wake-up enabled
+	U2MODEbits.WAKE = 0;
+	//bit 6 LPBACK: UARTx Loopback Mode Select bit
+	//1 = Enable Loopback mode
+	//0 = Loopback mode is disabled
+	U2MODEbits.LPBACK = 0;
+	//bit 5 ABAUD: Auto-Baud Enable bit
+	//1 = Enable baud rate measurement on the next character - requires reception of a Sync field (55h); cleared in hardware upon completion
+	//0 = Baud rate measurement disabled or completed
+	U2MODEbits.ABAUD = 0;
+	//bit 4 RXINV: Receive Polarity Inversion bit
+	//1 = UxRX Idle state is `0'
+	//0 = UxRX Idle state is `1'
+	U2MODEbits.RXINV = 0;
+	//bit 3 BRGH: High Baud Rate Enable bit
+	//1 = BRG generates 4 clocks per bit period (4x baud clock, High-Speed mode)
+	//0 = BRG generates 16 clocks per bit period (16x baud clock, Standard mode)
+	U2MODEbits.BRGH = 1;
+	//bit 2-1 PDSEL1:PDSEL0: Parity and Data Selection bits
+	//11 = 9-bit data, no parity
+	//10 = 8-bit data, odd parity
+	//01 = 8-bit data, even parity
+	//00 = 8-bit data, no parity
+	U2MODEbits.PDSEL1=0, U2MODEbits.PDSEL0=0;
+	//bit 0 STSEL: Stop Bit Selection bit
+	//1 = Two Stop bits
+	//0 = One Stop bit
+	U2MODEbits.STSEL=0;
+	//Note 1: If UARTEN = 1, the peripheral inputs and outputs must be configured to an available RPn pin. See
+	//Section 10.4 "Peripheral Pin Select" for more information.
+	//2: This feature is only available for the 16x BRG mode (BRGH = 0).
+	//3: Bit availability depends on pin availability.
+
+
+	//BAUDCON
+	U2BRG = F_UART / 4 / baud_rate - 1;				//set lower byte of brg
+	_u2_baud = baud_rate;
+
+	//disable interrupts
+//#if defined(UxTX2RP)
+	IFS1bits.U2TXIF = 0;						//clera the flag
+	IEC1bits.U2TXIE = 0;						//disable the interrupt
+
+	//set up status register
+	//bit 15,13 UTXISEL1:UTXISEL0: Transmission Interrupt Mode Selection bits
+	//11 = Reserved; do not use
+	//10 = Interrupt when a character is transferred to the Transmit Shift Register (TSR) and as a result, the transmit buffer becomes empty
+	//01 = Interrupt when the last character is shifted out of the Transmit Shift Register; all transmit operations are completed
+	//00 = Interrupt when a character is transferred to the Transmit Shift Register (this implies there is at least one character open in the transmit buffer)
+	U2STAbits.UTXISEL1=0, U2STAbits.UTXISEL0=0;
+//#endif
+	//bit 14 UTXINV: IrDAr Encoder Transmit Polarity Inversion bit
+	//If IREN = 0:
+	//1 = UxTX Idle `0'
+	//0 = UxTX Idle `1'
+	//If IREN = 1:
+	//1 = UxTX Idle `1'
+	//0 = UxTX Idle `0'
+	U2STAbits.UTXINV=0;
+	//bit 12 Unimplemented: Read as `0'
+	//bit 11 UTXBRK: Transmit Break bit
+	//1 = Send Sync Break on next transmission - Start bit, followed by twelve `0' bits, followed by Stop bit;	cleared by hardware upon completion
+	//0 = Sync Break transmission disabled or completed
+	U2STAbits.UTXBRK=0;
+	//bit 10 UTXEN: Transmit Enable bit(1)
+	//1 = Transmit enabled, UxTX pin controlled by UARTx
+	//0 = Transmit disabled, any pending transmission is aborted and buffer is reset. UxTX pin controlled by the PORT register.
+#if defined(U2TX2RP)
+	U2STAbits.UTXEN=1;
+#else
+	U2STAbits.UTXEN=0;
+#endif
+#if defined(U2RX2RP)
+	//U2STAbits.URXEN=1;
+#else
+	//U2STAbits.URXEN=0;
+#endif
+	//bit 9 UTXBF: Transmit Buffer Full Status bit (read-only)
+	//1 = Transmit buffer is full
+	//0 = Transmit buffer is not full, at least one more character can be written
+	//bit 8 TRMT: Transmit Shift Register Empty bit (read-only)
+	//1 = Transmit Shift Register is empty and transmit buffer is empty (the last transmission has completed)
+	//0 = Transmit Shift Register is not empty, a transmission is in progress or queued
+//#if defined(UxRX2RP)
+	IFS1bits.U2RXIF = 0;						//clear the flag
+	IEC1bits.U2RXIE = 0;						//disable the interrupt
+
+	//bit 7-6 URXISEL1:URXISEL0: Receive Interrupt Mode Selection bits
+	//11 = Interrupt is set on RSR transfer, making the receive buffer full (i.e., has 4 data characters)
+	//10 = Interrupt is set on RSR transfer, making the receive buffer 3/4 full (i.e., has 3 data characters)
+	//0x = Interrupt is set when any character is received and transferred from the RSR to the receive buffer. Receive buffer has one or more characters.
+	U2STAbits.URXISEL1 = 0, U2STAbits.URXISEL0 = 0;
+//#endif
+	//bit 5 ADDEN: Address Character Detect bit (bit 8 of received data = 1)
+	//1 = Address Detect mode enabled. If 9-bit mode is not selected, this does not take effect.
+	//0 = Address Detect mode disabled
+	//bit 4 RIDLE: Receiver Idle bit (read-only)
+	//1 = Receiver is Idle
+	//0 = Receiver is active
+	//bit 3 PERR: Parity Error Status bit (read-only)
+	//1 = Parity error has been detected for the current character (character at the top of the receive FIFO)
+	//0 = Parity error has not been detected
+	//bit 2 FERR: Framing Error Status bit (read-only)
+	//1 = Framing error has been detected for the current character (character at the top of the receive FIFO)
+	//0 = Framing error has not been detected
+	//bit 1 OERR: Receive Buffer Overrun Error Status bit (clear/read-only)
+	//1 = Receive buffer has overflowed
+	//0 = Receive buffer has not overflowed (clearing a previously set OERR bit (1 ? 0 transition) will reset the receiver buffer and the RSR to the empty state)
+	//bit 0 URXDA: Receive Buffer Data Available bit (read-only)
+	//1 = Receive buffer has data; at least one more character can be read
+	//0 = Receive buffer is empty
+	//REGISTER 17-2: U1STAbits: UARTx STATUS AND CONTROL REGISTER (CONTINUED)
+	//Note 1: If UARTEN = 1, the peripheral inputs and outputs must be configured to an available RPn pin. See
+	//Section 10.4 "Peripheral Pin Select" for more information.
+
+}
+
+void uart2Putch(char ch) {
+	while (U2STAbits.UTXBF) yield();	//wait if the tx buffer is full
+
+	//Write data
+	U2TXREG=ch;				//load up the tx register
+
+	//while(!TRMT);			//wait for the transmission to finish
+	//don't use txif as this is not back-to-back transmission
+	//USART_WAIT(U1STAbits.TRMT);
+}
+
+void uart2Puts(char *str) {
+	while(*str) {
+		uart2Putch(*str++);	//send the ch and advance the pointer
+	}
+}
+
+/*
+
+Writes a line of text to USART and goes to new line
+The new line is Windows style CR/LF pair.
+
+This will work on Hyper Terminal Only NOT on Linux
+
+*/
+
+void uart2Putline(char *ln) {
+	//USARTWriteString(ln);
+	uart2Puts(ln);
+	//USARTWriteString("\r\n");
+	uart2Puts((char *)"\r\n");
+}
+
+//uint8_t uart2Getch(void) {
+//    //while(!RCIF); RCIF=0;		//Wait for a byte
+//   //USART_WAIT(U1STAbits.TRMT);		//wait for the prior transmission to end
+//
+//    return U2RXREG;		//return it
+//}
+
+//test if data rx is available
+//uint16_t uart2Available(void) {
+//    return U2STAbits.URXDA;
+//}
+
+//test if uart tx is busy
+//uint16_t uart2Busy(void) {
+//    return U2STAbits.UTXBF;
+//}
+
+//print to uart2
+void u2Print(char *str, int32_t dat) {
+	char uRAM[40];						//transmission buffer, 40-1 char max
+
+	strcpy(uRAM, str);					//copy to uarm
+	if (dat < 0) {
+		uRAM[6]='-';
+		dat = -dat;
+	}
+	uRAM[19]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[18]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[17]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[16]=',';	//'0'+(dat % 10); dat /= 10;
+	uRAM[15]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[14]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[13]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[12]=',';	//'0'+(dat % 10); dat /= 10;
+	uRAM[11]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[10]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[ 9]='0'+(dat % 10);
+	dat /= 10;
+	uRAM[ 8]=',';	//'0'+(dat % 10); dat /= 10;
+	uRAM[ 7]='0'+(dat % 10);
+	dat /= 10;
+	uart2Puts(uRAM);	//send a message on uart1
+}
+
+//re-derive UxBRG for the current F_PHB, after a clock change
+//rates out of reach (lprc, deep frcdiv) end up at the fastest brg
+void uartRebaud(void) {
+	uint32_t brg;
+
+	if (_u1_baud && U1MODEbits.UARTEN) {brg = F_UART / 4 / _u1_baud; U1BRG = brg?(brg - 1):0;}
+	if (_u2_baud && U2MODEbits.UARTEN) {brg = F_UART / 4 / _u2_baud; U2BRG = brg?(brg - 1):0;}
+}
+
+//wait for the enabled uarts to finish sending
+void uartFlush(void) {
+	while ((U1MODEbits.UARTEN && !U1STAbits.TRMT) || (U2MODEbits.UARTEN && !U2STAbits.TRMT)) continue;
+}
+
+//end Serial
+
+//tmr1
+//global variables
+static void (* _tmr1_isrptr)(void)=empty_handler;				//tmr1_ptr pointing to empty_handler by default
+
+//interrupt service routine
+void _ISR_PSV _T1Interrupt(void) {
+	ISR_ENTER();								//ISR_PROFILE
+	IFS0bits.T1IF=0;							//clear tmr1 interrupt flag
+#if defined(SYSTICK_TMR1)
+	SysTick+=0x10000ul;							//increment overflow count: 16-bit timer
+#else	//systick on tmr2
+	//do nothing
+#endif
+#if defined(T1_HANDLER)
+	T1_HANDLER();						//bound at compile time
+#else
+	_tmr1_isrptr();								//execute user tmr1 isr
+#endif
+	ISR_EXIT(IRQ_T1);
+}
+
+//initialize the timer1 (16bit)
+void tmr1Init(uint8_t ps, uint16_t period) {
+	_tmr1_isrptr=empty_handler;					//point to default handler
+
+	PMD1bits.T1MD = 0;							//enable power to tmr
+	T1CONbits.TON = 0;							//turn off rtc1
+	T1CONbits.TCS = 0;							//use internal clock = Fosc
+	//T1CONbits.T32 = 0;						//0->16 bit timer, 1->32bit timer
+	T1CONbits.TCKPS=ps & TMR_PSMASK;			//set prescaler to 1:1
+	T1CONbits.TGATE = 0;						//rtc1 gate disabled
+	TMR1 = 0;									//reset the timer/counter
+	PR1=period-0;								//minimum rtc resolution is 1ms
+	IFS0bits.T1IF = 0;							//reset the flag
+	IEC0bits.T1IE = 0;							//rtc1 interrupt off
+	T1CONbits.TON = 1;							//turn on rtc1
+}
+
+//activate the isr handler
+void tmr1AttachISR(void (*isrptr)(void)) {
+	_tmr1_isrptr=isrptr;						//activate the isr handler
+	irqApply(IRQ_T1);
+	//IPC0bits.T1IS = TxIS_DEFAULT;
+	IFS0bits.T1IF = 0;							//reset the flag
+	IEC0bits.T1IE = 1;							//rtc1 interrupt on
+}
+
+//tmr2
+//global variables
+static void (* _tmr2_isrptr)(void)=empty_handler;				//tmr1_ptr pointing to empty_handler by default
+
+//interrupt service routine
+void _ISR_PSV _T2Interrupt(void) {
+	ISR_ENTER();								//ISR_PROFILE
+	IFS0bits.T2IF=0;							//clear tmr1 interrupt flag
+#if defined(SYSTICK_TMR1)
+	//do nothing
+#else	//systick on tmr2
+	SysTick+=0x10000ul;							//increment overflow count: 16-bit timer
+	if (SysTick == 0) _tb_hi++;					//ticks64()
+	if (SysTick - (uint32_t) _tb_t0 >= _tb_span) {	//epoch getting old: move it up, every 2^31 ticks (~134s at 16MHz) or 2^31us at most
+		uint64_t t = ticks64();					//only this isr moves the epoch between clock switches: no need to hold others off
+
+		_tb_rebase(t, _tb_us0 + _tb_conv((uint32_t) t - (uint32_t) _tb_t0, _tb_usk, _tb_ussh));
+	}
+#endif
+#if defined(T2_HANDLER)
+	T2_HANDLER();						//bound at compile time
+#else
+	_tmr2_isrptr();								//execute user tmr2 isr
+#endif
+	ISR_EXIT(IRQ_T2);
+}
+
+//initialize the timer2 (16bit)
+void tmr2Init(uint8_t ps, uint16_t period) {
+	_tmr2_isrptr=empty_handler;					//point to default handler
+
+	PMD1bits.T2MD = 0;							//enable power to tmr
+	T2CONbits.TON = 0;							//turn off rtc1
+	T2CONbits.TCS = 0;							//use internal clock = Fosc
+	T2CONbits.T32 = 0;							//0->16 bit timer, 1->32bit timer
+	T2CONbits.TCKPS=ps & TMR_PSMASK;			//set prescaler to 1:1
+	T2CONbits.TGATE = 0;						//rtc1 gate disabled
+	TMR2 = 0;									//reset the timer/counter
+	PR2=period-0;								//minimum rtc resolution is 1ms
+	IFS0bits.T2IF = 0;							//reset the flag
+	IEC0bits.T2IE = 0;							//rtc1 interrupt off
+	T2CONbits.TON = 1;							//turn on rtc1
+}
+
+//activate the isr handler
+void tmr2AttachISR(void (*isrptr)(void)) {
+	_tmr2_isrptr=isrptr;						//activate the isr handler
+	irqApply(IRQ_T2);
+	//IPC2bits.T2IS = TxIS_DEFAULT;
+	IFS0bits.T2IF = 0;							//reset the flag
+	IEC0bits.T2IE = 1;							//rtc1 interrupt on
+}
+
+//tmr3
+//global variables
+static void (* _tmr3_isrptr)(void)=empty_handler;				//tmr1_ptr pointing to empty_handler by default
+
+//interrupt service routine
+void _ISR_PSV _T3Interrupt(void) {
+	ISR_ENTER();								//ISR_PROFILE
+	IFS0bits.T3IF=0;							//clear tmr1 interrupt flag
+#if defined(T3_HANDLER)
+	T3_HANDLER();						//bound at compile time
+#else
+	_tmr3_isrptr();								//execute user tmr1 isr
+#endif
+	ISR_EXIT(IRQ_T3);
+}
+
+//initialize the timer3 (16bit)
+void tmr3Init(uint8_t ps, uint16_t period) {
+	_tmr3_isrptr=empty_handler;					//point to default handler
+
+	PMD1bits.T3MD = 0;							//enable power to tmr
+	T3CONbits.TON = 0;							//turn off rtc1
+	T3CONbits.TCS = 0;							//use internal clock = Fosc
+	//T3CONbits.T32 = 0;						//0->16 bit timer, 1->32bit timer
+	T3CONbits.TCKPS=ps & TMR_PSMASK;			//set prescaler to 1:1
+	T3CONbits.TGATE = 0;						//rtc1 gate disabled
+	TMR3 = 0;									//reset the timer/counter
+	PR3=period-0;								//minimum rtc resolution is 1ms
+	IFS0bits.T3IF = 0;							//reset the flag
+	IEC0bits.T3IE = 0;							//rtc1 interrupt off
+	T3CONbits.TON = 1;							//turn on rtc1
+}
+
+//activate the isr handler
+void tmr3AttachISR(void (*isrptr)(void)) {
+	_tmr3_isrptr=isrptr;						//activate the isr handler
+	irqApply(IRQ_T3);
+	//IPC2bits.T3IS = TxIS_DEFAULT;
+	IFS0bits.T3IF = 0;							//reset the flag
+	IEC0bits.T3IE = 1;							//rtc1 interrupt on
+}
+
+//tmr4
+//global variables
+static void (* _tmr4_isrptr)(void)=empty_handler;				//tmr1_ptr pointing to empty_handler by default
+
+//interrupt service routine
+void _ISR_PSV _T4Interrupt(void) {
+	ISR_ENTER();								//ISR_PROFILE
+	IFS1bits.T4IF=0;							//clear tmr1 interrupt flag
+#if defined(T4_HANDLER)
+	T4_HANDLER();						//bound at compile time
+#else
+	_tmr4_isrptr();								//execute user tmr1 isr
+#endif
+	ISR_EXIT(IRQ_T4);
+}
+
+//initialize the timer4 (16bit)
+void tmr4Init(uint8_t ps, uint16_t period) {
+	_tmr4_isrptr=empty_handler;					//point to default handler
+
+	PMD1bits.T4MD = 0;							//enable power to tmr
+	T4CONbits.TON = 0;							//turn off rtc1
+	T4CONbits.TCS = 0;							//use internal clock = Fosc
+	T4CONbits.T32 = 0;							//0->16 bit timer, 1->32bit timer
+	T4CONbits.TCKPS=ps & TMR_PSMASK;			//set prescaler to 1:1
+	T4CONbits.TGATE = 0;						//rtc1 gate disabled
+	TMR4 = 0;									//reset the timer/counter
+	PR4=period-0;								//minimum rtc resolution is 1ms
+	IFS1bits.T4IF = 0;							//reset the flag
+	IEC1bits.T4IE = 0;							//rtc1 interrupt off
+	T4CONbits.TON = 1;							//turn on rtc1
+}
+
+//activate the isr handler
+void tmr4AttachISR(void (*isrptr)(void)) {
+	_tmr4_isrptr=isrptr;						//activate the isr handler
+	irqApply(IRQ_T4);
+	//IPC6bits.T4IS = TxIS_DEFAULT;
+	IFS1bits.T4IF = 0;							//reset the flag
+	IEC1bits.T4IE = 1;							//rtc1 interrupt on
+}
+
+//tmr5
+//global variables
+static void (* _tmr5_isrptr)(void)=empty_handler;				//tmr1_ptr pointing to empty_handler by default
+
+//interrupt service routine
+void _ISR_PSV _T5Interrupt(void) {
+	ISR_ENTER();								//ISR_PROFILE
+	IFS1bits.T5IF=0;							//clear tmr1 interrupt flag
+#if defined(T5_HANDLER)
+	T5_HANDLER();						//bound at compile time
+#else
+	_tmr5_isrptr();								//execute user tmr1 isr
+#endif
+	ISR_EXIT(IRQ_T5);
+}
+
+//initialize the timer5 (16bit)
+void tmr5Init(uint8_t ps, uint16_t period) {
+	_tmr5_isrptr=empty_handler;					//point to default handler
+
+	PMD1bits.T5MD = 0;							//enable power to tmr
+	T5CONbits.TON = 0;							//turn off rtc1
+	T5CONbits.TCS = 0;							//use internal clock = Fosc
+	//T5CONbits.T32 = 0;						//0->16 bit timer, 1->32bit timer
+	T5CONbits.TCKPS=ps & TMR_PSMASK;			//set prescaler to 1:1
+	T5CONbits.TGATE = 0;						//rtc1 gate disabled
+	TMR5 = 0;									//reset the timer/counter
+	PR5=period-0;								//minimum rtc resolution is 1ms
+	IFS1bits.T5IF = 0;							//reset the flag
+	IEC1bits.T5IE = 0;							//rtc1 interrupt off
+	T5CONbits.TON = 1;							//turn on rtc1
+}
+
+//activate the isr handler
+void tmr5AttachISR(void (*isrptr)(void)) {
+	_tmr5_isrptr=isrptr;						//activate the isr handler
+	irqApply(IRQ_T5);
+	//IPC7bits.T5IS = TxIS_DEFAULT;
+	IFS1bits.T5IF = 0;							//reset the flag
+	IEC1bits.T5IE = 1;							//rtc1 interrupt on
+}
+
+//set up 32-bit timer
+//using tmr2 (lsw) and tmr3 (msw)
+void tmr23Init(uint8_t ps, uint32_t period) {
+	tmr2Init(ps, period);
+	tmr3Init(ps, period >>16);
+	T2CONbits.T32=1;					//1->as 32-bit timer
+
+	TMR2 = TMR3 = 0;					//reset the timer
+}
+
+//read 32-bit timer2 and 3
+uint32_t tmr23Get(void) {
+	uint16_t tmp2, tmp3;
+
+	do {
+		tmp3 = TMR3;					//read the mws
+		tmp2 = TMR2;					//read the lsw
+	} while (tmp3 ^ TMR2);
+
+	return ((uint32_t) tmp3 << 16) | tmp2;
+}
+
+//#define tmr23AttachISR(isr)				tmr3AttachISR(isr)
+
+//using tmr4 (lsw) and tmr5 (msw)
+void tmr45Init(uint8_t ps, uint32_t period) {
+	tmr4Init(ps, period);
+	tmr5Init(ps, period>>16);
+	T4CONbits.T32=1;					//1->as 32-bit timer
+
+	TMR4 = TMR5 = 0;					//reset the timer
+}
+
+//read 32-bit timer4 and 5
+uint32_t tmr45Get(void) {
+	uint16_t tmp4, tmp5;
+
+	do {
+		tmp5 = TMR5;					//read the mws
+		tmp4 = TMR4;					//read the lsw
+	} while (tmp5 ^ TMR5);
+
+	return ((uint32_t) tmp5 << 16) | tmp5;
+}
+
+//#define tmr45AttachISR(isr)				tmr5AttachISR(isr)
+//end Timer
+
+//define pwm functions
+//time base is Timer2, defined in mcu_init()
+
+//pwm1/oc1
+//reset pwm
+void pwm1Init(void) {
+	//power up the pwm module
+	PMD2bits.OC1MD = 0;							//0->turn on the peripheral, 1->turn off the peripheral
+
+#if defined(PWM12RP)
+	//assign the output pins
+	PWM12RP();
+#endif
+
+	//tris pin presumed to have been set to output
+
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
+			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+	//OCxCON1 register settings
+	//reset the registers
+	OC1CON1 = 0x0000;
+	OC1CON2 = 0x0000;
+	OC1CON1bits.OCM = 7;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm
+	OC1CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	OC1R = OC1RS = 0;						//reset the duty cycle registers
+	//OC1CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
+#else
+	//for GA002 chips
+	//OCxCON1 register settings
+	//reset the registers
+	OC1CON = 0x0000;
+	//OC1CON2 = 0x0000;
+	OC1CONbits.OCM = 0x06;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled
+	OC1CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	OC1R = OC1RS = 0;						//reset the duty cycle registers
+	//OC1CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
+#endif
+}
+
+//pwm2/oc2
+//reset pwm
+void pwm2Init(void) {
+	//power up the pwm module
+	PMD2bits.OC2MD = 0;						//0->turn on the peripheral, 1->turn off the peripheral
+
+#if defined(PWM22RP)
+	//assign the output pins
+	PWM22RP();
+#endif
+
+	//tris pin presumed to have been set to output
+
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
+			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+
+	//OCxCON1 register settings
+	//reset the registers
+	OC2CON1 = 0x0000;
+	OC2CON2 = 0x0000;
+	OC2CON1bits.OCM = 7;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm
+	OC2CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	OC2R = OC2RS = 0;						//reset the duty cycle registers
+	//OC2CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
+#else
+	//for ga002 devices
+	//OCxCON1 register settings
+	//reset the registers
+	OC2CON = 0x0000;
+	//OC2CON2 = 0x0000;
+	OC2CONbits.OCM = 0x06;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled
+	OC2CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	OC2R = OC2RS = 0;						//reset the duty cycle registers
+	//OC2CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
+#endif
+}
+
+
+//pwm3/oc3
+//reset pwm
+void pwm3Init(void) {
+	//power up the pwm module
+	PMD2bits.OC3MD = 0;						//0->turn on the peripheral, 1->turn off the peripheral
+
+#if defined(PWM32RP)
+	//assign the output pins
+	PWM32RP();
+#endif
+
+	//tris pin presumed to have been set to output
+
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
+			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+	//OCxCON1 register settings
+	//reset the registers
+	OC3CON1 = 0x0000;
+	OC3CON2 = 0x0000;
+	OC3CON1bits.OCM = 7;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm
+	OC3CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	OC3R = OC3RS = 0;						//reset the duty cycle registers
+	//OC2CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
+#else
+	//for ga002 devices
+	//OCxCON1 register settings
+	//reset the registers
+	OC3CON = 0x0000;
+	//OC3CON2 = 0x0000;
+	OC3CONbits.OCM = 0x06;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled
+	OC3CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	OC3R = OC3RS = 0;						//reset the duty cycle registers
+	//OC3CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
+#endif
+}
+
+
+//pwm4/oc4
+//reset pwm
+void pwm4Init(void) {
+	//power up the pwm module
+	PMD2bits.OC4MD = 0;						//0->turn on the peripheral, 1->turn off the peripheral
+
+#if defined(PWM42RP)
+	//assign the output pins
+	PWM42RP();
+#endif
+
+	//tris pin presumed to have been set to output
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
+			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+
+	//OCxCON1 register settings
+	//reset the registers
+	OC4CON1 = 0x0000;
+	OC4CON2 = 0x0000;
+	OC4CON1bits.OCM = 7;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm
+	OC4CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	OC4R = OC4RS = 0;						//reset the duty cycle registers
+	//OC2CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
+#else
+	//for ga002 devices
+	//OCxCON1 register settings
+	//reset the registers
+	OC4CON = 0x0000;
+	//OC4CON2 = 0x0000;
+	OC4CONbits.OCM = 0x06;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled
+	OC4CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	OC4R = OC4RS = 0;						//reset the duty cycle registers
+	//OC4CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
+#endif
+}
+
+
+//pwm5/oc5
+//reset pwm
+void pwm5Init(void) {
+	//power up the pwm module
+	PMD2bits.OC5MD = 0;						//0->turn on the peripheral, 1->turn off the peripheral
+
+#if defined(PWM52RP)
+	//assign the output pins
+	PWM52RP();
+#endif
+
+	//tris pin presumed to have been set to output
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
+			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+	//OCxCON1 register settings
+	//reset the registers
+	OC5CON1 = 0x0000;
+	OC5CON2 = 0x0000;
+	OC5CON1bits.OCM = 7;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm
+	OC5CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	OC5R = OC5RS = 0;						//reset the duty cycle registers
+	//OC5CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
+#else
+	//for ga002 devices
+	//OCxCON1 register settings
+	//reset the registers
+	OC5CON = 0x0000;
+	//OC5CON2 = 0x0000;
+	OC5CONbits.OCM = 0x06;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled
+	OC5CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	OC5R = OC5RS = 0;						//reset the duty cycle registers
+	//OC5CON1bits.ON= 1;					//1->turn on oc, 0->turn off oc
+#endif
+}
+//end pwm/oc
+
+//adc module
+//rest the adc
+//automatic sampling (ASAM=1), manual conversion
+void adcInit(void) {
+	PMD1bits.ADC1MD = 0;					//enable power to adc
+	irqApply(IRQ_AD1);						//set the interrupt priority
+
+	//reset the adc control registers
+	AD1CON1 = 0;
+	AD1CON2 = 0;
+	AD1CON3 = 0;
+
+	AD1CON1bits.SSRC = 7;					//0->samp ends sampling and starts conversion. 7=auto mode
+	AD1CON2bits.VCFG = 0;					//0..7. adc reference: 0->AVdd-AVss,1=Vref+-AVss, 2=AVdd-Vref-, 3=Vref+ - Vref-
+	AD1CON2bits.ALTS = 0;					//0->always use mux A inputs. 1->alternate between mux a and mux b inputs
+	AD1CON3bits.SAMC = 31;					//0..31. 0->0 Tad (not recommended), 1->1 Tad, ... 31->32 Tad
+	AD1CON3bits.ADCS = 2;					//0..63. 0->Tcy, 1-> 1Tcy, 63->64 Tcy
+	AD1CSSL = 0;							//scanning disabled
+	AD1PCFGbits.PCFG15=1;					//1->band gap enabled, 0->band gap disabled
+	AD1CON1bits.ADON = 1;					//1->enable adc
+}
+
+//read the adc
+//single ended only.
+uint16_t analogRead(uint16_t adc_ch) {
+	uint16_t tmp;
+
+	tmp=AD1PCFG;							//save current port configuration setting
+	//set up adc port configuration bits
+	//for the positive channel (mux a only)
+	AD1CON1bits.DONE=0;
+	adc_ch = adc_ch & 0x0f;					//adc_ch limited to 16 channels
+#if 1
+	AD1PCFG &=~(1<<adc_ch);					//configure the port to be analog
+	AD1CHS = adc_ch;						//select the channel
+#else
+	switch (adc_ch) {
+	case ADC_AN0:
+		AD1PCFG &=~(1<< 0);
+		AD1CHS =0x0000;
+		break;		//AD1PCFG: 1->digital GPIO, 0->analog input
+	case ADC_AN1:
+		AD1PCFG &=~(1<< 1);
+		AD1CHS =0x0001;
+		break;
+	case ADC_AN2:
+		AD1PCFG &=~(1<< 2);
+		AD1CHS =0x0002;
+		break;
+	case ADC_AN3:
+		AD1PCFG &=~(1<< 3);
+		AD1CHS =0x0003;
+		break;
+	case ADC_AN4:
+		AD1PCFG &=~(1<< 4);
+		AD1CHS =0x0004;
+		break;
+	case ADC_AN5:
+		AD1PCFG &=~(1<< 5);
+		AD1CHS =0x0005;
+		break;
+	case ADC_AN6:
+		AD1PCFG &=~(1<< 6);
+		AD1CHS =0x0006;
+		break;					//not implemented on 28pin devices. do not use
+	case ADC_AN7:
+		AD1PCFG &=~(1<< 7);
+		AD1CHS =0x0007;
+		break;					//not implemented on 28pin devices. do not use
+	case ADC_AN8:
+		AD1PCFG &=~(1<< 8);
+		AD1CHS =0x0008;
+		break;					//not implemented on 28pin devices. do not use
+	case ADC_AN9:
+		AD1PCFG &=~(1<< 9);
+		AD1CHS =0x0008;
+		break;
+	case ADC_AN10:
+		AD1PCFG &=~(1<<10);
+		AD1CHS =0x000a;
+		break;
+	case ADC_AN11:
+		AD1PCFG &=~(1<<11);
+		AD1CHS =0x000b;
+		break;
+	case ADC_AN12:
+		AD1PCFG &=~(1<<12);
+		AD1CHS =0x000c;
+		break;						//not impelemned on 28pin devices. do not use
+	case ADC_VCORE:
+		AD1PCFG &=~(1<<13);
+		AD1CHS =0x000d;
+		break;
+	case ADC_VBG_2:
+		AD1PCFG &=~(1<<14);
+		AD1CHS =0x000e;
+		break;
+	case ADC_VBG:
+		AD1PCFG &=~(1<<15);
+		AD1CHS =0x000f;
+		break;						//AD1PCFG = ~adc_ch;					//mux b: not used; mux a: negative is Vref-,
+		//case ADC_CTMU:		AD1PCFG &=~(0<<0); AD1CHS = 0x001f; break;						//reserved for ctmu
+	default:
+		break;				//do nothing
+	}
+#endif
+	AD1CON1bits.SAMP = 1;						//start the adc
+	while (!AD1CON1bits.DONE) continue;			//wait for adc to finish
+	AD1PCFG = tmp;								//restore ad1pcfg setting
+	return ADC1BUF0;							//return the adc results
+}
+//end ADC
+
+//output compare
+//oc1
+uint16_t _oc1pr=0xffff;							//oc isr period
+void (*_oc1_isrptr)(void)=empty_handler;		//tmr1_ptr pointing to empty_handler by default
+//OC ISR
+void _ISR_PSV _OC1Interrupt(void) {				//for PIC24
+	ISR_ENTER();								//ISR_PROFILE
+	//clear the flag
+	IFS0bits.OC1IF = 0;							//clear the flag
+	OC1R += _oc1pr;								//update to the next match point
+#if defined(OC1_HANDLER)
+	OC1_HANDLER();						//bound at compile time
+#else
+	_oc1_isrptr();								//run user handler
+#endif
+	ISR_EXIT(IRQ_OC1);
+}
+
+void oc1Init(uint16_t pr) {
+	_oc1_isrptr=empty_handler;
+	_oc1pr = pr;								//reset the pr
+
+	//power up the pwm module
+	PMD2bits.OC1MD = 0;							//0->turn on the peripheral, 1->turn off the peripheral
+
+	//assign the output pins
+#if defined(PWM12RP)
+	PWM12RP();
+#endif
+
+	//tris pin presumed to have been set to output
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
+			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+	//OCxCON1 register settings
+	//reset the registers
+	OC1CON1 = 0x0000;
+	OC1CON2 = 0x0000;
+	OC1CON1bits.OCM = 0x03;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm, 0b011->continous pulse
+	OC1CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	//OC1R = OC1RS = TMR2 + _oc1pr;			//reset the duty cycle registers
+
+	IFS0bits.OC1IF = 0;						//0->clear the flag;
+	IEC0bits.OC1IE = 0;						//0->disable the interrupt, 1->enable the interrupt
+	irqApply(IRQ_OC1);					//set the interrupt priority
+
+	//OC1CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
+#else
+	//for ga002 devices
+	//OCxCON1 register settings
+	//reset the registers
+	OC1CON = 0x0000;
+	//OC5CON2 = 0x0000;
+	OC1CONbits.OCM = 0x03;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled, 0b011->compare toggles ocx
+	OC1CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	//OC1R = OC1RS = TMR2 + _oc1pr;			//reset the duty cycle registers
+
+	IFS0bits.OC1IF = 0;						//0->clear the flag;
+	IEC0bits.OC1IE = 0;						//0->disable the interrupt, 1->enable the interrupt
+	irqApply(IRQ_OC1);					//set the interrupt priority
+
+	//OC1CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
+#endif
+}
+
+//activate user isr
+void oc1AttachISR(void (*isrptr)(void)) {
+	_oc1_isrptr=isrptr;						//activate the isr handler
+	OC1R = TMR2 + _oc1pr;					//update to the next match point
+	IFS0bits.OC1IF = 0;						//0->clear the flag;
+	IEC0bits.OC1IE = 1;						//0->disable the interrupt, 1->enable the interrupt
+}
+
+//oc2
+uint16_t _oc2pr=0xffff;							//oc isr period
+void (*_oc2_isrptr)(void)=empty_handler;		//tmr1_ptr pointing to empty_handler by default
+//OC ISR
+void _ISR_PSV _OC2Interrupt(void) {				//for PIC24
+	ISR_ENTER();								//ISR_PROFILE
+	//clear the flag
+	IFS0bits.OC2IF = 0;							//clear the flag
+	OC2R += _oc2pr;								//update to the next match point
+#if defined(OC2_HANDLER)
+	OC2_HANDLER();						//bound at compile time
+#else
+	_oc2_isrptr();								//run user handler
+#endif
+	ISR_EXIT(IRQ_OC2);
+}
+
+void oc2Init(uint16_t pr) {
+	_oc2_isrptr=empty_handler;
+	_oc2pr = pr;								//reset the pr
+
+	//power up the pwm module
+	PMD2bits.OC2MD = 0;							//0->turn on the peripheral, 1->turn off the peripheral
+
+	//assign the output pins
+#if defined(PWM22RP)
+	PWM22RP();
+#endif
+
+	//tris pin presumed to have been set to output
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
+			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+	//OCxCON1 register settings
+	//reset the registers
+	OC2CON1 = 0x0000;
+	OC2CON2 = 0x0000;
+	OC2CON1bits.OCM = 0x03;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm, 0b011->continous pulse
+	OC2CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	//OC2R = OC2RS = TMR2 + _oc2pr;			//reset the duty cycle registers
+
+	IFS0bits.OC2IF = 0;						//0->clear the flag;
+	IEC0bits.OC2IE = 0;						//0->disable the interrupt, 1->enable the interrupt
+	irqApply(IRQ_OC2);					//set the interrupt priority
+
+	//OC2CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
+#else
+	//for ga002 devices
+	//OCxCON1 register settings
+	//reset the registers
+	OC2CON = 0x0000;
+	//OC5CON2 = 0x0000;
+	OC2CONbits.OCM = 0x03;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled, 0b011->compare toggles ocx
+	OC2CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	//OC2R = OC2RS = TMR2 + _oc2pr;			//reset the duty cycle registers
+
+	IFS0bits.OC2IF = 0;						//0->clear the flag;
+	IEC0bits.OC2IE = 0;						//0->disable the interrupt, 1->enable the interrupt
+	irqApply(IRQ_OC2);					//set the interrupt priority
+
+	//OC2CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
+#endif
+}
+
+//activate user isr
+void oc2AttachISR(void (*isrptr)(void)) {
+	_oc2_isrptr=isrptr;						//activate the isr handler
+	OC2R = TMR2 + _oc2pr;					//update to the next match point
+	IFS0bits.OC2IF = 0;						//0->clear the flag;
+	IEC0bits.OC2IE = 1;						//0->disable the interrupt, 1->enable the interrupt
+}
+
+//oc3
+uint16_t _oc3pr=0xffff;							//oc isr period
+void (*_oc3_isrptr)(void)=empty_handler;		//tmr1_ptr pointing to empty_handler by default
+//OC ISR
+void _ISR_PSV _OC3Interrupt(void) {				//for PIC24
+	ISR_ENTER();								//ISR_PROFILE
+	//clear the flag
+	IFS1bits.OC3IF = 0;							//clear the flag
+	OC3R += _oc3pr;								//update to the next match point
+#if defined(OC3_HANDLER)
+	OC3_HANDLER();						//bound at compile time
+#else
+	_oc3_isrptr();								//run user handler
+#endif
+	ISR_EXIT(IRQ_OC3);
+}
+
+void oc3Init(uint16_t pr) {
+	_oc3_isrptr=empty_handler;
+	_oc3pr = pr;								//reset the pr
+
+	//power up the pwm module
+	PMD2bits.OC3MD = 0;							//0->turn on the peripheral, 1->turn off the peripheral
+
+	//assign the output pins
+#if defined(PWM32RP)
+	PWM32RP();
+#endif
+
+	//tris pin presumed to have been set to output
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
+			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+	//OCxCON1 register settings
+	//reset the registers
+	OC3CON1 = 0x0000;
+	OC3CON2 = 0x0000;
+	OC3CON1bits.OCM = 0x03;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm, 0b011->continous pulse
+	OC3CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	//OC3R = OC3RS = TMR2 + _oc3pr;			//reset the duty cycle registers
+
+	IFS1bits.OC3IF = 0;						//0->clear the flag;
+	IEC1bits.OC3IE = 0;						//0->disable the interrupt, 1->enable the interrupt
+	irqApply(IRQ_OC3);					//set the interrupt priority
+
+	//OC3CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
+#else
+	//for ga002 devices
+	//OCxCON1 register settings
+	//reset the registers
+	OC3CON = 0x0000;
+	//OC3CON2 = 0x0000;
+	OC3CONbits.OCM = 0x03;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled, 0b011->compare toggles ocx
+	OC3CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	//OC3R = OC3RS = TMR2 + _oc3pr;			//reset the duty cycle registers
+
+	IFS1bits.OC3IF = 0;						//0->clear the flag;
+	IEC1bits.OC3IE = 0;						//0->disable the interrupt, 1->enable the interrupt
+	irqApply(IRQ_OC3);					//set the interrupt priority
+
+	//OC3CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
+#endif
+}
+
+//activate user isr
+void oc3AttachISR(void (*isrptr)(void)) {
+	_oc3_isrptr=isrptr;						//activate the isr handler
+	OC3R = TMR2 + _oc3pr;					//update to the next match point
+	IFS1bits.OC3IF = 0;						//0->clear the flag;
+	IEC1bits.OC3IE = 1;						//0->disable the interrupt, 1->enable the interrupt
+}
+
+//oc4
+uint16_t _oc4pr=0xffff;							//oc isr period
+void (*_oc4_isrptr)(void)=empty_handler;		//tmr1_ptr pointing to empty_handler by default
+//OC ISR
+void _ISR_PSV _OC4Interrupt(void) {				//for PIC24
+	ISR_ENTER();								//ISR_PROFILE
+	//clear the flag
+	IFS1bits.OC4IF = 0;							//clear the flag
+	OC4R += _oc4pr;								//update to the next match point
+#if defined(OC4_HANDLER)
+	OC4_HANDLER();						//bound at compile time
+#else
+	_oc4_isrptr();								//run user handler
+#endif
+	ISR_EXIT(IRQ_OC4);
+}
+
+void oc4Init(uint16_t pr) {
+	_oc4_isrptr=empty_handler;
+	_oc4pr = pr;								//reset the pr
+
+	//power up the pwm module
+	PMD2bits.OC4MD = 0;							//0->turn on the peripheral, 1->turn off the peripheral
+
+	//assign the output pins
+#if defined(PWM42RP)
+	PWM42RP();
+#endif
+
+	//tris pin presumed to have been set to output
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
+			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+	//OCxCON1 register settings
+	//reset the registers
+	OC4CON1 = 0x0000;
+	OC4CON2 = 0x0000;
+	OC4CON1bits.OCM = 0x03;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm, 0b011->continous pulse
+	OC4CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	//OC4R = OC4RS = TMR2 + _oc4pr;			//reset the duty cycle registers
+
+	IFS1bits.OC4IF = 0;						//0->clear the flag;
+	IEC1bits.OC4IE = 0;						//0->disable the interrupt, 1->enable the interrupt
+	irqApply(IRQ_OC4);					//set the interrupt priority
+
+	//OC4CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
+#else
+	//for ga002 devices
+	//OCxCON1 register settings
+	//reset the registers
+	OC4CON = 0x0000;
+	//OC4CON2 = 0x0000;
+	OC4CONbits.OCM = 0x03;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled, 0b011->compare toggles ocx
+	OC4CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	//OC4R = OC4RS = TMR2 + _oc4pr;			//reset the duty cycle registers
+
+	IFS1bits.OC4IF = 0;						//0->clear the flag;
+	IEC1bits.OC4IE = 0;						//0->disable the interrupt, 1->enable the interrupt
+	irqApply(IRQ_OC4);					//set the interrupt priority
+
+	//OC1CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
+#endif
+}
+
+//activate user isr
+void oc4AttachISR(void (*isrptr)(void)) {
+	_oc4_isrptr=isrptr;						//activate the isr handler
+	OC4R = TMR2 + _oc4pr;					//update to the next match point
+	IFS1bits.OC4IF = 0;						//0->clear the flag;
+	IEC1bits.OC4IE = 1;						//0->disable the interrupt, 1->enable the interrupt
+}
+
+//oc5
+uint16_t _oc5pr=0xffff;							//oc isr period
+void (*_oc5_isrptr)(void)=empty_handler;		//tmr1_ptr pointing to empty_handler by default
+//OC ISR
+void _ISR_PSV _OC5Interrupt(void) {				//for PIC24
+	ISR_ENTER();								//ISR_PROFILE
+	//clear the flag
+	IFS2bits.OC5IF = 0;							//clear the flag
+	OC5R += _oc5pr;								//update to the next match point
+#if defined(OC5_HANDLER)
+	OC5_HANDLER();						//bound at compile time
+#else
+	_oc5_isrptr();								//run user handler
+#endif
+	ISR_EXIT(IRQ_OC5);
+}
+
+void oc5Init(uint16_t pr) {
+	_oc5_isrptr=empty_handler;
+	_oc5pr = pr;								//reset the pr
+
+	//power up the pwm module
+	PMD2bits.OC5MD = 0;							//0->turn on the peripheral, 1->turn off the peripheral
+
+	//assign the output pins
+#if defined(PWM52RP)
+	PWM52RP();
+#endif
+
+	//tris pin presumed to have been set to output
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
+			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+	//OCxCON1 register settings
+	//reset the registers
+	OC5CON1 = 0x0000;
+	OC5CON2 = 0x0000;
+	OC5CON1bits.OCM = 0x03;					//0b110 -> edge aligned pwm, 0b111->center aligned pwm, 0b011->continous pulse
+	OC5CON1bits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	//OC5R = OC5RS = TMR2 + _oc5pr;			//reset the duty cycle registers
+
+	IFS2bits.OC5IF = 0;						//0->clear the flag;
+	IEC2bits.OC5IE = 0;						//0->disable the interrupt, 1->enable the interrupt
+	irqApply(IRQ_OC5);					//set the interrupt priority
+
+	//OC5CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
+#else
+	//for ga002 devices
+	//OCxCON1 register settings
+	//reset the registers
+	OC5CON = 0x0000;
+	//OC5CON2 = 0x0000;
+	OC5CONbits.OCM = 0x03;					//0b110 -> pwm on OCx, fault pin disabled, 0b111->pwm on OCx, fault pin enabled, 0b011->compare toggles ocx
+	OC5CONbits.OCTSEL = 0;					//0->timebase = timer2, 1->timebase = timer3
+	//OC5R = OC5RS = TMR2 + _oc5pr;			//reset the duty cycle registers
+
+	IFS2bits.OC5IF = 0;						//0->clear the flag;
+	IEC2bits.OC5IE = 0;						//0->disable the interrupt, 1->enable the interrupt
+	irqApply(IRQ_OC5);					//set the interrupt priority
+
+	//OC1CON1bits.ON= 1;						//1->turn on oc, 0->turn off oc
+#endif
+}
+
+//activate user isr
+void oc5AttachISR(void (*isrptr)(void)) {
+	_oc5_isrptr=isrptr;						//activate the isr handler
+	OC5R = TMR2 + _oc5pr;					//update to the next match point
+	IFS2bits.OC5IF = 0;						//0->clear the flag;
+	IEC2bits.OC5IE = 1;						//0->disable the interrupt, 1->enable the interrupt
+}
+//end output compare
+
+//servo
+//at each oc1 compare, the current servo pin goes low, the next one goes high and OC1R is advanced by its pulse width
+//once all servos are done, the rest of the frame is spent in steps that fit the 16-bit compare
+//oc1 runs with a 0 period so _OC1Interrupt() leaves OC1R alone: the servo isr advances it
+#define SERVO_GAP				0x8000					//max compare step while idling, in ticks
+#define SERVO_GAPMIN			0x100					//shortest compare step, in ticks. anything shorter is folded into the next frame
+static PIN_TypeDef _servo_pin[SERVO_CNT];				//servo pins
+static uint16_t _servo_us[SERVO_CNT];					//servo pulse widths, in us
+static volatile uint16_t _servo_pw[SERVO_CNT];			//servo pulse widths, in ticks
+static volatile uint8_t _servo_cnt=0;					//number of servos attached
+static volatile uint8_t _servo_ch=0;					//channel whose pulse is in progress. >=_servo_cnt -> idling
+static uint32_t _servo_frame;							//frame period, in ticks
+static uint32_t _servo_rem=0;							//ticks left in the current frame
+
+//servo isr - runs on oc1 compare
+static void _servo_isr(void) {
+	uint16_t pr;
+
+	if (_servo_ch < _servo_cnt) digitalWrite(_servo_pin[_servo_ch++], LOW);	//end the current pulse
+	if ((_servo_ch >= _servo_cnt) && (_servo_rem < SERVO_GAPMIN)) {		//frame done -> start a new one
+		_servo_ch = 0;
+		_servo_rem = _servo_frame;
+	}
+	if (_servo_ch < _servo_cnt) {						//start the next pulse
+		pr = _servo_pw[_servo_ch];
+		_servo_rem = (_servo_rem > pr)?(_servo_rem - pr):0;
+		digitalWrite(_servo_pin[_servo_ch], HIGH);
+	} else {											//idle for the rest of the frame
+		pr = (_servo_rem > SERVO_GAP)?SERVO_GAP:_servo_rem;
+		_servo_rem -= pr;
+	}
+	OC1R += pr;											//schedule the next compare
+}
+
+//initialize the servo driver on oc1
+void servoInit(void) {
+	_servo_cnt = 0;										//no servo attached
+	_servo_ch = 0;
+	_servo_rem = 0;
+	_servo_frame = SERVO_FRAME * cyclesPerMicrosecond();	//frame period, in ticks
+	oc1Init(0);											//0 period: the servo isr advances OC1R
+	oc1AttachISR(_servo_isr);							//install the servo isr
+	OC1R = TMR2 + SERVO_GAP;							//first compare
+}
+
+//attach a servo pin
+//return its channel, or SERVO_CNT if none is left
+uint8_t servoAttach(PIN_TypeDef pin) {
+	uint8_t ch = _servo_cnt;
+
+	if (ch >= SERVO_CNT) return SERVO_CNT;				//no channel left
+	digitalWrite(pin, LOW); pinMode(pin, OUTPUT);		//pin idles low
+	_servo_pin[ch] = pin;
+	servoWriteMicroseconds(ch, SERVO_MIDUS);			//center the servo
+	IEC0bits.OC1IE = 0;									//hold off the servo isr
+	if (_servo_ch >= ch) _servo_ch = ch + 1;			//idling -> stay idle for the rest of the frame
+	_servo_cnt = ch + 1;
+	IEC0bits.OC1IE = 1;
+	return ch;
+}
+
+//set servo position, 0..180 degrees
+void servoWrite(uint8_t ch, uint8_t angle) {
+	if (angle > 180) angle = 180;
+	servoWriteMicroseconds(ch, SERVO_MINUS + (uint32_t) (SERVO_MAXUS - SERVO_MINUS) * angle / 180);
+}
+
+//set servo pulse width, in us
+//takes effect from the channel's next pulse
+void servoWriteMicroseconds(uint8_t ch, uint16_t us) {
+	if (ch >= SERVO_CNT) return;
+	us = constrain(us, SERVO_MINUS, SERVO_MAXUS);
+	_servo_us[ch] = us;
+	_servo_pw[ch] = us * cyclesPerMicrosecond();		//16-bit write is atomic
+}
+
+//read servo pulse width, in us
+uint16_t servoReadMicroseconds(uint8_t ch) {
+	return (ch < SERVO_CNT)?_servo_us[ch]:0;
+}
+//end servo
+
+//tone
+//oc2 toggles its pin whenever timer3 rolls over -> f = F_PHB / prescaler / (PR3 + 1) / 2
+//oc5 times the notes off TMR2, in steps that fit the 16-bit compare. the player loads the next note from the oc5 isr
+#define TONE_STEP				0x8000					//max compare step, in ticks
+static const uint16_t _tone_oct8[]={4186, 4435, 4699, 4978, 5274, 5588, 5920, 6272, 6645, 7040, 7459, 7902};	//c8..b8, in Hz
+static volatile uint32_t _tone_rem=0;					//ticks left in the current note
+static volatile uint8_t _tone_busy=0;					//1->a timed tone / song is playing
+static const TONE_TypeDef *_tone_seq=NULL;				//note sequence being played
+static const char *_tone_rtttl=NULL;					//rtttl notes being played
+static uint8_t _tone_dur, _tone_oct;					//rtttl default duration and octave
+static uint32_t _tone_whole;							//rtttl whole note, in ms
+static uint16_t _tone_freq=0;							//frequency being played, for clkRetune()
+
+//power up oc2 and run it off timer3
+static void _tone_init(void) {
+	oc2Init(0);											//power up oc2 and map its pin
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	OC2CON1bits.OCM = 0;								//0->oc off
+	OC2CON1bits.OCTSEL = 1;								//1->timebase = timer3
+	OC2CON2bits.SYNCSEL = 0x0d;							//0x0d->synchronized to timer3
+#else
+	OC2CONbits.OCM = 0;									//0->oc off
+	OC2CONbits.OCTSEL = 1;								//0->timebase = timer2, 1->timebase = timer3
+#endif
+}
+
+//set the output frequency, 0->output off
+static void _tone_out(uint16_t freq) {
+	uint32_t pr;
+	uint8_t ps=0;										//timer3 prescaler: 0->1:1, 1->8:1, 2->64:1, 3->256:1
+
+	_tone_freq = freq;
+	if (freq == 0) {									//rest: stop the output
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+		OC2CON1bits.OCM = 0;							//0->oc off, pin low
+#else
+		OC2CONbits.OCM = 0;								//0->oc off, pin low
+#endif
+		T3CONbits.TON = 0;
+		return;
+	}
+	pr = F_PHB / 2 / freq;								//timer3 period at 1:1
+	if (pr > 0x10000ul) {pr >>= 3; ps = 1;}				//1:8
+	if (pr > 0x10000ul) {pr >>= 3; ps = 2;}				//1:64
+	if (pr > 0x10000ul) {pr >>= 2; ps = 3;}				//1:256
+	if (pr > 0x10000ul) pr = 0x10000ul;
+	if (pr == 0) pr = 1;
+	tmr3Init(ps, pr - 1);								//restart timer3
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	OC2CON1bits.OCM = 0;								//restart oc2 with its pin low
+	OC2R = 0;											//toggle at timer3 rollover
+	OC2CON1bits.OCM = 0x03;								//0b011->compare toggles ocx
+#else
+	OC2CONbits.OCM = 0;									//restart oc2 with its pin low
+	OC2R = 0;											//toggle at timer3 rollover
+	OC2CONbits.OCM = 0x03;								//0b011->compare toggles ocx
+#endif
+}
+
+//parse the next rtttl note: [duration]note[#][.][octave][.]
+//return its duration in ms, 0->end of the song
+static uint32_t _tone_nextRTTTL(uint16_t *freq) {
+	const char *p = _tone_rtttl;
+	uint8_t dur=0, oct=0, note, dot=0;
+	uint32_t ms;
+
+	while ((*p == ',') || (*p == ' ')) p++;
+	if (*p == 0) return 0;								//end of the song
+	while ((*p >= '0') && (*p <= '9')) dur = dur * 10 + (*p++ - '0');
+	if (dur == 0) dur = _tone_dur;
+	switch (*p | 0x20) {								//note, in semitones from c
+	case 'c': note = 0; break;
+	case 'd': note = 2; break;
+	case 'e': note = 4; break;
+	case 'f': note = 5; break;
+	case 'g': note = 7; break;
+	case 'a': note = 9; break;
+	case 'b': case 'h': note = 11; break;
+	default: note = 0xff; break;						//'p' -> pause
+	}
+	if (*p) p++;
+	if (*p == '#') {if (note != 0xff) note++; p++;}
+	if (*p == '.') {dot = 1; p++;}
+	if ((*p >= '0') && (*p <= '9')) oct = *p++ - '0';
+	if (*p == '.') {dot = 1; p++;}
+	while ((*p != ',') && (*p != 0)) p++;				//skip anything unknown
+	_tone_rtttl = p;
+
+	if (oct == 0) oct = _tone_oct;
+	if (oct > 8) oct = 8;
+	if (note == 12) {note = 0; oct++;}					//b# -> c of the next octave
+	*freq = ((note == 0xff) || (oct > 8))?0:(_tone_oct8[note] >> (8 - oct));
+	ms = _tone_whole / dur;
+	return dot?(ms + (ms >> 1)):ms;
+}
+
+//note length in ticks, saturated: ms * cyclesPerMillisecond() passes 2^32 after ~268s at 16MHz
+static uint32_t _tone_ticks(uint32_t ms) {
+	uint64_t t = (uint64_t) ms * cyclesPerMillisecond();
+
+	return (t > 0xfffffffful)?0xfffffffful:(uint32_t) t;
+}
+
+//load the next note of the sequence / song
+//return 0 when there is nothing left to play
+static uint8_t _tone_next(void) {
+	uint16_t freq=0;
+	uint32_t ms=0;
+
+	if (_tone_seq) {
+		ms = _tone_seq->ms; freq = _tone_seq->freq;
+		if (ms) _tone_seq++; else _tone_seq = NULL;
+	} else if (_tone_rtttl) {
+		ms = _tone_nextRTTTL(&freq);
+		if (ms == 0) _tone_rtttl = NULL;
+	}
+	if (ms == 0) return 0;
+	_tone_out(freq);
+	_tone_rem = _tone_ticks(ms);
+	return 1;
+}
+
+//schedule the next oc5 compare, from base towards the end of the current note
+//steps are kept away from 0 so no compare is scheduled in the past
+static void _tone_step(uint16_t base) {
+	uint16_t pr;
+
+	pr = (_tone_rem > 2 * TONE_STEP)?TONE_STEP:((_tone_rem > TONE_STEP)?(_tone_rem >> 1):_tone_rem);
+	_tone_rem -= pr;
+	OC5R = base + pr;
+}
+
+//tone isr - runs on oc5 compare
+static void _tone_isr(void) {
+	if ((_tone_rem == 0) && (_tone_next() == 0)) {		//note done and nothing else to play
+		_tone_out(0);
+		IEC2bits.OC5IE = 0;
+		_tone_busy = 0;
+		return;
+	}
+	_tone_step(OC5R);
+}
+
+//start timing the current note on oc5
+static void _tone_start(void) {
+	oc5Init(0);											//0 period: the tone isr advances OC5R
+	_tone_busy = 1;
+	oc5AttachISR(_tone_isr);
+	_tone_step(TMR2);
+}
+
+//play freq Hz for ms milliseconds
+//ms=0->until noTone()
+void tone(uint16_t freq, uint32_t ms) {
+	noTone();
+	_tone_init();
+	_tone_out(freq);
+	if (ms == 0) return;
+	_tone_rem = _tone_ticks(ms);
+	_tone_start();
+}
+
+//stop the tone / player
+void noTone(void) {
+	IEC2bits.OC5IE = 0;									//stop timing
+	_tone_seq = NULL; _tone_rtttl = NULL;
+	_tone_busy = 0;
+	_tone_out(0);
+}
+
+//play a note sequence in the background
+//the sequence is terminated by a note with ms=0 and must stay valid while being played
+void tonePlay(const TONE_TypeDef *seq) {
+	noTone();
+	_tone_init();
+	_tone_seq = seq;
+	if (_tone_next()) _tone_start();
+}
+
+//play a rtttl song in the background
+//"name:d=4,o=5,b=63:notes". the song must stay valid while being played
+void tonePlayRTTTL(const char *song) {
+	const char *p = song;
+	uint16_t val;
+	char key;
+
+	noTone();
+	_tone_init();
+	_tone_dur = 4; _tone_oct = 6; _tone_whole = 240000ul / 63;	//rtttl defaults: d=4, o=6, b=63
+	while ((*p != ':') && (*p != 0)) p++;				//skip the name
+	if (*p) p++;
+	while ((*p != ':') && (*p != 0)) {					//defaults section
+		key = *p++ | 0x20;
+		if (*p == '=') p++;
+		val = 0;
+		while ((*p >= '0') && (*p <= '9')) val = val * 10 + (*p++ - '0');
+		if ((key == 'd') && val) _tone_dur = val;
+		if ((key == 'o') && val) _tone_oct = val;
+		if ((key == 'b') && val) _tone_whole = 240000ul / val;	//4 beats in a whole note
+		while ((*p == ',') || (*p == ' ')) p++;
+	}
+	if (*p) p++;
+	_tone_rtttl = p;
+	if (_tone_next()) _tone_start();
+}
+
+//1->a timed tone / song is playing
+uint8_t toneBusy(void) {
+	return _tone_busy;
+}
+//end tone
+
+//stepper
+//each axis runs its oc in toggle mode: a rising edge every other compare is one step, and _OCxInterrupt()
+//advances OCxR by _ocxpr = half the step period. the step isr runs the ramp once per step:
+//p' = p * (1 -/+ m * p^2), m = accel / F_PHB^2 (multiplications only), with p in 16.16 ticks
+#define STEPPER_MARGIN			0x100					//min lead of a compare over TMR2, in ticks
+#define STEPPER_IDLE			0						//axis states
+#define STEPPER_ACCEL			1
+#define STEPPER_CRUISE			2
+#define STEPPER_DECEL			3
+typedef struct {
+	uint16_t *pr;										//_ocxpr of the axis' oc
+	volatile uint16_t *ocr;								//OCxR
+	volatile uint16_t *con;								//OCxCON / OCxCON1
+	PIN_TypeDef dir;									//direction pin
+	volatile uint8_t state;								//STEPPER_IDLE..STEPPER_DECEL
+	uint8_t phase;										//1->step pin high
+	uint8_t late;										//1->a compare was missed during this step
+	int8_t inc;											//+1/-1 per step
+	volatile int32_t pos;								//position, in steps
+	uint32_t rem;										//steps left in the move
+	uint32_t done;										//steps done in the move
+	uint32_t nacc;										//steps spent accelerating
+	uint32_t p;											//step period, in 16.16 ticks
+	uint32_t pc;										//cruise period, in 16.16 ticks
+	uint32_t m;											//accel / F_PHB^2, scaled by 2^48
+	uint16_t pmin;										//shortest step period met, in ticks
+	uint16_t ovr;										//steps the isr was too late for
+} STEPPER_TypeDef;
+static STEPPER_TypeDef _stepper[STEPPER_AXES];
+#define OC4_FREE				0						//oc4 users: stepper axis 1 or the timer wheel, first one in keeps it
+#define OC4_STEPPER				1
+#define OC4_TMW					2
+static uint8_t _oc4_user=OC4_FREE;
+
+//step period change for the ramp: p * m * p^2, in 16.16 ticks
+static uint32_t _stepper_delta(uint16_t p, uint32_t m) {
+	uint32_t pp = (uint32_t) p * p;						//p^2
+	uint16_t ph = pp >> 16, pl = pp, mh = m >> 16, ml = m;
+	uint32_t q;
+
+	q = (uint32_t) ph * mh + (((uint32_t) ph * ml) >> 16) + (((uint32_t) pl * mh) >> 16);	//(p^2 * m) >> 32 = m * p^2 in 0.16
+	if (q > 0xffff) q = 0xffff;
+	return (uint32_t) p * (uint16_t) q;
+}
+
+//integer square root
+static uint32_t _stepper_sqrt(uint32_t x) {
+	uint32_t r=0, b=1ul<<30;
+
+	while (b > x) b >>= 2;
+	while (b) {
+		if (x >= r + b) {x -= r + b; r = (r >> 1) + b;}
+		else r >>= 1;
+		b >>= 2;
+	}
+	return r;
+}
+
+//step isr - runs on every compare of the axis' oc
+static void _stepper_isr(STEPPER_TypeDef *a) {
+	uint32_t d;
+
+	if ((int16_t) (*a->ocr - TMR2) < STEPPER_MARGIN / 4) {	//next compare about to be missed -> push it out
+		*a->ocr = TMR2 + STEPPER_MARGIN;
+		a->late = 1;
+	}
+	a->phase ^= 1;
+	if (a->phase == 0) {								//falling edge: step done
+		if (a->rem == 0) {								//move done: stop with the pin low
+			*a->con &= ~0x07;							//0b000->oc off
+			a->state = STEPPER_IDLE;
+		}
+		return;
+	}
+
+	//rising edge: one step out
+	a->pos += a->inc;
+	a->rem--; a->done++;
+	if (a->late) {a->ovr++; a->late = 0;}
+	else if ((a->p >> 16) < a->pmin) a->pmin = a->p >> 16;
+
+	//next step period
+	switch (a->state) {
+	case STEPPER_ACCEL:
+		if (a->rem <= a->done) {a->state = STEPPER_DECEL; break;}	//half way without reaching vmax
+		d = _stepper_delta(a->p >> 16, a->m);
+		if (a->p > a->pc + d) a->p -= d;
+		else {a->p = a->pc; a->nacc = a->done; a->state = STEPPER_CRUISE;}
+		break;
+	case STEPPER_CRUISE:
+		if (a->rem <= a->nacc) a->state = STEPPER_DECEL;
+		break;
+	case STEPPER_DECEL:
+		d = _stepper_delta(a->p >> 16, a->m);
+		a->p = (a->p < 0xffff0000ul - d)?(a->p + d):0xffff0000ul;
+		break;
+	}
+	*a->pr = a->p >> 17;								//half a step period per compare
+}
+
+static void _stepper0_isr(void) {_stepper_isr(&_stepper[0]);}
+#if STEPPER_AXES > 1
+static void _stepper1_isr(void) {_stepper_isr(&_stepper[1]);}
+#endif
+
+//initialize an axis, with its direction pin
+//axis 0 steps on oc3, axis 1 on oc4
+void stepperInit(uint8_t axis, PIN_TypeDef dir) {
+	STEPPER_TypeDef *a;
+
+	if (axis >= STEPPER_AXES) return;
+	if ((axis == 1) && (_oc4_user == OC4_TMW)) return;	//oc4 runs the timer wheel
+	a = &_stepper[axis];
+	memset(a, 0, sizeof(STEPPER_TypeDef));
+	a->dir = dir; a->inc = 1; a->pmin = 0xffff;
+	digitalWrite(dir, LOW); pinMode(dir, OUTPUT);
+	switch (axis) {
+	case 0:
+		oc3Init(0xffff);								//toggle mode off TMR2
+		a->pr = &_oc3pr; a->ocr = &OC3R;
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+		a->con = &OC3CON1;
+		OC3CON2bits.SYNCSEL = 0x0c;						//0x0c->synchronized to timer2: OC3TMR counts with TMR2, so OC3R is a TMR2 value
+		OC3TMR = TMR2;
+#else
+		a->con = &OC3CON;
+#endif
+		*a->con &= ~0x07;								//oc off until a move starts
+		oc3AttachISR(_stepper0_isr);
+		break;
+#if STEPPER_AXES > 1
+	case 1:
+		_oc4_user = OC4_STEPPER;
+		oc4Init(0xffff);								//toggle mode off TMR2
+		a->pr = &_oc4pr; a->ocr = &OC4R;
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+		a->con = &OC4CON1;
+		OC4CON2bits.SYNCSEL = 0x0c;						//0x0c->synchronized to timer2: OC4TMR counts with TMR2, so OC4R is a TMR2 value
+		OC4TMR = TMR2;
+#else
+		a->con = &OC4CON;
+#endif
+		*a->con &= ~0x07;								//oc off until a move starts
+		oc4AttachISR(_stepper1_isr);
+		break;
+#endif
+	}
+}
+
+//relative move: steps>0 -> dir pin high
+//vmax in steps/s, accel in steps/s^2. the divisions are done here, once per move
+void stepperMove(uint8_t axis, int32_t steps, uint32_t vmax, uint32_t accel) {
+	STEPPER_TypeDef *a;
+	uint32_t f = F_PHB, p0, pc;
+
+	if ((axis >= STEPPER_AXES) || (steps == 0) || (vmax == 0) || (accel == 0)) return;
+	a = &_stepper[axis];
+	if (a->con == NULL) return;							//stepperInit() not called for this axis
+	stepperStop(axis);
+	a->inc = (steps > 0)?1:-1;
+	digitalWrite(a->dir, (steps > 0)?HIGH:LOW);
+	a->rem = (steps > 0)?steps:-steps;
+	a->done = 0; a->nacc = 0; a->phase = 0; a->late = 0;
+
+	pc = f / vmax;										//cruise period, in ticks
+	pc = constrain(pc, STEPPER_PMIN, 0xffff);
+	p0 = f / (_stepper_sqrt(accel << 1) + 1);			//first step: p0 = F / sqrt(2 * accel)
+	p0 = constrain(p0, pc, 0xffff);
+	a->m = (((((uint64_t) accel) << 32) / f) << 16) / f;	//accel / F^2 * 2^48
+	a->pc = pc << 16;
+	a->p = p0 << 16;
+	a->state = (p0 > pc)?STEPPER_ACCEL:STEPPER_CRUISE;
+
+	*a->pr = p0 >> 1;									//half a step period per compare
+	*a->ocr = TMR2 + STEPPER_MARGIN;					//first step
+	*a->con |= 0x03;									//0b011->compare toggles ocx, starting low
+}
+
+//stop immediately, pin low
+void stepperStop(uint8_t axis) {
+	if ((axis >= STEPPER_AXES) || (_stepper[axis].con == NULL)) return;	//no such axis, or not initialized
+	*_stepper[axis].con &= ~0x07;						//0b000->oc off
+	_stepper[axis].state = STEPPER_IDLE;
+}
+
+//1->axis is moving
+uint8_t stepperBusy(uint8_t axis) {
+	return (axis < STEPPER_AXES) && (_stepper[axis].state != STEPPER_IDLE);
+}
+
+//current position, in steps
+int32_t stepperPosition(uint8_t axis) {
+	int32_t pos;
+
+	if (axis >= STEPPER_AXES) return 0;
+	do pos = _stepper[axis].pos; while (pos != _stepper[axis].pos);	//32-bit read is not atomic
+	return pos;
+}
+
+//max sustained step rate achieved, in steps/s: shortest step period met without a missed compare
+uint32_t stepperMaxRate(uint8_t axis) {
+	if ((axis >= STEPPER_AXES) || (_stepper[axis].pmin == 0xffff)) return 0;
+	return F_PHB / _stepper[axis].pmin;
+}
+
+//number of steps the isr was too late for
+uint16_t stepperOverruns(uint8_t axis) {
+	return (axis < STEPPER_AXES)?_stepper[axis].ovr:0;
+}
+//end stepper
+
+//software timers
+//4 levels of 32 slots: a timer due d granules from the wheel time sits in level 0 if d < 32, level 1 if d < 32^2, ...
+//a level 1..3 slot is moved down when the wheel time reaches its start; level 0 slots expire
+//the wheel time only advances in the isr, skipping from one event to the next with the slot bitmaps
+#define TMW_BITS				5				//32 slots per level
+#define TMW_SLOTS				(1 << TMW_BITS)
+#define TMW_LEVELS				4
+#define TMW_FAR					0x7000			//max oc4 step, in ticks
+
+static TMW_TypeDef *_tmw_wheel[TMW_LEVELS * TMW_SLOTS];	//slot lists
+static uint32_t _tmw_map[TMW_LEVELS];			//1->slot not empty
+static uint32_t _tmw_g=0;						//wheel time, in granules
+static uint32_t _tmw_t=0;						//ticks at the start of granule _tmw_g
+static uint16_t _tmw_cnt=0;						//timers running
+
+//granule due for tick due, rounded up
+static uint32_t _tmw_gran(uint32_t due) {
+	int32_t dt = due - _tmw_t;
+
+	return (dt <= 0)?_tmw_g:(_tmw_g + ((dt + (1ul << TMW_SHIFT) - 1) >> TMW_SHIFT));
+}
+
+//put a timer into its slot, from the wheel time
+//now=1: may go into the current granule, which _tmw_step() is about to expire. now=0: next granule at the earliest
+static void _tmw_place(TMW_TypeDef *tmr, uint8_t now) {
+	uint32_t g = _tmw_gran(tmr->due), d = g - _tmw_g;
+	uint8_t lvl, slot;
+
+	if ((int32_t) d < (int32_t) (1 - now)) {d = 1 - now; g = _tmw_g + d;}	//already due
+	if (d >= (1ul << (TMW_BITS * TMW_LEVELS))) {	//beyond the wheel: park in the farthest slot, placed again from there
+		d = (1ul << (TMW_BITS * TMW_LEVELS)) - 1; g = _tmw_g + d;
+	}
+	for (lvl = 0; d >= TMW_SLOTS; lvl++) d >>= TMW_BITS;
+	slot = lvl * TMW_SLOTS + ((g >> (TMW_BITS * lvl)) & (TMW_SLOTS - 1));
+
+	tmr->prev = NULL;
+	tmr->next = _tmw_wheel[slot];
+	if (tmr->next) tmr->next->prev = tmr;
+	_tmw_wheel[slot] = tmr;
+	_tmw_map[lvl] |= 1ul << (slot & (TMW_SLOTS - 1));
+	tmr->slot = slot + 1;
+	_tmw_cnt++;
+}
+
+//take a timer out of its slot
+static void _tmw_unlink(TMW_TypeDef *tmr) {
+	uint8_t slot = tmr->slot - 1;
+
+	if (tmr->next) tmr->next->prev = tmr->prev;
+	if (tmr->prev) tmr->prev->next = tmr->next;
+	else if ((_tmw_wheel[slot] = tmr->next) == NULL) _tmw_map[slot >> TMW_BITS] &= ~(1ul << (slot & (TMW_SLOTS - 1)));
+	tmr->slot = 0;
+	_tmw_cnt--;
+}
+
+//distance from slot from to the first busy slot at or after it, circularly. TMW_SLOTS if none
+static uint8_t _tmw_scan(uint32_t map, uint8_t from) {
+	if (map == 0) return TMW_SLOTS;
+	if (from) map = (map >> from) | (map << (TMW_SLOTS - from));
+	if ((uint16_t) map) return __builtin_ff1r((uint16_t) map) - 1;
+	return __builtin_ff1r((uint16_t) (map >> 16)) + 15;
+}
+
+//next granule with something to do: a level 0 slot to expire or a higher slot to move down
+static uint32_t _tmw_next(void) {
+	uint32_t g, next = _tmw_g + 0x7ffffffful;
+	uint8_t lvl, cur, n;
+
+	for (lvl = 0; lvl < TMW_LEVELS; lvl++) {
+		cur = (_tmw_g >> (TMW_BITS * lvl)) & (TMW_SLOTS - 1);
+		n = _tmw_scan(_tmw_map[lvl], (cur + 1) & (TMW_SLOTS - 1));
+		if (n >= TMW_SLOTS) continue;
+		g = ((_tmw_g >> (TMW_BITS * lvl)) + n + 1) << (TMW_BITS * lvl);	//start of that slot
+		if ((int32_t) (g - next) < 0) next = g;
+	}
+	return next;
+}
+
+//wheel time reaches granule g: move higher slots down, then expire the level 0 slot
+static void _tmw_step(uint32_t g) {
+	TMW_TypeDef *tmr;
+	uint8_t lvl, slot;
+
+	for (lvl = TMW_LEVELS - 1; lvl > 0; lvl--) {
+		if (g & ((1ul << (TMW_BITS * lvl)) - 1)) continue;	//not at a slot start on this level
+		slot = lvl * TMW_SLOTS + ((g >> (TMW_BITS * lvl)) & (TMW_SLOTS - 1));
+		while ((tmr = _tmw_wheel[slot]) != NULL) {_tmw_unlink(tmr); _tmw_place(tmr, 1);}
+	}
+	slot = g & (TMW_SLOTS - 1);
+	while ((tmr = _tmw_wheel[slot]) != NULL) {	//callbacks may start and stop timers
+		_tmw_unlink(tmr);
+		if (tmr->period) {tmr->due += tmr->period; _tmw_place(tmr, 0);}	//rearm before the callback, so it can stop itself
+		tmr->func(tmr->arg);
+	}
+}
+
+//set oc4 for the next event, or leave it off with no timer running
+static void _tmw_arm(void) {
+	uint32_t target;
+
+	if (_tmw_cnt == 0) {IEC1bits.OC4IE = 0; return;}
+	target = _tmw_t + ((_tmw_next() - _tmw_g) << TMW_SHIFT);
+	if ((int32_t) (target - ticks()) > TMW_FAR) target = ticks() + TMW_FAR;	//16-bit compare: step towards it
+	IFS1bits.OC4IF = 0;
+	OC4R = target;
+	if ((int32_t) (ticks() - target) >= 0) IFS1bits.OC4IF = 1;	//already past: don't wait for TMR2 to wrap
+	IEC1bits.OC4IE = 1;
+}
+
+//oc4 isr: advance the wheel time to now, event by event
+static void _tmw_isr(void) {
+	uint32_t g = _tmw_g + ((ticks() - _tmw_t) >> TMW_SHIFT), next;
+
+	while (_tmw_cnt && ((int32_t) ((next = _tmw_next()) - g) <= 0)) {
+		_tmw_t += (next - _tmw_g) << TMW_SHIFT;
+		_tmw_g = next;
+		_tmw_step(next);
+	}
+	_tmw_t += (g - _tmw_g) << TMW_SHIFT;
+	_tmw_g = g;
+	_tmw_arm();
+}
+
+//take an output function off whichever RPn pins it is mapped to: the pins go back to their port latches
+#if defined(_RP16R)
+#define RPOR_CNT				13				//RPOR0..12: RP0..25
+#else
+#define RPOR_CNT				8				//RPOR0..7: RP0..15
+#endif
+static void _tmw_unmap(uint8_t func) {
+	volatile uint16_t *rpor = &RPOR0;
+	uint8_t i;
+
+	for (i = 0; i < RPOR_CNT; i++) {
+		if ((rpor[i] & 0x003f) == func) rpor[i] &=~0x003f;
+		if ((rpor[i] & 0x3f00) == ((uint16_t) func << 8)) rpor[i] &=~0x3f00;
+	}
+}
+
+//take over oc4, unless stepper axis 1 has it: tmwStart() then does nothing
+//oc4 runs as a pure compare: its output is unmapped so the toggles at each compare reach no pin
+void tmwInit(void) {
+	if (_oc4_user == OC4_STEPPER) return;		//oc4 steps axis 1
+	_oc4_user = OC4_TMW;
+	oc4Init(0);									//compare advanced by _tmw_arm()
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	OC4CON2bits.SYNCSEL = 0x0c;					//0x0c->synchronized to timer2: OC4R compares against TMR2 values
+	OC4TMR = TMR2;
+#endif
+	_tmw_unmap(21);								//21->oc4 output, mapped by PWM42RP()
+	oc4AttachISR(_tmw_isr);
+	IEC1bits.OC4IE = 0;							//on once a timer runs
+	_tmw_cnt = 0;
+	memset(_tmw_wheel, 0, sizeof(_tmw_wheel));
+	memset(_tmw_map, 0, sizeof(_tmw_map));
+}
+
+//call func(arg) in delay ticks, then every period ticks (0->once)
+void tmwStart(TMW_TypeDef *tmr, uint32_t delay, uint32_t period, void (*func)(void *arg), void *arg) {
+	uint32_t now, g;
+
+	if (_oc4_user != OC4_TMW) return;			//no tmwInit(), or oc4 taken by the stepper
+	IEC1bits.OC4IE = 0;							//hold off the isr
+	if (tmr->slot) _tmw_unlink(tmr);			//restart
+	now = ticks();
+	if (_tmw_cnt == 0) {						//idle wheel: catch up with now
+		g = (now - _tmw_t) >> TMW_SHIFT;
+		_tmw_g += g; _tmw_t += g << TMW_SHIFT;
+	}
+	tmr->due = now + delay;
+	tmr->period = period;
+	tmr->func = func; tmr->arg = arg;
+	_tmw_place(tmr, 0);
+	_tmw_arm();
+}
+
+//cancel a timer
+void tmwStop(TMW_TypeDef *tmr) {
+	if (_oc4_user != OC4_TMW) return;			//leave the stepper's oc4 interrupt alone
+	IEC1bits.OC4IE = 0;							//hold off the isr
+	if (tmr->slot) _tmw_unlink(tmr);
+	_tmw_arm();
+}
+//end software timers
+
+//input capture
+static void (*_ic1_isrptr)(void)=empty_handler;	//function pointer pointing to empty_handler by default
+//volatile uint16_t IC1DAT=0;						//buffer
+
+//input capture ISR
+void _ISR_PSV _IC1Interrupt(void) {				//for PIC24
+	ISR_ENTER();								//ISR_PROFILE
+	//clear the flag
+	//IC1DAT = IC1BUF;							//read the captured value
+	IFS0bits.IC1IF = 0;							//clear the flag after the buffer has been read (the interrupt flag is persistent)
+#if defined(IC1_HANDLER)
+	IC1_HANDLER();						//bound at compile time
+#else
+	_ic1_isrptr();								//run user handler
+#endif
+	ISR_EXIT(IRQ_IC1);
+}
+
+//reset input capture 1
+//16-bit mode, rising edge, single capture, Timer2 as timebase
+//interrupt disabled
+void ic1Init(void) {
+	_ic1_isrptr = empty_handler;				//reset user handler
+
+	IC12RP();									//assign pin to IC
+	PMD2bits.IC1MD = 0;							//0->enable power to input capture
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
+			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+	IC1CON1 = 0;						//reset to default value
+	IC1CON2 = 0;						//reset to default value
+	IC1CON1  = 	(0<<15) |				//1->enable the module, 0->disable the module
+				(0<<13) |				//0->operates in idle, 1->don't operate in idle
+				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
+				(0<<8) |				//1->32-bit mode, 0->16-bit mode
+				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
+				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
+				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
+				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
+				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
+				0x00;
+
+	while (IC1CON1bits.ICBNE) IC1BUF;	//read the buffer to clear the flag
+	IFS0bits.IC1IF   = 0;				//0->clear the flag
+	IEC0bits.IC1IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
+	irqApply(IRQ_IC1);					//set the interrupt priority
+	//enable the input capture
+	//IC1CON1bits.ON = 1;				//1->enable the module, 0->disable the module
+#else
+	//for ga002 devices
+	IC1CON = 0;							//reset to default value
+	//IC1CON2 = 0;						//reset to default value
+	IC1CON  = 	(0<<15) |				//1->enable the module, 0->disable the module
+				(0<<13) |				//0->operates in idle, 1->don't operate in idle
+				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
+				(0<<8) |				//1->32-bit mode, 0->16-bit mode
+				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
+				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
+				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
+				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
+				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
+				0x00;
+
+	while (IC1CONbits.ICBNE) IC1BUF;	//read the buffer to clear the flag
+	IFS0bits.IC1IF   = 0;				//0->clear the flag
+	IEC0bits.IC1IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
+	irqApply(IRQ_IC1);					//set the interrupt priority
+	//enable the input capture
+	//IC1CONbits.ON = 1;				//1->enable the module, 0->disable the module
+#endif
+	//input capture running now
+}
+
+//activate user ptr
+void ic1AttachISR(void (*isrptr)(void)) {
+	_ic1_isrptr = isrptr;				//install user ptr
+	//IC1BUF;								//read the buffer to clear the flag
+	IFS0bits.IC1IF   = 0;				//0->clear the flag
+	irqApply(IRQ_IC1);					//set the interrupt priority
+	IEC0bits.IC1IE   = 1;				//1->enable the interrupt, 0->disable the interrupt
+}
+
+static void (*_ic2_isrptr)(void)=empty_handler;				//function pointer pointing to empty_handler by default
+//volatile uint16_t IC2DAT=0;				//buffer
+
+//input capture ISR
+void _ISR_PSV _IC2Interrupt(void) {		//for PIC24
+	ISR_ENTER();								//ISR_PROFILE
+	//clear the flag
+	//IC2DAT = IC2BUF;					//read the captured value
+	IFS0bits.IC2IF = 0;					//clear the flag after the buffer has been read (the interrupt flag is persistent)
+#if defined(IC2_HANDLER)
+	IC2_HANDLER();						//bound at compile time
+#else
+	_ic2_isrptr();						//run user handler
+#endif
+	ISR_EXIT(IRQ_IC2);
+}
+
+//reset input capture 1
+//16-bit mode, rising edge, single capture, Timer2 as timebase
+//interrupt disabled
+void ic2Init(void) {
+	_ic2_isrptr = empty_handler;		//reset user handler
+
+	IC22RP();							//assign pin to IC
+	PMD2bits.IC2MD = 0;					//0->enable power to input capture
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
+			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+	IC2CON1 = 0;						//reset to default value
+	IC2CON2 = 0;						//reset to default value
+	IC2CON1  = 	(0<<15) |				//1->enable the module, 0->disable the module
+				(0<<13) |				//0->operates in idle, 1->don't operate in idle
+				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
+				(0<<8) |				//1->32-bit mode, 0->16-bit mode
+				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
+				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
+				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
+				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
+				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
+				0x00;
+
+	while (IC2CON1bits.ICBNE) IC2BUF;	//read the buffer to clear the flag
+	IFS0bits.IC2IF   = 0;				//0->clear the flag
+	IEC0bits.IC2IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
+	irqApply(IRQ_IC2);					//set the interrupt priority
+	//enable the input capture
+	//IC2CON1bits.ON = 1;				//1->enable the module, 0->disable the module
+#else
+	//for ga002 devices
+	IC2CON = 0;							//reset to default value
+	//IC2CON2 = 0;						//reset to default value
+	IC2CON  = 	(0<<15) |				//1->enable the module, 0->disable the module
+				(0<<13) |				//0->operates in idle, 1->don't operate in idle
+				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
+				(0<<8) |				//1->32-bit mode, 0->16-bit mode
+				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
+				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
+				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
+				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
+				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
+				0x00;
+
+	while (IC2CONbits.ICBNE) IC2BUF;	//read the buffer to clear the flag
+	IFS0bits.IC2IF   = 0;				//0->clear the flag
+	IEC0bits.IC2IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
+	irqApply(IRQ_IC2);					//set the interrupt priority
+	//enable the input capture
+	//IC2CONbits.ON = 1;				//1->enable the module, 0->disable the module
+#endif
+}
+
+//activate user ptr
+void ic2AttachISR(void (*isrptr)(void)) {
+	_ic2_isrptr = isrptr;				//install user ptr
+	//IC2BUF;								//read the buffer to clear the flag
+	IFS0bits.IC2IF   = 0;				//0->clear the flag
+	irqApply(IRQ_IC2);					//set the interrupt priority
+	IEC0bits.IC2IE   = 1;				//1->enable the interrupt, 0->disable the interrupt
+}
+
+static void (*_ic3_isrptr)(void)=empty_handler;				//function pointer pointing to empty_handler by default
+//volatile uint16_t IC3DAT=0;				//buffer
+
+//input capture ISR
+void _ISR_PSV _IC3Interrupt(void) {		//for PIC24
+	ISR_ENTER();								//ISR_PROFILE
+	//clear the flag
+	//IC3DAT = IC3BUF;					//read the captured value
+	IFS2bits.IC3IF = 0;					//clear the flag after the buffer has been read (the interrupt flag is persistent)
+#if defined(IC3_HANDLER)
+	IC3_HANDLER();						//bound at compile time
+#else
+	_ic3_isrptr();						//run user handler
+#endif
+	ISR_EXIT(IRQ_IC3);
+}
+
+//reset input capture 1
+//16-bit mode, rising edge, single capture, Timer2 as timebase
+//interrupt disabled
+void ic3Init(void) {
+	_ic3_isrptr = empty_handler;		//reset user handler
+
+	IC32RP();							//assign pin to IC
+	PMD2bits.IC3MD = 0;					//0->enable power to input capture
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
+			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+	IC3CON1 = 0;						//reset to default value
+	IC3CON2 = 0;						//reset to default value
+	IC3CON1  = 	(0<<15) |				//1->enable the module, 0->disable the module
+				(0<<13) |				//0->operates in idle, 1->don't operate in idle
+				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
+				(0<<8) |				//1->32-bit mode, 0->16-bit mode
+				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
+				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
+				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
+				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
+				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
+				0x00;
+
+	while (IC3CON1bits.ICBNE) IC3BUF;	//read the buffer to clear the flag
+	IFS2bits.IC3IF   = 0;				//0->clear the flag
+	IEC2bits.IC3IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
+	irqApply(IRQ_IC3);					//set the interrupt priority
+	//enable the input capture
+	//IC3CON1bits.ON = 1;				//1->enable the module, 0->disable the module
+	//input capture running now
+#else
+	//for ga002 devices
+	IC3CON = 0;							//reset to default value
+	//IC3CON2 = 0;						//reset to default value
+	IC3CON  = 	(0<<15) |				//1->enable the module, 0->disable the module
+				(0<<13) |				//0->operates in idle, 1->don't operate in idle
+				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
+				(0<<8) |				//1->32-bit mode, 0->16-bit mode
+				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
+				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
+				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
+				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
+				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
+				0x00;
+
+	while (IC3CONbits.ICBNE) IC3BUF;	//read the buffer to clear the flag
+	IFS2bits.IC3IF   = 0;				//0->clear the flag
+	IEC2bits.IC3IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
+	irqApply(IRQ_IC3);					//set the interrupt priority
+	//enable the input capture
+	//IC3CONbits.ON = 1;				//1->enable the module, 0->disable the module
+#endif
+}
+
+//activate user ptr
+void ic3AttachISR(void (*isrptr)(void)) {
+	_ic3_isrptr = isrptr;				//install user ptr
+	//IC3BUF;								//read the buffer to clear the flag
+	IFS2bits.IC3IF   = 0;				//0->clear the flag
+	irqApply(IRQ_IC3);					//set the interrupt priority
+	IEC2bits.IC3IE   = 1;				//1->enable the interrupt, 0->disable the interrupt
+}
+
+static void (*_ic4_isrptr)(void)=empty_handler;				//function pointer pointing to empty_handler by default
+//volatile uint16_t IC4DAT=0;				//buffer
+
+//input capture ISR
+void _ISR_PSV _IC4Interrupt(void) {		//for PIC24
+	ISR_ENTER();								//ISR_PROFILE
+	//clear the flag
+	//IC4DAT = IC4BUF;					//read the captured value
+	IFS2bits.IC4IF = 0;					//clear the flag after the buffer has been read (the interrupt flag is persistent)
+#if defined(IC4_HANDLER)
+	IC4_HANDLER();						//bound at compile time
+#else
+	_ic4_isrptr();						//run user handler
+#endif
+	ISR_EXIT(IRQ_IC4);
+}
+
+//reset input capture 1
+//16-bit mode, rising edge, single capture, Timer2 as timebase
+//interrupt disabled
+void ic4Init(void) {
+	_ic4_isrptr = empty_handler;		//reset user handler
+
+	IC42RP();							//assign pin to IC
+	PMD2bits.IC4MD = 0;					//0->enable power to input capture
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
+			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+	IC4CON1 = 0;						//reset to default value
+	IC4CON2 = 0;						//reset to default value
+	IC4CON1  = 	(0<<15) |				//1->enable the module, 0->disable the module
+				(0<<13) |				//0->operates in idle, 1->don't operate in idle
+				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
+				(0<<8) |				//1->32-bit mode, 0->16-bit mode
+				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
+				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
+				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
+				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
+				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
+				0x00;
+
+	while (IC4CON1bits.ICBNE) IC4BUF;	//read the buffer to clear the flag
+	IFS2bits.IC4IF   = 0;				//0->clear the flag
+	IEC2bits.IC4IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
+	irqApply(IRQ_IC4);					//set the interrupt priority
+	//enable the input capture
+	//IC4CON1bits.ON = 1;				//1->enable the module, 0->disable the module
+	//input capture running now
+#else
+	//for ga002 devices
+	IC4CON = 0;							//reset to default value
+	//IC4CON2 = 0;						//reset to default value
+	IC4CON  = 	(0<<15) |				//1->enable the module, 0->disable the module
+				(0<<13) |				//0->operates in idle, 1->don't operate in idle
+				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
+				(0<<8) |				//1->32-bit mode, 0->16-bit mode
+				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
+				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
+				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
+				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
+				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
+				0x00;
+
+	while (IC4CONbits.ICBNE) IC4BUF;	//read the buffer to clear the flag
+	IFS2bits.IC4IF   = 0;				//0->clear the flag
+	IEC2bits.IC4IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
+	irqApply(IRQ_IC4);					//set the interrupt priority
+	//enable the input capture
+	//IC4CONbits.ON = 1;				//1->enable the module, 0->disable the module
+#endif
+}
+
+//activate user ptr
+void ic4AttachISR(void (*isrptr)(void)) {
+	_ic4_isrptr = isrptr;				//install user ptr
+	//IC4BUF;								//read the buffer to clear the flag
+	IFS2bits.IC4IF   = 0;				//0->clear the flag
+	irqApply(IRQ_IC4);					//set the interrupt priority
+	IEC2bits.IC4IE   = 1;				//1->enable the interrupt, 0->disable the interrupt
+}
+
+static void (*_ic5_isrptr)(void)=empty_handler;				//function pointer pointing to empty_handler by default
+//volatile uint16_t IC5DAT=0;				//buffer
+
+//input capture ISR
+void _ISR_PSV _IC5Interrupt(void) {		//for PIC24
+	ISR_ENTER();								//ISR_PROFILE
+	//clear the flag
+	//IC5DAT = IC5BUF;					//read the captured value
+	IFS2bits.IC5IF = 0;					//clear the flag after the buffer has been read (the interrupt flag is persistent)
+#if defined(IC5_HANDLER)
+	IC5_HANDLER();						//bound at compile time
+#else
+	_ic5_isrptr();						//run user handler
+#endif
+	ISR_EXIT(IRQ_IC5);
+}
+
+//reset input capture 1
+//16-bit mode, rising edge, single capture, Timer2 as timebase
+//interrupt disabled
+void ic5Init(void) {
+	_ic5_isrptr = empty_handler;		//reset user handler
+
+	IC52RP();							//assign pin to IC
+	PMD2bits.IC5MD = 0;					//0->enable power to input capture
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
+			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+	IC5CON1 = 0;						//reset to default value
+	IC5CON2 = 0;						//reset to default value
+	IC5CON1  = 	(0<<15) |				//1->enable the module, 0->disable the module
+				(0<<13) |				//0->operates in idle, 1->don't operate in idle
+				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
+				(0<<8) |				//1->32-bit mode, 0->16-bit mode
+				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
+				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
+				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
+				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
+				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
+				0x00;
+
+	while (IC5CON1bits.ICBNE) IC5BUF;	//read the buffer to clear the flag
+	IFS2bits.IC5IF   = 0;				//0->clear the flag
+	IEC2bits.IC5IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
+	irqApply(IRQ_IC5);					//set the interrupt priority
+	//enable the input capture
+	//IC5CON1bits.ON = 1;				//1->enable the module, 0->disable the module
+	//input capture running now
+#else
+	//for ga002 devices
+	IC5CON = 0;							//reset to default value
+	//IC5CON2 = 0;						//reset to default value
+	IC5CON  = 	(0<<15) |				//1->enable the module, 0->disable the module
+				(0<<13) |				//0->operates in idle, 1->don't operate in idle
+				(1<<9) |				//1-.capture rising edge first (only used for ICM110)
+				(0<<8) |				//1->32-bit mode, 0->16-bit mode
+				(1<<7) |				//1->timer2 as timebase, 0->timer3 as timebase
+				(0<<5) |				//0->interrupt on every capture event, 1->on every second capture event, 2->on every 3rd event, 3->on every 4th event
+				(0<<4) |				//0->ICx no overflow, 1->ICx overflow
+				(0<<3) |				//0->buffer is empty, 1->buffer is not empty
+				(3<<0) |				//0->ICx disabled, 1->every edge, 2->every falling edge, 3->every rising edge, ...
+				0x00;
+
+	while (IC5CONbits.ICBNE) IC5BUF;	//read the buffer to clear the flag
+	IFS2bits.IC5IF   = 0;				//0->clear the flag
+	IEC2bits.IC5IE   = 0;				//1->enable the interrupt, 0->disable the interrupt
+	irqApply(IRQ_IC5);					//set the interrupt priority
+	//enable the input capture
+	//IC5CONbits.ON = 1;				//1->enable the module, 0->disable the module
+#endif
+}
+
+//activate user ptr
+void ic5AttachISR(void (*isrptr)(void)) {
+	_ic5_isrptr = isrptr;				//install user ptr
+	//IC5BUF;								//read the buffer to clear the flag
+	IFS2bits.IC5IF   = 0;				//0->clear the flag
+	irqApply(IRQ_IC5);					//set the interrupt priority
+	IEC2bits.IC5IE   = 1;				//1->enable the interrupt, 0->disable the interrupt
+}
+
+//end input capture
+
+//input capture measurement on ic1
+//captures are timestamps off TMR2: 16-bit differences are wrap-safe for periods up to 65535 ticks
+//in ICM_EDGE mode, the polarity of the first capture is recovered from IC1_PIN and alternates from there
+static volatile uint32_t _icm_psum=0, _icm_hsum=0;		//published sums of ICM_AVG periods / high times, in ticks
+static uint32_t _icm_pacc, _icm_hacc;					//sums being accumulated
+static uint8_t _icm_cnt;								//periods accumulated
+static uint8_t _icm_mode;								//ICM_EDGE or ICM_RISING
+static uint8_t _icm_sync;								//0->(re)synchronize on the next captures
+static uint8_t _icm_rising;								//1->next capture is a rising edge
+static uint8_t _icm_valid;								//1->_icm_rise holds a rising edge
+static uint16_t _icm_rise, _icm_high;					//last rising edge, last high time
+static volatile uint16_t _icm_ovf=0;					//fifo overflows
+
+//restart the capture: clears ICOV and flushes the fifo
+static void _icm_restart(void) {
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	IC1CON1bits.ICM = 0;								//0->ICx disabled
+	IC1CON1bits.ICM = _icm_mode;
+#else
+	IC1CONbits.ICM = 0;									//0->ICx disabled
+	IC1CONbits.ICM = _icm_mode;
+#endif
+	_icm_sync = 0; _icm_valid = 0;
+}
+
+//ic1 isr: drain the fifo
+static void _icm_isr(void) {
+	uint16_t buf[5], dt;
+	uint8_t n=0, i;
+
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	while (IC1CON1bits.ICBNE && (n < 5)) buf[n++] = IC1BUF;
+	if (IC1CON1bits.ICOV) {_icm_ovf++; _icm_restart(); return;}	//an edge was lost
+#else
+	while (IC1CONbits.ICBNE && (n < 5)) buf[n++] = IC1BUF;
+	if (IC1CONbits.ICOV) {_icm_ovf++; _icm_restart(); return;}	//an edge was lost
+#endif
+	if (n == 0) return;
+	if (_icm_sync == 0) {								//polarity of buf[0]: the pin now follows buf[n-1]
+		_icm_rising = (_icm_mode == ICM_RISING) || (digitalRead(IC1_PIN) ^ ((n - 1) & 1));
+		_icm_high = 0;
+		_icm_sync = 1;
+	}
+	for (i = 0; i < n; i++) {
+		if (_icm_rising) {
+			if (_icm_valid) {							//a full period
+				dt = buf[i] - _icm_rise;				//16-bit difference: wrap-safe
+				_icm_pacc += dt; _icm_hacc += _icm_high;
+				if (++_icm_cnt == ICM_AVG) {			//publish the sums
+					_icm_psum = _icm_pacc; _icm_hsum = _icm_hacc;
+					_icm_pacc = _icm_hacc = 0; _icm_cnt = 0;
+				}
+			}
+			_icm_rise = buf[i]; _icm_valid = 1;
+		} else if (_icm_valid) _icm_high = buf[i] - _icm_rise;	//falling edge: high time
+		if (_icm_mode == ICM_EDGE) _icm_rising ^= 1;
+	}
+}
+
+//start measuring on ic1
+//mode=ICM_EDGE: every edge -> period + duty. mode=ICM_RISING: rising edges -> period only
+//ici=0..3: interrupt on every 1st..4th capture - the fifo is 4 deep. ICM_RISING only:
+//the hardware ignores ICI in every-edge mode (ICM=001), so ICM_EDGE interrupts on each edge
+void icmInit(uint8_t mode, uint8_t ici) {
+	ic1Init();											//16-bit, off TMR2
+	_icm_mode = (mode == ICM_EDGE)?ICM_EDGE:ICM_RISING;
+	_icm_psum = _icm_hsum = _icm_pacc = _icm_hacc = 0; _icm_cnt = 0; _icm_ovf = 0;
+	if (_icm_mode == ICM_EDGE) pinMode(IC1_PIN, INPUT);
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	IC1CON1bits.ICTSEL = 1;								//1->timer2 clock as timebase
+	IC1CON1bits.ICI = (_icm_mode == ICM_RISING)?(ici & 0x03):0;
+#else
+	IC1CONbits.ICI = (_icm_mode == ICM_RISING)?(ici & 0x03):0;
+#endif
+	_icm_restart();
+	ic1AttachISR(_icm_isr);
+}
+
+//read the published sums
+static void _icm_get(uint32_t *psum, uint32_t *hsum) {
+	uint8_t ie = IEC0bits.IC1IE;
+
+	IEC0bits.IC1IE = 0;									//sums are updated by the isr
+	*psum = _icm_psum; *hsum = _icm_hsum;
+	IEC0bits.IC1IE = ie;
+}
+
+//averaged period, in ticks. 0->no reading yet
+uint32_t icmPeriod(void) {
+	uint32_t p, h;
+
+	_icm_get(&p, &h);
+	return p / ICM_AVG;
+}
+
+//averaged frequency, in Hz
+uint32_t icmFrequency(void) {
+	uint32_t p, h;
+
+	_icm_get(&p, &h);
+	return p?(((uint64_t) F_PHB * ICM_AVG + (p >> 1)) / p):0;
+}
+
+//averaged duty cycle, 0..0xffff
+uint16_t icmDuty(void) {
+	uint32_t p, h;
+
+	_icm_get(&p, &h);
+	if ((p == 0) || (h >= p)) return (p)?0xffff:0;
+	return ((uint64_t) h << 16) / p;
+}
+
+//number of capture fifo overflows
+uint16_t icmOverflows(void) {
+	return _icm_ovf;
+}
+//end input capture measurement
+
+//32-bit input capture
+//extend a 16-bit TMR2 capture to a ticks() value
+//the capture must have been taken within the last TMR2 period
+uint32_t icExtend(uint16_t cap) {
+	uint32_t now = ticks();
+
+	return now - (uint16_t) ((uint16_t) now - cap);		//age of the capture, modulo the TMR2 period
+}
+
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+//cascade an odd (lsw) / even (msw) pair of captures: same settings on both, IC32 set in both
+//both run off their own timer, clocked by timer2's clock and free running over 32 bits
+#define IC32_CON1				((0<<13) |		/*0->operates in idle, 1->don't operate in idle*/ \
+								 (1<<10) |		/*ictsel: 1->timer2 clock, 0->timer3 clock, 4->timer1 clock, 7->system clock*/ \
+								 (0<<5)  |		/*0->interrupt on every capture event*/ \
+								 (3<<0))		/*3->every rising edge*/
+#define IC32_CON2				((1<<8) |		/*1->32-bit cascade, 0->16-bit*/ \
+								 (0<<7) |		/*0->synchronous mode, 1->trigger mode*/ \
+								 (0<<0))		/*syncsel: 0->free running*/
+
+//32-bit capture on ic1/ic2, rising edge, interrupt disabled
+void ic12Init(void) {
+	ic1Init(); ic2Init();								//power, pin
+	IC1CON1 = 0; IC2CON1 = 0;							//stop both before cascading
+	IC1CON2 = IC32_CON2; IC2CON2 = IC32_CON2;
+	IC2CON1 = IC32_CON1;								//msw first
+	IC1CON1 = IC32_CON1;
+	while (IC1CON1bits.ICBNE) {IC1BUF; IC2BUF;}			//read the buffer to clear the flag
+	IFS0bits.IC2IF = 0;									//0->clear the flag
+	IEC0bits.IC2IE = 0;									//1->enable the interrupt, 0->disable the interrupt
+}
+
+//read a 32-bit capture: lsw from the odd module first
+uint32_t ic12Get(void) {
+	uint16_t lsw = IC1BUF;
+
+	return ((uint32_t) IC2BUF << 16) | lsw;
+}
+
+//32-bit capture on ic3/ic4, rising edge, interrupt disabled
+void ic34Init(void) {
+	ic3Init(); ic4Init();								//power, pin
+	IC3CON1 = 0; IC4CON1 = 0;							//stop both before cascading
+	IC3CON2 = IC32_CON2; IC4CON2 = IC32_CON2;
+	IC4CON1 = IC32_CON1;								//msw first
+	IC3CON1 = IC32_CON1;
+	while (IC3CON1bits.ICBNE) {IC3BUF; IC4BUF;}			//read the buffer to clear the flag
+	IFS2bits.IC4IF = 0;									//0->clear the flag
+	IEC2bits.IC4IE = 0;									//1->enable the interrupt, 0->disable the interrupt
+}
+
+//read a 32-bit capture: lsw from the odd module first
+uint32_t ic34Get(void) {
+	uint16_t lsw = IC3BUF;
+
+	return ((uint32_t) IC4BUF << 16) | lsw;
+}
+#else
+//GA00x has no cascade: 16-bit TMR2 captures, extended with SysTick
+//32-bit capture on ic1, rising edge, interrupt disabled
+void ic12Init(void) {
+	ic1Init();
+}
+
+//read a 32-bit capture, as a ticks() value
+uint32_t ic12Get(void) {
+	return icExtend(IC1BUF);
+}
+
+//32-bit capture on ic3, rising edge, interrupt disabled
+void ic34Init(void) {
+	ic3Init();
+}
+
+//read a 32-bit capture, as a ticks() value
+uint32_t ic34Get(void) {
+	return icExtend(IC3BUF);
+}
+#endif
+//end 32-bit input capture
+
+//infrared remote decoder
+//ic2 captures every edge. the line idles high, so the first edge after a long gap is the start of a mark (ir on):
+//edges alternate from there. each mark / space duration is fed to both state machines
+#define IR_IDLE					20000					//gap that ends a frame, in us
+#define IR_RC5_SHORTPULSE		2						//rc5 events: bit offsets in the transition table
+#define IR_RC5_LONGSPACE		4
+#define IR_RC5_LONGPULSE		6
+#define IR_RC5_START1			0						//rc5 states
+#define IR_RC5_MID1				1
+#define IR_RC5_MID0				2
+#define IR_RC5_START0			3
+#define IR_RC5_DEAD				4
+static const uint8_t _ir_rc5trans[4]={0x01, 0x91, 0x9b, 0xfb};	//next rc5 state, 2 bits per event
+static struct {											//mark / space windows, in ticks
+	uint32_t idle;
+	uint32_t hdrmin, hdrmax;							//nec header mark: 9ms
+	uint32_t spcmin, spcmax;							//nec header space: 4.5ms
+	uint32_t rptmin, rptmax;							//nec repeat space: 2.25ms
+	uint32_t bitmin, bitmax;							//nec bit mark / 0 space: 560us
+	uint32_t onemin, onemax;							//nec 1 space: 1690us
+	uint32_t shortmin, shortmax;						//rc5 half bit: 889us
+	uint32_t longmax;									//rc5 full bit: 1778us
+} _ir_t;
+static uint32_t _ir_last;								//last edge, in ticks
+static uint8_t _ir_mark;								//1->line is in a mark since the last edge
+static uint8_t _ir_nec, _ir_necbits;					//nec state / bits received
+static uint32_t _ir_necdat;								//nec bits, lsb first
+static uint8_t _ir_necok=0;								//1->a nec code was received -> repeat codes are valid
+static uint16_t _ir_necaddr; static uint8_t _ir_neccmd;	//last nec code
+static uint8_t _ir_rc5, _ir_rc5bits;					//rc5 state / bits received
+static uint16_t _ir_rc5dat;								//rc5 bits, msb first
+static uint16_t _ir_rc5last=0xffff;						//last rc5 frame, for repeat detection
+static IR_TypeDef _ir_q[IR_QUEUE];						//decoded codes
+static volatile uint8_t _ir_head=0, _ir_tail=0;			//queue indices
+static volatile uint16_t _ir_ovf=0;						//codes lost to a full queue
+
+//queue a decoded code
+static void _ir_put(uint8_t proto, uint8_t repeat, uint16_t addr, uint8_t cmd) {
+	IR_TypeDef *code;
+
+	if ((uint8_t) (_ir_head - _ir_tail) >= IR_QUEUE) {_ir_ovf++; return;}	//queue full
+	code = &_ir_q[_ir_head & (IR_QUEUE - 1)];
+	code->proto = proto; code->repeat = repeat; code->addr = addr; code->cmd = cmd;
+	_ir_head++;
+}
+
+//nec: 9ms mark, 4.5ms space, 32 bits lsb first (560us mark + 560us / 1690us space), 560us mark
+//repeat: 9ms mark, 2.25ms space, 560us mark
+static void _ir_necfeed(uint32_t dt, uint8_t mark) {
+	switch (_ir_nec) {
+	case 0:												//header mark
+		if (mark && (dt >= _ir_t.hdrmin) && (dt <= _ir_t.hdrmax)) _ir_nec = 1;
+		return;
+	case 1:												//header space: data or repeat
+		if (!mark && (dt >= _ir_t.spcmin) && (dt <= _ir_t.spcmax)) {_ir_nec = 2; _ir_necbits = 0; _ir_necdat = 0; return;}
+		if (!mark && (dt >= _ir_t.rptmin) && (dt <= _ir_t.rptmax)) {_ir_nec = 4; return;}
+		break;
+	case 2:												//bit mark, or the stop mark after 32 bits
+		if (mark && (dt >= _ir_t.bitmin) && (dt <= _ir_t.bitmax)) {
+			if (_ir_necbits < 32) {_ir_nec = 3; return;}
+			if ((uint8_t) (_ir_necdat >> 16) == (uint8_t) ~(_ir_necdat >> 24)) {	//command and its complement
+				_ir_neccmd = _ir_necdat >> 16;
+				_ir_necaddr = _ir_necdat & 0xffff;
+				if ((uint8_t) _ir_necaddr == (uint8_t) ~(_ir_necaddr >> 8)) _ir_necaddr &= 0xff;	//8-bit address + its complement
+				_ir_necok = 1;
+				_ir_put(IR_NEC, 0, _ir_necaddr, _ir_neccmd);
+			}
+		}
+		break;
+	case 3:												//bit space
+		if (!mark && (dt >= _ir_t.bitmin) && (dt <= _ir_t.bitmax)) {_ir_necbits++; _ir_nec = 2; return;}
+		if (!mark && (dt >= _ir_t.onemin) && (dt <= _ir_t.onemax)) {_ir_necdat |= 1ul << _ir_necbits++; _ir_nec = 2; return;}
+		break;
+	case 4:												//repeat stop mark
+		if (mark && (dt >= _ir_t.bitmin) && (dt <= _ir_t.bitmax) && _ir_necok) _ir_put(IR_NEC, 1, _ir_necaddr, _ir_neccmd);
+		break;
+	}
+	_ir_nec = 0;										//done or invalid -> wait for the next header
+	if (mark && (dt >= _ir_t.hdrmin) && (dt <= _ir_t.hdrmax)) _ir_nec = 1;
+}
+
+//rc5: 14 bits msb first, manchester with 889us half bits (1 = space then mark)
+//the first edge of a frame is the middle of the first start bit
+static void _ir_rc5feed(uint32_t dt, uint8_t mark) {
+	uint8_t ev, state;
+	uint8_t cmd;
+
+	if (_ir_rc5 == IR_RC5_DEAD) return;
+	if ((dt < _ir_t.shortmin) || (dt > _ir_t.longmax)) {_ir_rc5 = IR_RC5_DEAD; return;}
+	ev = ((dt > _ir_t.shortmax)?IR_RC5_LONGSPACE:0) + (mark?IR_RC5_SHORTPULSE:0);
+	state = (_ir_rc5trans[_ir_rc5] >> ev) & 0x03;
+	if (state == _ir_rc5) {_ir_rc5 = IR_RC5_DEAD; return;}	//no valid transition
+	_ir_rc5 = state;
+	if ((state == IR_RC5_MID0) || (state == IR_RC5_MID1)) {
+		_ir_rc5dat = (_ir_rc5dat << 1) | (state == IR_RC5_MID1);
+		if (++_ir_rc5bits == 14) {						//s1 s2 t a4..a0 c5..c0
+			cmd = (_ir_rc5dat & 0x3f) | ((~_ir_rc5dat >> 6) & 0x40);	//s2 is the inverted c6
+			_ir_put(IR_RC5, (_ir_rc5dat & 0x0fff) == _ir_rc5last, (_ir_rc5dat >> 6) & 0x1f, cmd);
+			_ir_rc5last = _ir_rc5dat & 0x0fff;			//toggle, address and command
+			_ir_rc5 = IR_RC5_DEAD;
+		}
+	}
+}
+
+//ic2 isr: one edge per capture
+static void _ir_isr(void) {
+	uint32_t t, dt;
+
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	while (IC2CON1bits.ICBNE) {
+#else
+	while (IC2CONbits.ICBNE) {
+#endif
+		t = icExtend(IC2BUF);
+		dt = t - _ir_last; _ir_last = t;
+		if (dt > _ir_t.idle) {							//line was idle: this edge starts a mark
+			_ir_nec = 0;
+			_ir_rc5 = IR_RC5_MID1; _ir_rc5bits = 1; _ir_rc5dat = 1;
+			_ir_mark = 1;
+			continue;
+		}
+		_ir_necfeed(dt, _ir_mark);
+		_ir_rc5feed(dt, _ir_mark);
+		_ir_mark ^= 1;
+	}
+}
+
+//start the decoder on ic2, every edge
+void irInit(void) {
+	uint32_t cpu = cyclesPerMicrosecond();
+
+	_ir_t.idle = IR_IDLE * cpu;
+	_ir_t.hdrmin = 7000 * cpu; _ir_t.hdrmax = 11000 * cpu;
+	_ir_t.spcmin = 3500 * cpu; _ir_t.spcmax = 5500 * cpu;
+	_ir_t.rptmin = 1700 * cpu; _ir_t.rptmax = 2800 * cpu;
+	_ir_t.bitmin = 300 * cpu; _ir_t.bitmax = 850 * cpu;
+	_ir_t.onemin = 1200 * cpu; _ir_t.onemax = 2100 * cpu;
+	_ir_t.shortmin = 444 * cpu; _ir_t.shortmax = 1333 * cpu;
+	_ir_t.longmax = 2222 * cpu;
+	_ir_nec = 0; _ir_necok = 0; _ir_rc5 = IR_RC5_DEAD; _ir_rc5last = 0xffff;
+	_ir_head = _ir_tail = 0; _ir_ovf = 0;
+
+	ic2Init();											//16-bit, off TMR2
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	//IC2TMR runs off timer2's clock but is its own counter: sync it to timer2 so captures are TMR2 values for icExtend()
+	IC2CON1bits.ICTSEL = 1;								//1->timer2 clock as timebase
+	IC2CON2bits.ICTRIG = 0;								//0->synchronous mode
+	IC2CON2bits.SYNCSEL = 0x0c;							//0x0c->synchronized to timer2: reset at each TMR2 rollover
+	IC2TMR = TMR2;										//in step until the first rollover, too
+	IC2CON1bits.ICM = 1;								//1->every edge
+	while (IC2CON1bits.ICBNE) IC2BUF;					//read the buffer to clear the flag
+#else
+	IC2CONbits.ICM = 1;									//1->every edge
+	while (IC2CONbits.ICBNE) IC2BUF;					//read the buffer to clear the flag
+#endif
+	_ir_last = ticks() - _ir_t.idle - 1;				//the next edge starts a frame
+	ic2AttachISR(_ir_isr);
+}
+
+//number of codes queued
+uint8_t irAvailable(void) {
+	return _ir_head - _ir_tail;
+}
+
+//pop a code. 1->code read, 0->queue empty
+uint8_t irRead(IR_TypeDef *code) {
+	if (_ir_head == _ir_tail) return 0;
+	*code = _ir_q[_ir_tail & (IR_QUEUE - 1)];
+	_ir_tail++;
+	return 1;
+}
+
+//codes lost to a full queue
+uint16_t irOverflows(void) {
+	return _ir_ovf;
+}
+//end infrared
+
+//extint
+static uint8_t _int_mode[5];			//RISING/FALLING/CHANGE, per intx
+static volatile uint32_t _int_cnt[5];	//interrupts taken, per intx
+
+//extint0
+void (* _int0_isrptr) (void)=empty_handler;
+
+void _ISR_PSV _INT0Interrupt(void) {
+	ISR_ENTER();								//ISR_PROFILE
+	if (_int_mode[0] == CHANGE) INTCON2bits.INT0EP ^= 1;	//wait for the opposite edge
+	IFS0bits.INT0IF = 0;				//clera the flag. after the edge flip, which may set it
+	_int_cnt[0]++;
+#if defined(INT0_HANDLER)
+	INT0_HANDLER();					//bound at compile time
+#else
+	_int0_isrptr();						//run the isr
+#endif
+	ISR_EXIT(IRQ_INT0);
+}
+
+void int0Init(void) {
+	//INT02RP();						//map int0_pin - int0 cannot be remapped
+	_int0_isrptr = empty_handler;		//initialize int isr ptr
+	IFS0bits.INT0IF = 0;				//clear int0 flag
+	IEC0bits.INT0IE = 0;				//1->enable int0 interrupt, 0->disable the interrupt
+	INTCON2bits.INT0EP = 0;				//1=triggered on the falling edge. 0 = rising edge
+	irqApply(IRQ_INT0);				//set the interrupt priority
+	_int_mode[0] = RISING;
+}
+
+void int0AttachISR(void (*isrptr) (void)) {
+	_int0_isrptr = isrptr;
+	IFS0bits.INT0IF = 0;				//clear int0 flag
+	irqApply(IRQ_INT0);				//set the interrupt priority
+	IEC0bits.INT0IE = 1;				//1->enable int0 interrupt, 0->disable the interrupt
+}
+
+//extint1
+void (* _int1_isrptr) (void)=empty_handler;
+
+void _ISR_PSV _INT1Interrupt(void) {
+	ISR_ENTER();								//ISR_PROFILE
+	if (_int_mode[1] == CHANGE) INTCON2bits.INT1EP ^= 1;	//wait for the opposite edge
+	IFS1bits.INT1IF = 0;				//clera the flag. after the edge flip, which may set it
+	_int_cnt[1]++;
+#if defined(INT1_HANDLER)
+	INT1_HANDLER();					//bound at compile time
+#else
+	_int1_isrptr();						//run the isr
+#endif
+	ISR_EXIT(IRQ_INT1);
+}
+
+void int1Init(void) {
+	INT12RP();							//map int1_pin
+	_int1_isrptr = empty_handler;		//initialize int isr ptr
+	IFS1bits.INT1IF = 0;				//clear int1 flag
+	IEC1bits.INT1IE = 0;				//1->enable int1 interrupt, 0->disable the interrupt
+	INTCON2bits.INT1EP = 0;				//1=triggered on the falling edge. 0 = rising edge
+	irqApply(IRQ_INT1);				//set the interrupt priority
+	_int_mode[1] = RISING;
+}
+
+void int1AttachISR(void (*isrptr) (void)) {
+	_int1_isrptr = isrptr;
+	IFS1bits.INT1IF = 0;				//clear int1 flag
+	irqApply(IRQ_INT1);				//set the interrupt priority
+	IEC1bits.INT1IE = 1;				//1->enable int1 interrupt, 0->disable the interrupt
+}
+
+//extint2
+void (* _int2_isrptr) (void)=empty_handler;
+
+void _ISR_PSV _INT2Interrupt(void) {
+	ISR_ENTER();								//ISR_PROFILE
+	if (_int_mode[2] == CHANGE) INTCON2bits.INT2EP ^= 1;	//wait for the opposite edge
+	IFS1bits.INT2IF = 0;				//clera the flag. after the edge flip, which may set it
+	_int_cnt[2]++;
+#if defined(INT2_HANDLER)
+	INT2_HANDLER();					//bound at compile time
+#else
+	_int2_isrptr();						//run the isr
+#endif
+	ISR_EXIT(IRQ_INT2);
+}
+
+void int2Init(void) {
+	INT22RP();							//map int2_pin
+	_int2_isrptr = empty_handler;		//initialize int isr ptr
+	IFS1bits.INT2IF = 0;				//clear int2 flag
+	IEC1bits.INT2IE = 0;				//1->enable int2 interrupt, 0->disable the interrupt
+	INTCON2bits.INT2EP = 0;				//1=triggered on the falling edge. 0 = rising edge
+	irqApply(IRQ_INT2);				//set the interrupt priority
+	_int_mode[2] = RISING;
+}
+
+void int2AttachISR(void (*isrptr) (void)) {
+	_int2_isrptr = isrptr;
+	IFS1bits.INT2IF = 0;				//clear int2 flag
+	irqApply(IRQ_INT2);				//set the interrupt priority
+	IEC1bits.INT2IE = 1;				//1->enable int2 interrupt, 0->disable the interrupt
+}
+
+#if defined(_INT3IF)					//int3/int4 on GA10x/GB00x
+//extint3
+void (* _int3_isrptr) (void)=empty_handler;
+
+void _ISR_PSV _INT3Interrupt(void) {
+	ISR_ENTER();								//ISR_PROFILE
+	if (_int_mode[3] == CHANGE) INTCON2bits.INT3EP ^= 1;	//wait for the opposite edge
+	IFS3bits.INT3IF = 0;				//clera the flag. after the edge flip, which may set it
+	_int_cnt[3]++;
+#if defined(INT3_HANDLER)
+	INT3_HANDLER();					//bound at compile time
+#else
+	_int3_isrptr();						//run the isr
+#endif
+	ISR_EXIT(IRQ_INT3);
+}
+
+void int3Init(void) {
+	INT32RP();							//map int3_pin
+	_int3_isrptr = empty_handler;		//initialize int isr ptr
+	IFS3bits.INT3IF = 0;				//clear int3 flag
+	IEC3bits.INT3IE = 0;				//1->enable int3 interrupt, 0->disable the interrupt
+	INTCON2bits.INT3EP = 0;				//1=triggered on the falling edge. 0 = rising edge
+	irqApply(IRQ_INT3);				//set the interrupt priority
+	_int_mode[3] = RISING;
+}
+
+void int3AttachISR(void (*isrptr) (void)) {
+	_int3_isrptr = isrptr;
+	IFS3bits.INT3IF = 0;				//clear int3 flag
+	irqApply(IRQ_INT3);				//set the interrupt priority
+	IEC3bits.INT3IE = 1;				//1->enable int3 interrupt, 0->disable the interrupt
+}
+
+//extint4
+void (* _int4_isrptr) (void)=empty_handler;
+
+void _ISR_PSV _INT4Interrupt(void) {
+	ISR_ENTER();								//ISR_PROFILE
+	if (_int_mode[4] == CHANGE) INTCON2bits.INT4EP ^= 1;	//wait for the opposite edge
+	IFS3bits.INT4IF = 0;				//clera the flag. after the edge flip, which may set it
+	_int_cnt[4]++;
+#if defined(INT4_HANDLER)
+	INT4_HANDLER();					//bound at compile time
+#else
+	_int4_isrptr();						//run the isr
+#endif
+	ISR_EXIT(IRQ_INT4);
+}
+
+void int4Init(void) {
+	INT42RP();							//map int4_pin
+	_int4_isrptr = empty_handler;		//initialize int isr ptr
+	IFS3bits.INT4IF = 0;				//clear int4 flag
+	IEC3bits.INT4IE = 0;				//1->enable int4 interrupt, 0->disable the interrupt
+	INTCON2bits.INT4EP = 0;				//1=triggered on the falling edge. 0 = rising edge
+	irqApply(IRQ_INT4);				//set the interrupt priority
+	_int_mode[4] = RISING;
+}
+
+void int4AttachISR(void (*isrptr) (void)) {
+	_int4_isrptr = isrptr;
+	IFS3bits.INT4IF = 0;				//clear int4 flag
+	irqApply(IRQ_INT4);				//set the interrupt priority
+	IEC3bits.INT4IE = 1;				//1->enable int4 interrupt, 0->disable the interrupt
+}
+#endif	//_INT3IF
+
+//level on intx's pin: int0 on RB7, int1..int4 on the RPn pin picked by RPINRx (RP0..15->RB0..15, RP16..25->RC0..9)
+static uint8_t _int_level(uint8_t intx) {
+	uint8_t rp;
+
+	switch (intx) {
+		case 0: return PORTBbits.RB7;
+		case 1: rp = _INT1R; break;
+		case 2: rp = _INT2R; break;
+#if defined(_INT3IF)
+		case 3: rp = _INT3R; break;
+		case 4: rp = _INT4R; break;
+#endif
+		default: return 0;
+	}
+	if (rp < 16) return (PORTB >> rp) & 1;
+#if defined(_RC0)
+	if (rp < 26) return (PORTC >> (rp - 16)) & 1;
+#endif
+	return 0;
+}
+
+//install external interrupt handler on intx=0..4
+//mode: RISING, FALLING or CHANGE. CHANGE arms the edge away from the pin's current level and flips the edge in the isr
+void attachInterrupt(uint8_t intx, void (*isrptr) (void), uint8_t mode) {
+	uint8_t ep = (mode == FALLING)?1:0;	//1=triggered on the falling edge. 0 = rising edge
+
+	switch (intx) {						//init maps the pin
+		case 0: int0Init(); break;
+		case 1: int1Init(); break;
+		case 2: int2Init(); break;
+#if defined(_INT3IF)
+		case 3: int3Init(); break;
+		case 4: int4Init(); break;
+#endif
+		default: return;				//no such intx
+	}
+	if (mode == CHANGE) ep = _int_level(intx);	//change: wait for the edge away from the current level
+	switch (intx) {
+		case 0: INTCON2bits.INT0EP = ep; break;
+		case 1: INTCON2bits.INT1EP = ep; break;
+		case 2: INTCON2bits.INT2EP = ep; break;
+#if defined(_INT3IF)
+		case 3: INTCON2bits.INT3EP = ep; break;
+		case 4: INTCON2bits.INT4EP = ep; break;
+#endif
+	}
+	_int_mode[intx] = mode;
+	_int_cnt[intx] = 0;
+	switch (intx) {						//edge is set: clear the flag and go
+		case 0: int0AttachISR(isrptr); break;
+		case 1: int1AttachISR(isrptr); break;
+		case 2: int2AttachISR(isrptr); break;
+#if defined(_INT3IF)
+		case 3: int3AttachISR(isrptr); break;
+		case 4: int4AttachISR(isrptr); break;
+#endif
+	}
+}
+
+//remove the handler and disable intx
+void detachInterrupt(uint8_t intx) {
+	switch (intx) {
+		case 0: int0Init(); break;
+		case 1: int1Init(); break;
+		case 2: int2Init(); break;
+#if defined(_INT3IF)
+		case 3: int3Init(); break;
+		case 4: int4Init(); break;
+#endif
+	}
+}
+
+//interrupts taken on intx since its attachInterrupt()
+uint32_t intCount(uint8_t intx) {
+	uint32_t cnt;
+
+	if (intx > 4) return 0;
+	do cnt = _int_cnt[intx]; while (cnt != _int_cnt[intx]);	//isr may update it mid-read
+	return cnt;
+}
+
+
+//end extint
+
+//interrupt priorities
+//priority table, seeded from the xxIP_DEFAULT values
+static uint8_t _irq_ipl[IRQ_CNT]={
+	TxIP_DEFAULT, TxIP_DEFAULT, TxIP_DEFAULT, TxIP_DEFAULT, TxIP_DEFAULT,
+	OCxIP_DEFAULT, OCxIP_DEFAULT, OCxIP_DEFAULT, OCxIP_DEFAULT, OCxIP_DEFAULT,
+	ICxIP_DEFAULT, ICxIP_DEFAULT, ICxIP_DEFAULT, ICxIP_DEFAULT, ICxIP_DEFAULT,
+	INTxIP_DEFAULT, INTxIP_DEFAULT, INTxIP_DEFAULT,
+#if defined(_INT3IF)
+	INTxIP_DEFAULT, INTxIP_DEFAULT,
+#endif
+	CNIP_DEFAULT,
+	UxIP_DEFAULT, UxIP_DEFAULT, UxIP_DEFAULT, UxIP_DEFAULT,
+	ADCIP_DEFAULT, SPIIP_DEFAULT, SPIIP_DEFAULT, CRCIP_DEFAULT,
+	RTCIP_DEFAULT,
+};
+
+//names for irqDump(), padded for u1Print()/u2Print(): the number goes into chars 6..19
+static const char *_irq_name[IRQ_CNT]={
+	"T1   =              \r\n", "T2   =              \r\n", "T3   =              \r\n", "T4   =              \r\n", "T5   =              \r\n",
+	"OC1  =              \r\n", "OC2  =              \r\n", "OC3  =              \r\n", "OC4  =              \r\n", "OC5  =              \r\n",
+	"IC1  =              \r\n", "IC2  =              \r\n", "IC3  =              \r\n", "IC4  =              \r\n", "IC5  =              \r\n",
+	"INT0 =              \r\n", "INT1 =              \r\n", "INT2 =              \r\n",
+#if defined(_INT3IF)
+	"INT3 =              \r\n", "INT4 =              \r\n",
+#endif
+	"CN   =              \r\n",
+	"U1RX =              \r\n", "U1TX =              \r\n", "U2RX =              \r\n", "U2TX =              \r\n",
+	"AD1  =              \r\n", "SPI1 =              \r\n", "SPI2 =              \r\n", "CRC  =              \r\n",
+	"RTC  =              \r\n",
+};
+
+//write ipl to the vector's IPCx field if set, and return the field
+static uint8_t _irq_ipc(IRQ_TypeDef irq, uint8_t set, uint8_t ipl) {
+	switch (irq) {
+		case IRQ_T1:   if (set) IPC0bits.T1IP = ipl;    return IPC0bits.T1IP;
+		case IRQ_T2:   if (set) IPC1bits.T2IP = ipl;    return IPC1bits.T2IP;
+		case IRQ_T3:   if (set) IPC2bits.T3IP = ipl;    return IPC2bits.T3IP;
+		case IRQ_T4:   if (set) IPC6bits.T4IP = ipl;    return IPC6bits.T4IP;
+		case IRQ_T5:   if (set) IPC7bits.T5IP = ipl;    return IPC7bits.T5IP;
+		case IRQ_OC1:  if (set) IPC0bits.OC1IP = ipl;   return IPC0bits.OC1IP;
+		case IRQ_OC2:  if (set) IPC1bits.OC2IP = ipl;   return IPC1bits.OC2IP;
+		case IRQ_OC3:  if (set) IPC6bits.OC3IP = ipl;   return IPC6bits.OC3IP;
+		case IRQ_OC4:  if (set) IPC6bits.OC4IP = ipl;   return IPC6bits.OC4IP;
+		case IRQ_OC5:  if (set) IPC10bits.OC5IP = ipl;  return IPC10bits.OC5IP;
+		case IRQ_IC1:  if (set) IPC0bits.IC1IP = ipl;   return IPC0bits.IC1IP;
+		case IRQ_IC2:  if (set) IPC1bits.IC2IP = ipl;   return IPC1bits.IC2IP;
+		case IRQ_IC3:  if (set) IPC9bits.IC3IP = ipl;   return IPC9bits.IC3IP;
+		case IRQ_IC4:  if (set) IPC9bits.IC4IP = ipl;   return IPC9bits.IC4IP;
+		case IRQ_IC5:  if (set) IPC9bits.IC5IP = ipl;   return IPC9bits.IC5IP;
+		case IRQ_INT0: if (set) IPC0bits.INT0IP = ipl;  return IPC0bits.INT0IP;
+		case IRQ_INT1: if (set) IPC5bits.INT1IP = ipl;  return IPC5bits.INT1IP;
+		case IRQ_INT2: if (set) IPC7bits.INT2IP = ipl;  return IPC7bits.INT2IP;
+#if defined(_INT3IF)
+		case IRQ_INT3: if (set) IPC13bits.INT3IP = ipl; return IPC13bits.INT3IP;
+		case IRQ_INT4: if (set) IPC13bits.INT4IP = ipl; return IPC13bits.INT4IP;
+#endif
+		case IRQ_CN:   if (set) IPC4bits.CNIP = ipl;    return IPC4bits.CNIP;
+		case IRQ_U1RX: if (set) IPC2bits.U1RXIP = ipl;  return IPC2bits.U1RXIP;
+		case IRQ_U1TX: if (set) IPC3bits.U1TXIP = ipl;  return IPC3bits.U1TXIP;
+		case IRQ_U2RX: if (set) IPC7bits.U2RXIP = ipl;  return IPC7bits.U2RXIP;
+		case IRQ_U2TX: if (set) IPC7bits.U2TXIP = ipl;  return IPC7bits.U2TXIP;
+		case IRQ_AD1:  if (set) IPC3bits.AD1IP = ipl;   return IPC3bits.AD1IP;
+		case IRQ_SPI1: if (set) IPC2bits.SPI1IP = ipl;  return IPC2bits.SPI1IP;
+		case IRQ_SPI2: if (set) IPC8bits.SPI2IP = ipl;  return IPC8bits.SPI2IP;
+		case IRQ_CRC:  if (set) IPC16bits.CRCIP = ipl;  return IPC16bits.CRCIP;
+		case IRQ_RTC:  if (set) IPC15bits.RTCIP = ipl;  return IPC15bits.RTCIP;
+		default: return 0;
+	}
+}
+
+//set the priority (0..7, 0->disabled) and apply it
+void irqSetPriority(IRQ_TypeDef irq, uint8_t ipl) {
+	if (irq >= IRQ_CNT) return;
+	_irq_ipl[irq] = ipl & 0x07;
+	irqApply(irq);
+}
+
+//priority in the table
+uint8_t irqGetPriority(IRQ_TypeDef irq) {
+	return (irq < IRQ_CNT)?_irq_ipl[irq]:0;
+}
+
+//write the table entry to its IPCx field
+void irqApply(IRQ_TypeDef irq) {
+	if (irq < IRQ_CNT) _irq_ipc(irq, 1, _irq_ipl[irq]);
+}
+
+//priority in effect in its IPCx field
+uint8_t irqRead(IRQ_TypeDef irq) {
+	return _irq_ipc(irq, 0, 0);
+}
+
+//print the effective priority of each vector, with u1Print()/u2Print()
+void irqDump(void (*print)(char *str, int32_t dat)) {
+	uint8_t irq;
+
+	for (irq = 0; irq < IRQ_CNT; irq++) print((char *) _irq_name[irq], irqRead(irq));
+}
+
+#if defined(ISR_PROFILE)
+//shortest / longest run of a vector so far, in ticks. 0->not taken yet
+uint16_t isrMin(IRQ_TypeDef irq) {
+	return (irq < IRQ_CNT)?_isr_min[irq]:0;
+}
+
+uint16_t isrMax(IRQ_TypeDef irq) {
+	return (irq < IRQ_CNT)?_isr_max[irq]:0;
+}
+
+//restart the measurements
+void isrReset(void) {
+	uint8_t irq, ipl;
+
+	critEnter(ipl);
+	for (irq = 0; irq < IRQ_CNT; irq++) _isr_min[irq] = _isr_max[irq] = 0;
+	critExit(ipl);
+}
+
+//print the longest (max=1) or shortest (max=0) run of each vector, in ticks, with u1Print()/u2Print()
+void isrDump(void (*print)(char *str, int32_t dat), uint8_t max) {
+	uint8_t irq;
+
+	for (irq = 0; irq < IRQ_CNT; irq++) print((char *) _irq_name[irq], max?_isr_max[irq]:_isr_min[irq]);
+}
+#endif
+//end interrupt priorities
+
+//event queue
+//free-running 16-bit indices: each is written by one side only, in a single instruction
+//the event is filled in before the head moves, and read out before the tail moves
+static EVT_TypeDef _evt_q[EVT_SIZE];
+static volatile uint16_t _evt_head=0, _evt_tail=0;	//head: written by the producer, tail: by the consumer
+static volatile uint16_t _evt_ovf=0;			//events lost to a full queue
+static volatile uint16_t _evt_hwm=0;			//high-water mark
+
+//producer: queue an event stamped with ticks()
+//return 0 if full
+uint8_t evtPost(uint8_t type, uint16_t data) {
+	uint16_t head = _evt_head, used = head - _evt_tail;
+	EVT_TypeDef *evt;
+
+	if (used >= EVT_SIZE) {_evt_ovf++; return 0;}
+	evt = &_evt_q[head & (EVT_SIZE - 1)];
+	evt->type = type; evt->data = data; evt->tick = ticks();
+	memBarrier();								//event complete before it is published
+	_evt_head = head + 1;
+	if (++used > _evt_hwm) _evt_hwm = used;
+	return 1;
+}
+
+//consumer: take the oldest event
+//return 0 if empty
+uint8_t evtGet(EVT_TypeDef *evt) {
+	uint16_t tail = _evt_tail;
+
+	if (_evt_head == tail) return 0;
+	memBarrier();								//head read before the event
+	*evt = _evt_q[tail & (EVT_SIZE - 1)];
+	memBarrier();								//event copied before its slot is released
+	_evt_tail = tail + 1;
+	return 1;
+}
+
+//events in the queue
+uint16_t evtAvailable(void) {
+	return _evt_head - _evt_tail;
+}
+
+//events lost to a full queue
+uint16_t evtOverflows(void) {
+	return _evt_ovf;
+}
+
+//most events ever queued at once
+uint16_t evtHighWater(void) {
+	return _evt_hwm;
+}
+//end event queue
+
+//cooperative scheduler
+static TASK_TypeDef _task[TASK_CNT];
+static uint8_t _task_cnt=0;						//slots in use: 0.._task_cnt-1
+static uint32_t _task_p0[TASK_CNT], _task_f0[TASK_CNT];	//period as given to taskAdd() and F_PHB then: clkRetune() scales from these, so switches don't add up rounding
+
+//run func every period ticks, starting one period from now
+//return the task id, or TASK_CNT if full or period is 0
+uint8_t taskAdd(void (*func)(void), uint32_t period) {
+	uint8_t id;
+
+	if (period == 0) return TASK_CNT;			//taskRun() divides by the period
+	for (id = 0; id < _task_cnt; id++) if (_task[id].func == 0) break;	//reuse a removed slot
+	if (id >= TASK_CNT) return TASK_CNT;
+	memset(&_task[id], 0, sizeof(TASK_TypeDef));
+	_task[id].period = period;
+	_task_p0[id] = period; _task_f0[id] = F_PHB;
+	_task[id].next = ticks() + period;
+	_task[id].func = func;
+	if (id == _task_cnt) _task_cnt++;
+	return id;
+}
+
+//remove a task
+void taskRemove(uint8_t id) {
+	if (id < _task_cnt) _task[id].func = 0;
+}
+
+//run the tasks that are due
+//a task started a period or more late skips the missed releases and keeps its phase
+void taskRun(void) {
+	TASK_TypeDef *task;
+	uint32_t now, late, dt;
+	uint8_t id;
+
+	for (id = 0; id < _task_cnt; id++) {
+		task = &_task[id];
+		if (task->func == 0) continue;
+		now = ticks();
+		late = now - task->next;
+		if ((int32_t) late < 0) continue;		//not due yet
+		if (late >= task->period) {				//missed releases
+			dt = late / task->period;
+			task->miss = (dt < 0xffffu - task->miss)?(task->miss + dt):0xffffu;	//saturate
+			task->next += dt * task->period;
+		}
+		task->next += task->period;
+
+		task->func();							//run the task
+		dt = ticks() - now;
+		task->runs++;
+		task->exec = dt;
+		task->exec_sum += dt;
+		if (dt > task->exec_max) task->exec_max = dt;
+		if ((dt > task->period) && (task->overrun < 0xffffu)) task->overrun++;	//saturate
+	}
+}
+
+//copy of a task's statistics
+void taskStat(uint8_t id, TASK_TypeDef *stat) {
+	if (id < _task_cnt) *stat = _task[id];
+}
+//end scheduler
+
+//preemptive kernel
+#if defined(USE_KERNEL)
+#if defined(SYSTICK_TMR1)
+#error "USE_KERNEL ticks on tmr1: run systick on tmr2"
+#endif
+#if defined(T1_HANDLER)
+#error "USE_KERNEL ticks through tmr1AttachISR(): T1_HANDLER must not be defined"
+#endif
+#define K_FREE					0				//thread states
+#define K_READY					1
+#define K_WAIT					2				//sleeping, or blocked on wait
+#define K_IDLE_STACK			96				//idle thread stack, in words
+
+static struct {
+	uint16_t sp;								//saved stack pointer
+	uint8_t prio;								//higher runs first
+	uint8_t state;								//K_FREE/K_READY/K_WAIT
+	uint8_t timed;								//1->wakes up at wake
+	uint32_t wake;								//in ticks
+	void *wait;									//object blocked on, NULL when sleeping
+} _k_thr[K_THREADS];
+static uint8_t _k_cur=0;						//running thread
+static uint8_t _k_run=0;						//1->kernel started
+static uint16_t _k_idle_stk[K_IDLE_STACK];
+static uint32_t _k_switches=0;					//context switches
+volatile uint16_t _k_t0, _k_cyc=0;				//set by kYield(): TMR2 once masked, cycles of the switch
+static uint16_t _k_cycmax=0;					//longest switch
+
+//context switch. saves and restores the full cpu context on the thread stack:
+//SR, w0..w14, RCOUNT, TBLPAG, CORCON, PSVPAG. runs at ipl 7 from the first save to the last restore
+//called from threads and, through the tmr1 tick, from isrs: the isr frame stays on the thread's stack
+asm(
+"	.text							\n"
+"	.global	_kYield					\n"
+"_kYield:							\n"
+"	push	SR						\n"
+"	push	w0						\n"
+"	mov		#0xe0, w0				\n"		//ipl 7
+"	mov		w0, SR					\n"
+"	mov		TMR2, w0				\n"		//start of the switch
+"	mov		w0, __k_t0				\n"
+"	push	w1						\n"
+"	push.d	w2						\n"
+"	push.d	w4						\n"
+"	push.d	w6						\n"
+"	push.d	w8						\n"
+"	push.d	w10						\n"
+"	push.d	w12						\n"
+"	push	w14						\n"
+"	push	RCOUNT					\n"
+"	push	TBLPAG					\n"
+"	push	CORCON					\n"
+"	push	PSVPAG					\n"
+"	mov		w15, w0					\n"		//sp of the outgoing thread
+"	call	__k_switch				\n"
+"	mov		w0, w15					\n"		//sp of the incoming thread
+"	mov		TMR2, w0				\n"		//end of the switch
+"	mov		__k_t0, w1				\n"
+"	sub		w0, w1, w0				\n"
+"	mov		w0, __k_cyc				\n"
+"	pop		PSVPAG					\n"
+"	pop		CORCON					\n"
+"	pop		TBLPAG					\n"
+"	pop		RCOUNT					\n"
+"	pop		w14						\n"
+"	pop.d	w12						\n"
+"	pop.d	w10						\n"
+"	pop.d	w8						\n"
+"	pop.d	w6						\n"
+"	pop.d	w4						\n"
+"	pop.d	w2						\n"
+"	pop.d	w0						\n"
+"	pop		SR						\n"
+"	return							\n"
+);
+
+//ticks() with interrupts masked: count in a pending tmr2 overflow
+static uint32_t _k_now(void) {
+	uint32_t m = SysTick;
+	uint16_t f = TMR2;
+
+	if (IFS0bits.T2IF && (f < 0x8000)) m += 0x10000ul;
+	return m | f;
+}
+
+//pick the next thread: the highest priority ready one, round robin among equals
+//called by kYield() with the outgoing sp, returns the incoming sp
+uint16_t _k_switch(uint16_t sp) {
+	uint32_t now = _k_now();
+	uint8_t i, n, best = 0;						//idle thread is always ready
+
+	_k_thr[_k_cur].sp = sp;
+	if (_k_cyc > _k_cycmax) _k_cycmax = _k_cyc;	//from the previous switch
+	_k_switches++;
+
+	for (i = 0; i < K_THREADS; i++)				//time-outs
+		if ((_k_thr[i].state == K_WAIT) && _k_thr[i].timed && ((int32_t) (now - _k_thr[i].wake) >= 0)) {
+			_k_thr[i].state = K_READY; _k_thr[i].wait = NULL;
+		}
+	for (n = 0, i = _k_cur; n < K_THREADS; n++) {	//start after the current thread
+		if (++i >= K_THREADS) i = 0;
+		if ((_k_thr[i].state == K_READY) && (_k_thr[i].prio > _k_thr[best].prio)) best = i;
+	}
+	_k_cur = best;
+	return _k_thr[best].sp;
+}
+
+//a returning thread frees its slot
+static void _k_exit(void) {
+	uint8_t ipl;
+
+	critEnter(ipl);
+	_k_thr[_k_cur].state = K_FREE;
+	kYield();									//never comes back
+	critExit(ipl);
+}
+
+//initial frame, as kYield() leaves it: returns into func, and func returns into _k_exit()
+static uint16_t _k_frame(uint16_t *stk, void (*func)(void)) {
+	uint8_t i;
+
+	*stk++ = (uint16_t) _k_exit; *stk++ = 0;	//return address of func
+	*stk++ = (uint16_t) func; *stk++ = 0;		//return address of kYield()
+	*stk++ = 0;									//SR: ipl 0
+	for (i = 0; i < 15; i++) *stk++ = 0;		//w0..w14
+	*stk++ = 0;									//RCOUNT
+	*stk++ = 0;									//TBLPAG
+	*stk++ = CORCON;							//keep psv on
+	*stk++ = PSVPAG;
+	return (uint16_t) stk;						//stack grows up
+}
+
+//idle thread: runs when nothing else is ready
+static void _k_idle(void) {
+	while (1) Idle();							//wait for an interrupt
+}
+
+//wake the threads blocked on obj. return the highest priority woken, 0 if none
+static uint8_t _k_wake(void *obj) {
+	uint8_t i, prio = 0;
+
+	for (i = 0; i < K_THREADS; i++)
+		if ((_k_thr[i].state == K_WAIT) && (_k_thr[i].wait == obj)) {
+			_k_thr[i].state = K_READY; _k_thr[i].wait = NULL;
+			if (_k_thr[i].prio > prio) prio = _k_thr[i].prio;
+		}
+	return prio;
+}
+
+//block the running thread on obj until woken or, if timed, until end. called in a critical section
+static void _k_block(void *obj, uint8_t timed, uint32_t end) {
+	_k_thr[_k_cur].wait = obj;
+	_k_thr[_k_cur].timed = timed;
+	_k_thr[_k_cur].wake = end;
+	_k_thr[_k_cur].state = K_WAIT;
+	kYield();
+}
+
+//tick isr: time slice and time-outs
+static void _k_tick(void) {
+	kYield();
+}
+
+//turn the caller into the main thread and start the tick
+//threads started before kInit() run from the first tick
+void kInit(void) {
+	_k_thr[0].sp = _k_frame(_k_idle_stk, _k_idle);	//idle thread
+	_k_thr[0].prio = 0; _k_thr[0].state = K_READY;
+	_k_thr[1].prio = K_MAIN_PRIO; _k_thr[1].state = K_READY;	//main thread: sp saved on its first switch
+	_k_cur = 1;
+	_k_run = 1;
+
+	irqSetPriority(IRQ_T1, K_IPL);				//tick below all other isrs
+	tmr1Init(TMR_PS1x, F_PHB / K_HZ);
+	tmr1AttachISR(_k_tick);
+}
+
+//start a thread on stack[words]
+//return its id, or K_THREADS if none is left or prio is 0
+uint8_t kThread(void (*func)(void), uint16_t *stack, uint16_t words, uint8_t prio) {
+	uint8_t i, ipl;
+
+	if ((words < K_STACK_MIN) || (prio == 0)) return K_THREADS;	//prio 0 is the idle thread's: never picked over it
+	critEnter(ipl);
+	for (i = 2; i < K_THREADS; i++) if (_k_thr[i].state == K_FREE) break;
+	if (i < K_THREADS) {
+		_k_thr[i].sp = _k_frame(stack, func);
+		_k_thr[i].prio = prio;
+		_k_thr[i].wait = NULL;
+		_k_thr[i].state = K_READY;
+	}
+	critExit(ipl);
+	if (_k_run && (i < K_THREADS) && (prio > _k_thr[_k_cur].prio)) kYield();	//preempt the caller
+	return i;
+}
+
+//sleep t ticks
+void kSleep(uint32_t t) {
+	uint8_t ipl;
+
+	critEnter(ipl);
+	_k_block(NULL, 1, _k_now() + t);
+	critExit(ipl);
+}
+
+void kSemInit(KSEM_TypeDef *sem, uint16_t count) {
+	sem->count = count;
+}
+
+//take the semaphore, waiting up to timeout ticks
+//return 0 on timeout
+uint8_t kSemWait(KSEM_TypeDef *sem, uint32_t timeout) {
+	uint32_t end = ticks() + timeout;
+	uint8_t ipl;
+
+	critEnter(ipl);
+	while (sem->count == 0) {
+		if ((timeout != K_FOREVER) && ((int32_t) (_k_now() - end) >= 0)) {critExit(ipl); return 0;}
+		_k_block(sem, timeout != K_FOREVER, end);
+	}
+	sem->count--;
+	critExit(ipl);
+	return 1;
+}
+
+//give the semaphore, from a thread
+void kSemPost(KSEM_TypeDef *sem) {
+	uint8_t ipl, prio;
+
+	critEnter(ipl);
+	sem->count++;
+	prio = _k_wake(sem);
+	if (prio > _k_thr[_k_cur].prio) kYield();	//woke a higher priority thread
+	critExit(ipl);
+}
+
+//give the semaphore, from an isr. the switch is left to the tick isr
+void kSemPostISR(KSEM_TypeDef *sem) {
+	uint8_t ipl;
+
+	critEnter(ipl);
+	sem->count++;
+	if (_k_wake(sem) > _k_thr[_k_cur].prio) IFS0bits.T1IF = 1;	//pend a switch once the isrs are done
+	critExit(ipl);
+}
+
+void kQueueInit(KQUEUE_TypeDef *q, uint16_t *buf, uint8_t size) {
+	q->buf = buf; q->size = size;
+	q->head = q->cnt = 0;
+}
+
+//add dat behind the newest word. called in a critical section
+static void _k_put(KQUEUE_TypeDef *q, uint16_t dat) {
+	uint8_t i = q->head + q->cnt;
+
+	if (i >= q->size) i -= q->size;
+	q->buf[i] = dat;
+	q->cnt++;
+}
+
+//queue dat, waiting up to timeout ticks for room
+//return 0 on timeout
+uint8_t kQueuePut(KQUEUE_TypeDef *q, uint16_t dat, uint32_t timeout) {
+	uint32_t end = ticks() + timeout;
+	uint8_t ipl;
+
+	critEnter(ipl);
+	while (q->cnt >= q->size) {
+		if ((timeout != K_FOREVER) && ((int32_t) (_k_now() - end) >= 0)) {critExit(ipl); return 0;}
+		_k_block(q, timeout != K_FOREVER, end);
+	}
+	_k_put(q, dat);
+	if (_k_wake(q) > _k_thr[_k_cur].prio) kYield();	//woke a higher priority reader
+	critExit(ipl);
+	return 1;
+}
+
+//take the oldest word, waiting up to timeout ticks
+//return 0 on timeout
+uint8_t kQueueGet(KQUEUE_TypeDef *q, uint16_t *dat, uint32_t timeout) {
+	uint32_t end = ticks() + timeout;
+	uint8_t ipl;
+
+	critEnter(ipl);
+	while (q->cnt == 0) {
+		if ((timeout != K_FOREVER) && ((int32_t) (_k_now() - end) >= 0)) {critExit(ipl); return 0;}
+		_k_block(q, timeout != K_FOREVER, end);
+	}
+	*dat = q->buf[q->head];
+	if (++q->head >= q->size) q->head = 0;
+	q->cnt--;
+	if (_k_wake(q) > _k_thr[_k_cur].prio) kYield();	//woke a higher priority writer
+	critExit(ipl);
+	return 1;
+}
+
+//queue dat from an isr
+//return 0 if full
+uint8_t kQueuePutISR(KQUEUE_TypeDef *q, uint16_t dat) {
+	uint8_t ipl, ok = 0;
+
+	critEnter(ipl);
+	if (q->cnt < q->size) {
+		_k_put(q, dat);
+		if (_k_wake(q) > _k_thr[_k_cur].prio) IFS0bits.T1IF = 1;	//pend a switch once the isrs are done
+		ok = 1;
+	}
+	critExit(ipl);
+	return ok;
+}
+
+//context switches so far
+uint32_t kSwitches(void) {
+	return _k_switches;
+}
+
+//cycles of the last context switch, from masking in the outgoing thread to restoring the incoming one
+uint16_t kSwitchCycles(void) {
+	return _k_cyc;
+}
+
+//longest context switch, in cycles
+uint16_t kSwitchCyclesMax(void) {
+	return (_k_cyc > _k_cycmax)?_k_cyc:_k_cycmax;
+}
+#endif	//use_kernel
+//end kernel
+
+//tickless idle
+#if !defined(USE_KERNEL) && !defined(SYSTICK_TMR1)
+static uint64_t _idle_idle=0, _idle_active=0;	//ticks spent idle / active
+static uint32_t _idle_last=0;					//ticks() at the last wake-up
+
+//ticks() with interrupts masked: count in a pending tmr2 overflow
+static uint32_t _idle_now(void) {
+	uint32_t m = SysTick;
+	uint16_t f = TMR2;
+
+	if (IFS0bits.T2IF && (f < 0x8000)) m += 0x10000ul;
+	return m | f;
+}
+
+//idle until ticks() reaches due, or an interrupt wakes the cpu
+//runs at ipl 7: a waking interrupt resumes here and is taken once SysTick is right again
+void idleUntil(uint32_t due) {
+	uint32_t t0, dt, t;
+	uint8_t ipl;
+#if !defined(IDLE_SLEEP)
+	uint16_t f;
+	uint8_t t2ie;
+#endif
+
+	critEnter(ipl);
+	t0 = _idle_now();
+	dt = due - t0;
+	if (((int32_t) dt <= 0) || (dt > IDLE_MAX)) {critExit(ipl); return;}	//due, or too far
+	_idle_active += t0 - _idle_last;
+
+	PMD1bits.T1MD = 0;							//power up tmr1
+	T1CON = 0;
+#if defined(IDLE_SLEEP)
+	__builtin_write_OSCCONL(OSCCON | 0x02);		//SOSCEN=1: keep SOSC running
+	T1CONbits.TCS = 1;							//1->T1CK/SOSC
+	T1CONbits.TSYNC = 0;						//0->asynchronous: counts in Sleep
+	dt = ((uint64_t) dt << 15) / F_PHB;			//in SOSC counts: exact ratio, no divide by 0 below 32768Hz
+#else
+	T1CONbits.TCKPS = 3;						//3->256:1 from F_PHB
+	dt >>= 8;
+#endif
+	PR1 = (dt > 0xffff)?0xffff:((dt == 0)?1:dt);
+	TMR1 = 0;
+	IFS0bits.T1IF = 0;
+	IEC0bits.T1IE = 1;							//to wake up: taken after critExit() as an empty isr
+	T1CONbits.TON = 1;
+
+#if defined(IDLE_SLEEP)
+	sleep();
+	T1CONbits.TON = 0;
+	dt = ((uint64_t) TMR1 * F_PHB) >> 15;		//time asleep, in ticks
+	T2CONbits.TON = 0;							//tmr2 stopped in Sleep: move it on by dt
+	t = _idle_now() + dt;
+	IFS0bits.T2IF = 0;
+	if ((t & 0xffff0000ul) < SysTick) _tb_hi++;	//SysTick wrapped: the isr for a pending overflow won't run
+	SysTick = t & 0xffff0000ul; TMR2 = t;
+	T2CONbits.TON = 1;
+#else
+	t2ie = IEC0bits.T2IE; IEC0bits.T2IE = 0;	//no tmr2 overflows while idle
+	Idle();
+	T1CONbits.TON = 0;
+	IEC0bits.T2IE = t2ie;
+	t = t0 + ((uint32_t) TMR1 << 8);			//estimate, good to 256 ticks
+	do {										//overflows up to f are in t: clear their flag, but not one after f
+		f = TMR2;
+		IFS0bits.T2IF = 0;
+	} while (TMR2 < f);							//wrapped between the read and the clear: read again
+	dt = (t & 0xffff0000ul) | f;				//tmr2 is exact: fix the low 16 bits, take the nearest
+	if ((int32_t) (dt - t) > 0x8000) dt -= 0x10000ul;
+	else if ((int32_t) (t - dt) > 0x8000) dt += 0x10000ul;
+	if ((dt & 0xffff0000ul) < SysTick) _tb_hi++;	//SysTick wrapped: the isr for a pending overflow won't run
+	SysTick = dt & 0xffff0000ul;
+	t = dt;
+#endif
+	IFS0bits.T1IF = 0;
+	IEC0bits.T1IE = 0;
+	_idle_idle += t - t0;
+	_idle_last = t;
+	critExit(ipl);
+}
+
+//idle until the next scheduler task is due
+//in Sleep mode the software timers stop with tmr2, so their next expiry counts too
+void idle(void) {
+	uint32_t due = ticks() + IDLE_MAX;
+	uint8_t id;
+
+	for (id = 0; id < _task_cnt; id++)
+		if (_task[id].func && ((int32_t) (_task[id].next - due) < 0)) due = _task[id].next;
+#if defined(IDLE_SLEEP)
+	if (_tmw_cnt) {
+		uint32_t t = _tmw_t + ((_tmw_next() - _tmw_g) << TMW_SHIFT);
+		if ((int32_t) (t - due) < 0) due = t;
+	}
+#endif
+	idleUntil(due);
+}
+
+//ticks spent idle and active so far
+void idleStats(uint64_t *idle, uint64_t *active) {
+	uint8_t ipl;
+
+	critEnter(ipl);
+	*idle = _idle_idle;
+	*active = _idle_active + (_idle_now() - _idle_last);
+	critExit(ipl);
+}
+#endif	//use_kernel, systick_tmr1
+//end tickless idle
+
+//frequency scaling
+//cpu at F_PHB / 2^doze, doze=0..7
+void cpuDoze(uint8_t doze) {
+	doze &= 0x07;
+	CLKDIVbits.ROI = 0;							//0->interrupts leave DOZE alone
+	CLKDIVbits.DOZE = doze;						//0->1:1, 1->1:2, .. 7->1:128
+	CLKDIVbits.DOZEN = (doze != 0);
+}
+
+//frc postscaler 1:2^rcdiv, rcdiv=0..7. F_PHB follows when running off FRCDIV/FRCPLL
+void cpuRcdiv(uint8_t rcdiv) {
+	uint32_t f = F_PHB;
+	uint64_t now;
+	uint8_t ipl;
+
+	uartFlush();								//let tx drain at the old rate
+	critEnter(ipl);
+	now = micros64();
+	CLKDIVbits.RCDIV = rcdiv & 0x07;
+	SystemCoreClockUpdate();
+	_tb_epoch(now);								//millis()/micros() carry on at the new rate
+	clkRetune(f);
+	critExit(ipl);
+}
+
+//step DOZE by the load idle() saw since the last call: faster above DVFS_HIGH, slower below DVFS_LOW
+//return DOZE
+uint8_t cpuGovern(void) {
+	uint8_t doze = CLKDIVbits.DOZEN?CLKDIVbits.DOZE:0;
+#if !defined(USE_KERNEL) && !defined(SYSTICK_TMR1)
+	static uint64_t idle0=0, active0=0;
+	uint64_t idle, active;
+	uint32_t di, da;
+
+	idleStats(&idle, &active);
+	di = idle - idle0; da = active - active0;
+	idle0 = idle; active0 = active;
+	if (di + da == 0) return doze;
+	if ((uint64_t) da * 100 > (uint64_t) DVFS_HIGH * (di + da)) {if (doze) cpuDoze(--doze);}
+	else if ((uint64_t) da * 100 < (uint64_t) DVFS_LOW * (di + da)) {if (doze < 7) cpuDoze(++doze);}
+#endif
+	return doze;
+}
+//end frequency scaling
+
+//spi
+static uint32_t _spi1_hz=0, _spi2_hz=0;		//bit rates set by spixInit(), for spiRebaud()
+
+//bit rate from the PPRE/SPRE bits of SPIxCON1
+static uint32_t _spi_hz(uint16_t con) {
+	return F_PHB / (1ul << (2 * (3 - (con & 0x03)))) / (8 - ((con >> 2) & 0x07));
+}
+
+//PPRE/SPRE bits for the fastest bit rate not above hz
+static uint16_t _spi_con(uint32_t hz) {
+	uint32_t div = (F_PHB + hz - 1) / hz;		//total prescaler, rounded up
+	uint32_t sp;
+	uint8_t pp;
+
+	for (pp = 3; ; pp--) {						//primary: 3->1:1, 2->4:1, 1->16:1, 0->64:1
+		sp = (div + (1ul << (2 * (3 - pp))) - 1) >> (2 * (3 - pp));	//secondary needed
+		if ((sp <= 8) || (pp == 0)) break;
+	}
+	sp = constrain(sp, 1, 8);
+	if ((pp == 3) && (sp == 1)) sp = 2;			//1:1 / 1:1 is not allowed
+	return ((8 - sp) << 2) | pp;				//secondary: 7->1:1 .. 0->8:1
+}
+
+//rest spi1
+void spi1Init(uint16_t br) {
+	PMD1bits.SPI1MD = 0;				//0->enable the module
+
+	//map the pins
+#if defined(SCK1RP)
+	SCK1RP();
+#endif
+#if defined(SDO1RP)
+	SDO1RP();
+#endif
+#if defined(SDI1RP)
+	SDI1RP();
+#endif
+
+	//initialize the spi module
+	//master mode, PBCLK as clock, 8-bit data, enhanced buffer mode
+	SPI1CON1 = SPI1CON2 = 0; 			//reset the spi module
+	SPI1CON1bits.MSTEN = 1;				//1->master mode, 0->slave mode
+	SPI1CON1bits.PPRE = br;				//set the baudrate generator (primary prescaler)
+	SPI1CON1bits.SPRE = 0;				//set the secondary prescaler
+	_spi1_hz = _spi_hz(SPI1CON1);
+	SPI1STATbits.SPIROV=0;				//clear rov flag
+	//SPI1BUF;							//perform a read to clear the flag
+	SPI1CON2bits.SPIBEN= 1;				//1->enable enhanced buffer mode, 0->disable enhanced buffer mode
+	//need to deal with secondary as well
+	SPI1BUF;							//read the buffer to reset the flag
+	IFS0bits.SPI1IF = 0;				//0->reset the flag
+	IEC0bits.SPI1IE = 0;				//0->disable the interrupt, 1->enable the interrupt
+	irqApply(IRQ_SPI1);	//default interrupt priority
+
+	SPI1STATbits.SPIEN = 1;				//1->enable the module, 0->disable the module
+}
+
+//rest spi2
+void spi2Init(uint16_t br) {
+	PMD1bits.SPI2MD = 0;				//0->enable the module
+
+	//map the pins
+#if defined(SCK2RP)
+	SCK2RP();
+#endif
+#if defined(SDO2RP)
+	SDO2RP();
+#endif
+#if defined(SDI2RP)
+	SDI2RP();
+#endif
+
+
+	//initialize the spi module
+	//master mode, PBCLK as clock, 8-bit data, enhanced buffer mode
+	SPI2CON1 = SPI2CON2 = 0; 			//reset the spi module
+	SPI2CON1bits.MSTEN = 1;				//1->master mode, 0->slave mode
+	SPI2CON1bits.PPRE = br;				//set the baudrate generator
+	SPI2CON1bits.SPRE = 0;				//set the secondary prescaler
+	_spi2_hz = _spi_hz(SPI2CON1);
+	SPI1STATbits.SPIROV=0;				//clear rov flag
+	//SPI1BUF;							//perform a read to clear the flag
+	SPI1CON2bits.SPIBEN= 1;				//1->enable enhanced buffer mode, 0->disable enhanced buffer mode
+	//need to deal with 2nd ary as well
+	SPI2BUF;							//read the buffer to reset the flag
+	IFS2bits.SPI2IF = 0;				//0->reset the flag
+	IEC2bits.SPI2IE = 0;				//0->disable the interrupt, 1->enable the interrupt
+	irqApply(IRQ_SPI2);	//default interrupt priority
+
+	SPI2STATbits.SPIEN = 1;				//1->enable the module, 0->disable the module
+}
+
+//restore the spi bit rates set by spixInit() for the current F_PHB, or the nearest slower ones
+//the prescalers are only written with the module off: wait for the shift register to empty first
+void spiRebaud(void) {
+	if (_spi1_hz && SPI1STATbits.SPIEN) {
+		while (!SPI1STATbits.SRMPT) continue;
+		SPI1STATbits.SPIEN = 0;
+		SPI1CON1 = (SPI1CON1 & ~0x001f) | _spi_con(_spi1_hz);
+		SPI1STATbits.SPIEN = 1;
+	}
+	if (_spi2_hz && SPI2STATbits.SPIEN) {
+		while (!SPI2STATbits.SRMPT) continue;
+		SPI2STATbits.SPIEN = 0;
+		SPI2CON1 = (SPI2CON1 & ~0x001f) | _spi_con(_spi2_hz);
+		SPI2STATbits.SPIEN = 1;
+	}
+}
+
+//send data via spi
+//void spi2Write(uint8_t dat) {
+//	while (spi2Busy()) continue;		//tx buffer is full
+//	SPI2BUF = dat;						//load the data
+//}
+//end spi
+
+//clock switching
+//switch oscillator
+//return SystemCoreClock in frequency
+//111 = Fast RC Oscillator with Postscaler (FRCDIV)
+//110 = Reserved
+//101 = Low-Power RC Oscillator (LPRC)
+//100 = Secondary Oscillator (SOSC)
+//011 = Primary Oscillator with PLL module (XTPLL, HSPLL, ECPLL)
+//010 = Primary Oscillator (XT, HS, EC)
+//001 = Fast RC Oscillator with Postscaler and PLL module (FRCPLL)
+//000 = Fast RC Oscillator (FRC)
+//one transaction at ipl 7: snapshot micros64(), switch, wait for pll lock, start a new timebase epoch, re-derive the peripherals
+//the waits are bounded: with switching disabled (FCKSM) or an oscillator that does not start, the switch is abandoned
+//updates SystemCoreClock. return 0 if the switch did not happen
+#define CLK_SPIN				60000u			//polls of OSWEN / LOCK before giving up: ~10ms at 16MHz, longer on slow clocks
+uint32_t SystemCoreClockSwitch(uint8_t nosc) {
+	uint32_t f = F_PHB;
+	uint64_t now;
+	uint16_t spin;
+	uint8_t ipl;
+
+	uartFlush();								//let tx drain at the old rate
+	critEnter(ipl);								//hold off the interrupts
+	now = micros64();
+	__builtin_write_OSCCONH(nosc);
+	__builtin_write_OSCCONL(OSCCON | 0x01);		//set oswen bit -> start the switch
+	for (spin = CLK_SPIN; OSCCONbits.OSWEN && spin; spin--) continue;	//0->clock switch complete
+	if (OSCCONbits.OSWEN) __builtin_write_OSCCONL(OSCCON & ~0x01);	//still pending: abort it
+	if (OSCCONbits.COSC != (nosc & 0x07)) {critExit(ipl); return 0;}	//switching disabled, or nosc did not start: still on the old clock
+	if ((nosc == 0b001) || (nosc == 0b011))
+		for (spin = CLK_SPIN; (OSCCONbits.LOCK == 0) && spin; spin--) continue;	//1->pll locked
+	SystemCoreClockUpdate();					//update the core clock
+	_tb_epoch(now);								//millis()/micros() carry on at the new rate
+	clkRetune(f);
+	critExit(ipl);								//restore the interrupts
+	return SystemCoreClock;
+}
+
+//re-derive peripheral timing after F_PHB changed from f_old. call with interrupts held off
+//pwm on tmr2 keeps PR2=0xffff (it is the timebase): its frequency scales with F_PHB, duty cycles hold
+//stepper and software timer periods stay in ticks
+void clkRetune(uint32_t f_old) {
+	uint32_t f = F_PHB, t, dt;
+	uint64_t p;
+	uint8_t id;
+
+	if (f == f_old) return;
+	uartRebaud();
+	spiRebaud();
+
+	//servo: frame and pulse widths back in ticks
+	if (_servo_cnt) {
+		_servo_frame = SERVO_FRAME * cyclesPerMicrosecond();
+		for (id = 0; id < _servo_cnt; id++) _servo_pw[id] = _servo_us[id] * cyclesPerMicrosecond();
+	}
+
+	//tone: same pitch, same time left in the note
+	if (_tone_freq) _tone_out(_tone_freq);
+	_tone_rem = (uint64_t) _tone_rem * f / f_old;
+
+	//scheduler: same rates, same time to the next run
+	t = ticks64();								//ticks() may miss a pending tmr2 overflow at ipl 7
+	for (id = 0; id < _task_cnt; id++) {
+		p = ((uint64_t) _task_p0[id] * f + (_task_f0[id] >> 1)) / _task_f0[id];	//nearest, from the original period
+		_task[id].period = (p == 0)?1:((p > 0xfffffffful)?0xfffffffful:p);	//taskRun() divides by it
+		dt = _task[id].next - t;
+		if ((int32_t) dt > 0) _task[id].next = t + (uint64_t) dt * f / f_old;
+	}
+
+#if defined(USE_KERNEL)
+	PR1 = F_PHB / K_HZ;							//kernel tick
+#endif
+}
+//end clock switching
+
+//peripheral power
+#define PMD_REGS				5				//max registers saved per module
+#if defined(USE_KERNEL)
+#define PMD_TICK(pmd)			(((pmd) == PMD_T1) || ((pmd) == PMD_T2))	//kernel tick on tmr1, timebase on tmr2: never powered off
+#elif defined(SYSTICK_TMR1)
+#define PMD_TICK(pmd)			((pmd) == PMD_T1)	//timebase: never powered off
+#else
+#define PMD_TICK(pmd)			((pmd) == PMD_T2)
+#endif
+
+//PMDx register and bit of each module, registers to save in restore order: enable bits last
+static const struct {
+	volatile uint16_t *pmd;
+	uint8_t bit;
+	volatile uint16_t *reg[PMD_REGS];
+} _pmd_tbl[PMD_CNT]={
+	{&PMD1, 11, {&PR1, &TMR1, &T1CON}},
+	{&PMD1, 12, {&PR2, &TMR2, &T2CON}},
+	{&PMD1, 13, {&PR3, &TMR3, &T3CON}},
+	{&PMD1, 14, {&PR4, &TMR4, &T4CON}},
+	{&PMD1, 15, {&PR5, &TMR5, &T5CON}},
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	{&PMD2,  0, {&OC1R, &OC1RS, &OC1CON2, &OC1CON1}},
+	{&PMD2,  1, {&OC2R, &OC2RS, &OC2CON2, &OC2CON1}},
+	{&PMD2,  2, {&OC3R, &OC3RS, &OC3CON2, &OC3CON1}},
+	{&PMD2,  3, {&OC4R, &OC4RS, &OC4CON2, &OC4CON1}},
+	{&PMD2,  4, {&OC5R, &OC5RS, &OC5CON2, &OC5CON1}},
+	{&PMD2,  8, {&IC1CON2, &IC1CON1}},
+	{&PMD2,  9, {&IC2CON2, &IC2CON1}},
+	{&PMD2, 10, {&IC3CON2, &IC3CON1}},
+	{&PMD2, 11, {&IC4CON2, &IC4CON1}},
+	{&PMD2, 12, {&IC5CON2, &IC5CON1}},
+#else
+	{&PMD2,  0, {&OC1R, &OC1RS, &OC1CON}},
+	{&PMD2,  1, {&OC2R, &OC2RS, &OC2CON}},
+	{&PMD2,  2, {&OC3R, &OC3RS, &OC3CON}},
+	{&PMD2,  3, {&OC4R, &OC4RS, &OC4CON}},
+	{&PMD2,  4, {&OC5R, &OC5RS, &OC5CON}},
+	{&PMD2,  8, {&IC1CON}},
+	{&PMD2,  9, {&IC2CON}},
+	{&PMD2, 10, {&IC3CON}},
+	{&PMD2, 11, {&IC4CON}},
+	{&PMD2, 12, {&IC5CON}},
+#endif
+	{&PMD1,  5, {&U1BRG, &U1MODE, &U1STA}},		//UTXEN only takes after UARTEN
+	{&PMD1,  6, {&U2BRG, &U2MODE, &U2STA}},
+	{&PMD1,  3, {&SPI1CON1, &SPI1CON2, &SPI1STAT}},
+	{&PMD1,  4, {&SPI2CON1, &SPI2CON2, &SPI2STAT}},
+	{&PMD1,  0, {&AD1CHS, &AD1CSSL, &AD1CON3, &AD1CON2, &AD1CON1}},
+};
+static const char *_pmd_name[PMD_CNT]={
+	"T1   =              \r\n", "T2   =              \r\n", "T3   =              \r\n", "T4   =              \r\n", "T5   =              \r\n",
+	"OC1  =              \r\n", "OC2  =              \r\n", "OC3  =              \r\n", "OC4  =              \r\n", "OC5  =              \r\n",
+	"IC1  =              \r\n", "IC2  =              \r\n", "IC3  =              \r\n", "IC4  =              \r\n", "IC5  =              \r\n",
+	"U1   =              \r\n", "U2   =              \r\n", "SPI1 =              \r\n", "SPI2 =              \r\n", "AD1  =              \r\n",
+};
+static uint8_t _pmd_cnt[PMD_CNT];				//users, 0->none counted yet
+static uint16_t _pmd_reg[PMD_CNT][PMD_REGS];	//registers saved at power-off
+static uint32_t _pmd_saved=0;					//bit n->_pmd_reg[n] is valid
+
+//1->module powered up
+#define _pmd_on(pmd)			((*_pmd_tbl[pmd].pmd & (1u << _pmd_tbl[pmd].bit)) == 0)
+
+//users, 0->powered off. a module powered up by its xxxInit() counts as one
+uint8_t pmdUsers(PMD_TypeDef pmd) {
+	if (pmd >= PMD_CNT) return 0;
+	return _pmd_cnt[pmd]?_pmd_cnt[pmd]:(_pmd_on(pmd)?1:0);
+}
+
+//add a user, power up on the first
+//return the users
+uint8_t pmdEnable(PMD_TypeDef pmd) {
+	uint8_t ipl, i;
+
+	if (pmd >= PMD_CNT) return 0;
+	critEnter(ipl);
+	_pmd_cnt[pmd] = pmdUsers(pmd);
+	if ((_pmd_cnt[pmd] == 0) && !_pmd_on(pmd)) {
+		*_pmd_tbl[pmd].pmd &=~(1u << _pmd_tbl[pmd].bit);	//0->power up
+		if (_pmd_saved & (1ul << pmd)) {
+			for (i = 0; (i < PMD_REGS) && _pmd_tbl[pmd].reg[i]; i++) *_pmd_tbl[pmd].reg[i] = _pmd_reg[pmd][i];
+			_pmd_saved &=~(1ul << pmd);
+		}
+	}
+	if (_pmd_cnt[pmd] < 0xff) _pmd_cnt[pmd]++;
+	critExit(ipl);
+	return _pmd_cnt[pmd];
+}
+
+//drop a user, power off on the last
+//return the users
+uint8_t pmdDisable(PMD_TypeDef pmd) {
+	uint8_t ipl, i;
+
+	if (pmd >= PMD_CNT) return 0;
+	critEnter(ipl);
+	_pmd_cnt[pmd] = pmdUsers(pmd);
+	if (_pmd_cnt[pmd] && !(PMD_TICK(pmd) && (_pmd_cnt[pmd] == 1))) {
+		if (--_pmd_cnt[pmd] == 0) {
+			for (i = 0; (i < PMD_REGS) && _pmd_tbl[pmd].reg[i]; i++) _pmd_reg[pmd][i] = *_pmd_tbl[pmd].reg[i];
+			_pmd_saved |= (1ul << pmd);
+			*_pmd_tbl[pmd].pmd |= (1u << _pmd_tbl[pmd].bit);	//1->power off: registers reset
+		}
+	}
+	critExit(ipl);
+	return _pmd_cnt[pmd];
+}
+
+//powered modules: bit n->PMD_TypeDef n
+uint32_t pmdMap(void) {
+	uint32_t map=0;
+	uint8_t pmd;
+
+	for (pmd = 0; pmd < PMD_CNT; pmd++) if (_pmd_on(pmd)) map |= (1ul << pmd);
+	return map;
+}
+
+//print the users of each module, 0->powered off
+//print: u1Print() / u2Print()
+void pmdDump(void (*print)(char *str, int32_t dat)) {
+	uint8_t pmd;
+
+	for (pmd = 0; pmd < PMD_CNT; pmd++) print((char *) _pmd_name[pmd], pmdUsers(pmd));
+}
+//end peripheral power
+
+//deep sleep
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+//save state in DSGPR0/1, arm the DS_INT0/DS_RTC wake-ups and enter deep sleep
+//INT0 wakes on the edge set by INTCON2bits.INT0EP. the rtcc alarm must have been armed with RTCCAlarmSet()
+//the DSWDT, if enabled in the config bits, restarts on entry
+//wakes through a reset. returns only if an interrupt was pending: deep sleep was not entered
+void dsEnter(uint32_t state, uint16_t wake) {
+	DSGPR0 = state;
+	DSGPR1 = state >> 16;
+	if (wake & DS_INT0) {IFS0bits.INT0IF = 0; IEC0bits.INT0IE = 1;}
+	if (wake & DS_RTC) {IFS3bits.RTCIF = 0; IEC3bits.RTCIE = 1;}
+	uartFlush();								//let tx drain
+	__asm__ volatile (
+		"disi	#4\n"							//no interrupt between the writes and pwrsav
+		"bset	DSCON, #15\n"					//DSEN=1: set twice, back to back
+		"bset	DSCON, #15\n"
+		"pwrsav	#0\n"							//sleep -> deep sleep
+	);
+	DSCONbits.DSEN = 0;							//not entered
+}
+
+//DSWAKE bits at boot, 0->not a deep sleep wake
+uint16_t dsWake(void) {
+	return _ds_wake;
+}
+
+//state saved by dsEnter(), valid when dsWake()
+uint32_t dsState(void) {
+	return _ds_state;
+}
+#endif
+//end deep sleep
+
+//i2c
+
+//end i2c
+
+//rtcc
+//initialize the rtcc
+//clock source choosen in config bits: RTCOSC (SOSC and LPRC)
+void RTCCInit(void) {
+	PMD3bits.RTCCMD = 0;						//0->enable power to rtcc
+	RTCC_WREN();								//allows write to rtc registers
+	RCFGCALbits.RTCEN=1;						//start the rtc
+	RTCC_WRDIS();
+}
+
+//read from rtcc
+//mask: 0b00->min.sec, 0b01->weekday.hour, 0b10->month.day, 0b11->..year
+uint16_t RTCCRead(uint16_t mask) {
+	uint16_t tmp;
+	//RTCC_WREN();								//allows write to rtc registers
+	//RCFGCAL &= RTCC_MASK;						//mask off all bits not related to pointers
+	//RCFGCAL |= mask;							//point to min/sec
+	RCFGCALbits.RTCPTR=mask;
+	tmp = RTCVAL;								//return the lower byte
+	//RTCC_WRDIS();
+	return tmp;
+}
+
+//write to rtcc
+void RTCCWrite(uint16_t mask, uint16_t byte_t) {
+	RTCC_WREN();								//allows write to rtc registers
+	//RCFGCAL &= RTCC_MASK;						//mask off all bits not related to pointers
+	//RCFGCAL |= mask;							//point to min/sec
+	RCFGCALbits.RTCPTR=mask;
+	RTCVAL = byte_t;							//return the lower byte
+	RTCC_WRDIS();
+}
+
+//write to rtcc calibration register
+void RTCCSetCal(uint8_t cal) {
+	RTCC_WREN();								//allows write to rtc registers
+	RCFGCALbits.CAL=cal;
+	RTCC_WRDIS();
+}
+
+//read from rtcc calibration register
+uint8_t RTCCGetCal(void) {
+	return RCFGCALbits.CAL;
+}
+
+static const uint8_t _rtcc_bcd[100]={			//0..99 -> bcd
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19,
+	0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+	0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59,
+	0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79,
+	0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99
+};
+static const uint16_t _rtcc_yday[13]={0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365};	//days before each month, non-leap year
+static const uint16_t _rtcc_y4[4]={0, 366, 731, 1096};	//days before each year of a 4-year cycle: the first one is leap
+
+//the four RTCPTR words in one auto-decrementing pass: v[3]=year, v[2]=month.day, v[1]=wday.hour, v[0]=min.sec
+static void _rtcc_read(uint16_t *v) {
+	RCFGCALbits.RTCPTR = RTCPTR_YEAR;
+	v[3] = RTCVAL;
+	v[2] = RTCVAL;
+	v[1] = RTCVAL;
+	v[0] = RTCVAL;
+}
+
+//consistent snapshot of the rtcc, in binary
+//RTCSYNC->a rollover may land within the pass: read again until two passes agree
+void RTCCReadTime(RTCC_TypeDef *t) {
+	uint16_t v[4], w[4];
+	uint8_t sync;
+
+	do {
+		sync = RCFGCALbits.RTCSYNC;
+		_rtcc_read(v);
+		if (!sync && !RCFGCALbits.RTCSYNC) break;
+		_rtcc_read(w);
+	} while ((v[0] != w[0]) || (v[1] != w[1]) || (v[2] != w[2]) || (v[3] != w[3]));
+	t->year  = BCD2DEC(v[3] & 0xff);
+	t->month = BCD2DEC(v[2] >> 8);
+	t->day   = BCD2DEC(v[2] & 0xff);
+	t->wday  = v[1] >> 8;
+	t->hour  = BCD2DEC(v[1] & 0xff);
+	t->min   = BCD2DEC(v[0] >> 8);
+	t->sec   = BCD2DEC(v[0] & 0xff);
+}
+
+//days since 2000-01-01
+static uint16_t _rtcc_days(const RTCC_TypeDef *t) {
+	uint16_t d = (uint16_t) t->year * 365 + ((t->year + 3) >> 2);	//days before the year: 2000 is leap
+	uint8_t m = constrain(t->month, 1, 12) - 1;
+
+	d += _rtcc_yday[m] + t->day - 1;
+	if (((t->year & 0x03) == 0) && (m > 1)) d++;	//past feb 29
+	return d;
+}
+
+//date/time -> epoch
+uint32_t RTCCToEpoch(const RTCC_TypeDef *t) {
+	return RTCC_EPOCH2000 + (uint32_t) _rtcc_days(t) * 86400ul + (uint32_t) t->hour * 3600 + t->min * 60 + t->sec;
+}
+
+//epoch -> date/time, with wday. epochs before 2000 give 2000-01-01
+void RTCCFromEpoch(uint32_t epoch, RTCC_TypeDef *t) {
+	uint32_t s = (epoch > RTCC_EPOCH2000)?(epoch - RTCC_EPOCH2000):0, sd = s % 86400ul;
+	uint16_t d = s / 86400ul, y4, yd;
+	uint8_t y, m, leap;
+
+	t->hour = sd / 3600; sd %= 3600;
+	t->min = sd / 60;
+	t->sec = sd % 60;
+	t->wday = (d + 6) % 7;						//2000-01-01 was a saturday
+	y4 = d / 1461; yd = d % 1461;				//4-year cycles
+	y = (yd >= _rtcc_y4[3])?3:((yd >= _rtcc_y4[2])?2:((yd >= _rtcc_y4[1])?1:0));
+	yd -= _rtcc_y4[y];
+	t->year = y4 * 4 + y;
+	leap = (y == 0);
+	if (leap && (yd == 59)) {t->month = 2; t->day = 29; return;}	//feb 29
+	if (leap && (yd > 59)) yd--;				//on the non-leap table from here
+	m = yd >> 5;								//at or below the month
+	while (yd >= _rtcc_yday[m + 1]) m++;		//one step at most
+	t->month = m + 1;
+	t->day = yd - _rtcc_yday[m] + 1;
+}
+
+//set the rtcc in one pass. wday is ignored and worked out from the date
+//waits out RTCSYNC so the write does not straddle a rollover
+void RTCCWriteTime(const RTCC_TypeDef *t) {
+	uint16_t v[4];
+	uint8_t ipl;
+
+	v[3] = _rtcc_bcd[t->year % 100];
+	v[2] = (_rtcc_bcd[t->month] << 8) | _rtcc_bcd[t->day];
+	v[1] = (((_rtcc_days(t) + 6) % 7) << 8) | _rtcc_bcd[t->hour];
+	v[0] = (_rtcc_bcd[t->min] << 8) | _rtcc_bcd[t->sec];
+	while (RCFGCALbits.RTCSYNC) continue;
+	critEnter(ipl);
+	RTCC_WREN();								//allows write to rtc registers
+	RCFGCALbits.RTCPTR = RTCPTR_YEAR;			//auto-decrements on each write
+	RTCVAL = v[3];
+	RTCVAL = v[2];
+	RTCVAL = v[1];
+	RTCVAL = v[0];
+	RTCC_WRDIS();
+	critExit(ipl);
+}
+
+//epoch from the rtcc
+uint32_t RTCCGetEpoch(void) {
+	RTCC_TypeDef t;
+
+	RTCCReadTime(&t);
+	return RTCCToEpoch(&t);
+}
+
+//set the rtcc from an epoch
+void RTCCSetEpoch(uint32_t epoch) {
+	RTCC_TypeDef t;
+
+	RTCCFromEpoch(epoch, &t);
+	RTCCWriteTime(&t);
+}
+
+//rtcc alarm
+static void (* _rtcc_isrptr)(void)=empty_handler;	//alarm callback
+
+void _ISR_PSV _RTCCInterrupt(void) {
+	ISR_ENTER();								//ISR_PROFILE
+	IFS3bits.RTCIF = 0;							//clear the flag
+#if defined(RTC_HANDLER)
+	RTC_HANDLER();						//bound at compile time
+#else
+	_rtcc_isrptr();								//run the isr
+#endif
+	ISR_EXIT(IRQ_RTC);
+}
+
+//cancel the alarm
+//ALRMEN is only cleared with RTCSYNC=0
+void RTCCAlarmStop(void) {
+	IEC3bits.RTCIE = 0;							//0->disable the interrupt
+	while (RCFGCALbits.RTCSYNC) continue;
+	ALCFGRPTbits.ALRMEN = 0;
+	IFS3bits.RTCIF = 0;
+}
+
+//alarm at t, then every.. (RTCC_EVERY_xx: fields finer than every are matched, the rest ignored)
+//repeat=1..256 alarms in all, RTCC_FOREVER->never stop. the hardware disarms itself after the last one
+//func runs in the rtcc isr, NULL->flag and wake-up only
+void RTCCAlarmSet(const RTCC_TypeDef *t, uint8_t every, uint16_t repeat, void (*func)(void)) {
+	RTCCAlarmStop();
+	_rtcc_isrptr = func?func:empty_handler;
+	ALCFGRPT = 0;								//ALRMEN=0, CHIME=0
+	ALCFGRPTbits.AMASK = every;
+	ALCFGRPTbits.ALRMPTR = 2;					//auto-decrements on each write
+	ALRMVAL = (_rtcc_bcd[t->month] << 8) | _rtcc_bcd[t->day];
+	ALRMVAL = ((t->wday & 0x07) << 8) | _rtcc_bcd[t->hour];
+	ALRMVAL = (_rtcc_bcd[t->min] << 8) | _rtcc_bcd[t->sec];
+	if (repeat == RTCC_FOREVER) ALCFGRPTbits.CHIME = 1;	//1->ARPT rolls over: repeats forever
+	else ALCFGRPTbits.ARPT = (repeat > 256)?255:(repeat - 1);
+	IFS3bits.RTCIF = 0;							//0->reset the flag
+	irqApply(IRQ_RTC);							//set the interrupt priority
+	IEC3bits.RTCIE = 1;							//1->enable the interrupt
+	ALCFGRPTbits.ALRMEN = 1;
+}
+
+//one-shot alarm at an epoch
+void RTCCAlarmAt(uint32_t epoch, void (*func)(void)) {
+	RTCC_TypeDef t;
+
+	RTCCFromEpoch(epoch, &t);
+	RTCCAlarmSet(&t, RTCC_EVERY_YEAR, 1, func);
+}
+
+//wall clock
+static volatile uint32_t _now_sec=0;			//epoch at the last rtcc rollover
+static volatile uint64_t _now_t=0;				//ticks64() at the last rtcc rollover
+static volatile uint32_t _now_rate=1;			//ticks per rtcc second
+static volatile uint16_t _now_cnt=0;			//latches taken
+
+//1Hz alarm: latch ticks64() against the new second
+//a one-second interval within 1/64 of F_PHB is taken as the measured rate. otherwise (first latch, missed second, clock switch) F_PHB
+static void _now_isr(void) {
+	uint64_t t = ticks64();
+	uint32_t sec = RTCCGetEpoch(), dt = t - _now_t;
+	uint8_t ipl;
+
+	critEnter(ipl);								//latch updated as one: now() in a higher priority isr sees old or new
+	_now_rate = ((sec == _now_sec + 1) && (dt > _tb_rate - (_tb_rate >> 6)) && (dt < _tb_rate + (_tb_rate >> 6)))?dt:_tb_rate;
+	_now_sec = sec;
+	_now_t = t;
+	_now_cnt++;
+	critExit(ipl);
+}
+
+//start the 1Hz latch: rtcc running and set
+//takes over the rtcc alarm and waits for the first rollover, up to 1.5 seconds
+//return 0 if the latch did not start: rtcc off, RTC_HANDLER bound in place of the alarm isr, or no rollover
+uint8_t nowInit(void) {
+#if defined(RTC_HANDLER)
+	return 0;									//the vector never reaches _now_isr()
+#else
+	RTCC_TypeDef t;
+	uint16_t cnt = _now_cnt;
+	uint32_t t0;
+
+	if (RCFGCALbits.RTCEN == 0) return 0;		//rtcc not running: no rollover to wait for
+	RTCCReadTime(&t);
+	RTCCAlarmSet(&t, RTCC_EVERY_SEC, RTCC_FOREVER, _now_isr);	//every second: no field matched
+	t0 = ticks();
+	while (_now_cnt == cnt) {
+		if (ticks() - t0 > F_PHB + (F_PHB >> 1)) {RTCCAlarmStop(); return 0;}	//no alarm: rtcc stalled (no SOSC?)
+		yield();
+	}
+	return 1;
+#endif
+}
+
+//microseconds since 1970-01-01 00:00:00
+uint64_t now(void) {
+	uint64_t t;
+	uint32_t sec, rate, us;
+	uint8_t ipl;
+
+	critEnter(ipl);								//latch and ticks64() read together: no retry loop, safe in any isr
+	sec = _now_sec; rate = _now_rate;
+	t = ticks64() - _now_t;
+	critExit(ipl);
+	t = t * 1000000ul / rate;
+	us = (t > 999999ul)?999999ul:t;				//latch overdue: hold at the end of the second
+	return (uint64_t) sec * 1000000ul + us;
+}
+
+//ticks per rtcc second, as last measured
+uint32_t nowRate(void) {
+	uint32_t rate;
+	uint8_t ipl;
+
+	critEnter(ipl);
+	rate = _now_rate;
+	critExit(ipl);
+	return rate;
+}
+
+//end rtcc
+
+//cnint
+void (* _cn_isrptr) (void)=empty_handler;
+
+//per-pin callbacks
+#define CN_PORTS	(PMAX / 16)					//16 pins per port
+static struct {
+	PIN_TypeDef pin;
+	uint8_t mode;								//RISING/FALLING/CHANGE
+	void (*func)(PIN_TypeDef pin, uint8_t level, uint32_t tick);
+} _cn_cb[CN_CNT];
+static uint8_t _cn_cbcnt=0;						//number of callbacks
+static uint16_t _cn_watch[CN_PORTS];			//pins with a callback, per port
+static uint16_t _cn_last[CN_PORTS];				//port snapshot at the last interrupt
+
+//snapshot the watched ports once, and call back the pins that changed
+static void _cn_dispatch(void) {
+	uint16_t port[CN_PORTS], diff[CN_PORTS], any=0, mask;
+	uint8_t i, p, level;
+	uint32_t tick;
+
+	for (p = 0; p < CN_PORTS; p++) {
+		if (_cn_watch[p] == 0) {diff[p] = 0; continue;}
+		port[p] = GPIO_PinDef[p << 4].gpio->PORT;
+		diff[p] = (port[p] ^ _cn_last[p]) & _cn_watch[p];
+		_cn_last[p] = port[p];
+		any |= diff[p];
+	}
+	if (any == 0) return;						//none of ours changed
+
+	tick = ticks();
+	for (i = 0; i < _cn_cbcnt; i++) {
+		p = _cn_cb[i].pin >> 4; mask = GPIO_PinDef[_cn_cb[i].pin].mask;
+		if ((diff[p] & mask) == 0) continue;
+		level = (port[p] & mask)?1:0;
+		if ((_cn_cb[i].mode == CHANGE) || (_cn_cb[i].mode == RISING && level) || (_cn_cb[i].mode == FALLING && !level))
+			_cn_cb[i].func(_cn_cb[i].pin, level, tick);
+	}
+}
+
+void _ISR_PSV _CNInterrupt(void) {
+	ISR_ENTER();								//ISR_PROFILE
+	IFS1bits.CNIF = 0; 							//clear the flag
+	if (_cn_cbcnt) _cn_dispatch();				//per-pin callbacks
+#if defined(CN_HANDLER)
+	CN_HANDLER();						//bound at compile time
+#else
+	_cn_isrptr();								//run the isr
+#endif
+	ISR_EXIT(IRQ_CN);
+}
+
+//initialize change notification
+void cnInit(uint32_t pins) {
+	_cn_isrptr=empty_handler;					//reset the isr
+
+	//enable power - always enabled
+
+	IFS1bits.CNIF = 0;							//clear the flag
+	irqApply(IRQ_CN);							//set the interrupt priority
+	IEC1bits.CNIE = 1;							//1->enable the interrupt, 0->disable the interrupt
+
+	//set up cnie
+	CNEN1 = pins;
+	CNPU1 = pins;
+	pins = pins >> 16;
+	CNEN2 = pins;
+	CNPU2 = pins;
+
+	IEC1bits.CNIE = 1;							//1->enable the interrupt, 0->disable the interrupt
+}
+
+//attach user isr
+void cnAttachISR(void (*isrptr) (void)) {
+	_cn_isrptr = isrptr;						//point the isrptr
+	irqApply(IRQ_CN);							//set the interrupt priority
+	IFS1bits.CNIF= 0;							//0->clear the flag
+	IEC1bits.CNIE= 1;							//0->disable the interrupt
+}
+
+//call func(pin, level, ticks()) when pin changes: mode=RISING/FALLING/CHANGE
+//return 0 if the table is full
+uint8_t cnAttach(PIN_TypeDef pin, void (*func)(PIN_TypeDef pin, uint8_t level, uint32_t tick), uint8_t mode) {
+	uint8_t i, p = pin >> 4;
+	uint16_t mask = GPIO_PinDef[pin].mask;
+
+	for (i = 0; i < _cn_cbcnt; i++) if (_cn_cb[i].pin == pin) break;	//replace an existing callback
+	if (i >= CN_CNT) return 0;
+
+	IEC1bits.CNIE = 0;							//hold off the cn isr
+	_cn_cb[i].pin = pin; _cn_cb[i].mode = mode; _cn_cb[i].func = func;
+	if (i == _cn_cbcnt) _cn_cbcnt++;
+	_cn_last[p] = (_cn_last[p] & ~mask) | (GPIO_PinDef[pin].gpio->PORT & mask);	//current level as the baseline
+	_cn_watch[p] |= mask;
+	irqApply(IRQ_CN);							//set the interrupt priority
+	IFS1bits.CNIF = 0;							//0->clear the flag
+	IEC1bits.CNIE = 1;							//1->enable the interrupt
+	return 1;
+}
+
+//remove the pin's callback
+void cnDetach(PIN_TypeDef pin) {
+	uint8_t i, ie = IEC1bits.CNIE;
+
+	IEC1bits.CNIE = 0;							//hold off the cn isr
+	for (i = 0; i < _cn_cbcnt; i++)
+		if (_cn_cb[i].pin == pin) {
+			_cn_cb[i] = _cn_cb[--_cn_cbcnt];	//move the last one in
+			_cn_watch[pin >> 4] &= ~GPIO_PinDef[pin].mask;
+			break;
+		}
+	IEC1bits.CNIE = ie;
+}
+
+//end cnint
+
+//quadrature encoders on change notification
+//each cn interrupt reads the encoder's port once and looks up the count from the old and new a/b bits
+//transitions with both bits changed are missed edges and count 0
+static const int8_t _enc_tbl[16]={0, -1, 1, 0, 1, 0, 0, -1, -1, 0, 0, 1, 0, 1, -1, 0};	//index: old ab << 2 | new ab
+static struct {
+	GPIO_TypeDef *gpio;									//port of both channels
+	uint16_t a, b;										//channel masks
+	uint8_t ab;											//last a/b bits
+	volatile int32_t pos;								//position, in counts
+	int32_t pos0;										//position at the start of the velocity window
+	int32_t vel;										//counts in the last velocity window
+	uint32_t t0;										//start of the velocity window, in ticks
+} _enc[ENC_CNT];
+static volatile uint8_t _enc_cnt=0;						//number of encoders
+static uint32_t _enc_win;								//velocity window, in ticks
+
+//close the velocity window if it has elapsed
+static void _enc_window(uint8_t i, uint32_t now) {
+	uint32_t dt = now - _enc[i].t0;
+
+	if (dt < _enc_win) return;
+	_enc[i].vel = (dt < 2 * _enc_win)?(_enc[i].pos - _enc[i].pos0):0;	//no edge for a whole window -> stopped
+	_enc[i].pos0 = _enc[i].pos;
+	_enc[i].t0 = now;
+}
+
+//cn isr
+static void _enc_isr(void) {
+	GPIO_TypeDef *gpio=NULL;
+	uint16_t port=0;
+	uint8_t i, ab;
+	uint32_t now = ticks();
+
+	for (i = 0; i < _enc_cnt; i++) {
+		if (_enc[i].gpio != gpio) {gpio = _enc[i].gpio; port = gpio->PORT;}	//one read per port
+		ab = ((port & _enc[i].a)?2:0) | ((port & _enc[i].b)?1:0);
+		_enc[i].pos += _enc_tbl[(_enc[i].ab << 2) | ab];
+		_enc[i].ab = ab;
+		_enc_window(i, now);
+	}
+}
+
+//start decoding
+//cnpins: cn inputs of the encoder channels, as in cnInit(). window: velocity window, in ticks
+void encInit(uint32_t cnpins, uint32_t window) {
+	_enc_cnt = 0;
+	_enc_win = window;
+	cnInit(cnpins);										//enable the cn inputs, with pull-ups
+	cnAttachISR(_enc_isr);
+}
+
+//add an encoder: both channels on the same port
+//return its index, or ENC_CNT if none is left
+uint8_t encAttach(PIN_TypeDef a, PIN_TypeDef b) {
+	uint8_t i = _enc_cnt;
+	uint16_t port;
+
+	if (i >= ENC_CNT) return ENC_CNT;
+	pinMode(a, INPUT); pinMode(b, INPUT);
+	IEC1bits.CNIE = 0;									//hold off the cn isr
+	_enc[i].gpio = GPIO_PinDef[a].gpio;
+	_enc[i].a = GPIO_PinDef[a].mask; _enc[i].b = GPIO_PinDef[b].mask;
+	port = _enc[i].gpio->PORT;
+	_enc[i].ab = ((port & _enc[i].a)?2:0) | ((port & _enc[i].b)?1:0);
+	_enc[i].pos = _enc[i].pos0 = _enc[i].vel = 0;
+	_enc[i].t0 = ticks();
+	_enc_cnt = i + 1;
+	IEC1bits.CNIE = 1;
+	return i;
+}
+
+//atomic snapshot of position and velocity
+void encRead(uint8_t enc, ENC_TypeDef *snap) {
+	uint8_t ie = IEC1bits.CNIE;
+
+	if (enc >= _enc_cnt) return;
+	IEC1bits.CNIE = 0;									//hold off the cn isr
+	snap->tick = ticks();
+	_enc_window(enc, snap->tick);
+	snap->pos = _enc[enc].pos;
+	snap->vel = _enc[enc].vel;
+	IEC1bits.CNIE = ie;
+}
+
+//set the position
+void encWrite(uint8_t enc, int32_t pos) {
+	uint8_t ie = IEC1bits.CNIE;
+
+	if (enc >= _enc_cnt) return;
+	IEC1bits.CNIE = 0;									//hold off the cn isr
+	_enc[enc].pos0 += pos - _enc[enc].pos;				//keep the velocity window going
+	_enc[enc].pos = pos;
+	IEC1bits.CNIE = ie;
+}
+//end encoder
+
+//crc, 16-bit and 32-bit
+//initialize crc engine: little endian, no interrupt
+//weight in xor, and initial value in init
+void CRCInit(uint8_t len, uint32_t poly) {
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__) | \
+			defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+			defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+			defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+	PMD3bits.CRCMD = 0;							//0->enable the model, 1->disable the model
+
+	//configure the crc engine
+	CRCCON1 = CRCCON2 = 0;						//reset the configuration word
+	CRCCON1bits.LENDIAN=0;						//0->data shifting LSB first (little endian), 1->data shifting MSB first (big endian)
+	CRCCON1bits.CRCISEL=0;						//0->CRCIF set on shift completion; 1->CRCIF set on buffer empty
+	//CRCCON1bits.CRCGO  =1;					//1->start crc shift, 0->crc shifter turned off
+
+	CRCCON2bits.PLEN = len-1;	//0..31: length of CRC. 0x07->8bit, 0x0f->16 bit, 0x1f->32 bit
+	CRCCON2bits.DWIDTH = CRCCON2bits.PLEN;		//set data width to plen
+
+	//CRCXORH = CRCXORL = 0;					//crc xor registers
+	//CRCXORH = xor >> 16; CRCXORL = xor;		//configure the xor words
+	CRCXOR = poly;
+
+	//CRCWDATH= init >> 16; CRCWDATL = init;
+	//CRCWDAT = init;
+
+	IFS4bits.CRCIF = 0;							//0->clear the flag, 1->set the flag
+	irqApply(IRQ_CRC);				//set the interrupt priority
+	//IPC16bits.CRCIS= CRCIS_DEFAULT;			//set the interrupt subpriority
+	IEC4bits.CRCIE = 0;							//0->disable the interrupt, 1->enable the interrupt
+
+	CRCCON1bits.CRCEN = 1;						//1->enable the model, 0->disable the model
+#else	//ga002 chips
+	PMD3bits.CRCPMD = 0;						//0->enable the model, 1->disable the model
+
+	//configure the crc engine
+	CRCCON = 0;									//reset the configuration word
+	//CRCCONbits.LENDIAN=0;						//0->data shifting LSB first (little endian), 1->data shifting MSB first (big endian)
+	//CRCCONbits.CRCISEL=0;						//0->CRCIF set on shift completion; 1->CRCIF set on buffer empty
+	//CRCCON1bits.CRCGO  =1;					//1->start crc shift, 0->crc shifter turned off
+
+	CRCCONbits.PLEN = len-1;	//0..31: length of CRC. 0x07->8bit, 0x0f->16 bit, 0x1f->32 bit
+	//CRCCONbits.DWIDTH = CRCCON2bits.PLEN;		//set data width to plen
+
+	//CRCXORH = CRCXORL = 0;					//crc xor registers
+	//CRCXORH = xor >> 16; CRCXORL = xor;		//configure the xor words
+	CRCXOR = poly;
+
+	//CRCWDATH= init >> 16; CRCWDATL = init;
+	//CRCWDAT = init;
+
+	IFS4bits.CRCIF = 0;							//0->clear the flag, 1->set the flag
+	irqApply(IRQ_CRC);				//set the interrupt priority
+	//IPC16bits.CRCIS= CRCIS_DEFAULT;			//set the interrupt subpriority
+	IEC4bits.CRCIE = 0;							//0->disable the interrupt, 1->enable the interrupt
+
+	//CRCCONbits.CRCEN = 1;						//1->enable the model, 0->disable the model
+#endif	//ga102
+}
+
+//calculate crc
+//length must be multiples of 2
+uint16_t CRC16(char *msg, uint16_t length, uint16_t init_val) {
+	uint16_t tmp;
+#if defined(__PIC24GA10x__)
+	/*#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+			defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__)*/
+	CRCWDAT = init_val;							//load the initial word
+	CRCCON1bits.CRCGO = 1;						//CRCGo(); //while (CRCCON1bits.CRCMPT==0) continue;	//wait for crc to complete
+
+	while (length) {
+		//tmp = *(uint16_t *)msg++;				//load the data
+		//tmp = ((uint16_t) (*msg++) << 8) | (*msg++);
+		tmp = *msg++;
+		tmp = tmp << 8;			//form the data
+		tmp|= *msg++;
+		while (CRCCON1bits.CRCFUL==1) continue;	//wait for buffer to have at least 1 space
+		CRCDAT = tmp;
+		length-=2;
+	}
+
+	while (CRCCON1bits.CRCFUL==1) continue;		//wait until CRC is not full
+	CRCDAT = 0;									//shift out the last two bytes
+	while (CRCCON1bits.CRCMPT==0) continue;
+	NOP4();										//wait for the shift to complete. 1 NOP() is enough
+	//CRCCON1bits.CRCGO=0;						//why?
+	//while (CRCCON1bits.CRCGO == 1) continue;
+
+#else
+	CRCWDAT = init_val;							//load the initial word
+	CRCCONbits.CRCGO = 1;						//CRCGo(); //while (CRCCON1bits.CRCMPT==0) continue;	//wait for crc to complete
+
+	while (length) {
+		//tmp = *(uint16_t *)msg++;				//load the data
+		//tmp = ((uint16_t) (*msg++) << 8) | (*msg++);
+		tmp = *msg++;
+		tmp = tmp << 8;			//form the data
+		tmp|= *msg++;
+		while (CRCCONbits.CRCFUL==1) continue;	//wait for buffer to have at least 1 space
+		CRCDAT = tmp;
+		length-=2;
+	}
+
+	while (CRCCONbits.CRCFUL==1) continue;		//wait until CRC is not full
+	CRCDAT = 0;									//shift out the last two bytes
+	while (CRCCONbits.CRCMPT==0) continue;
+	NOP4();										//wait for the shift to complete. 1 NOP() is enough
+	//CRCCON1bits.CRCGO=0;						//why?
+	//while (CRCCON1bits.CRCGO == 1) continue;
+
+#endif
+
+	return CRCWDAT;
+}
+
+//comparator voltage reference
+void CVrefInit(void) {
+	//no PMD bits?
+
+	CVRCON = 0;									//reset value
+	CVRCONbits.CVRR = 1;						//1->0..0.625 in 24 steps. 0->0.25..0.719 in 32 steps
+	//output disabled
+	//
+	CVRCONbits.CVREN = 1;						//enable the module
+}
+//end comparator voltage reference
+
+//comparator
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+/*#if 	defined(__PIC24FJ64GA102__) | defined(__PIC24FJ64GA104__) | \
+		defined(__PIC24FJ32GA102__) | defined(__PIC24FJ32GA104__) | \
+	 	defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+		defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+		defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)*/
+//initialize comparator
+void CM1Init(void) {
+	PMD3bits.CMPMD = 0;							//1->disable the module, 0->enable the model
+
+	CM1CON = 0;									//reset value
+	CM1CONbits.CEN = 1;							//1->enable the module, 0->disable the module
+}
+
+void CM2Init(void) {
+	PMD3bits.CMPMD = 0;							//1->disable the module, 0->enable the model
+
+	CM2CON = 0;									//reset value
+	CM2CONbits.CEN = 1;							//1->enable the module, 0->disable the module
+}
+
+void CM3Init(void) {
+	PMD3bits.CMPMD = 0;							//1->disable the module, 0->enable the model
+
+	CM3CON = 0;									//reset value
+	CM3CONbits.CEN = 1;							//1->enable the module, 0->disable the module
+}
+#else		//ga002 devices
+//initialize comparator
+void CM1Init(void) {
+	PMD3bits.CMPMD = 0;							//1->disable the module, 0->enable the model
+
+	CMCON = CMCON & 0b0010101010101100;			//reset value
+	CMCONbits.C1EN = 1;							//1->enable the module, 0->disable the module
+}
+
+void CM2Init(void) {
+	PMD3bits.CMPMD = 0;							//1->disable the module, 0->enable the model
+
+	CMCON = CMCON &~0b0010101010101100;			//reset value
+	CMCONbits.C2EN = 1;							//1->enable the module, 0->disable the module
+}
+#endif
+
+//end comparator
+
@@ -1,1170 +1,1600 @@
-#ifndef _PIC24DUINO_H
-#define _PIC24DUINO_H
-
-//PIC24duino code
-// - using PIC24FJxxGA004/104, and GB004 family (GA002/004, GA102/104, and GB002/004 families)
-// - free running timer2 for ticks, pwm and input capture
-// -
-// - version history
-// - v2.0, 5/15/2021: simplified port
-// - v2.1, 5/26/2021: implemented SystemCoreClockUpdate() - to be executed during mcu initialization or after oscillator reconfiguration
-// - v2.2, 6/06/2021: implemented hardware CRC (16-bit only).
-// - v2.3, 6/07/2021: revised rtcc implementation
-// - v2.4, 6/16/2021: updated to support GB002/004 chips
-// - v2.5, 6/19/2021: implemented output compare (dah!)
-// - v2.6, 5/19/2022: output compare routines no longer advance compare registers
-// - v2.7, 5/24/2022: simplified support for GA00x, GA10x, and GB00x devices
-// - v2.8, 5/24/2022: added support for C30 compiler
-// - v2.9, 6/04/2022: support IO port A..G
-//
-//
-//               PIC24FJ
-//              |=====================|
-//    Vcc       |                     |
-//     |        |                Vcap |>--[.1u]-+->GND
-//     |        |                     |         |
-//     +-[10K]-<| MCLR        DISVreg |>--------+
-//              |                     |
-//              |                     |
-//     +------->| OSCI            Vdd |>--+------>Vcc
-//  [Xtal]      |                     | [.1u]
-//     +-------<| OSCO            Vss |>--+------>GND
-//              |                     |
-//              |                 RP0 |>---------->Uart2TX
-//              |                     |
-//              |                 RB5 |>---------->LED
-//              |                     |
-//              |                     |
-//              |                     |
-//              |                     |
-//              |                     |
-//              |                     |
-//              |                     |
-//              |                     |
-//              |                     |
-//              |=====================|
-//
-//
-
-#if defined(__XC__)
-#include <xc.h>							//we use xc24
-#include <stdint.h>						//we use uint types
-#elif defined(__C30__)						//we use C30
-#include <p24fxxxx.h>
-
-//PIC24GA10x family
-#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-		defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__)
-#define __PIC24GA10x__
-
-//PIC24GA00x family
-#elif 	defined(__PIC24FJ64GA002__) | defined (__PIC24FJ64GA004__) | \
-		defined(__PIC24FJ48GA002__) | defined (__PIC24FJ48GA004__) | \
-		defined(__PIC24FJ32GA002__) | defined (__PIC24FJ32GA004__) | \
-		defined(__PIC24FJ16GA002__) | defined (__PIC24FJ16GA004__)
-#define __PIC24GA00x__
-
-//pic24GB00x family
-#elif 	defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
-		defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
-		defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)
-#define __PIC24GB00x__
-#else
-#error "PIC24Duino.c: PIC24 not supported!"
-#endif
-
-//define types
-typedef unsigned char uint8_t;
-typedef signed char int8_t;
-typedef unsigned short uint16_t;
-typedef signed short int16_t;
-typedef unsigned long uint32_t;
-typedef signed long int32_t;
-#else
-#error "PIC24Duino.h: only C30 / XC compilers supported!"
-#endif
-#include <string.h>							//we use strcpy()
-
-//hardware configuration
-//#define USE_MAIN							//use self-defined main() in user code
-#define USE_SYSTICK							//for compatability with pic32duino. ignored
-//#define SYSTICK_TMR1						//systick running on tmr1 if defined (default). otherwise on tmr2
-
-//oscillator configuration
-#define F_XTAL				8000000ul		//crystal frequency, user-specified
-#define F_SOSC				32768			//SOSC = 32768Hz, user-specified
-
-#define TxIP_DEFAULT		5				//default priority for timer interrupts 0..7. 0->interrupt disabled, 7->highest priority
-#define TxIS_DEFAULT		5				//default subpriority for timer interrupts
-#define OCxIP_DEFAULT		5				//default priority for timer interrupts 0..7. 0->interrupt disabled, 7->highest priority
-#define CRCIP_DEFAULT		5				//default priority for crc interrupt
-#define SPIIP_DEFAULT		1					//default interrupt priority
-#define SPIIS_DEFAULT		0
-//end user specification
-
-//uart1 pin configuration
-#define U1TX2RP()			PPS_U1TX_TO_RP(2)			//map u1tx pin to an rp pin
-//#define U1RX2RP()			PPS_U1RX_TO_RP(3)			//map u1rx pin to an rp pin
-
-//uart2 pin configuration
-#define U2TX2RP()			PPS_U2TX_TO_RP(0)			//u2tx pin
-//#define U2RX2RP()			PPS_U2RX_TO_RP(1)			//u2rx pin
-
-//pwm/oc pin configuration
-#define PWM12RP()			PPS_OC1_TO_RP(0)			//oc1 pin:
-#define PWM22RP()			PPS_OC2_TO_RP(1)			//oc2 pin:
-#define PWM32RP()			PPS_OC3_TO_RP(2)			//oc3 pin:
-#define PWM42RP()			PPS_OC4_TO_RP(3)			//oc4 pin:
-//#define PWM52RP()			PPS_OC5_TO_RP(5)			//oc5 pin:
-
-//input capture pin configuration
-#define IC12RP()			PPS_IC1_TO_RP(4)			//ic1 pin:
-#define IC22RP()			PPS_IC2_TO_RP(7)			//ic2 pin:
-#define IC32RP()			PPS_IC3_TO_RP(4)			//ic3 pin:
-#define IC42RP()			PPS_IC4_TO_RP(4)			//ic4 pin:
-#define IC52RP()			PPS_IC5_TO_RP(4)			//ic5 pin:
-
-//spi1 pin configuration
-#define SCK1RP()			PPS_SCK1OUT_TO_RP(0)		//spi1 serial clock output
-#define SDO1RP()			PPS_SDO1_TO_RP(1)			//spi1 serial data output
-//#define SDI1RP()			PPS_SDI1_TO_RP(3)			//spi1 serial data input
-#define SCK2RP()			PPS_SCK2OUT_TO_RP(1)		//spi1 serial clock output
-#define SDO2RP()			PPS_SDO2_TO_RP(2)			//spi1 serial data output
-#define SDI2RP()			PPS_SDI2_TO_RP(3)			//spi1 serial data input
-
-//extint pin configuration
-//#define INT02RP()			PPS_INT0_TO_RP(7)			//int0 pin: fixed to rp7
-#define INT12RP()			PPS_INT1_TO_RP(5)			//int1 pin:
-#define INT22RP()			PPS_INT2_TO_RP(5)			//int2 pin:
-//#define INT32RP()			PPS_INT3_TO_RP(5)			//int3 pin:
-//#define INT42RP()			PPS_INT4_TO_RP(5)			//int4 pin:
-//end pin configuration
-
-
-#define PWM_PR				0xffff			//pwm period - don't change
-
-//port manipulation macros for PIC.
-//#define IO_SET(port, bits)              port |= (bits)			//set bits on port
-//#define IO_CLR(port, bits)              port &=~(bits)			//clear bits on port
-//#define IO_FLP(port, bits)              port ^= (bits)			//flip bits on port
-//#define IO_GET(port, bits)              ((port) & (bits))		//return bits on port
-//#define IO_OUT(ddr, bits)               ddr &=~(bits)			//set bits as output
-//#define IO_IN(ddr, bits)                ddr |= (bits)			//set bits as input
-
-//if gpio_typedef is used
-#define GIO_SET(port, bits)              port->LAT |= (bits)			//set bits on port
-#define GIO_CLR(port, bits)              port->LAT &=~(bits)			//clear bits on port
-#define GIO_FLP(port, bits)              port->LAT ^= (bits)			//flip bits on port
-#define GIO_GET(port, bits)              ((port->PORT) & (bits))		//return bits on port
-#define GIO_OUT(port, bits)              port->TRIS &=~(bits)			//set bits as output
-#define GIO_IN(port, bits)               port->TRIS |= (bits)			//set bits as input
-
-//fast port operations
-#define FIO_SET(port, bits)              port->LATSET = (bits)			//set bits on port
-#define FIO_CLR(port, bits)              port->LATCLR = (bits)			//clear bits on port
-#define FIO_FLP(port, bits)              port->LATINV = (bits)			//flip bits on port
-#define FIO_GET(port, bits)              ((port->PORT) & (bits))		//return bits on port
-#define FIO_OUT(port, bits)              port->TRISCLR = (bits)			//set bits as output
-#define FIO_IN(port, bits)               port->TRISSET = (bits)			//set bits as input
-
-#define NOP()				Nop()                           //asm("nop")					//nop()
-#define NOP2()				{NOP(); NOP();}
-#define NOP4()				{NOP2(); NOP2();}
-#define NOP8()				{NOP4(); NOP4();}
-#define NOP16()				{NOP8(); NOP8();}
-#define NOP16()				{NOP8(); NOP8();}
-#define NOP24()				{NOP16(); NOP8();}
-#define NOP32()				{NOP16(); NOP16();}
-#define NOP40()				{NOP32(); NOP8();}
-#define NOP64()				{NOP32(); NOP32();}
-
-#define sleep()				asm("sleep")						//put the mcu into sleep
-
-#ifndef ei
-#define ei()				//asm volatile ("ei")				//__builtin_enable_interrupts()	//do {INTEnableInterrupts();	INTEnableSystemMultiVectoredInt();} while (0)	//__builtin_enable_interrupts()
-#endif
-
-#ifndef di
-#define di()				//asm volatile ("di")				//__builtin_enable_interrupts()	//INTDisableInterrupts()			//__builtin_disable_interrupts()	//
-#endif
-
-
-#define F_PHB				(SystemCoreClock / 2)			//cpu runs at F_SYS/2 by default -> Fxtal = 8Mhz. *4 for PLL. RCDIV set to 0 (1:1 postscaler)
-#define F_CPU				(CLKDIVbits.DOZEN?(F_PHB >> CLKDIVbits.DOZE):(F_PHB))			//peripheral block runs at F_PHB - default = F_CPU / 1
-#define F_FRC				8000000ul						//FRC frequency = 8Mhz, fixed
-#define F_LPRC				31000							//LPRC = 31Khz, fixed
-extern uint32_t SystemCoreClock;							//pheriphral core clock, before dividing by 2
-
-//iolock/unlock sequence
-//unlock IOLOCK
-#define IO_UNLOCK()	{asm volatile ( "MOV #OSCCON, w1 \n" \
-					"MOV #0x46, w2 \n" \
-					"MOV #0x57, w3 \n" \
-					"MOV.b w2, [w1] \n" \
-					"MOV.b w3, [w1] \n" \
-					"BCLR OSCCON,#6"); \
-					}
-
-//lock IOLOCK
-#define IO_LOCK()	{asm volatile ( "MOV #OSCCON, w1 \n" \
-					"MOV #0x46, w2 \n" \
-					"MOV #0x57, w3 \n" \
-					"MOV.b w2, [w1] \n" \
-					"MOV.b w3, [w1] \n" \
-					"BSET OSCCON, #6" ); \
-					}
-
-//pps macros
-//more on macro
-//macros for remappable pins
-//for peripheral pin select (PPS)
-#if defined(_INT1R)
-/// Maps INT1 to a remappable pin;
-/// see PPS_xxx_TO_RP(pin) for more informatino.
-#define PPS_INT1_TO_RP(pin) _INT1R = pin
-#else
-#define PPS_INT1_TO_RP(pin)
-#endif
-
-
-#if defined(_INT2R)
-#define PPS_INT2_TO_RP(pin) _INT2R = pin
-#else
-#define PPS_INT2_TO_RP(pin)
-#endif
-
-#if defined(_T2CKR)
-#define PPS_T2CK_TO_RP(pin) _T2CKR = pin
-#else
-#define PPS_T2CK_TO_RP(pin)
-#endif
-
-#if defined(_T3CKR)
-#define PPS_T3CK_TO_RP(pin) _T3CKR = pin
-#else
-#define PPS_T3CK_TO_RP(pin)
-#endif
-
-#if defined(_T4CKR)
-#define PPS_T4CK_TO_RP(pin) _T4CKR = pin
-#else
-#define PPS_T4CK_TO_RP(pin)
-#endif
-
-#if defined(_T5CKR)
-#define PPS_T5CK_TO_RP(pin) _T5CKR = pin
-#else
-#define PPS_T5CK_TO_RP(pin)
-#endif
-
-#if defined(_IC1R)
-#define PPS_IC1_TO_RP(pin) _IC1R = pin
-#else
-#define PPS_IC1_TO_RP(pin)
-#endif
-
-#if defined(_IC2R)
-#define PPS_IC2_TO_RP(pin) _IC2R = pin
-#else
-#define PPS_IC2_TO_RP(pin)
-#endif
-
-#if defined(_IC3R)
-#define PPS_IC3_TO_RP(pin) _IC3R = pin
-#else
-#define PPS_IC3_TO_RP(pin)
-#endif
-
-#if defined(_IC4R)
-#define PPS_IC4_TO_RP(pin) _IC4R = pin
-#else
-#define PPS_IC4_TO_RP(pin)
-#endif
-
-#if defined(_IC5R)
-#define PPS_IC5_TO_RP(pin) _IC5R = pin
-#else
-#define PPS_IC5_TO_RP(pin)
-#endif
-
-#if defined(_IC6R)
-#define PPS_IC6_TO_RP(pin) _IC6R = pin
-#else
-#define PPS_IC6_TO_RP(pin)
-#endif
-
-#if defined(_IC7R)
-#define PPS_IC7_TO_RP(pin) _IC7R = pin
-#else
-#define PPS_IC7_TO_RP(pin)
-#endif
-
-#if defined(_IC8R)
-#define PPS_IC8_TO_RP(pin) _IC8R = pin
-#else
-#define PPS_IC8_TO_RP(pin)
-#endif
-
-#if defined(_OCFAR)
-#define PPS_OCFA_TO_RP(pin) _OCFAR = pin
-#else
-#define PPS_OCFA_TO_RP(pin)
-#endif
-
-#if defined(_OCFBR)
-#define PPS_OCFB_TO_RP(pin) _OCFBR = pin
-#else
-#define PPS_OCFB_TO_RP(pin)
-#endif
-
-#if defined(_U1RXR)
-#define PPS_U1RX_TO_RP(pin) _U1RXR = pin
-#else
-#define PPS_U1RX_TO_RP(pin)
-#endif
-
-#if defined(_U1CTSR)
-#define PPS_U1CTS_TO_RP(pin) _U1CTSR = pin
-#else
-#define PPS_U1CTS_TO_RP(pin)
-#endif
-
-#if defined(_U2RXR)
-#define PPS_U2RX_TO_RP(pin) _U2RXR = pin
-#else
-#define PPS_U2RX_TO_RP(pin)
-#endif
-
-#if defined(_U2CTSR)
-#define PPS_U2CTS_TO_RP(pin) _U2CTSR = pin
-#else
-#define PPS_U2CTS_TO_RP(pin)
-#endif
-
-#if defined(_SDI1R)
-#define PPS_SDI1_TO_RP(pin) _SDI1R = pin
-#else
-#define PPS_SDI1_TO_RP(pin)
-#endif
-
-#if defined(_SCK1R)
-#define PPS_SCK1IN_TO_RP(pin) _SCK1R = pin
-#else
-#define PPS_SCK1IN_TO_RP(pin)
-#endif
-
-#if defined(_SS1R)
-#define PPS_SS1IN_TO_RP(pin) _SS1R = pin
-#else
-#define PPS_SS1IN_TO_RP(pin)
-#endif
-
-#if defined(_SDI2R)
-#define PPS_SDI2_TO_RP(pin) _SDI2R = pin
-#else
-#define PPS_SDI2_TO_RP(pin)
-#endif
-
-#if defined(_SCK2R)
-#define PPS_SCK2IN_TO_RP(pin) _SCK2R = pin
-#else
-#define PPS_SCK2IN_TO_RP(pin)
-#endif
-
-#if defined(_SS2R)
-#define PPS_SS2IN_TO_RP(pin) _SS2R = pin
-#else
-#define PPS_SS2IN_TO_RP(pin)
-#endif
-
-#if defined(_C1RXR)
-#define PPS_C1RXR_TO_RP(pin) _C1RXR = pin
-#else
-#define PPS_C1RXR_TO_RP(pin)
-#endif
-
-#if defined(_C2RXR)
-#define PPS_C2RXR_TO_RP(pin) _C2RXR = pin
-#else
-#define PPS_C2RXR_TO_RP(pin)
-#endif
-
-
-//end RP input mapping
-//Your device may not have all of these peripherals!
-
-//start RP output mapping
-
-
-#if defined(_RP0R)
-/// Maps C1OUT to a remappable pin;
-/// see PPS_yyy_TO_RP(pin) for more informatino.
-#define PPS_C1OUT_TO_RP(pin) _RP##pin##R = 1
-#else
-#define PPS_C1OUT_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_C2OUT_TO_RP(pin) _RP##pin##R = 2
-#else
-#define PPS_C2OUT_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_U1TX_TO_RP(pin) _RP##pin##R = 3
-#else
-#define PPS_U1TX_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_U1RTS_TO_RP(pin) _RP##pin##R = 4
-#else
-#define PPS_U1RTS_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_U2TX_TO_RP(pin) _RP##pin##R = 5
-#else
-#define PPS_U2TX_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_U2RTS_TO_RP(pin) _RP##pin##R = 6
-#else
-#define PPS_U2RTS_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_SDO1_TO_RP(pin) _RP##pin##R = 7
-#else
-#define PPS_SDO1_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_SCK1OUT_TO_RP(pin) _RP##pin##R = 8
-#else
-#define PPS_SCK1OUT_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_SS1OUT_TO_RP(pin) _RP##pin##R = 9
-#else
-#define PPS_SS1OUT_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_SDO2_TO_RP(pin) _RP##pin##R = 10
-#else
-#define PPS_SDO2_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_SCK2OUT_TO_RP(pin) _RP##pin##R = 11
-#else
-#define PPS_SCK2OUT_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_SS2OUT_TO_RP(pin) _RP##pin##R = 12
-#else
-#define PPS_SS2OUT_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_C1TX_TO_RP(pin) _RP##pin##R = 16
-#else
-#define PPS_C1TX_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_OC1_TO_RP(pin) _RP##pin##R = 18
-#else
-#define PPS_OC1_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_OC2_TO_RP(pin) _RP##pin##R = 19
-#else
-#define PPS_OC2_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_OC3_TO_RP(pin) _RP##pin##R = 20
-#else
-#define PPS_OC3_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_OC4_TO_RP(pin) _RP##pin##R = 21
-#else
-#define PPS_OC4_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_OC5_TO_RP(pin) _RP##pin##R = 22
-#else
-#define PPS_OC5_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_CTPLS_TO_RP(pin) _RP##pin##R = 29
-#else
-#define PPS_CTPLS_TO_RP(pin)
-#endif
-
-#if defined(_RP0R)
-#define PPS_C3OUT_TO_RP(pin) _RP##pin##R = 30
-#else
-#define PPS_C3OUT_TO_RP(pin)
-#endif
-
-//simple multiples
-#define x1(val)				(val)								//multiply val by 1
-#define x2(val)				(((val) << 1))						//multiply val by 2
-#define x3(val)				(x2(val) + (val))					//multiply val by 3
-#define x4(val)				(((val) << 2))						//multiply val by 4
-#define x5(val)				(x4(val) + (val))					//multiply val by 5
-#define x6(val)				(x4(val) + x2(val))					//multiply val by 6
-#define x7(val)				(x6(val) + (val))					//multiply val by 7
-#define x8(val)				((val) << 3)						//multiply val by 8
-#define x9(val)				(x8(val) + (val))					//multiply val by 9
-
-//multiples of 10s
-#define x10(val)			(x8(val) + x2(val))					//multiply val by 10
-#define x100(val)			(x10(x10(val)))						//multiply val by 100
-#define x1000(val)			(x100(x10(val)))					//multiply val by 1000
-#define x1k(val)			x1000(val)							//multiply val by 1000
-#define x10k(val)			(x100(x100(val)))					//multiply val by 10000
-
-#define x20(val)			(x2(x10(val)))
-#define x30(val)			(x3(x10(val)))
-#define x40(val)			(x4(x10(val)))
-#define x50(val)			(x5(x10(val)))
-#define x60(val)			(x6(x10(val)))
-#define x70(val)			(x7(x10(val)))
-#define x80(val)			(x8(x10(val)))
-#define x90(val)			(x9(x10(val)))
-
-//multiples of 100s
-#define x200(val)			(x2(x100(val)))
-#define x300(val)			(x3(x100(val)))
-#define x400(val)			(x4(x100(val)))
-#define x500(val)			(x5(x100(val)))
-#define x600(val)			(x6(x100(val)))
-#define x700(val)			(x7(x100(val)))
-#define x800(val)			(x8(x100(val)))
-#define x900(val)			(x9(x100(val)))
-
-//custom definitions
-#define x34(val)			(x30(val) + x4(val))				//multiply val by 34
-#define x97(val)			(x90(val) + x7(val))				//multiply val by 97x
-
-//to surpress warning messages about PSV
-#define _ISR_PSV __attribute__((__interrupt__, __auto_psv__))
-#define _ISR_NOPSV __attribute__((__interrupt__, __no_auto_psv__))
-
-//gpio
-//port structure
-typedef struct {
-	volatile uint16_t TRIS;             //data direction register -> 0ffset 0x0000, little endian
-	volatile uint16_t PORT;             //input data register
-	volatile uint16_t LAT;              //output data register
-	volatile uint16_t ODC;              //open drain configuration register. set to activate open drain
-} GPIO_TypeDef;                         //port definition registers
-
-#define GPIOA				((GPIO_TypeDef *) &TRISA)
-#define GPIOB				((GPIO_TypeDef *) &TRISB)
-#if defined(TRISC)
-#define GPIOC            	((GPIO_TypeDef *) &TRISC)
-#endif
-#if defined(TRISD)
-#define GPIOD				((GPIO_TypeDef *) &TRISD)
-#endif
-#if defined(TRISE)
-#define GPIOE				((GPIO_TypeDef *) &TRISE)
-#endif
-#if defined(TRISF)
-#define GPIOF				((GPIO_TypeDef *) &TRISF)
-#endif
-#if defined(TRISG)
-#define GPIOG				((GPIO_TypeDef *) &TRISG)
-#endif
-
-
-//global defines
-//gpio definitions
-
-//pin enum - matches GPIO_PinDef[]
-typedef enum {
-	PA0, PA1, PA2, PA3, PA4, PA5, PA6, PA7, PA8, PA9, PA10, PA11, PA12, PA13, PA14, PA15,
-	PB0, PB1, PB2, PB3, PB4, PB5, PB6, PB7, PB8, PB9, PB10, PB11, PB12, PB13, PB14, PB15,
-#if defined(GPIOC)
-	PC0, PC1, PC2, PC3, PC4, PC5, PC6, PC7, PC8, PC9, PC10, PC11, PC12, PC13, PC14, PC15,
-#endif		//GPIOC
-#if defined(GPIOD)
-	PD0, PD1, PD2, PD3, PD4, PD5, PD6, PD7, PD8, PD9, PD10, PD11, PD12, PD13, PD14, PD15,
-#endif		//GPIOD
-#if defined(GPIOE)
-	PE0, PE1, PE2, PE3, PE4, PE5, PE6, PE7, PE8, PE9, PE10, PE11, PE12, PE13, PE14, PE15,
-#endif		//GPIOE
-#if defined(GPIOF)
-	PF0, PF1, PF2, PF3, PF4, PF5, PF6, PF7, PF8, PF9, PF10, PF11, PF12, PF13, PF14, PF15,
-#endif		//GPIOF
-#if defined(GPIOG)
-	PG0, PG1, PG2, PG3, PG4, PG5, PG6, PG7, PG8, PG9, PG10, PG11, PG12, PG13, PG14, PG15,
-#endif		//GPIOG
-	PMAX
-} PIN_TypeDef;
-
-//map pin number to GPIOx
-typedef struct {
-	GPIO_TypeDef *gpio;					//gpio for a pin
-	uint16_t mask;						//pin mask - 16-bit port
-} PIN2GPIO;
-//end gpio
-
-//devid
-typedef struct {
-	uint16_t DEVID;						//device id	- 0..5: DevID, 6..13: FamilyID
-	uint16_t DEVREV;					//family id - 0..3: DOT, 6..8: MajRev
-} DevID_TypeDef;
-
-#define PIC24ID							((DevID_TypeDef *) 0xff0000ul)	//for PIC24FxxxGA1/GB1 devices
-//end devid
-
-#define INPUT				0
-#define OUTPUT				1			//(!INPUT)
-#define INPUT_PULLUP		2
-
-#define LOW					0
-#define HIGH				(!LOW)
-
-#define PI 					3.1415926535897932384626433832795
-#define HALF_PI 			(PI / 2)							//1.5707963267948966192313216916398
-#define TWO_PI 				(PI + PI)							//6.283185307179586476925286766559
-#define DEG_TO_RAD 			(TWO_PI / 360)						//0.017453292519943295769236907684886
-#define RAD_TO_DEG 			(360 / TWO_PI)						//57.295779513082320876798154814105
-#define EULER 				2.718281828459045235360287471352	//Euler's number
-
-#define SERIAL  			0x0
-#define DISPLAY 			0x1
-
-#define LSBFIRST 			0
-#define MSBFIRST 			1									//(!LSBFIRST)							//1
-
-#define CHANGE 				1
-#define FALLING 			2
-#define RISING 				3
-
-#ifndef min
-#define min(a,b) 			((a)<(b)?(a):(b))
-#endif
-#ifndef max
-#define max(a,b) 			((a)>(b)?(a):(b))
-#endif
-#define abs(x) 				((x)>0?(x):-(x))
-#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
-#define round(x)     		((x)>=0?(long)((x)+0.5):(long)((x)-0.5))
-#define radians(deg) 		((deg)*DEG_TO_RAD)
-#define degrees(rad) 		((rad)*RAD_TO_DEG)
-#define sq(x) 				((x)*(x))
-
-#define interrupts() 		ei()
-#define noInterrupts() 		di()
-
-#define clockCyclesPerMillisecond() 	( F_CPU / 1000L )
-#define clockCyclesPerMicrosecond() 	( F_CPU / 1000000L )
-#define clockCyclesToMicroseconds(a) 	( (a) / clockCyclesPerMicrosecond() )
-#define microsecondsToClockCycles(a) 	( (a) * clockCyclesPerMicrosecond() )
-
-#define lowByte(w) 			((uint8_t) ((w) & 0xff))
-#define highByte(w) 		((uint8_t) ((w) >> 8))
-
-#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
-#define bitSet(value, bit) 	((value) |= (1UL << (bit)))
-#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
-#define bitWrite(value, bit, bitvalue) (bitvalue ? bitSet(value, bit) : bitClear(value, bit))
-#define bit(n)				(1ul<<(n))
-
-#define false				0
-#define true				(!false)
-
-//characters
-#define isAlphaNumeric(c)	isalnum(c)
-#define isAlpha(c)			isalpha(c)
-#define isAscii(c)			isascii(c)
-#define isWhitespace(c)		isblank(c)
-#define isControl(c)		iscntrl(c)
-#define isDigit(c)			isdigit(c)
-#define isGraph(c)			isgraph(c)
-#define isLowerCase(c)		islower(c)
-#define isPrintable(c)		isprint(c)
-#define isPunct(c)			ispunct(c)
-#define isSpace(c)			isspace(c)
-#define isUpperCase(c)		isupper(c)
-#define isHexadecimalDigit(c)	isxdigit(c)
-
-//external setup/loop - defined by user
-extern void setup(void);
-extern void loop(void);
-
-//random number
-#define randomSeed(seed)	srand(seed)
-#define random(max)			random2(0, max)
-#define random2(min, max)	((min) + (int32_t) ((max) - (min)) * rand() / 32768)
-
-//GPIO
-//flip the pin
-#define pinFlip(pin)		digitalWrite(pin, !digitalRead(pin))
-void pinMode(PIN_TypeDef pin, uint8_t mode);
-void digitalWrite(PIN_TypeDef pin, uint8_t mode);
-int digitalRead(PIN_TypeDef pin);
-
-//time base
-uint32_t ticks(void);								//timer ticks from timer2
-#define millis()			(ticks() / cyclesPerMillisecond())
-#define micros()			(ticks() / cyclesPerMicrosecond())
-void delay(uint32_t ms);
-void delayMicroseconds(uint32_t us);
-#define cyclesPerMicrosecond()			(F_CPU / 1000000ul)
-#define cyclesPerMillisecond()			(F_CPU / 1000)
-
-//advanced IO
-//void tone(void);									//tone frequency specified by F_TONE in STM8Sduino.h
-//void noTone(void);
-//shiftin/out: bitOrder = MSBFIRST or LSBFIRST
-uint8_t shiftIn(PIN_TypeDef dataPin, PIN_TypeDef clockPin, uint8_t bitOrder);
-void shiftOut(PIN_TypeDef dataPin, PIN_TypeDef clockPin, uint8_t bitOrder, uint8_t val);
-uint32_t pulseIn(PIN_TypeDef pin, uint8_t state);		//wait for a pulse and return timing
-
-//pwm output
-//dc = 0x00..0x0fff for pwm2/3/4/5, 0x00..0xffff for pwm1
-//RP4=PWM1, RP12=PWM2, RP13=PWM3, RP14=PWM4, RP15=PWM5
-void analogWrite(uint8_t pin, uint16_t dc);
-
-//analog read on ADC1
-//read DRL first for right aligned results
-//uint16_t analogRead(uint8_t pin);
-
-//analog reference - default to AVdd-AVss
-//Vref sources: 0->Vref = AVdd-AVss, 1->Vref+-AVss, 2->AVdd-Vref-, 3->Vref+ - Vref-
-//void analogReference(uint8_t Vref);
-
-//interrupts
-//install external interrupt handler
-//mode 1: falling edge, 0: rising edge
-//void attachInterrupt(uint8_t intx, void (*isrptr) (void), uint8_t mode);
-//void detachInterrupt(uint8_t intx);
-
-//change notification interrupts
-//install user CN interrupt handler
-//void attachCNInterrupt(void (*isrptr) (void));
-//void detachCNInterrupt(void);
-//void activateCNInterrupt(uint8_t cnx, uint8_t pue);
-//void deactivateCNInterrupt(uint8_t cnx);
-
-//global variables
-
-//reset the mcu
-void mcuInit(void);
-//111 = Fast RC Oscillator with Postscaler (FRCDIV)
-//110 = Reserved
-//101 = Low-Power RC Oscillator (LPRC)
-//100 = Secondary Oscillator (SOSC)
-//011 = Primary Oscillator with PLL module (XTPLL, HSPLL, ECPLL)
-//010 = Primary Oscillator (XT, HS, EC)
-//001 = Fast RC Oscillator with Postscaler and PLL module (FRCPLL)
-//000 = Fast RC Oscillator (FRC)
-//Needs to be executed during mcu initialization or after oscillator reconfiguration
-//updates SystemCoreClock.
-uint32_t SystemCoreClockUpdate(void);
-
-//switch oscillator
-//return SystemCoreClock in frequency
-//111 = Fast RC Oscillator with Postscaler (FRCDIV)
-//110 = Reserved
-//101 = Low-Power RC Oscillator (LPRC)
-//100 = Secondary Oscillator (SOSC)
-//011 = Primary Oscillator with PLL module (XTPLL, HSPLL, ECPLL)
-//010 = Primary Oscillator (XT, HS, EC)
-//001 = Fast RC Oscillator with Postscaler and PLL module (FRCPLL)
-//000 = Fast RC Oscillator (FRC)
-//Needs to be executed during mcu initialization or after oscillator reconfiguration
-//updates SystemCoreClock.
-uint32_t SystemCoreClockSwitch(uint8_t nosc);
-
-#define SystemCoreClockFRC()			SystemCoreClockSwitch(0b000)
-#define SystemCoreClockFRCPLL()			SystemCoreClockSwitch(0b001)
-#define SystemCoreClockPOSC()			SystemCoreClockSwitch(0b010)
-#define SystemCoreClockPOSCPLL()		SystemCoreClockSwitch(0b011)
-#define SystemCoreClockSOSC()			SystemCoreClockSwitch(0b100)
-#define SystemCoreClockLPRC()			SystemCoreClockSwitch(0b101)
-#define SystemCoreClockFRCDIV()			SystemCoreClockSwitch(0b111)
-
-//empty interrupt handler
-void empty_handler(void);
-
-
-//#define Mhz					000000ul	//suffix for Mhz
-#define F_UART				(F_PHB)	//peripheral clock
-#define UART_BR300			300ul		//buadrate=300
-#define UART_BR600			600ul		//buadrate=600
-#define UART_BR1200			1200ul		//buadrate=1200
-#define UART_BR2400			2400ul		//buadrate=2400
-#define UART_BR4800			4800ul		//buadrate=4800
-#define UART_BR9600			9600ul		//buadrate=9600
-#define UART_BR19200		19200ul		//buadrate=19200
-#define UART_BR38400		38400ul		//buadrate=38400
-#define UART_BR57600		57600ul		//buadrate=57600
-#define UART_BR115200		115200ul	//buadrate=115200
-
-//initiate the hardware usart1
-void uart1Init(unsigned long baud_rate);//initialize uart
-void uart1Putch(char ch);				//output a char on uart
-void uart1Puts(char *str);				//output a string on uart
-void uart1Putline(char *ln);			//output a string + linefeed on uart
-#define uart1Getch()		U1RXREG		//uint8_t uart1Getch(void);				//read a char from usart
-#define uart1Available()	U1STAbits.URXDA	//uint16_t uart1Available(void);			//test if data rx is available
-#define uart1Busy()			U1STAbits.UTXBF	//uint16_t uart1Busy(void);				//test if uart tx is busy
-void u1Print(char *str, int32_t dat);	//output a number on uart
-#define u1Println()			uart1Puts("\r\n")
-//for compatability
-#define uart1Put(ch)		uart1Putch(ch)
-#define uart1Get()			uart1Getch()
-
-
-//initiate the hardware usart2
-void uart2Init(unsigned long baud_rate);//initialize uart
-void uart2Putch(char ch);				//output a char on uart
-void uart2Puts(char *str);				//output a string on uart
-void uart2Putline(char *ln);			//output a string + linefeed on uart
-#define uart2Getch()		U2RXREG		//uint8_t uart2Getch(void);				//read a char from usart
-#define uart2Available()	U2STAbits.URXDA	//uint16_t uart2Available(void);			//test if data rx is available
-#define uart2Busy()			U2STAbits.UTXBF	//uint16_t uart2Busy(void);				//test if uart tx is busy
-void u2Print(char *str, int32_t dat);	//output a number on uart
-#define u2Println()			uart2Puts("\r\n")
-//for compatability
-#define uart2Put(ch)		uart2Putch(ch)
-#define uart2Get()			uart2Getch()
-
-//end Serial
-
-
-//tmr1-5 prescaler
-#define TMR_PS1x			0x00
-#define TMR_PS4x			0x01
-#define TMR_PS8x			0x02
-#define TMR_PS256x			0x03
-#define TMR_PSMASK			TMR_PS256x
-
-//#define TMR_IPDEFAULT		2
-//#define TMR_ISDEFAULT		0
-
-//initialize the timer1 (16bit)
-void tmr1Init(uint8_t ps, uint16_t period);
-//activate the isr handler
-void tmr1AttachISR(void (*isrptr)(void));
-
-//initialize the timer2 (16bit)
-void tmr2Init(uint8_t ps, uint16_t period);
-//activate the isr handler
-void tmr2AttachISR(void (*isrptr)(void));
-
-//initialize the timer3 (16bit)
-void tmr3Init(uint8_t ps, uint16_t period);
-//activate the isr handler
-void tmr3AttachISR(void (*isrptr)(void));
-
-//initialize the timer4 (16bit)
-void tmr4Init(uint8_t ps, uint16_t period);
-//activate the isr handler
-void tmr4AttachISR(void (*isrptr)(void));
-
-//initialize the timer5 (16bit)
-void tmr5Init(uint8_t ps, uint16_t period);
-//activate the isr handler
-void tmr5AttachISR(void (*isrptr)(void));
-
-//32-bit timers
-//initialize the timer23 (32bit)
-void tmr23Init(uint8_t ps, uint32_t period);
-//read 32-bit tmr23
-uint32_t tmr23Get(void);
-//activate the isr handler
-#define tmr23AttachISR(isr)		tmr3AttachISR(isr)
-
-//initialize the timer45 (32bit)
-void tmr45Init(uint8_t ps, uint32_t period);
-//read 32-bit tmr45
-uint32_t tmr45Get(void);
-//activate the isr handler
-#define tmr45AttachISR(isr)		tmr5AttachISR(isr)
-
-//pwm / oc
-//initialize pwm1
-void pwm1Init(void);
-#define pwm1SetDC(dc)			do {OC1RS = (dc);} while (0)
-#define pwm1GetDC()				(OC1RS)
-
-//initialize pwm2
-void pwm2Init(void);
-#define pwm2SetDC(dc)			do {OC2RS = (dc);} while (0)
-#define pwm2GetDC()				(OC2RS)
-
-//initialize pwm3
-void pwm3Init(void);
-#define pwm3SetDC(dc)			do {OC3RS = (dc);} while (0)
-#define pwm3GetDC()				(OC3RS)
-
-//initialize pwm4
-void pwm4Init(void);
-#define pwm4SetDC(dc)			do {OC4RS = (dc);} while (0)
-#define pwm4GetDC()				(OC4RS)
-
-//initialize pwm5
-void pwm5Init(void);
-#define pwm5SetDC(dc)			do {OC5RS = (dc);} while (0)
-#define pwm5GetDC()				(OC5RS)
-
-//adc
-//adc channels
-#define ADC_AN0					(0)		//adc an0
-#define ADC_AN1					(1)		//adc an1
-#define ADC_AN2					(2)		//adc an2
-#define ADC_AN3					(3)		//adc an3
-#define ADC_AN4					(4)		//adc an4
-#define ADC_AN5					(5)		//adc an5
-#define ADC_AN6					(6)		//adc an6		-unimplemented on 28pin devices
-#define ADC_AN7					(7)		//adc an7		-unimplemented on 28pin devices
-#define ADC_AN8					(8)		//adc an8		-unimplemented on 28pin devices
-#define ADC_AN9					(9)		//adc an9
-#define ADC_AN10				(10)	//adc an10
-#define ADC_AN11				(11)	//adc an11
-#define ADC_AN12				(12)	//adc an12
-#define ADC_VCORE				(13)	//adc vcore
-#define ADC_VBG2				(14)	//adc bandgap/2
-#define ADC_VBG					(15)	//adc bandgap
-#define ADC_CTMU				(0xffff)	//for ctmu
-
-//rest the adc
-//automatic sampling (ASAM=1), manual conversion
-void adcInit(void);
-
-//read the adc
-uint16_t analogRead(uint16_t ch);
-//end ADC
-
-//output compare - TMR2 is the base
-#define OC_TIMEBASE()			TMR2			//TMR2 as the timebase
-void oc1Init(uint16_t pr);						//initialize oc1, by prescaler + period
-void oc1AttachISR(void (*isrptr)(void));		//install user isr
-void oc2Init(uint16_t pr);						//initialize oc1, by prescaler + period
-void oc2AttachISR(void (*isrptr)(void));		//install user isr
-void oc3Init(uint16_t pr);						//initialize oc1, by prescaler + period
-void oc3AttachISR(void (*isrptr)(void));		//install user isr
-void oc4Init(uint16_t pr);						//initialize oc1, by prescaler + period
-void oc4AttachISR(void (*isrptr)(void));		//install user isr
-void oc5Init(uint16_t pr);						//initialize oc1, by prescaler + period
-void oc5AttachISR(void (*isrptr)(void));		//install user isr
-//end output compare
-
-//input capture
-//16-bit mode, rising edge, single capture, Timer2 as timebase
-#define IC_TIMEBASE()			TMR2			//TMR2 as the timebase
-//interrupt disabled
-void ic1Init(void);
-void ic1AttachISR(void (*isrptr)(void));		//activate user ptr
-#define ic1Get()		IC1BUF					//read buffer value
-
-void ic2Init(void);
-void ic2AttachISR(void (*isrptr)(void));		//activate user ptr
-#define ic2Get()		IC2BUF					//read buffer value
-
-void ic3Init(void);
-void ic3AttachISR(void (*isrptr)(void));		//activate user ptr
-#define ic3Get()		IC3BUF					//read buffer value
-
-void ic4Init(void);
-void ic4AttachISR(void (*isrptr)(void));		//activate user ptr
-#define ic4Get()		IC4BUF					//read buffer value
-
-void ic5Init(void);
-void ic5AttachISR(void (*isrptr)(void));		//activate user ptr
-#define ic5Get()		IC5BUF					//read buffer value
-//end input capture
-
-//extint
-void int0Init(void);							//initialize the module
-void int0AttachISR(void (*isrptr) (void));		//attach user isr
-
-void int1Init(void);							//initialize the module
-void int1AttachISR(void (*isrptr) (void));		//attach user isr
-
-void int2Init(void);							//initialize the module
-void int2AttachISR(void (*isrptr) (void));		//attach user isr
-
-void int3Init(void);							//initialize the module
-void int3AttachISR(void (*isrptr) (void));		//attach user isr
-
-void int4Init(void);							//initialize the module
-void int4AttachISR(void (*isrptr) (void));		//attach user isr
-//end extint
-
-//spi
-void spi1Init(uint16_t br);						//reset the spi
-#define spi1Busy()			(SPI1STATbits.SPITBF)	//transmit buffer full, must wait before writing to SPIxBUF
-#define spi1Available()		(!SPI1STATbits.SPIRBE)	//receive buffer not empty -> there is data
-#define spi1Write(dat)		SPI1BUF=(dat)		//send data via spi
-#define spi1Read()			(SPI1BUF)			//read from the buffer
-
-void spi2Init(uint16_t br);						//reset the spi
-#define spi2Busy()			(SPI2STATbits.SPITBF)	//transmit buffer full, must wait before writing to SPIxBUF
-#define spi2Available()		(!SPI2STATbits.SPIRBE)	//receive buffer not empty -> there is data
-#define spi1Write(dat)		SPI1BUF=(dat)		//send data via spi
-#define spi2Read()			(SPI2BUF)			//read from the buffer
-
-//end spi
-
-//i2c
-//end i2c
-
-//rtcc
-//allows write to rtc registers
-//#define RTCC_WREN()			do {NVMKEY=0x55; NVMKEY=0xaa; RCFGCALbits.RTCWREN = 1;} while (RCFGCALbits.RTCWREN == 0)
-#define RTCC_WREN()	{	asm volatile("push w7"); \
-						asm volatile("push w8"); \
-						asm volatile("disi #5"); \
-						asm volatile("mov #0x55, w7"); \
-						asm volatile("mov w7, _NVMKEY"); \
-						asm volatile("mov #0xAA, w8"); \
-						asm volatile("mov w8, _NVMKEY"); \
-						asm volatile("bset _RCFGCAL, #13"); \
-						asm volatile("pop w8"); \
-						asm volatile("pop w7"); \
-					}
-//do not allow any write to rtc registers - assumes the nvmkey sequence has been sent
-#define RTCC_WRDIS()	do {RCFGCALbits.RTCWREN = 0;} while (RCFGCALbits.RTCWREN == 1)
-
-//for RTCC PTR values to be used with RTCCRead() and RTCCWrite()
-#define RTCPTR_MINSEC	0
-#define RTCPTR_WKDHRS	1
-#define RTCPTR_MONDAY	2
-#define RTCPTR_YEAR		3
-
-//bcd to dec conversion
-#define BCD2DEC(bcd)			((((bcd) & 0xf0)>>4)*10+((bcd) & 0x0f))	//convert bcd to int
-#define DEC2BCD(dec)			((((dec) / 10)<<4) +((dec) % 10))		//convert int to bcd
-
-void RTCCInit(void);							//initialize the rtcc
-uint16_t RTCCRead(uint16_t mask);				//read from rtcc, based on the value of mask (0..3)
-#define RTCCGetSec()			(RTCCRead(RTCPTR_MINSEC) & 0xff)
-#define RTCCGetMin()			(RTCCRead(RTCPTR_MINSEC) >> 8)
-#define RTCCGetHour()			(RTCCRead(RTCPTR_WKDHRS) & 0xff)
-#define RTCCGetWDay()			(RTCCRead(RTCPTR_WKDHRS) >> 8)
-#define RTCCGetDay()			(RTCCRead(RTCPTR_MONDAY) & 0xff)
-#define RTCCGetMonth()			(RTCCRead(RTCPTR_MONDAY) >> 8)
-#define RTCCGetYear()			(RTCCRead(RTCPTR_YEAR  ) & 0xff)
-void RTCCWrite(uint16_t mask, uint16_t byte_t);	//write to rtcc,  based on the value of mask (0..3)
-#define RTCCSetSec(dat)			RTCCWrite(RTCPTR_MINSEC, (RTCCRead(RTCPTR_MINSEC) & ~0x00ff) | ((dat) & 0x00ff))
-#define RTCCSetMin(dat)			RTCCWrite(RTCPTR_MINSEC, (RTCCRead(RTCPTR_MINSEC) & ~0xff00) | ((dat) & 0xff00))
-#define RTCCSetHour(dat)		RTCCWrite(RTCPTR_WKDHRS, (RTCCRead(RTCPTR_WKDHRS) & ~0x00ff) | ((dat) & 0x00ff))
-#define RTCCSetWDay(dat)		RTCCWrite(RTCPTR_WKDHRS, (RTCCRead(RTCPTR_WKDHRS) & ~0xff00) | ((dat) & 0xff00))
-#define RTCCSetDay(dat)			RTCCWrite(RTCPTR_MONDAY, (RTCCRead(RTCPTR_MONDAY) & ~0x00ff) | ((dat) & 0x00ff))
-#define RTCCSetMonth(dat)		RTCCWrite(RTCPTR_MONDAY, (RTCCRead(RTCPTR_MONDAY) & ~0xff00) | ((dat) & 0xff00))
-#define RTCCSetYear(dat)		RTCCWrite(RTCPTR_YEAR,   (RTCCRead(RTCPTR_YEAR  ) & ~0x00ff) | ((dat) & 0x00ff))
-void RTCCSetCal(uint8_t cal); 	//write to rtcc calibration register
-uint8_t RTCCGetCal(void);		//read from rtcc calibration register
-
-//end rtcc
-
-//cnint
-void cnInit(uint32_t pins);					//initialize change notification
-void cnAttachISR(void (*isrptr) (void));		//attach user isr
-//end cnint
-
-//crc
-void CRCInit(uint8_t len, uint32_t poly);							//initialize the crc
-uint16_t CRC16(char *msg, uint16_t length, uint16_t init_val);		//return crc check on a message. length must be multiples of 2
-#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-		defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__)
-#define CRCBusy()				(CRCCON1bits.CRCGO == 1)			////if CRC is busy
-#define CRCAvailable()		(CRCCON1bits.CRCGO == 0)			//crc complete, data available
-#else
-#define CRCBusy()				(CRCCONbits.CRCGO == 1)			////if CRC is busy
-#define CRCAvailable()		(CRCCONbits.CRCGO == 0)			//crc complete, data available
-#endif
-#define CRCGet()				(CRCWDAT)							//read CRC back
-#define CRC8Init(xor, init)		CRCInit(0x07, xor, init)			//initialize 16-bit CRC
-#define CRC16Init(xor, init)	CRCInit(0x0f, xor, init)			//initialize 16-bit CRC
-#define CRC32Init(xor, init)	CRCInit(0x1f, x0r, init)			//initialize 32-bit CRC
-//end crc
-
-//comparator voltage reference
-//comparator voltage reference
-void CVrefInit(void);
-#define CVrefSet(range)			CVRCONbits.CVR=(range)			//set output range
-#define CVrefGet()				(CVRCONbits.CVR)				//return output range
-#define CVrefOE()				CVRCONbits.CVROE=1				//0->disable output, 1->enable output
-#define CVrefOD()				CVRCONbits.CVROE=0				//0->disable output, 1->enable output
-
-//comparator
-#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
-		defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__)
-
-void CM1Init(void);				//initialize comparator
-#define CM1OUT()				(CM1CONbits.COUT)				//output status
-#define CM1INA()				CM1CONbits.CREF=0				//0->non-inventing input to CxINA, 1->non-inventing input to CVref+
-#define CM1CVrefp()				CM1CONbits.CREF=1				//0->non-inventing input to CxINA, 1->non-inventing input to CVref+
-#define CM1INB()				CM1CONbits.CCH =0				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
-#define CM1INC()				CM1CONbits.CCH =1				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
-#define CM1IND()				CM1CONbits.CCH =2				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
-#define CM1CVrefn()				CM1CONbits.CCH =3				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
-#define CM1OE()					CM1CONbits.COE =1				//1->enable output, 0->disable output
-#define CM1OD()					CM1CONbits.COE =0				//1->enable output, 0->disable output
-
-void CM2Init(void);				//initialize comparator
-#define CM2OUT()				(CM2CONbits.COUT)				//output status
-#define CM2INA()				CM2CONbits.CREF=0				//0->non-inventing input to CxINA, 1->non-inventing input to CVref+
-#define CM2CVrefp()				CM2CONbits.CREF=1				//0->non-inventing input to CxINA, 1->non-inventing input to CVref+
-#define CM2INB()				CM2CONbits.CCH =0				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
-#define CM2INC()				CM2CONbits.CCH =1				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
-#define CM2IND()				CM2CONbits.CCH =2				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
-#define CM2CVrefn()				CM2CONbits.CCH =3				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
-#define CM2OE()					CM2CONbits.COE =1				//1->enable output, 0->disable output
-#define CM2OD()					CM2CONbits.COE =0				//1->enable output, 0->disable output
-
-void CM3Init(void);				//initialize comparator
-#define CM3OUT()				(CM3CONbits.COUT)				//output status
-#define CM3INA()				CM3CONbits.CREF=0				//0->non-inventing input to CxINA, 1->non-inventing input to CVref+
-#define CM3CVrefp()				CM3CONbits.CREF=1				//0->non-inventing input to CxINA, 1->non-inventing input to CVref+
-#define CM3INB()				CM3CONbits.CCH =0				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
-#define CM3INC()				CM3CONbits.CCH =1				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
-#define CM3IND()				CM3CONbits.CCH =2				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
-#define CM3CVrefn()				CM3CONbits.CCH =3				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
-#define CM3OE()					CM3CONbits.COE =1				//1->enable output, 0->disable output
-#define CM3OD()					CM3CONbits.COE =0				//1->enable output, 0->disable output
-
-#else		//ga002 chips
-
-void CM1Init(void);				//initialize comparator
-#define CM1OUT()				(CMCONbits.C1OUT)				//output status
-#define CM1NVinp()				CMCONbits.C1NEG=1				//1->C1NEG to Vin+, 0->C1NEG to Vin-
-#define CM1NVinn()				CMCONbits.C1NEG=0				//1->C1NEG to Vin+, 0->C1NEG to Vin-
-#define CM1PVinp()				CMCONbits.C1POS=1				//1->C1POS to Vin+, 0->C1NEG to CVref
-#define CM1PCVref()				CMCONbits.C1POS=0				//1->C1POS to Vin+, 0->C1NEG to CVref
-#define CM1OE()					CMCONbits.C1OUTEN =1			//1->enable output, 0->disable output
-#define CM1OD()					CMCONbits.C1OUTEN =0			//1->enable output, 0->disable output
-
-void CM2Init(void);				//initialize comparator
-#define CM2OUT()				(CMCONbits.C2OUT)				//output status
-#define CM2NVinp()				CMCONbits.C2NEG=1				//1->C1NEG to Vin+, 0->C1NEG to Vin-
-#define CM2NVinn()				CMCONbits.C2NEG=0				//1->C1NEG to Vin+, 0->C1NEG to Vin-
-#define CM2PVinp()				CMCONbits.C2POS=1				//1->C1POS to Vin+, 0->C1NEG to CVref
-#define CM2PCVref()				CMCONbits.C2POS=0				//1->C1POS to Vin+, 0->C1NEG to CVref
-#define CM2OE()					CMCONbits.C2OUTEN =1			//1->enable output, 0->disable output
-#define CM2OD()					CMCONbits.C2OUTEN =0			//1->enable output, 0->disable output
-
-#endif		//comparator
-
-#endif
-
+#ifndef _PIC24DUINO_H
+#define _PIC24DUINO_H
+
+//PIC24duino code
+// - using PIC24FJxxGA004/104, and GB004 family (GA002/004, GA102/104, and GB002/004 families)
+// - free running timer2 for ticks, pwm and input capture
+// -
+// - version history
+// - v2.0, 5/15/2021: simplified port
+// - v2.1, 5/26/2021: implemented SystemCoreClockUpdate() - to be executed during mcu initialization or after oscillator reconfiguration
+// - v2.2, 6/06/2021: implemented hardware CRC (16-bit only).
+// - v2.3, 6/07/2021: revised rtcc implementation
+// - v2.4, 6/16/2021: updated to support GB002/004 chips
+// - v2.5, 6/19/2021: implemented output compare (dah!)
+// - v2.6, 5/19/2022: output compare routines no longer advance compare registers
+// - v2.7, 5/24/2022: simplified support for GA00x, GA10x, and GB00x devices
+// - v2.8, 5/24/2022: added support for C30 compiler
+// - v2.9, 6/04/2022: support IO port A..G
+// - v2.10, 10/18/2026: multi-servo driver, time-multiplexed on oc1
+// - v2.11, 10/18/2026: tone()/noTone() on oc2 toggle mode + background note / rtttl player
+// - v2.12, 10/18/2026: stepper pulse generator with trapezoidal profiles on oc3/oc4
+// - v2.13, 10/18/2026: buffered input capture period / duty / frequency measurement on ic1
+// - v2.14, 10/18/2026: 32-bit input capture: ic1/ic2 + ic3/ic4 cascade on GA10x/GB00x, SysTick-extended on GA00x
+// - v2.15, 10/18/2026: NEC/RC5 infrared decoder on ic2 edge timestamps
+// - v2.16, 10/18/2026: quadrature encoders on change notification
+// - v2.17, 10/18/2026: per-pin change notification callbacks. cnInit() sets CNPU2
+// - v2.18, 10/18/2026: attachInterrupt()/detachInterrupt() with edge selection, int3/int4, interrupt counts
+// - v2.19, 10/18/2026: ei()/di() act on the cpu ipl. nested critical sections
+// - v2.20, 10/18/2026: per-vector interrupt priority table, applied by the inits, irqDump()
+// - v2.21, 10/18/2026: optional compile-time isr binding per vector (XX_HANDLER())
+// - v2.22, 10/18/2026: lock-free event queue from isrs to loop()
+// - v2.23, 10/18/2026: cooperative fixed-rate task scheduler, run ahead of loop()
+// - v2.24, 10/18/2026: optional preemptive kernel on tmr1 (USE_KERNEL): threads, semaphores, queues
+// - v2.25, 10/18/2026: hierarchical software timer wheel on oc4
+// - v2.26, 10/18/2026: tickless idle on tmr1 with SysTick correction, idle/active statistics. sleep() uses pwrsav
+// - v2.27, 10/18/2026: yield() hooks run from delay(), delayMicroseconds() and the uart tx waits
+// - v2.28, 10/18/2026: DOZE/RCDIV frequency scaling. ticks64()/micros64() continuous across clock changes. cyclesPer*() on F_PHB
+// - v2.29, 10/18/2026: SystemCoreClockSwitch() keeps millis() continuous, waits for pll lock and re-derives uart/spi/servo/tone/task timing
+// - v2.30, 10/18/2026: reference-counted peripheral power gating (PMDx) with register save/restore, pmdDump()
+// - v2.31, 10/18/2026: deep sleep on GA10x/GB00x: dsEnter(), wake-up reason and DSGPR state at boot, DS_RESUME() in place of setup()
+// - v2.32, 10/18/2026: rtcc snapshot in one RTCPTR pass with RTCSYNC retry, unix epoch conversion both ways, single-pass time write
+// - v2.33, 10/18/2026: rtcc alarm service: one-shot and repeating alarms with an isr callback, IRQ_RTC
+// - v2.34, 10/18/2026: now(): rtcc epoch plus a microsecond fraction from ticks64(), latched at each rtcc second
+//
+//
+//               PIC24FJ
+//              |=====================|
+//    Vcc       |                     |
+//     |        |                Vcap |>--[.1u]-+->GND
+//     |        |                     |         |
+//     +-[10K]-<| MCLR        DISVreg |>--------+
+//              |                     |
+//              |                     |
+//     +------->| OSCI            Vdd |>--+------>Vcc
+//  [Xtal]      |                     | [.1u]
+//     +-------<| OSCO            Vss |>--+------>GND
+//              |                     |
+//              |                 RP0 |>---------->Uart2TX
+//              |                     |
+//              |                 RB5 |>---------->LED
+//              |                     |
+//              |                     |
+//              |                     |
+//              |                     |
+//              |                     |
+//              |                     |
+//              |                     |
+//              |                     |
+//              |                     |
+//              |=====================|
+//
+//
+
+#if defined(__XC__)
+#include <xc.h>							//we use xc24
+#include <stdint.h>						//we use uint types
+#elif defined(__C30__)						//we use C30
+#include <p24fxxxx.h>
+
+//PIC24GA10x family
+#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+		defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__)
+#define __PIC24GA10x__
+
+//PIC24GA00x family
+#elif 	defined(__PIC24FJ64GA002__) | defined (__PIC24FJ64GA004__) | \
+		defined(__PIC24FJ48GA002__) | defined (__PIC24FJ48GA004__) | \
+		defined(__PIC24FJ32GA002__) | defined (__PIC24FJ32GA004__) | \
+		defined(__PIC24FJ16GA002__) | defined (__PIC24FJ16GA004__)
+#define __PIC24GA00x__
+
+//pic24GB00x family
+#elif 	defined(__PIC24FJ64GB002__) | defined(__PIC24FJ64GB004__) | \
+		defined(__PIC24FJ48GB002__) | defined(__PIC24FJ48GB004__) | \
+		defined(__PIC24FJ32GB002__) | defined(__PIC24FJ32GB004__)
+#define __PIC24GB00x__
+#else
+#error "PIC24Duino.c: PIC24 not supported!"
+#endif
+
+//define types
+typedef unsigned char uint8_t;
+typedef signed char int8_t;
+typedef unsigned short uint16_t;
+typedef signed short int16_t;
+typedef unsigned long uint32_t;
+typedef signed long int32_t;
+typedef unsigned long long uint64_t;
+typedef signed long long int64_t;
+#else
+#error "PIC24Duino.h: only C30 / XC compilers supported!"
+#endif
+#include <string.h>							//we use strcpy()
+
+//hardware configuration
+//#define USE_MAIN							//use self-defined main() in user code
+#define USE_SYSTICK							//for compatability with pic32duino. ignored
+//#define SYSTICK_TMR1						//systick running on tmr1 if defined. otherwise on tmr2 (default), which the timebase needs
+//#define USE_KERNEL						//preemptive kernel, ticking on tmr1. needs systick on tmr2
+
+//oscillator configuration
+#define F_XTAL				8000000ul		//crystal frequency, user-specified
+#define F_SOSC				32768			//SOSC = 32768Hz, user-specified
+
+#define TxIP_DEFAULT		5				//default priority for timer interrupts 0..7. 0->interrupt disabled, 7->highest priority
+#define TxIS_DEFAULT		5				//default subpriority for timer interrupts
+#define OCxIP_DEFAULT		5				//default priority for timer interrupts 0..7. 0->interrupt disabled, 7->highest priority
+#define CRCIP_DEFAULT		5				//default priority for crc interrupt
+#define SPIIP_DEFAULT		1					//default interrupt priority
+#define SPIIS_DEFAULT		0
+#define ICxIP_DEFAULT		4				//default priority for input capture interrupts. 4->reset value
+#define INTxIP_DEFAULT		4				//default priority for external interrupts
+#define CNIP_DEFAULT		4				//default priority for change notification interrupt
+#define UxIP_DEFAULT		4				//default priority for uart rx/tx interrupts
+#define ADCIP_DEFAULT		4				//default priority for adc interrupt
+#define RTCIP_DEFAULT		4				//default priority for rtcc alarm interrupt
+
+//compile-time isr binding: define XX_HANDLER() to have the vector call it directly instead of the isr pointer
+//XX = T1..T5, OC1..OC5, IC1..IC5, INT0..INT4, CN, RTC. the vector then ignores xxAttachISR(), including the library's
+//own users of it (servo on oc1, tone on oc5, stepper on oc3/oc4, icm on ic1, infrared on ic2, encoders on cn)
+//a static inline handler declared here is inlined into the vector; an empty XX_HANDLER() leaves only the flag clearing
+//#define OC1_HANDLER()		myOC1Handler()	//example: void myOC1Handler(void) in user code
+//ISR_PROFILE latches TMR2 at the first and last statement of each of these vectors into per-vector min/max, read
+//with isrMin()/isrMax()/isrDump(): build once with the isr pointer and once with XX_HANDLER() to compare the two.
+//in ticks (cycles at DOZE 1:1), including any nested higher-priority isr. the 5-cycle hardware entry, the compiler's
+//register save/restore and retfie are outside the window: the pointer form also saves w0..w7 there for the call
+//#define ISR_PROFILE						//per-vector execution time
+//end user specification
+
+//uart1 pin configuration
+#define U1TX2RP()			PPS_U1TX_TO_RP(2)			//map u1tx pin to an rp pin
+//#define U1RX2RP()			PPS_U1RX_TO_RP(3)			//map u1rx pin to an rp pin
+
+//uart2 pin configuration
+#define U2TX2RP()			PPS_U2TX_TO_RP(0)			//u2tx pin
+//#define U2RX2RP()			PPS_U2RX_TO_RP(1)			//u2rx pin
+
+//pwm/oc pin configuration
+#define PWM12RP()			PPS_OC1_TO_RP(0)			//oc1 pin:
+#define PWM22RP()			PPS_OC2_TO_RP(1)			//oc2 pin:
+#define PWM32RP()			PPS_OC3_TO_RP(2)			//oc3 pin:
+#define PWM42RP()			PPS_OC4_TO_RP(3)			//oc4 pin:
+//#define PWM52RP()			PPS_OC5_TO_RP(5)			//oc5 pin:
+
+//input capture pin configuration
+#define IC12RP()			PPS_IC1_TO_RP(4)			//ic1 pin:
+#define IC1_PIN				PB4							//ic1 pin as gpio (RP4 = RB4), read by icmInit(ICM_EDGE) for edge polarity
+#define IC22RP()			PPS_IC2_TO_RP(7)			//ic2 pin:
+#define IC32RP()			PPS_IC3_TO_RP(4)			//ic3 pin:
+#define IC42RP()			PPS_IC4_TO_RP(4)			//ic4 pin:
+#define IC52RP()			PPS_IC5_TO_RP(4)			//ic5 pin:
+
+//spi1 pin configuration
+#define SCK1RP()			PPS_SCK1OUT_TO_RP(0)		//spi1 serial clock output
+#define SDO1RP()			PPS_SDO1_TO_RP(1)			//spi1 serial data output
+//#define SDI1RP()			PPS_SDI1_TO_RP(3)			//spi1 serial data input
+#define SCK2RP()			PPS_SCK2OUT_TO_RP(1)		//spi1 serial clock output
+#define SDO2RP()			PPS_SDO2_TO_RP(2)			//spi1 serial data output
+#define SDI2RP()			PPS_SDI2_TO_RP(3)			//spi1 serial data input
+
+//extint pin configuration
+//#define INT02RP()			PPS_INT0_TO_RP(7)			//int0 pin: fixed to rp7
+#define INT12RP()			PPS_INT1_TO_RP(5)			//int1 pin:
+#define INT22RP()			PPS_INT2_TO_RP(5)			//int2 pin:
+#define INT32RP()			PPS_INT3_TO_RP(5)			//int3 pin: GA10x/GB00x only
+#define INT42RP()			PPS_INT4_TO_RP(5)			//int4 pin: GA10x/GB00x only
+//end pin configuration
+
+
+#define PWM_PR				0xffff			//pwm period - don't change
+
+//port manipulation macros for PIC.
+//#define IO_SET(port, bits)              port |= (bits)			//set bits on port
+//#define IO_CLR(port, bits)              port &=~(bits)			//clear bits on port
+//#define IO_FLP(port, bits)              port ^= (bits)			//flip bits on port
+//#define IO_GET(port, bits)              ((port) & (bits))		//return bits on port
+//#define IO_OUT(ddr, bits)               ddr &=~(bits)			//set bits as output
+//#define IO_IN(ddr, bits)                ddr |= (bits)			//set bits as input
+
+//if gpio_typedef is used
+#define GIO_SET(port, bits)              port->LAT |= (bits)			//set bits on port
+#define GIO_CLR(port, bits)              port->LAT &=~(bits)			//clear bits on port
+#define GIO_FLP(port, bits)              port->LAT ^= (bits)			//flip bits on port
+#define GIO_GET(port, bits)              ((port->PORT) & (bits))		//return bits on port
+#define GIO_OUT(port, bits)              port->TRIS &=~(bits)			//set bits as output
+#define GIO_IN(port, bits)               port->TRIS |= (bits)			//set bits as input
+
+//fast port operations
+#define FIO_SET(port, bits)              port->LATSET = (bits)			//set bits on port
+#define FIO_CLR(port, bits)              port->LATCLR = (bits)			//clear bits on port
+#define FIO_FLP(port, bits)              port->LATINV = (bits)			//flip bits on port
+#define FIO_GET(port, bits)              ((port->PORT) & (bits))		//return bits on port
+#define FIO_OUT(port, bits)              port->TRISCLR = (bits)			//set bits as output
+#define FIO_IN(port, bits)               port->TRISSET = (bits)			//set bits as input
+
+#define NOP()				Nop()                           //asm("nop")					//nop()
+#define NOP2()				{NOP(); NOP();}
+#define NOP4()				{NOP2(); NOP2();}
+#define NOP8()				{NOP4(); NOP4();}
+#define NOP16()				{NOP8(); NOP8();}
+#define NOP16()				{NOP8(); NOP8();}
+#define NOP24()				{NOP16(); NOP8();}
+#define NOP32()				{NOP16(); NOP16();}
+#define NOP40()				{NOP32(); NOP8();}
+#define NOP64()				{NOP32(); NOP32();}
+
+#define sleep()				asm volatile ("pwrsav #0")			//put the mcu into sleep
+
+#ifndef ei
+#define ei()				SET_CPU_IPL(0)						//cpu ipl 0 -> all enabled interrupts are taken
+#endif
+
+#ifndef di
+#define di()				SET_CPU_IPL(7)						//cpu ipl 7 -> all maskable interrupts are held off
+#endif
+
+//nested critical sections: raise the cpu ipl and restore the saved one on exit
+//save is a local uint8_t per section, so sections nest and can be used in isrs
+//critEnterIPL() only holds off interrupts of priority ipl and below, so higher priority isrs keep their latency
+#define critEnterIPL(save, ipl)	do {(save) = SRbits.IPL; if ((save) < (ipl)) {SET_CPU_IPL(ipl);}} while (0)
+#define critEnter(save)			critEnterIPL(save, 7)	//hold off all maskable interrupts
+#define critExit(save)			do {SET_CPU_IPL(save);} while (0)	//back to the ipl saved by critEnter()/critEnterIPL()
+#define memBarrier()			asm volatile ("" : : : "memory")	//compiler barrier: memory accesses are not moved across it
+
+
+#define F_PHB				(SystemCoreClock / 2)			//cpu runs at F_SYS/2 by default -> Fxtal = 8Mhz. *4 for PLL. RCDIV set to 0 (1:1 postscaler)
+#define F_CPU				(CLKDIVbits.DOZEN?(F_PHB >> CLKDIVbits.DOZE):(F_PHB))			//peripheral block runs at F_PHB - default = F_CPU / 1
+#define F_FRC				8000000ul						//FRC frequency = 8Mhz, fixed
+#define F_LPRC				31000							//LPRC = 31Khz, fixed
+extern uint32_t SystemCoreClock;							//pheriphral core clock, before dividing by 2
+
+//iolock/unlock sequence
+//unlock IOLOCK
+#define IO_UNLOCK()	{asm volatile ( "MOV #OSCCON, w1 \n" \
+					"MOV #0x46, w2 \n" \
+					"MOV #0x57, w3 \n" \
+					"MOV.b w2, [w1] \n" \
+					"MOV.b w3, [w1] \n" \
+					"BCLR OSCCON,#6"); \
+					}
+
+//lock IOLOCK
+#define IO_LOCK()	{asm volatile ( "MOV #OSCCON, w1 \n" \
+					"MOV #0x46, w2 \n" \
+					"MOV #0x57, w3 \n" \
+					"MOV.b w2, [w1] \n" \
+					"MOV.b w3, [w1] \n" \
+					"BSET OSCCON, #6" ); \
+					}
+
+//pps macros
+//more on macro
+//macros for remappable pins
+//for peripheral pin select (PPS)
+#if defined(_INT1R)
+/// Maps INT1 to a remappable pin;
+/// see PPS_xxx_TO_RP(pin) for more informatino.
+#define PPS_INT1_TO_RP(pin) _INT1R = pin
+#else
+#define PPS_INT1_TO_RP(pin)
+#endif
+
+
+#if defined(_INT2R)
+#define PPS_INT2_TO_RP(pin) _INT2R = pin
+#else
+#define PPS_INT2_TO_RP(pin)
+#endif
+
+#if defined(_INT3R)
+#define PPS_INT3_TO_RP(pin) _INT3R = pin
+#else
+#define PPS_INT3_TO_RP(pin)
+#endif
+
+#if defined(_INT4R)
+#define PPS_INT4_TO_RP(pin) _INT4R = pin
+#else
+#define PPS_INT4_TO_RP(pin)
+#endif
+
+#if defined(_T2CKR)
+#define PPS_T2CK_TO_RP(pin) _T2CKR = pin
+#else
+#define PPS_T2CK_TO_RP(pin)
+#endif
+
+#if defined(_T3CKR)
+#define PPS_T3CK_TO_RP(pin) _T3CKR = pin
+#else
+#define PPS_T3CK_TO_RP(pin)
+#endif
+
+#if defined(_T4CKR)
+#define PPS_T4CK_TO_RP(pin) _T4CKR = pin
+#else
+#define PPS_T4CK_TO_RP(pin)
+#endif
+
+#if defined(_T5CKR)
+#define PPS_T5CK_TO_RP(pin) _T5CKR = pin
+#else
+#define PPS_T5CK_TO_RP(pin)
+#endif
+
+#if defined(_IC1R)
+#define PPS_IC1_TO_RP(pin) _IC1R = pin
+#else
+#define PPS_IC1_TO_RP(pin)
+#endif
+
+#if defined(_IC2R)
+#define PPS_IC2_TO_RP(pin) _IC2R = pin
+#else
+#define PPS_IC2_TO_RP(pin)
+#endif
+
+#if defined(_IC3R)
+#define PPS_IC3_TO_RP(pin) _IC3R = pin
+#else
+#define PPS_IC3_TO_RP(pin)
+#endif
+
+#if defined(_IC4R)
+#define PPS_IC4_TO_RP(pin) _IC4R = pin
+#else
+#define PPS_IC4_TO_RP(pin)
+#endif
+
+#if defined(_IC5R)
+#define PPS_IC5_TO_RP(pin) _IC5R = pin
+#else
+#define PPS_IC5_TO_RP(pin)
+#endif
+
+#if defined(_IC6R)
+#define PPS_IC6_TO_RP(pin) _IC6R = pin
+#else
+#define PPS_IC6_TO_RP(pin)
+#endif
+
+#if defined(_IC7R)
+#define PPS_IC7_TO_RP(pin) _IC7R = pin
+#else
+#define PPS_IC7_TO_RP(pin)
+#endif
+
+#if defined(_IC8R)
+#define PPS_IC8_TO_RP(pin) _IC8R = pin
+#else
+#define PPS_IC8_TO_RP(pin)
+#endif
+
+#if defined(_OCFAR)
+#define PPS_OCFA_TO_RP(pin) _OCFAR = pin
+#else
+#define PPS_OCFA_TO_RP(pin)
+#endif
+
+#if defined(_OCFBR)
+#define PPS_OCFB_TO_RP(pin) _OCFBR = pin
+#else
+#define PPS_OCFB_TO_RP(pin)
+#endif
+
+#if defined(_U1RXR)
+#define PPS_U1RX_TO_RP(pin) _U1RXR = pin
+#else
+#define PPS_U1RX_TO_RP(pin)
+#endif
+
+#if defined(_U1CTSR)
+#define PPS_U1CTS_TO_RP(pin) _U1CTSR = pin
+#else
+#define PPS_U1CTS_TO_RP(pin)
+#endif
+
+#if defined(_U2RXR)
+#define PPS_U2RX_TO_RP(pin) _U2RXR = pin
+#else
+#define PPS_U2RX_TO_RP(pin)
+#endif
+
+#if defined(_U2CTSR)
+#define PPS_U2CTS_TO_RP(pin) _U2CTSR = pin
+#else
+#define PPS_U2CTS_TO_RP(pin)
+#endif
+
+#if defined(_SDI1R)
+#define PPS_SDI1_TO_RP(pin) _SDI1R = pin
+#else
+#define PPS_SDI1_TO_RP(pin)
+#endif
+
+#if defined(_SCK1R)
+#define PPS_SCK1IN_TO_RP(pin) _SCK1R = pin
+#else
+#define PPS_SCK1IN_TO_RP(pin)
+#endif
+
+#if defined(_SS1R)
+#define PPS_SS1IN_TO_RP(pin) _SS1R = pin
+#else
+#define PPS_SS1IN_TO_RP(pin)
+#endif
+
+#if defined(_SDI2R)
+#define PPS_SDI2_TO_RP(pin) _SDI2R = pin
+#else
+#define PPS_SDI2_TO_RP(pin)
+#endif
+
+#if defined(_SCK2R)
+#define PPS_SCK2IN_TO_RP(pin) _SCK2R = pin
+#else
+#define PPS_SCK2IN_TO_RP(pin)
+#endif
+
+#if defined(_SS2R)
+#define PPS_SS2IN_TO_RP(pin) _SS2R = pin
+#else
+#define PPS_SS2IN_TO_RP(pin)
+#endif
+
+#if defined(_C1RXR)
+#define PPS_C1RXR_TO_RP(pin) _C1RXR = pin
+#else
+#define PPS_C1RXR_TO_RP(pin)
+#endif
+
+#if defined(_C2RXR)
+#define PPS_C2RXR_TO_RP(pin) _C2RXR = pin
+#else
+#define PPS_C2RXR_TO_RP(pin)
+#endif
+
+
+//end RP input mapping
+//Your device may not have all of these peripherals!
+
+//start RP output mapping
+
+
+#if defined(_RP0R)
+/// Maps C1OUT to a remappable pin;
+/// see PPS_yyy_TO_RP(pin) for more informatino.
+#define PPS_C1OUT_TO_RP(pin) _RP##pin##R = 1
+#else
+#define PPS_C1OUT_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_C2OUT_TO_RP(pin) _RP##pin##R = 2
+#else
+#define PPS_C2OUT_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_U1TX_TO_RP(pin) _RP##pin##R = 3
+#else
+#define PPS_U1TX_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_U1RTS_TO_RP(pin) _RP##pin##R = 4
+#else
+#define PPS_U1RTS_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_U2TX_TO_RP(pin) _RP##pin##R = 5
+#else
+#define PPS_U2TX_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_U2RTS_TO_RP(pin) _RP##pin##R = 6
+#else
+#define PPS_U2RTS_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_SDO1_TO_RP(pin) _RP##pin##R = 7
+#else
+#define PPS_SDO1_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_SCK1OUT_TO_RP(pin) _RP##pin##R = 8
+#else
+#define PPS_SCK1OUT_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_SS1OUT_TO_RP(pin) _RP##pin##R = 9
+#else
+#define PPS_SS1OUT_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_SDO2_TO_RP(pin) _RP##pin##R = 10
+#else
+#define PPS_SDO2_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_SCK2OUT_TO_RP(pin) _RP##pin##R = 11
+#else
+#define PPS_SCK2OUT_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_SS2OUT_TO_RP(pin) _RP##pin##R = 12
+#else
+#define PPS_SS2OUT_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_C1TX_TO_RP(pin) _RP##pin##R = 16
+#else
+#define PPS_C1TX_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_OC1_TO_RP(pin) _RP##pin##R = 18
+#else
+#define PPS_OC1_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_OC2_TO_RP(pin) _RP##pin##R = 19
+#else
+#define PPS_OC2_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_OC3_TO_RP(pin) _RP##pin##R = 20
+#else
+#define PPS_OC3_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_OC4_TO_RP(pin) _RP##pin##R = 21
+#else
+#define PPS_OC4_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_OC5_TO_RP(pin) _RP##pin##R = 22
+#else
+#define PPS_OC5_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_CTPLS_TO_RP(pin) _RP##pin##R = 29
+#else
+#define PPS_CTPLS_TO_RP(pin)
+#endif
+
+#if defined(_RP0R)
+#define PPS_C3OUT_TO_RP(pin) _RP##pin##R = 30
+#else
+#define PPS_C3OUT_TO_RP(pin)
+#endif
+
+//simple multiples
+#define x1(val)				(val)								//multiply val by 1
+#define x2(val)				(((val) << 1))						//multiply val by 2
+#define x3(val)				(x2(val) + (val))					//multiply val by 3
+#define x4(val)				(((val) << 2))						//multiply val by 4
+#define x5(val)				(x4(val) + (val))					//multiply val by 5
+#define x6(val)				(x4(val) + x2(val))					//multiply val by 6
+#define x7(val)				(x6(val) + (val))					//multiply val by 7
+#define x8(val)				((val) << 3)						//multiply val by 8
+#define x9(val)				(x8(val) + (val))					//multiply val by 9
+
+//multiples of 10s
+#define x10(val)			(x8(val) + x2(val))					//multiply val by 10
+#define x100(val)			(x10(x10(val)))						//multiply val by 100
+#define x1000(val)			(x100(x10(val)))					//multiply val by 1000
+#define x1k(val)			x1000(val)							//multiply val by 1000
+#define x10k(val)			(x100(x100(val)))					//multiply val by 10000
+
+#define x20(val)			(x2(x10(val)))
+#define x30(val)			(x3(x10(val)))
+#define x40(val)			(x4(x10(val)))
+#define x50(val)			(x5(x10(val)))
+#define x60(val)			(x6(x10(val)))
+#define x70(val)			(x7(x10(val)))
+#define x80(val)			(x8(x10(val)))
+#define x90(val)			(x9(x10(val)))
+
+//multiples of 100s
+#define x200(val)			(x2(x100(val)))
+#define x300(val)			(x3(x100(val)))
+#define x400(val)			(x4(x100(val)))
+#define x500(val)			(x5(x100(val)))
+#define x600(val)			(x6(x100(val)))
+#define x700(val)			(x7(x100(val)))
+#define x800(val)			(x8(x100(val)))
+#define x900(val)			(x9(x100(val)))
+
+//custom definitions
+#define x34(val)			(x30(val) + x4(val))				//multiply val by 34
+#define x97(val)			(x90(val) + x7(val))				//multiply val by 97x
+
+//to surpress warning messages about PSV
+#define _ISR_PSV __attribute__((__interrupt__, __auto_psv__))
+#define _ISR_NOPSV __attribute__((__interrupt__, __no_auto_psv__))
+
+//gpio
+//port structure
+typedef struct {
+	volatile uint16_t TRIS;             //data direction register -> 0ffset 0x0000, little endian
+	volatile uint16_t PORT;             //input data register
+	volatile uint16_t LAT;              //output data register
+	volatile uint16_t ODC;              //open drain configuration register. set to activate open drain
+} GPIO_TypeDef;                         //port definition registers
+
+#define GPIOA				((GPIO_TypeDef *) &TRISA)
+#define GPIOB				((GPIO_TypeDef *) &TRISB)
+#if defined(TRISC)
+#define GPIOC            	((GPIO_TypeDef *) &TRISC)
+#endif
+#if defined(TRISD)
+#define GPIOD				((GPIO_TypeDef *) &TRISD)
+#endif
+#if defined(TRISE)
+#define GPIOE				((GPIO_TypeDef *) &TRISE)
+#endif
+#if defined(TRISF)
+#define GPIOF				((GPIO_TypeDef *) &TRISF)
+#endif
+#if defined(TRISG)
+#define GPIOG				((GPIO_TypeDef *) &TRISG)
+#endif
+
+
+//global defines
+//gpio definitions
+
+//pin enum - matches GPIO_PinDef[]
+typedef enum {
+	PA0, PA1, PA2, PA3, PA4, PA5, PA6, PA7, PA8, PA9, PA10, PA11, PA12, PA13, PA14, PA15,
+	PB0, PB1, PB2, PB3, PB4, PB5, PB6, PB7, PB8, PB9, PB10, PB11, PB12, PB13, PB14, PB15,
+#if defined(GPIOC)
+	PC0, PC1, PC2, PC3, PC4, PC5, PC6, PC7, PC8, PC9, PC10, PC11, PC12, PC13, PC14, PC15,
+#endif		//GPIOC
+#if defined(GPIOD)
+	PD0, PD1, PD2, PD3, PD4, PD5, PD6, PD7, PD8, PD9, PD10, PD11, PD12, PD13, PD14, PD15,
+#endif		//GPIOD
+#if defined(GPIOE)
+	PE0, PE1, PE2, PE3, PE4, PE5, PE6, PE7, PE8, PE9, PE10, PE11, PE12, PE13, PE14, PE15,
+#endif		//GPIOE
+#if defined(GPIOF)
+	PF0, PF1, PF2, PF3, PF4, PF5, PF6, PF7, PF8, PF9, PF10, PF11, PF12, PF13, PF14, PF15,
+#endif		//GPIOF
+#if defined(GPIOG)
+	PG0, PG1, PG2, PG3, PG4, PG5, PG6, PG7, PG8, PG9, PG10, PG11, PG12, PG13, PG14, PG15,
+#endif		//GPIOG
+	PMAX
+} PIN_TypeDef;
+
+//map pin number to GPIOx
+typedef struct {
+	GPIO_TypeDef *gpio;					//gpio for a pin
+	uint16_t mask;						//pin mask - 16-bit port
+} PIN2GPIO;
+//end gpio
+
+//devid
+typedef struct {
+	uint16_t DEVID;						//device id	- 0..5: DevID, 6..13: FamilyID
+	uint16_t DEVREV;					//family id - 0..3: DOT, 6..8: MajRev
+} DevID_TypeDef;
+
+#define PIC24ID							((DevID_TypeDef *) 0xff0000ul)	//for PIC24FxxxGA1/GB1 devices
+//end devid
+
+#define INPUT				0
+#define OUTPUT				1			//(!INPUT)
+#define INPUT_PULLUP		2
+
+#define LOW					0
+#define HIGH				(!LOW)
+
+#define PI 					3.1415926535897932384626433832795
+#define HALF_PI 			(PI / 2)							//1.5707963267948966192313216916398
+#define TWO_PI 				(PI + PI)							//6.283185307179586476925286766559
+#define DEG_TO_RAD 			(TWO_PI / 360)						//0.017453292519943295769236907684886
+#define RAD_TO_DEG 			(360 / TWO_PI)						//57.295779513082320876798154814105
+#define EULER 				2.718281828459045235360287471352	//Euler's number
+
+#define SERIAL  			0x0
+#define DISPLAY 			0x1
+
+#define LSBFIRST 			0
+#define MSBFIRST 			1									//(!LSBFIRST)							//1
+
+#define CHANGE 				1
+#define FALLING 			2
+#define RISING 				3
+
+#ifndef min
+#define min(a,b) 			((a)<(b)?(a):(b))
+#endif
+#ifndef max
+#define max(a,b) 			((a)>(b)?(a):(b))
+#endif
+#define abs(x) 				((x)>0?(x):-(x))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define round(x)     		((x)>=0?(long)((x)+0.5):(long)((x)-0.5))
+#define radians(deg) 		((deg)*DEG_TO_RAD)
+#define degrees(rad) 		((rad)*RAD_TO_DEG)
+#define sq(x) 				((x)*(x))
+
+#define interrupts() 		ei()
+#define noInterrupts() 		di()
+
+#define clockCyclesPerMillisecond() 	( F_CPU / 1000L )
+#define clockCyclesPerMicrosecond() 	( F_CPU / 1000000L )
+#define clockCyclesToMicroseconds(a) 	( (a) / clockCyclesPerMicrosecond() )
+#define microsecondsToClockCycles(a) 	( (a) * clockCyclesPerMicrosecond() )
+
+#define lowByte(w) 			((uint8_t) ((w) & 0xff))
+#define highByte(w) 		((uint8_t) ((w) >> 8))
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) 	((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) (bitvalue ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(n)				(1ul<<(n))
+
+#define false				0
+#define true				(!false)
+
+//characters
+#define isAlphaNumeric(c)	isalnum(c)
+#define isAlpha(c)			isalpha(c)
+#define isAscii(c)			isascii(c)
+#define isWhitespace(c)		isblank(c)
+#define isControl(c)		iscntrl(c)
+#define isDigit(c)			isdigit(c)
+#define isGraph(c)			isgraph(c)
+#define isLowerCase(c)		islower(c)
+#define isPrintable(c)		isprint(c)
+#define isPunct(c)			ispunct(c)
+#define isSpace(c)			isspace(c)
+#define isUpperCase(c)		isupper(c)
+#define isHexadecimalDigit(c)	isxdigit(c)
+
+//external setup/loop - defined by user
+extern void setup(void);
+extern void loop(void);
+
+//random number
+#define randomSeed(seed)	srand(seed)
+#define random(max)			random2(0, max)
+#define random2(min, max)	((min) + (int32_t) ((max) - (min)) * rand() / 32768)
+
+//GPIO
+//flip the pin
+#define pinFlip(pin)		digitalWrite(pin, !digitalRead(pin))
+void pinMode(PIN_TypeDef pin, uint8_t mode);
+void digitalWrite(PIN_TypeDef pin, uint8_t mode);
+int digitalRead(PIN_TypeDef pin);
+
+//time base
+//ticks run at F_PHB: DOZE slows the cpu (F_CPU) only
+uint32_t ticks(void);								//timer ticks from timer2
+uint64_t ticks64(void);								//ticks() extended to 64 bits
+uint64_t micros64(void);							//microseconds since reset, continuous across F_PHB changes
+uint32_t millis(void);								//milliseconds since reset: multiply and shift, no division
+uint32_t micros(void);								//microseconds since reset: multiply and shift, no division
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+#define cyclesPerMicrosecond()			(F_PHB / 1000000ul)	//ticks per us
+#define cyclesPerMillisecond()			(F_PHB / 1000)		//ticks per ms
+
+//background work, run by yield() from the library's blocking waits
+//hooks don't run from isrs or critical sections, nor from a wait inside a hook
+//#define YIELD_IDLE							//with no hook attached, delays idle the cpu through idleUntil()
+#if defined(IDLE_SLEEP)
+#define YIELD_IDLE_MIN		(F_PHB / 1000)				//shorter waits spin: sleep wakes in SOSC periods plus oscillator start-up
+#else
+#define YIELD_IDLE_MIN		1024						//shorter waits spin: idle wakes in steps of 256 ticks
+#endif
+#define YIELD_CNT			4							//max number of hooks
+uint8_t yieldAttach(void (*func)(void));			//add a hook. return 0 if full
+void yieldDetach(void (*func)(void));				//remove a hook
+void yield(void);									//run the hooks once
+
+//advanced IO
+//tone: square wave on oc2 (PWM22RP() pin), toggled in hardware off timer3 -> no cpu time per cycle
+//durations and the background player run off oc5 compares on TMR2
+//timer3, oc2 and oc5 are dedicated to tone generation
+typedef struct {
+	uint16_t freq;									//frequency in Hz, 0->rest
+	uint16_t ms;									//duration in ms, 0->end of the sequence
+} TONE_TypeDef;
+void tone(uint16_t freq, uint32_t ms);				//play freq Hz for ms milliseconds. ms=0->until noTone()
+void noTone(void);									//stop the tone / player
+void tonePlay(const TONE_TypeDef *seq);				//play a note sequence in the background
+void tonePlayRTTTL(const char *song);				//play a rtttl song in the background, ie. "name:d=4,o=5,b=120:8c,8e,g"
+uint8_t toneBusy(void);								//1->a timed tone / song is playing
+//shiftin/out: bitOrder = MSBFIRST or LSBFIRST
+uint8_t shiftIn(PIN_TypeDef dataPin, PIN_TypeDef clockPin, uint8_t bitOrder);
+void shiftOut(PIN_TypeDef dataPin, PIN_TypeDef clockPin, uint8_t bitOrder, uint8_t val);
+uint32_t pulseIn(PIN_TypeDef pin, uint8_t state);		//wait for a pulse and return timing
+
+//pwm output
+//dc = 0x00..0x0fff for pwm2/3/4/5, 0x00..0xffff for pwm1
+//RP4=PWM1, RP12=PWM2, RP13=PWM3, RP14=PWM4, RP15=PWM5
+void analogWrite(uint8_t pin, uint16_t dc);
+
+//analog read on ADC1
+//read DRL first for right aligned results
+//uint16_t analogRead(uint8_t pin);
+
+//analog reference - default to AVdd-AVss
+//Vref sources: 0->Vref = AVdd-AVss, 1->Vref+-AVss, 2->AVdd-Vref-, 3->Vref+ - Vref-
+//void analogReference(uint8_t Vref);
+
+//interrupts
+//install external interrupt handler on intx=0..4. the intx pin is set by INTx2RP()
+//mode: RISING, FALLING or CHANGE
+void attachInterrupt(uint8_t intx, void (*isrptr) (void), uint8_t mode);
+void detachInterrupt(uint8_t intx);
+uint32_t intCount(uint8_t intx);				//interrupts taken on intx since its attachInterrupt()
+
+//change notification interrupts
+//install user CN interrupt handler
+//void attachCNInterrupt(void (*isrptr) (void));
+//void detachCNInterrupt(void);
+//void activateCNInterrupt(uint8_t cnx, uint8_t pue);
+//void deactivateCNInterrupt(uint8_t cnx);
+
+//global variables
+
+//reset the mcu
+void mcuInit(void);
+//111 = Fast RC Oscillator with Postscaler (FRCDIV)
+//110 = Reserved
+//101 = Low-Power RC Oscillator (LPRC)
+//100 = Secondary Oscillator (SOSC)
+//011 = Primary Oscillator with PLL module (XTPLL, HSPLL, ECPLL)
+//010 = Primary Oscillator (XT, HS, EC)
+//001 = Fast RC Oscillator with Postscaler and PLL module (FRCPLL)
+//000 = Fast RC Oscillator (FRC)
+//Needs to be executed during mcu initialization or after oscillator reconfiguration
+//updates SystemCoreClock.
+uint32_t SystemCoreClockUpdate(void);
+
+//switch oscillator
+//return SystemCoreClock in frequency
+//111 = Fast RC Oscillator with Postscaler (FRCDIV)
+//110 = Reserved
+//101 = Low-Power RC Oscillator (LPRC)
+//100 = Secondary Oscillator (SOSC)
+//011 = Primary Oscillator with PLL module (XTPLL, HSPLL, ECPLL)
+//010 = Primary Oscillator (XT, HS, EC)
+//001 = Fast RC Oscillator with Postscaler and PLL module (FRCPLL)
+//000 = Fast RC Oscillator (FRC)
+//millis()/micros() carry on across the switch; uart, spi, servo, tone and scheduler timing are re-derived
+//pwm on tmr2, stepper and software timer periods stay in ticks and scale with F_PHB
+//needs FCKSM = CSECMD/CSECME in the config. the waits are bounded
+//updates SystemCoreClock. return 0 if the switch did not happen: the clock and timing are left as they were
+uint32_t SystemCoreClockSwitch(uint8_t nosc);
+void clkRetune(uint32_t f_old);					//re-derive peripheral timing after F_PHB changed from f_old. call with interrupts held off
+
+#define SystemCoreClockFRC()			SystemCoreClockSwitch(0b000)
+#define SystemCoreClockFRCPLL()			SystemCoreClockSwitch(0b001)
+#define SystemCoreClockPOSC()			SystemCoreClockSwitch(0b010)
+#define SystemCoreClockPOSCPLL()		SystemCoreClockSwitch(0b011)
+#define SystemCoreClockSOSC()			SystemCoreClockSwitch(0b100)
+#define SystemCoreClockLPRC()			SystemCoreClockSwitch(0b101)
+#define SystemCoreClockFRCDIV()			SystemCoreClockSwitch(0b111)
+
+//empty interrupt handler
+void empty_handler(void);
+
+
+//#define Mhz					000000ul	//suffix for Mhz
+#define F_UART				(F_PHB)	//peripheral clock
+#define UART_BR300			300ul		//buadrate=300
+#define UART_BR600			600ul		//buadrate=600
+#define UART_BR1200			1200ul		//buadrate=1200
+#define UART_BR2400			2400ul		//buadrate=2400
+#define UART_BR4800			4800ul		//buadrate=4800
+#define UART_BR9600			9600ul		//buadrate=9600
+#define UART_BR19200		19200ul		//buadrate=19200
+#define UART_BR38400		38400ul		//buadrate=38400
+#define UART_BR57600		57600ul		//buadrate=57600
+#define UART_BR115200		115200ul	//buadrate=115200
+
+//initiate the hardware usart1
+void uart1Init(unsigned long baud_rate);//initialize uart
+void uart1Putch(char ch);				//output a char on uart
+void uart1Puts(char *str);				//output a string on uart
+void uart1Putline(char *ln);			//output a string + linefeed on uart
+#define uart1Getch()		U1RXREG		//uint8_t uart1Getch(void);				//read a char from usart
+#define uart1Available()	U1STAbits.URXDA	//uint16_t uart1Available(void);			//test if data rx is available
+#define uart1Busy()			U1STAbits.UTXBF	//uint16_t uart1Busy(void);				//test if uart tx is busy
+void u1Print(char *str, int32_t dat);	//output a number on uart
+#define u1Println()			uart1Puts("\r\n")
+//for compatability
+#define uart1Put(ch)		uart1Putch(ch)
+#define uart1Get()			uart1Getch()
+
+
+//initiate the hardware usart2
+void uart2Init(unsigned long baud_rate);//initialize uart
+void uart2Putch(char ch);				//output a char on uart
+void uart2Puts(char *str);				//output a string on uart
+void uart2Putline(char *ln);			//output a string + linefeed on uart
+#define uart2Getch()		U2RXREG		//uint8_t uart2Getch(void);				//read a char from usart
+#define uart2Available()	U2STAbits.URXDA	//uint16_t uart2Available(void);			//test if data rx is available
+#define uart2Busy()			U2STAbits.UTXBF	//uint16_t uart2Busy(void);				//test if uart tx is busy
+void u2Print(char *str, int32_t dat);	//output a number on uart
+#define u2Println()			uart2Puts("\r\n")
+//for compatability
+#define uart2Put(ch)		uart2Putch(ch)
+#define uart2Get()			uart2Getch()
+
+void uartRebaud(void);					//re-derive UxBRG for the current F_PHB, after a clock change
+void uartFlush(void);					//wait for the enabled uarts to finish sending
+
+//end Serial
+
+
+//tmr1-5 prescaler
+#define TMR_PS1x			0x00
+#define TMR_PS4x			0x01
+#define TMR_PS8x			0x02
+#define TMR_PS256x			0x03
+#define TMR_PSMASK			TMR_PS256x
+
+//#define TMR_IPDEFAULT		2
+//#define TMR_ISDEFAULT		0
+
+//initialize the timer1 (16bit)
+void tmr1Init(uint8_t ps, uint16_t period);
+//activate the isr handler
+void tmr1AttachISR(void (*isrptr)(void));
+
+//initialize the timer2 (16bit)
+void tmr2Init(uint8_t ps, uint16_t period);
+//activate the isr handler
+void tmr2AttachISR(void (*isrptr)(void));
+
+//initialize the timer3 (16bit)
+void tmr3Init(uint8_t ps, uint16_t period);
+//activate the isr handler
+void tmr3AttachISR(void (*isrptr)(void));
+
+//initialize the timer4 (16bit)
+void tmr4Init(uint8_t ps, uint16_t period);
+//activate the isr handler
+void tmr4AttachISR(void (*isrptr)(void));
+
+//initialize the timer5 (16bit)
+void tmr5Init(uint8_t ps, uint16_t period);
+//activate the isr handler
+void tmr5AttachISR(void (*isrptr)(void));
+
+//32-bit timers
+//initialize the timer23 (32bit)
+void tmr23Init(uint8_t ps, uint32_t period);
+//read 32-bit tmr23
+uint32_t tmr23Get(void);
+//activate the isr handler
+#define tmr23AttachISR(isr)		tmr3AttachISR(isr)
+
+//initialize the timer45 (32bit)
+void tmr45Init(uint8_t ps, uint32_t period);
+//read 32-bit tmr45
+uint32_t tmr45Get(void);
+//activate the isr handler
+#define tmr45AttachISR(isr)		tmr5AttachISR(isr)
+
+//pwm / oc
+//initialize pwm1
+void pwm1Init(void);
+#define pwm1SetDC(dc)			do {OC1RS = (dc);} while (0)
+#define pwm1GetDC()				(OC1RS)
+
+//initialize pwm2
+void pwm2Init(void);
+#define pwm2SetDC(dc)			do {OC2RS = (dc);} while (0)
+#define pwm2GetDC()				(OC2RS)
+
+//initialize pwm3
+void pwm3Init(void);
+#define pwm3SetDC(dc)			do {OC3RS = (dc);} while (0)
+#define pwm3GetDC()				(OC3RS)
+
+//initialize pwm4
+void pwm4Init(void);
+#define pwm4SetDC(dc)			do {OC4RS = (dc);} while (0)
+#define pwm4GetDC()				(OC4RS)
+
+//initialize pwm5
+void pwm5Init(void);
+#define pwm5SetDC(dc)			do {OC5RS = (dc);} while (0)
+#define pwm5GetDC()				(OC5RS)
+
+//adc
+//adc channels
+#define ADC_AN0					(0)		//adc an0
+#define ADC_AN1					(1)		//adc an1
+#define ADC_AN2					(2)		//adc an2
+#define ADC_AN3					(3)		//adc an3
+#define ADC_AN4					(4)		//adc an4
+#define ADC_AN5					(5)		//adc an5
+#define ADC_AN6					(6)		//adc an6		-unimplemented on 28pin devices
+#define ADC_AN7					(7)		//adc an7		-unimplemented on 28pin devices
+#define ADC_AN8					(8)		//adc an8		-unimplemented on 28pin devices
+#define ADC_AN9					(9)		//adc an9
+#define ADC_AN10				(10)	//adc an10
+#define ADC_AN11				(11)	//adc an11
+#define ADC_AN12				(12)	//adc an12
+#define ADC_VCORE				(13)	//adc vcore
+#define ADC_VBG2				(14)	//adc bandgap/2
+#define ADC_VBG					(15)	//adc bandgap
+#define ADC_CTMU				(0xffff)	//for ctmu
+
+//rest the adc
+//automatic sampling (ASAM=1), manual conversion
+void adcInit(void);
+
+//read the adc
+uint16_t analogRead(uint16_t ch);
+//end ADC
+
+//output compare - TMR2 is the base
+#define OC_TIMEBASE()			TMR2			//TMR2 as the timebase
+void oc1Init(uint16_t pr);						//initialize oc1, by prescaler + period
+void oc1AttachISR(void (*isrptr)(void));		//install user isr
+void oc2Init(uint16_t pr);						//initialize oc1, by prescaler + period
+void oc2AttachISR(void (*isrptr)(void));		//install user isr
+void oc3Init(uint16_t pr);						//initialize oc1, by prescaler + period
+void oc3AttachISR(void (*isrptr)(void));		//install user isr
+void oc4Init(uint16_t pr);						//initialize oc1, by prescaler + period
+void oc4AttachISR(void (*isrptr)(void));		//install user isr
+void oc5Init(uint16_t pr);						//initialize oc1, by prescaler + period
+void oc5AttachISR(void (*isrptr)(void));		//install user isr
+//end output compare
+
+//servo
+//up to SERVO_CNT servos, time-multiplexed on oc1: servo pins are strobed one after another from the oc1 compare isr
+//oc1 is dedicated to the servo driver and its PWM12RP() pin toggles on every compare - unmap it if the pin is used elsewhere
+#define SERVO_CNT				8				//max number of servos
+#define SERVO_FRAME				20000			//frame period, in us
+#define SERVO_MINUS				544				//pulse width at 0 degree, in us
+#define SERVO_MAXUS				2400			//pulse width at 180 degrees, in us
+#define SERVO_MIDUS				1500			//pulse width at power-up, in us
+void servoInit(void);							//initialize the servo driver on oc1
+uint8_t servoAttach(PIN_TypeDef pin);			//attach a servo pin. return its channel, or SERVO_CNT if none is left
+void servoWrite(uint8_t ch, uint8_t angle);		//set servo position, 0..180 degrees
+void servoWriteMicroseconds(uint8_t ch, uint16_t us);	//set servo pulse width, in us
+uint16_t servoReadMicroseconds(uint8_t ch);		//read servo pulse width, in us
+//end servo
+
+//stepper
+//step pulses in hardware: axis 0 on oc3 (PWM32RP() pin), axis 1 on oc4 (PWM42RP() pin), toggle mode off TMR2
+//trapezoidal accel / cruise / decel, next step interval computed incrementally - no division per step
+//step rates from F_PHB/65535 to ~F_PHB/STEPPER_PMIN steps/s
+#define STEPPER_AXES			2				//number of axes: 1->oc3, 2->oc3+oc4
+#define STEPPER_PMIN			0x200			//shortest step period, in ticks
+void stepperInit(uint8_t axis, PIN_TypeDef dir);	//initialize an axis, with its direction pin
+void stepperMove(uint8_t axis, int32_t steps, uint32_t vmax, uint32_t accel);	//relative move, vmax in steps/s, accel in steps/s^2
+void stepperStop(uint8_t axis);					//stop immediately
+uint8_t stepperBusy(uint8_t axis);				//1->axis is moving
+int32_t stepperPosition(uint8_t axis);			//current position, in steps
+uint32_t stepperMaxRate(uint8_t axis);			//max sustained step rate achieved, in steps/s
+uint16_t stepperOverruns(uint8_t axis);			//number of steps the isr was too late for
+//end stepper
+
+//software timers: hierarchical timing wheel on oc4, shared with stepper axis 1: whichever of tmwInit() / stepperInit(1, ..) runs first gets oc4, the other does nothing
+//oc4 is set for the nearest deadline only: one interrupt per expiring slot, plus one every 0x7000 ticks while a timer is further out
+//start/stop are O(1). callbacks run in the oc4 isr, up to one granule (2^TMW_SHIFT ticks) late
+#define TMW_SHIFT				8				//granule: 2^TMW_SHIFT ticks
+typedef struct TMW_TypeDef {
+	struct TMW_TypeDef *next, *prev;			//slot list
+	uint8_t slot;								//wheel slot + 1, 0->not running. zero the timer before its first use
+	uint32_t due;								//in ticks
+	uint32_t period;							//in ticks, 0->one shot
+	void (*func)(void *arg);
+	void *arg;
+} TMW_TypeDef;
+void tmwInit(void);								//take over oc4, unless stepper axis 1 has it
+void tmwStart(TMW_TypeDef *tmr, uint32_t delay, uint32_t period, void (*func)(void *arg), void *arg);	//call func(arg) in delay ticks, then every period ticks (0->once)
+void tmwStop(TMW_TypeDef *tmr);					//cancel a timer
+#define tmwActive(tmr)			((tmr)->slot != 0)	//1->timer running
+//end software timers
+
+//input capture
+//16-bit mode, rising edge, single capture, Timer2 as timebase
+#define IC_TIMEBASE()			TMR2			//TMR2 as the timebase
+//interrupt disabled
+void ic1Init(void);
+void ic1AttachISR(void (*isrptr)(void));		//activate user ptr
+#define ic1Get()		IC1BUF					//read buffer value
+
+void ic2Init(void);
+void ic2AttachISR(void (*isrptr)(void));		//activate user ptr
+#define ic2Get()		IC2BUF					//read buffer value
+
+void ic3Init(void);
+void ic3AttachISR(void (*isrptr)(void));		//activate user ptr
+#define ic3Get()		IC3BUF					//read buffer value
+
+void ic4Init(void);
+void ic4AttachISR(void (*isrptr)(void));		//activate user ptr
+#define ic4Get()		IC4BUF					//read buffer value
+
+void ic5Init(void);
+void ic5AttachISR(void (*isrptr)(void));		//activate user ptr
+#define ic5Get()		IC5BUF					//read buffer value
+//end input capture
+
+//input capture measurement on ic1
+//every buffered capture is drained in the isr. periods are 16-bit TMR2 differences -> up to 65535 ticks
+#define ICM_AVG					8				//number of periods averaged, power of 2
+#define ICM_EDGE				1				//capture every edge -> period + duty
+#define ICM_RISING				3				//capture rising edges -> period only
+void icmInit(uint8_t mode, uint8_t ici);		//start measuring: mode=ICM_EDGE/ICM_RISING, ici=0..3->interrupt on every 1st..4th capture, ICM_RISING only
+uint32_t icmPeriod(void);						//averaged period, in ticks. 0->no reading yet
+uint32_t icmFrequency(void);					//averaged frequency, in Hz
+uint16_t icmDuty(void);							//averaged duty cycle, 0..0xffff. ICM_EDGE only
+uint16_t icmOverflows(void);					//number of capture fifo overflows
+//end input capture measurement
+
+//32-bit input capture
+//GA10x/GB00x: ic1/ic2 (ic3/ic4) cascaded on their own 32-bit timer, clocked like TMR2. captures are 32-bit counts of that timer:
+//take differences between them, they are not ticks() values. interrupt from the even (msw) module
+//GA00x: ic1 (ic3) extended in software with SysTick -> ticks() values. must be read within one TMR2 period of the edge
+uint32_t icExtend(uint16_t cap);				//extend a 16-bit TMR2 capture from the last TMR2 period to a ticks() value
+void ic12Init(void);							//32-bit capture on ic1/ic2, rising edge, interrupt disabled
+uint32_t ic12Get(void);							//read a 32-bit capture
+void ic34Init(void);							//32-bit capture on ic3/ic4, rising edge, interrupt disabled
+uint32_t ic34Get(void);							//read a 32-bit capture
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+#define ic12AttachISR(isr)		ic2AttachISR(isr)	//activate user ptr
+#define ic34AttachISR(isr)		ic4AttachISR(isr)	//activate user ptr
+#define ic12Available()			(IC1CON1bits.ICBNE)	//capture available
+#define ic34Available()			(IC3CON1bits.ICBNE)	//capture available
+#else
+#define ic12AttachISR(isr)		ic1AttachISR(isr)	//activate user ptr
+#define ic34AttachISR(isr)		ic3AttachISR(isr)	//activate user ptr
+#define ic12Available()			(IC1CONbits.ICBNE)	//capture available
+#define ic34Available()			(IC3CONbits.ICBNE)	//capture available
+#endif
+//end 32-bit input capture
+
+//infrared remote decoder on ic2 (IC22RP() pin), every edge, for an active-low receiver (TSOP-style)
+//NEC and RC5 are decoded in the capture isr and queued
+#define IR_QUEUE				4				//decoded codes queued, power of 2
+#define IR_NEC					1				//protocols
+#define IR_RC5					2
+typedef struct {
+	uint8_t proto;								//IR_NEC or IR_RC5
+	uint8_t repeat;								//1->repeat of the previous code (NEC repeat code / RC5 same toggle bit)
+	uint16_t addr;								//address: NEC 8 or 16 bits, RC5 5 bits
+	uint8_t cmd;								//command: NEC 8 bits, RC5 7 bits
+} IR_TypeDef;
+void irInit(void);								//start the decoder
+uint8_t irAvailable(void);						//number of codes queued
+uint8_t irRead(IR_TypeDef *code);				//pop a code. 1->code read, 0->queue empty
+uint16_t irOverflows(void);						//codes lost to a full queue
+//end infrared
+
+//extint
+void int0Init(void);							//initialize the module
+void int0AttachISR(void (*isrptr) (void));		//attach user isr
+
+void int1Init(void);							//initialize the module
+void int1AttachISR(void (*isrptr) (void));		//attach user isr
+
+void int2Init(void);							//initialize the module
+void int2AttachISR(void (*isrptr) (void));		//attach user isr
+
+#if defined(_INT3IF)								//int3/int4 on GA10x/GB00x
+void int3Init(void);							//initialize the module
+void int3AttachISR(void (*isrptr) (void));		//attach user isr
+
+void int4Init(void);							//initialize the module
+void int4AttachISR(void (*isrptr) (void));		//attach user isr
+#endif
+//end extint
+
+//interrupt priorities
+//one entry per vector, seeded from the xxIP_DEFAULT values. the inits and attach functions apply the entry
+typedef enum {
+	IRQ_T1, IRQ_T2, IRQ_T3, IRQ_T4, IRQ_T5,
+	IRQ_OC1, IRQ_OC2, IRQ_OC3, IRQ_OC4, IRQ_OC5,
+	IRQ_IC1, IRQ_IC2, IRQ_IC3, IRQ_IC4, IRQ_IC5,
+	IRQ_INT0, IRQ_INT1, IRQ_INT2,
+#if defined(_INT3IF)
+	IRQ_INT3, IRQ_INT4,
+#endif
+	IRQ_CN,
+	IRQ_U1RX, IRQ_U1TX, IRQ_U2RX, IRQ_U2TX,
+	IRQ_AD1, IRQ_SPI1, IRQ_SPI2, IRQ_CRC,
+	IRQ_RTC,
+	IRQ_CNT
+} IRQ_TypeDef;
+void irqSetPriority(IRQ_TypeDef irq, uint8_t ipl);	//set the priority (0..7, 0->disabled) and apply it
+uint8_t irqGetPriority(IRQ_TypeDef irq);		//priority in the table
+void irqApply(IRQ_TypeDef irq);					//write the table entry to its IPCx field
+uint8_t irqRead(IRQ_TypeDef irq);				//priority in effect in its IPCx field
+void irqDump(void (*print)(char *str, int32_t dat));	//print the effective priority of each vector, with u1Print()/u2Print()
+#if defined(ISR_PROFILE)
+uint16_t isrMin(IRQ_TypeDef irq);				//shortest run of a vector so far, in ticks. 0->not taken yet
+uint16_t isrMax(IRQ_TypeDef irq);				//longest run of a vector so far, in ticks
+void isrReset(void);							//restart the measurements
+void isrDump(void (*print)(char *str, int32_t dat), uint8_t max);	//print the longest (max=1) / shortest (max=0) run of each vector
+#endif
+//end interrupt priorities
+
+//event queue: one producer (isr) -> one consumer (loop())
+//several isrs may post if they share a priority, so none preempts another mid-post
+#define EVT_SIZE				16				//queue size, power of 2
+typedef struct {
+	uint8_t type;								//user defined
+	uint16_t data;								//user defined
+	uint32_t tick;								//ticks() at evtPost()
+} EVT_TypeDef;
+uint8_t evtPost(uint8_t type, uint16_t data);	//producer: queue an event stamped with ticks(). return 0 if full
+uint8_t evtGet(EVT_TypeDef *evt);				//consumer: take the oldest event. return 0 if empty
+uint16_t evtAvailable(void);					//events in the queue
+uint16_t evtOverflows(void);					//events lost to a full queue
+uint16_t evtHighWater(void);					//most events ever queued at once
+//end event queue
+
+//cooperative scheduler: fixed-rate tasks, released by taskRun()
+//main() runs taskRun() ahead of each loop(). with USE_MAIN, call taskRun() from your own loop
+//due tasks run in the order they were added: add the fastest first
+#define TASK_CNT				8				//max number of tasks
+#define TASK_1KHZ				(F_PHB / 1000)	//periods, in ticks
+#define TASK_100HZ				(F_PHB / 100)
+#define TASK_10HZ				(F_PHB / 10)
+typedef struct {
+	void (*func)(void);							//task, 0->free slot
+	uint32_t period;							//in ticks
+	uint32_t next;								//next release, in ticks
+	uint32_t runs;								//times run
+	uint16_t miss;								//releases skipped: started a period or more late. sticks at 0xffff
+	uint16_t overrun;							//runs longer than the period. sticks at 0xffff
+	uint32_t exec;								//duration of the last run, in ticks
+	uint32_t exec_max;							//longest run, in ticks
+	uint64_t exec_sum;							//total run time, in ticks. average = exec_sum / runs
+} TASK_TypeDef;
+uint8_t taskAdd(void (*func)(void), uint32_t period);	//run func every period ticks, starting one period from now. return the task id, or TASK_CNT if full or period is 0
+void taskRemove(uint8_t id);					//remove a task
+void taskRun(void);								//run the tasks that are due
+void taskStat(uint8_t id, TASK_TypeDef *stat);	//copy of a task's statistics
+//end scheduler
+
+//preemptive kernel
+//fixed-priority threads, time-sliced among equal priorities on the tmr1 tick
+//the main thread (setup()/loop()) runs at K_MAIN_PRIO, an idle thread at 0
+//isrs run on the stack of the thread they interrupt: size every stack for the deepest isr nesting
+#if defined(USE_KERNEL)
+#define K_THREADS				6				//max number of threads, including idle and main
+#define K_MAIN_PRIO				1				//priority of the main thread. higher runs first, 0 is reserved for idle
+#define K_HZ					1000			//tick rate, 250Hz or more
+#define K_IPL					1				//tick priority: below all other isrs
+#define K_STACK_MIN				64				//minimum thread stack, in words
+#define K_FOREVER				0xfffffffful	//timeout: wait forever
+typedef struct {
+	volatile uint16_t count;
+} KSEM_TypeDef;
+typedef struct {
+	uint16_t *buf;								//queue storage
+	uint8_t size;								//in words
+	volatile uint8_t head, cnt;
+} KQUEUE_TypeDef;
+void kInit(void);								//turn the caller into the main thread and start the tick
+uint8_t kThread(void (*func)(void), uint16_t *stack, uint16_t words, uint8_t prio);	//start a thread, prio 1 or more. return its id, or K_THREADS if none is left
+void kYield(void);								//let the scheduler pick the next thread
+void kSleep(uint32_t t);						//sleep t ticks
+void kSemInit(KSEM_TypeDef *sem, uint16_t count);
+uint8_t kSemWait(KSEM_TypeDef *sem, uint32_t timeout);	//take the semaphore, waiting up to timeout ticks. return 0 on timeout
+void kSemPost(KSEM_TypeDef *sem);				//give the semaphore, from a thread
+void kSemPostISR(KSEM_TypeDef *sem);			//give the semaphore, from an isr
+void kQueueInit(KQUEUE_TypeDef *q, uint16_t *buf, uint8_t size);
+uint8_t kQueuePut(KQUEUE_TypeDef *q, uint16_t dat, uint32_t timeout);	//queue dat, waiting up to timeout ticks for room. return 0 on timeout
+uint8_t kQueueGet(KQUEUE_TypeDef *q, uint16_t *dat, uint32_t timeout);	//take the oldest word, waiting up to timeout ticks. return 0 on timeout
+uint8_t kQueuePutISR(KQUEUE_TypeDef *q, uint16_t dat);	//queue dat from an isr. return 0 if full
+uint32_t kSwitches(void);						//context switches so far
+uint16_t kSwitchCycles(void);					//cycles of the last context switch
+uint16_t kSwitchCyclesMax(void);				//longest context switch, in cycles
+#endif	//use_kernel
+//end kernel
+
+//tickless idle: cpu off until the next due event, woken by tmr1
+//Idle mode (default): tmr2 keeps counting but its overflow interrupt is held off, SysTick is rebuilt on wake-up
+//Sleep mode (IDLE_SLEEP): tmr1 runs on the 32768Hz SOSC, and everything clocked from the cpu stops, tmr2 included
+//the isr that wakes the cpu runs after SysTick is corrected. not with USE_KERNEL, whose idle thread does this, or SYSTICK_TMR1
+//#define IDLE_SLEEP								//idle in Sleep mode, timed by SOSC
+#define IDLE_MAX				0x00ffffff		//longest idle, in ticks
+void idle(void);								//idle until the next scheduler task or, in Sleep mode, software timer is due
+void idleUntil(uint32_t due);					//idle until ticks() reaches due, or an interrupt wakes the cpu
+void idleStats(uint64_t *idle, uint64_t *active);	//ticks spent idle and active so far
+//end tickless idle
+
+//frequency scaling
+//DOZE slows the cpu alone: peripherals, baud rates and the timebase stay put
+//RCDIV scales F_PHB when running off FRCDIV/FRCPLL: micros64() carries on and peripheral timing is re-derived, as in SystemCoreClockSwitch()
+#define DVFS_HIGH				80				//cpuGovern(): load above which the cpu speeds up, in %
+#define DVFS_LOW				30				//cpuGovern(): load below which the cpu slows down, in %
+void cpuDoze(uint8_t doze);						//cpu at F_PHB / 2^doze, doze=0..7
+void cpuRcdiv(uint8_t rcdiv);					//frc postscaler 1:2^rcdiv, rcdiv=0..7
+uint8_t cpuGovern(void);						//step DOZE by the load idle() saw since the last call. return DOZE
+//end frequency scaling
+
+//peripheral power
+//a module powered up by its xxxInit() counts as one user. the last pmdDisable() saves its registers and powers it off
+//the next pmdEnable() powers it up and writes them back, enable bits last. interrupt enables and pin mapping are kept
+//the timebase timer (tmr2) and, with USE_KERNEL, the kernel tick timer (tmr1) are never powered off
+typedef enum {
+	PMD_T1, PMD_T2, PMD_T3, PMD_T4, PMD_T5,
+	PMD_OC1, PMD_OC2, PMD_OC3, PMD_OC4, PMD_OC5,
+	PMD_IC1, PMD_IC2, PMD_IC3, PMD_IC4, PMD_IC5,
+	PMD_U1, PMD_U2, PMD_SPI1, PMD_SPI2, PMD_ADC1,
+	PMD_CNT
+} PMD_TypeDef;
+uint8_t pmdEnable(PMD_TypeDef pmd);				//add a user, power up on the first. return the users
+uint8_t pmdDisable(PMD_TypeDef pmd);			//drop a user, power off on the last. return the users
+uint8_t pmdUsers(PMD_TypeDef pmd);				//users, 0->powered off
+uint32_t pmdMap(void);							//powered modules: bit n->PMD_TypeDef n
+void pmdDump(void (*print)(char *str, int32_t dat));	//print the users of each module, with u1Print()/u2Print()
+//end peripheral power
+
+//deep sleep - GA10x/GB00x only
+//core, ram and peripherals powered down. the mcu wakes through a reset with DSGPR0/1 (32 bits of state) intact
+//wake-up: DSWDT (DSWDTEN/DSWDTPS/DSWDTOSC config bits), rtcc alarm (RTCOSC config bit), INT0, MCLR
+//on a deep sleep wake mcuInit() picks up the reason and the state, and the pins stay latched until dsRelease()
+//define DS_RESUME() to run it in place of setup() after a deep sleep wake: set LATx/TRISx back, then dsRelease()
+//#define DS_RESUME()			myResume()
+#if defined(__PIC24GA10x__) | defined(__PIC24GB00x__)
+#define DS_INT0					(1<<8)			//DSWAKE bits: INT0
+#define DS_FLT					(1<<7)			//deep sleep fault
+#define DS_WDT					(1<<4)			//DSWDT
+#define DS_RTC					(1<<3)			//rtcc alarm
+#define DS_MCLR					(1<<2)			//MCLR
+#define DS_POR					(1<<0)			//power-on reset
+void dsEnter(uint32_t state, uint16_t wake);	//save state, arm the DS_INT0/DS_RTC wake-ups and enter deep sleep. returns only if an interrupt was pending
+uint16_t dsWake(void);							//DSWAKE bits at boot, 0->not a deep sleep wake
+uint32_t dsState(void);							//state saved by dsEnter(), valid when dsWake()
+#define dsRelease()				do {DSCONbits.RELEASE = 0;} while (0)	//let go of the pins latched through deep sleep
+#endif
+//end deep sleep
+
+//spi
+void spi1Init(uint16_t br);						//reset the spi
+#define spi1Busy()			(SPI1STATbits.SPITBF)	//transmit buffer full, must wait before writing to SPIxBUF
+#define spi1Available()		(!SPI1STATbits.SPIRBE)	//receive buffer not empty -> there is data
+#define spi1Write(dat)		SPI1BUF=(dat)		//send data via spi
+#define spi1Read()			(SPI1BUF)			//read from the buffer
+
+void spi2Init(uint16_t br);						//reset the spi
+#define spi2Busy()			(SPI2STATbits.SPITBF)	//transmit buffer full, must wait before writing to SPIxBUF
+#define spi2Available()		(!SPI2STATbits.SPIRBE)	//receive buffer not empty -> there is data
+#define spi1Write(dat)		SPI1BUF=(dat)		//send data via spi
+#define spi2Read()			(SPI2BUF)			//read from the buffer
+
+void spiRebaud(void);							//restore the spi bit rates set by spixInit() for the current F_PHB, or the nearest slower ones
+
+//end spi
+
+//i2c
+//end i2c
+
+//rtcc
+//allows write to rtc registers
+//#define RTCC_WREN()			do {NVMKEY=0x55; NVMKEY=0xaa; RCFGCALbits.RTCWREN = 1;} while (RCFGCALbits.RTCWREN == 0)
+#define RTCC_WREN()	{	asm volatile("push w7"); \
+						asm volatile("push w8"); \
+						asm volatile("disi #5"); \
+						asm volatile("mov #0x55, w7"); \
+						asm volatile("mov w7, _NVMKEY"); \
+						asm volatile("mov #0xAA, w8"); \
+						asm volatile("mov w8, _NVMKEY"); \
+						asm volatile("bset _RCFGCAL, #13"); \
+						asm volatile("pop w8"); \
+						asm volatile("pop w7"); \
+					}
+//do not allow any write to rtc registers - assumes the nvmkey sequence has been sent
+#define RTCC_WRDIS()	do {RCFGCALbits.RTCWREN = 0;} while (RCFGCALbits.RTCWREN == 1)
+
+//for RTCC PTR values to be used with RTCCRead() and RTCCWrite()
+#define RTCPTR_MINSEC	0
+#define RTCPTR_WKDHRS	1
+#define RTCPTR_MONDAY	2
+#define RTCPTR_YEAR		3
+
+//bcd to dec conversion
+#define BCD2DEC(bcd)			((((bcd) & 0xf0)>>4)*10+((bcd) & 0x0f))	//convert bcd to int
+#define DEC2BCD(dec)			((((dec) / 10)<<4) +((dec) % 10))		//convert int to bcd
+
+void RTCCInit(void);							//initialize the rtcc
+uint16_t RTCCRead(uint16_t mask);				//read from rtcc, based on the value of mask (0..3)
+#define RTCCGetSec()			(RTCCRead(RTCPTR_MINSEC) & 0xff)
+#define RTCCGetMin()			(RTCCRead(RTCPTR_MINSEC) >> 8)
+#define RTCCGetHour()			(RTCCRead(RTCPTR_WKDHRS) & 0xff)
+#define RTCCGetWDay()			(RTCCRead(RTCPTR_WKDHRS) >> 8)
+#define RTCCGetDay()			(RTCCRead(RTCPTR_MONDAY) & 0xff)
+#define RTCCGetMonth()			(RTCCRead(RTCPTR_MONDAY) >> 8)
+#define RTCCGetYear()			(RTCCRead(RTCPTR_YEAR  ) & 0xff)
+void RTCCWrite(uint16_t mask, uint16_t byte_t);	//write to rtcc,  based on the value of mask (0..3)
+#define RTCCSetSec(dat)			RTCCWrite(RTCPTR_MINSEC, (RTCCRead(RTCPTR_MINSEC) & ~0x00ff) | ((dat) & 0x00ff))
+#define RTCCSetMin(dat)			RTCCWrite(RTCPTR_MINSEC, (RTCCRead(RTCPTR_MINSEC) & ~0xff00) | ((dat) & 0xff00))
+#define RTCCSetHour(dat)		RTCCWrite(RTCPTR_WKDHRS, (RTCCRead(RTCPTR_WKDHRS) & ~0x00ff) | ((dat) & 0x00ff))
+#define RTCCSetWDay(dat)		RTCCWrite(RTCPTR_WKDHRS, (RTCCRead(RTCPTR_WKDHRS) & ~0xff00) | ((dat) & 0xff00))
+#define RTCCSetDay(dat)			RTCCWrite(RTCPTR_MONDAY, (RTCCRead(RTCPTR_MONDAY) & ~0x00ff) | ((dat) & 0x00ff))
+#define RTCCSetMonth(dat)		RTCCWrite(RTCPTR_MONDAY, (RTCCRead(RTCPTR_MONDAY) & ~0xff00) | ((dat) & 0xff00))
+#define RTCCSetYear(dat)		RTCCWrite(RTCPTR_YEAR,   (RTCCRead(RTCPTR_YEAR  ) & ~0x00ff) | ((dat) & 0x00ff))
+void RTCCSetCal(uint8_t cal); 	//write to rtcc calibration register
+uint8_t RTCCGetCal(void);		//read from rtcc calibration register
+
+//whole timestamp at once: the four RTCPTR words in one auto-decrementing pass
+//years 2000..2099. epoch: seconds since 1970-01-01 00:00:00
+#define RTCC_EPOCH2000			946684800ul		//epoch at 2000-01-01 00:00:00
+typedef struct {
+	uint8_t year;								//0..99 -> 2000..2099
+	uint8_t month;								//1..12
+	uint8_t day;								//1..31
+	uint8_t wday;								//0..6, 0->sunday
+	uint8_t hour;								//0..23
+	uint8_t min;								//0..59
+	uint8_t sec;								//0..59
+} RTCC_TypeDef;
+void RTCCReadTime(RTCC_TypeDef *t);				//consistent snapshot of the rtcc, in binary
+void RTCCWriteTime(const RTCC_TypeDef *t);		//set the rtcc in one pass. wday is ignored and worked out from the date
+uint32_t RTCCToEpoch(const RTCC_TypeDef *t);	//date/time -> epoch
+void RTCCFromEpoch(uint32_t epoch, RTCC_TypeDef *t);	//epoch -> date/time, with wday
+uint32_t RTCCGetEpoch(void);					//epoch from the rtcc
+void RTCCSetEpoch(uint32_t epoch);				//set the rtcc from an epoch
+
+//rtcc alarm: fires when the fields of the time not masked by every match the rtcc
+//the callback runs in the rtcc isr. the alarm also wakes the mcu from Sleep/Idle (and Deep Sleep with dsEnter(.., DS_RTC))
+#define RTCC_EVERY_HALFSEC		0				//AMASK values
+#define RTCC_EVERY_SEC			1
+#define RTCC_EVERY_10SEC		2
+#define RTCC_EVERY_MIN			3
+#define RTCC_EVERY_10MIN		4
+#define RTCC_EVERY_HOUR			5
+#define RTCC_EVERY_DAY			6
+#define RTCC_EVERY_WEEK			7
+#define RTCC_EVERY_MONTH		8
+#define RTCC_EVERY_YEAR			9
+#define RTCC_FOREVER			0				//repeat count: never stop
+void RTCCAlarmSet(const RTCC_TypeDef *t, uint8_t every, uint16_t repeat, void (*func)(void));	//alarm at t, then every.., repeat=1..256 alarms in all, 0->forever
+void RTCCAlarmAt(uint32_t epoch, void (*func)(void));	//one-shot alarm at an epoch
+void RTCCAlarmStop(void);						//cancel the alarm
+#define RTCCAlarmActive()		(ALCFGRPTbits.ALRMEN)	//1->alarm armed
+
+//wall clock: the rtcc gives the second, ticks64() since the last rtcc rollover gives the fraction
+//ticks are latched in a 1Hz rtcc alarm isr, which also measures F_PHB against the rtcc crystal
+//the fraction is off by the alarm isr latency plus one second of tick drift at most, and never reaches the next second
+//nowInit() takes over the rtcc alarm
+uint8_t nowInit(void);							//start the 1Hz latch. rtcc running and set. return 0 if it did not start (rtcc off, RTC_HANDLER bound, no rollover in 1.5s)
+uint64_t now(void);								//microseconds since 1970-01-01 00:00:00
+uint32_t nowRate(void);							//ticks per rtcc second, as last measured
+
+//end rtcc
+
+//cnint
+void cnInit(uint32_t pins);					//initialize change notification
+void cnAttachISR(void (*isrptr) (void));		//attach user isr
+#define CN_CNT					8				//max number of per-pin callbacks
+//call func(pin, level, ticks()) when pin changes: mode=RISING/FALLING/CHANGE. the pin's cn input must be enabled through cnInit()
+//callbacks run in the cn isr, ahead of the user isr. return 0 if the table is full
+uint8_t cnAttach(PIN_TypeDef pin, void (*func)(PIN_TypeDef pin, uint8_t level, uint32_t tick), uint8_t mode);
+void cnDetach(PIN_TypeDef pin);					//remove the pin's callback
+//end cnint
+
+//quadrature encoders on change notification
+//both channels of an encoder on the same port, their CN inputs enabled through encInit()
+#define ENC_CNT					2				//max number of encoders
+typedef struct {
+	int32_t pos;								//position, in counts (4 per quadrature cycle)
+	int32_t vel;								//counts in the last velocity window
+	uint32_t tick;								//ticks() at the snapshot
+} ENC_TypeDef;
+void encInit(uint32_t cnpins, uint32_t window);	//start decoding: cnpins as in cnInit(), velocity window in ticks. takes over the cn isr
+uint8_t encAttach(PIN_TypeDef a, PIN_TypeDef b);	//add an encoder. return its index, or ENC_CNT if none is left
+void encRead(uint8_t enc, ENC_TypeDef *snap);	//atomic snapshot of position and velocity
+void encWrite(uint8_t enc, int32_t pos);		//set the position
+//end encoder
+
+//crc
+void CRCInit(uint8_t len, uint32_t poly);							//initialize the crc
+uint16_t CRC16(char *msg, uint16_t length, uint16_t init_val);		//return crc check on a message. length must be multiples of 2
+#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+		defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__)
+#define CRCBusy()				(CRCCON1bits.CRCGO == 1)			////if CRC is busy
+#define CRCAvailable()		(CRCCON1bits.CRCGO == 0)			//crc complete, data available
+#else
+#define CRCBusy()				(CRCCONbits.CRCGO == 1)			////if CRC is busy
+#define CRCAvailable()		(CRCCONbits.CRCGO == 0)			//crc complete, data available
+#endif
+#define CRCGet()				(CRCWDAT)							//read CRC back
+#define CRC8Init(xor, init)		CRCInit(0x07, xor, init)			//initialize 16-bit CRC
+#define CRC16Init(xor, init)	CRCInit(0x0f, xor, init)			//initialize 16-bit CRC
+#define CRC32Init(xor, init)	CRCInit(0x1f, x0r, init)			//initialize 32-bit CRC
+//end crc
+
+//comparator voltage reference
+//comparator voltage reference
+void CVrefInit(void);
+#define CVrefSet(range)			CVRCONbits.CVR=(range)			//set output range
+#define CVrefGet()				(CVRCONbits.CVR)				//return output range
+#define CVrefOE()				CVRCONbits.CVROE=1				//0->disable output, 1->enable output
+#define CVrefOD()				CVRCONbits.CVROE=0				//0->disable output, 1->enable output
+
+//comparator
+#if 	defined(__PIC24FJ64GA102__) | defined (__PIC24FJ64GA104__) | \
+		defined(__PIC24FJ32GA102__) | defined (__PIC24FJ32GA104__)
+
+void CM1Init(void);				//initialize comparator
+#define CM1OUT()				(CM1CONbits.COUT)				//output status
+#define CM1INA()				CM1CONbits.CREF=0				//0->non-inventing input to CxINA, 1->non-inventing input to CVref+
+#define CM1CVrefp()				CM1CONbits.CREF=1				//0->non-inventing input to CxINA, 1->non-inventing input to CVref+
+#define CM1INB()				CM1CONbits.CCH =0				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
+#define CM1INC()				CM1CONbits.CCH =1				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
+#define CM1IND()				CM1CONbits.CCH =2				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
+#define CM1CVrefn()				CM1CONbits.CCH =3				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
+#define CM1OE()					CM1CONbits.COE =1				//1->enable output, 0->disable output
+#define CM1OD()					CM1CONbits.COE =0				//1->enable output, 0->disable output
+
+void CM2Init(void);				//initialize comparator
+#define CM2OUT()				(CM2CONbits.COUT)				//output status
+#define CM2INA()				CM2CONbits.CREF=0				//0->non-inventing input to CxINA, 1->non-inventing input to CVref+
+#define CM2CVrefp()				CM2CONbits.CREF=1				//0->non-inventing input to CxINA, 1->non-inventing input to CVref+
+#define CM2INB()				CM2CONbits.CCH =0				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
+#define CM2INC()				CM2CONbits.CCH =1				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
+#define CM2IND()				CM2CONbits.CCH =2				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
+#define CM2CVrefn()				CM2CONbits.CCH =3				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
+#define CM2OE()					CM2CONbits.COE =1				//1->enable output, 0->disable output
+#define CM2OD()					CM2CONbits.COE =0				//1->enable output, 0->disable output
+
+void CM3Init(void);				//initialize comparator
+#define CM3OUT()				(CM3CONbits.COUT)				//output status
+#define CM3INA()				CM3CONbits.CREF=0				//0->non-inventing input to CxINA, 1->non-inventing input to CVref+
+#define CM3CVrefp()				CM3CONbits.CREF=1				//0->non-inventing input to CxINA, 1->non-inventing input to CVref+
+#define CM3INB()				CM3CONbits.CCH =0				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
+#define CM3INC()				CM3CONbits.CCH =1				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
+#define CM3IND()				CM3CONbits.CCH =2				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
+#define CM3CVrefn()				CM3CONbits.CCH =3				//0->inventing input to CxINB, 1->to CxINC, 2->to CxIND, 3->to CVref-
+#define CM3OE()					CM3CONbits.COE =1				//1->enable output, 0->disable output
+#define CM3OD()					CM3CONbits.COE =0				//1->enable output, 0->disable output
+
+#else		//ga002 chips
+
+void CM1Init(void);				//initialize comparator
+#define CM1OUT()				(CMCONbits.C1OUT)				//output status
+#define CM1NVinp()				CMCONbits.C1NEG=1				//1->C1NEG to Vin+, 0->C1NEG to Vin-
+#define CM1NVinn()				CMCONbits.C1NEG=0				//1->C1NEG to Vin+, 0->C1NEG to Vin-
+#define CM1PVinp()				CMCONbits.C1POS=1				//1->C1POS to Vin+, 0->C1NEG to CVref
+#define CM1PCVref()				CMCONbits.C1POS=0				//1->C1POS to Vin+, 0->C1NEG to CVref
+#define CM1OE()					CMCONbits.C1OUTEN =1			//1->enable output, 0->disable output
+#define CM1OD()					CMCONbits.C1OUTEN =0			//1->enable output, 0->disable output
+
+void CM2Init(void);				//initialize comparator
+#define CM2OUT()				(CMCONbits.C2OUT)				//output status
+#define CM2NVinp()				CMCONbits.C2NEG=1				//1->C1NEG to Vin+, 0->C1NEG to Vin-
+#define CM2NVinn()				CMCONbits.C2NEG=0				//1->C1NEG to Vin+, 0->C1NEG to Vin-
+#define CM2PVinp()				CMCONbits.C2POS=1				//1->C1POS to Vin+, 0->C1NEG to CVref
+#define CM2PCVref()				CMCONbits.C2POS=0				//1->C1POS to Vin+, 0->C1NEG to CVref
+#define CM2OE()					CMCONbits.C2OUTEN =1			//1->enable output, 0->disable output
+#define CM2OD()					CMCONbits.C2OUTEN =0			//1->enable output, 0->disable output
+
+#endif		//comparator
+
+#endif
+